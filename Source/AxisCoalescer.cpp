@@ -0,0 +1,70 @@
+#include "AxisCoalescer.h"
+#include <algorithm>
+
+AxisCoalescer::AxisCoalescer(SendCC sendFn) : send(std::move(sendFn)) {
+  sources.reserve(8);
+}
+
+AxisCoalescer::Source &AxisCoalescer::sourceFor(InputID input) {
+  for (auto &source : sources)
+    if (source.input == input)
+      return source;
+  Source &added = sources.emplace_back();
+  added.input = input;
+  return added;
+}
+
+double AxisCoalescer::push(InputID input, int channel, int ccNumber,
+                           int value, double nowMs, double intervalMs) {
+  juce::ScopedLock sl(lock);
+  Source &source = sourceFor(input);
+  if (source.channel != channel || source.ccNumber != ccNumber) {
+    // Remapped to another CC: the old CC gets its held value now, and the
+    // first change on the new one goes out at once.
+    if (source.held != kNone)
+      send(source.channel, source.ccNumber, source.held);
+    source.channel = channel;
+    source.ccNumber = ccNumber;
+    source.lastSent = kNone;
+    source.held = kNone;
+    source.nextSendMs = 0.0;
+  }
+  source.intervalMs = std::max(0.0, intervalMs);
+
+  if (value == source.lastSent) {
+    source.held = kNone; // Back to what the receiver already has
+    return RealtimeScheduler::idle;
+  }
+  if (nowMs >= source.nextSendMs) {
+    send(channel, ccNumber, value);
+    source.lastSent = value;
+    source.held = kNone;
+    source.nextSendMs = nowMs + source.intervalMs;
+    return RealtimeScheduler::idle;
+  }
+  source.held = value;
+  return source.nextSendMs;
+}
+
+double AxisCoalescer::flush(double nowMs) {
+  juce::ScopedLock sl(lock);
+  double next = RealtimeScheduler::idle;
+  for (auto &source : sources) {
+    if (source.held == kNone)
+      continue;
+    if (nowMs < source.nextSendMs) {
+      next = std::min(next, source.nextSendMs);
+      continue;
+    }
+    send(source.channel, source.ccNumber, source.held);
+    source.lastSent = source.held;
+    source.held = kNone;
+    source.nextSendMs = nowMs + source.intervalMs;
+  }
+  return next;
+}
+
+void AxisCoalescer::clear() {
+  juce::ScopedLock sl(lock);
+  sources.clear();
+}
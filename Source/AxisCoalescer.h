@@ -0,0 +1,55 @@
+#pragma once
+#include "MappingTypes.h"
+#include "RealtimeScheduler.h"
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+// Rate limiter for axis -> CC output (pointer X/Y, pens, high-polling mice).
+// Keyed by source (device, axis): the first change after a quiet interval is
+// sent at once, later changes inside the interval are held and only the
+// newest is sent when the interval ends. Values equal to the last one sent
+// on that CC are dropped. Times are monotonic milliseconds
+// (RealtimeScheduler::nowMs). As a scheduler client its tick flushes held
+// values; the owner registers it and schedules the deadlines push returns.
+class AxisCoalescer : public RealtimeScheduler::Client {
+public:
+  using SendCC = std::function<void(int channel, int ccNumber, int value)>;
+
+  explicit AxisCoalescer(SendCC send);
+
+  // New 7-bit value for source's CC at nowMs; intervalMs <= 0 sends every
+  // change. A source remapped to another CC sends its held value on the old
+  // one and starts fresh. Returns the time a flush is needed for a held
+  // value, or RealtimeScheduler::idle when nothing is held.
+  double push(InputID source, int channel, int ccNumber, int value,
+              double nowMs, double intervalMs);
+
+  // Send held values whose interval has ended. Returns the next deadline or
+  // RealtimeScheduler::idle.
+  double flush(double nowMs);
+
+  // Forget all sources (held values are dropped, not sent).
+  void clear();
+
+  double onSchedulerTick(double nowMs) override { return flush(nowMs); }
+
+private:
+  static constexpr int kNone = -1;
+
+  struct Source {
+    InputID input;
+    int channel = 0;
+    int ccNumber = 0;
+    int lastSent = kNone;
+    int held = kNone;
+    double intervalMs = 0.0;
+    double nextSendMs = 0.0; // Earliest time the next value may go out
+  };
+
+  Source &sourceFor(InputID input);
+
+  SendCC send;
+  std::vector<Source> sources; // Few axes; linear search beats hashing
+  juce::CriticalSection lock;  // push (input thread) vs flush (scheduler)
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+
+// Heap allocation counter for the benchmark binary. AllocationCounter.cpp
+// replaces the global operator new/delete with versions that count
+// allocations per thread, so a benchmark can measure exactly what the code
+// under test allocates on the calling thread.
+struct AllocationCounter {
+  // Allocations made by the calling thread since it started.
+  static size_t threadAllocations();
+};
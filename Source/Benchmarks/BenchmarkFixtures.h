@@ -32,6 +32,12 @@ public:
   void sendNoteOff(int channel, int note) override {
     events.push_back({channel, note, 0.0f, false});
   }
+  void sendNoteOnAt(int channel, int note, float velocity, double) override {
+    sendNoteOn(channel, note, velocity);
+  }
+  void sendNoteOffAt(int channel, int note, double) override {
+    sendNoteOff(channel, note);
+  }
   void clear() { events.clear(); }
   size_t eventCount() const { return events.size(); }
 };
@@ -0,0 +1,248 @@
+// Config-time rebuild benchmarks: MappingCompiler::compile,
+// ZoneManager::rebuildLookupTable and Zone::rebuildCache over generated
+// presets, plus a resident-size report for the compiled context. Gate for
+// rebuild stalls when a preset, alias or zone changes.
+
+#include "../MappingCompiler.h"
+#include "../TaskPool.h"
+#include "../ZoneManager.h"
+#include "AllocationCounter.h"
+#include "BenchmarkFixtures.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace {
+
+// Shape of a generated session. Benchmarks take it from their Args as
+// {mappings, aliases, zones, touchpadLayouts, chordType}.
+struct PresetShape {
+  int mappings = 0;
+  int aliases = 0;
+  int zones = 0;
+  int touchpadLayouts = 0;
+  ChordUtilities::ChordType chordType = ChordUtilities::ChordType::None;
+
+  static PresetShape fromState(const benchmark::State &state) {
+    PresetShape shape;
+    shape.mappings = (int)state.range(0);
+    shape.aliases = (int)state.range(1);
+    shape.zones = (int)state.range(2);
+    shape.touchpadLayouts = (int)state.range(3);
+    shape.chordType = (ChordUtilities::ChordType)state.range(4);
+    return shape;
+  }
+};
+
+// Bytes held by each part of a compiled context. Grids shared between
+// layers or aliases count once; touchpad entries count their vector storage
+// only (nested pitch-pad bands and names are small and excluded).
+struct ContextMemory {
+  size_t audioGrids = 0, audioGridBytes = 0;
+  size_t visualGrids = 0, visualGridBytes = 0;
+  size_t actionPoolBytes = 0;
+  size_t chordPoolBytes = 0;
+  size_t touchpadBytes = 0;
+};
+
+template <typename T> size_t vectorBytes(const std::vector<T> &v) {
+  return v.capacity() * sizeof(T);
+}
+
+ContextMemory measureContext(const CompiledMapContext &context) {
+  ContextMemory memory;
+
+  std::unordered_set<const AudioGrid *> audio;
+  for (const auto &grid : context.globalGrids)
+    audio.insert(grid.get());
+  for (const auto &[hash, grids] : context.deviceGrids)
+    for (const auto &grid : grids)
+      audio.insert(grid.get());
+  audio.erase(nullptr);
+  memory.audioGrids = audio.size();
+  memory.audioGridBytes = audio.size() * sizeof(AudioGrid);
+
+  std::unordered_set<const VisualGrid *> visual;
+  for (const auto &[hash, grids] : context.visualLookup)
+    for (const auto &grid : grids)
+      visual.insert(grid.get());
+  visual.erase(nullptr);
+  memory.visualGrids = visual.size();
+  memory.visualGridBytes = visual.size() * sizeof(VisualGrid);
+
+  memory.actionPoolBytes = vectorBytes(context.actionPool);
+  memory.chordPoolBytes = vectorBytes(context.chordPool);
+  for (const auto &chord : context.chordPool)
+    memory.chordPoolBytes += vectorBytes(chord);
+
+  memory.touchpadBytes = vectorBytes(context.touchpadMappings) +
+                         vectorBytes(context.touchpadMixerStrips) +
+                         vectorBytes(context.touchpadDrumPadStrips) +
+                         vectorBytes(context.touchpadChordPads) +
+                         vectorBytes(context.touchpadDrumFxSplits) +
+                         vectorBytes(context.touchpadLayoutOrder);
+  return memory;
+}
+
+void reportMemory(benchmark::State &state, const ContextMemory &memory) {
+  state.counters["audio_grids"] = (double)memory.audioGrids;
+  state.counters["audio_grid_bytes"] = (double)memory.audioGridBytes;
+  state.counters["visual_grids"] = (double)memory.visualGrids;
+  state.counters["visual_grid_bytes"] = (double)memory.visualGridBytes;
+  state.counters["action_pool_bytes"] = (double)memory.actionPoolBytes;
+  state.counters["chord_pool_bytes"] = (double)memory.chordPoolBytes;
+  state.counters["touchpad_bytes"] = (double)memory.touchpadBytes;
+}
+
+} // namespace
+
+class CompilerBenchmarkFixture : public MidiBenchmarkFixture {
+public:
+  ZoneManager zoneMgr{scaleLib};
+  int generatedAliases = 0;
+
+  void TearDown(benchmark::State &state) override {
+    for (const auto &zone : zoneMgr.getZones())
+      zoneMgr.removeZone(zone);
+    for (int a = 0; a < generatedAliases; ++a)
+      deviceMgr.deleteAlias("BenchAlias" + juce::String(a));
+    generatedAliases = 0;
+    while (!touchpadLayoutMgr.getLayouts().empty())
+      touchpadLayoutMgr.removeLayout(0);
+    MidiBenchmarkFixture::TearDown(state);
+  }
+
+  // Fill the preset and managers with a session of the given shape. Mappings
+  // round-robin over the global stack and the aliases, spread over all nine
+  // layers; zones cycle layers and aliases with eight keys each.
+  void generate(const PresetShape &shape) {
+    std::vector<uintptr_t> hashes{0};
+    for (int a = 0; a < shape.aliases; ++a) {
+      const juce::String alias = "BenchAlias" + juce::String(a);
+      deviceMgr.createAlias(alias);
+      hashes.push_back(DeviceManager::getAliasHash(alias));
+    }
+    generatedAliases = std::max(generatedAliases, shape.aliases);
+
+    for (int i = 0; i < shape.mappings; ++i) {
+      const size_t owner = (size_t)i % hashes.size();
+      const int layer = (i / (int)hashes.size()) % 9;
+      auto mappings = presetMgr.getMappingsListForLayer(layer);
+      juce::ValueTree m("Mapping");
+      m.setProperty("inputKey", 0x30 + (i * 7) % 0x50, nullptr);
+      if (owner > 0)
+        m.setProperty("inputAlias", "BenchAlias" + juce::String(owner - 1),
+                      nullptr);
+      m.setProperty("deviceHash",
+                    juce::String::toHexString((juce::int64)hashes[owner])
+                        .toUpperCase(),
+                    nullptr);
+      m.setProperty("type", i % 5 == 4 ? "Expression" : "Note", nullptr);
+      m.setProperty("data1", 36 + i % 60, nullptr);
+      m.setProperty("data2", 100, nullptr);
+      m.setProperty("channel", 1 + i % 16, nullptr);
+      m.setProperty("layerID", layer, nullptr);
+      mappings.addChild(m, -1, nullptr);
+    }
+
+    for (int z = 0; z < shape.zones; ++z) {
+      std::vector<int> keys;
+      for (int k = 0; k < 8; ++k)
+        keys.push_back(0x41 + (z * 3 + k) % 26);
+      auto zone = createZone("BenchZone" + juce::String(z), z % 9, keys,
+                             shape.chordType);
+      zone->targetAliasHash = hashes[(size_t)z % hashes.size()];
+      zoneMgr.addZone(zone);
+    }
+
+    for (int t = 0; t < shape.touchpadLayouts; ++t) {
+      TouchpadLayoutConfig cfg;
+      cfg.type = (TouchpadType)(t % 3);
+      cfg.name = "BenchLayout" + std::to_string(t);
+      cfg.layerId = t % 9;
+      cfg.ccStart = 20 + t % 100;
+      touchpadLayoutMgr.addLayout(cfg);
+    }
+  }
+};
+
+// Full compile of a generated session, serial on the calling thread so the
+// allocation counter sees every allocation. Args: {mappings, aliases, zones,
+// touchpadLayouts, chordType}.
+BENCHMARK_DEFINE_F(CompilerBenchmarkFixture, Compiler_Compile)
+(benchmark::State &state) {
+  generate(PresetShape::fromState(state));
+
+  TaskPool serial(0);
+  size_t allocations = 0;
+  std::shared_ptr<CompiledMapContext> context;
+  for (auto _ : state) {
+    context.reset();
+    const size_t before = AllocationCounter::threadAllocations();
+    context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                       touchpadLayoutMgr, settingsMgr, nullptr,
+                                       MappingCompiler::Scope::all(), &serial);
+    allocations += AllocationCounter::threadAllocations() - before;
+  }
+  state.counters["allocs_per_compile"] = benchmark::Counter(
+      (double)allocations, benchmark::Counter::kAvgIterations);
+  reportMemory(state, measureContext(*context));
+}
+BENCHMARK_REGISTER_F(CompilerBenchmarkFixture, Compiler_Compile)
+    ->ArgNames({"maps", "aliases", "zones", "pads", "chord"})
+    ->Args({16, 0, 0, 0, 0})
+    ->Args({128, 0, 0, 0, 0})
+    ->Args({128, 4, 0, 0, 0})
+    ->Args({512, 8, 0, 0, 0})
+    ->Args({128, 4, 8, 0, 1})
+    ->Args({128, 4, 8, 0, 3})
+    ->Args({128, 4, 32, 0, 3})
+    ->Args({128, 4, 8, 6, 1})
+    ->Args({512, 8, 32, 12, 2})
+    ->Unit(benchmark::kMicrosecond);
+
+// ZoneManager::rebuildLookupTable over K zones of 8 keys spread over the
+// aliases. Args as Compiler_Compile (mappings and touchpads unused).
+BENCHMARK_DEFINE_F(CompilerBenchmarkFixture, Compiler_ZoneLookupTable)
+(benchmark::State &state) {
+  generate(PresetShape::fromState(state));
+
+  for (auto _ : state)
+    zoneMgr.rebuildLookupTable();
+  state.counters["zones"] = (double)state.range(2);
+}
+BENCHMARK_REGISTER_F(CompilerBenchmarkFixture, Compiler_ZoneLookupTable)
+    ->ArgNames({"maps", "aliases", "zones", "pads", "chord"})
+    ->Args({0, 0, 8, 0, 0})
+    ->Args({0, 4, 32, 0, 0})
+    ->Args({0, 8, 128, 0, 0})
+    ->Unit(benchmark::kMicrosecond);
+
+// Zone::rebuildCache for one zone: Arg 0 = keys in the zone, Arg 1 = chord
+// type (ChordUtilities::ChordType).
+BENCHMARK_DEFINE_F(CompilerBenchmarkFixture, Compiler_ZoneRebuildCache)
+(benchmark::State &state) {
+  std::vector<int> keys;
+  for (int k = 0; k < (int)state.range(0); ++k)
+    keys.push_back(0x30 + k);
+  auto zone = createZone("CacheZone", 0, keys,
+                         (ChordUtilities::ChordType)state.range(1),
+                         PolyphonyMode::Poly);
+  const std::vector<int> intervals = scaleLib.getIntervals("Major");
+
+  size_t allocations = 0;
+  for (auto _ : state) {
+    const size_t before = AllocationCounter::threadAllocations();
+    zone->rebuildCache(intervals, 60);
+    allocations += AllocationCounter::threadAllocations() - before;
+  }
+  state.counters["allocs_per_rebuild"] = benchmark::Counter(
+      (double)allocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(CompilerBenchmarkFixture, Compiler_ZoneRebuildCache)
+    ->ArgNames({"keys", "chord"})
+    ->Args({8, 0})
+    ->Args({8, 1})
+    ->Args({32, 1})
+    ->Args({32, 3})
+    ->Args({64, 3})
+    ->Unit(benchmark::kMicrosecond);
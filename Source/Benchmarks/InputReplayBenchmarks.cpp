@@ -0,0 +1,148 @@
+// Input Replay Benchmarks
+// Replays captured input streams (File > Start Input Capture) through a
+// headless InputProcessor and reports input-to-MIDI latency percentiles and
+// throughput. Set MIDIQY_REPLAY_CAPTURE (a .mqir capture) and
+// MIDIQY_REPLAY_PRESET (the preset .xml it was played with) to benchmark a
+// real performance; otherwise a built-in synthetic capture is used.
+
+#include "ReplayHarness.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Ten mapped keys played as overlapping runs and three-note chords, ending
+// with every key released so each replay starts from the same state.
+InputRecording makeSyntheticCapture() {
+  InputRecording rec;
+  double t = 0.0;
+  auto key = [&](int keyCode, bool isDown) {
+    InputRecording::Event e;
+    e.timeMs = t;
+    e.code = keyCode;
+    e.isDown = isDown;
+    e.kind = InputRecording::Kind::Key;
+    rec.events.push_back(e);
+    t += 5.0;
+  };
+  for (int bar = 0; bar < 50; ++bar) {
+    for (int i = 0; i < 8; ++i) { // Legato run
+      key(81 + i, true);
+      key(81 + (i + 9) % 10, false);
+    }
+    key(88, false);
+    for (int c = 0; c < 3; ++c) { // Chord
+      key(81 + c * 2, true);
+      key(82 + c * 2, true);
+      key(83 + c * 2, true);
+      key(81 + c * 2, false);
+      key(82 + c * 2, false);
+      key(83 + c * 2, false);
+    }
+  }
+  for (int i = 0; i < 10; ++i)
+    key(81 + i, false);
+  return rec;
+}
+
+void addSyntheticMappings(PresetManager &presetMgr) {
+  auto mappings = presetMgr.getMappingsListForLayer(0);
+  for (int i = 0; i < 10; ++i) {
+    juce::ValueTree m("Mapping");
+    m.setProperty("inputKey", 81 + i, nullptr);
+    m.setProperty("deviceHash",
+                  juce::String::toHexString((juce::int64)0).toUpperCase(),
+                  nullptr);
+    m.setProperty("type", "Note", nullptr);
+    m.setProperty("data1", 60 + i, nullptr);
+    m.setProperty("data2", 100, nullptr);
+    m.setProperty("channel", 1, nullptr);
+    m.setProperty("layerID", 0, nullptr);
+    mappings.addChild(m, -1, nullptr);
+  }
+}
+
+} // namespace
+
+class ReplayBenchmarkFixture : public benchmark::Fixture {
+public:
+  std::unique_ptr<ReplaySession> session;
+  InputRecording capture;
+
+  void SetUp(benchmark::State &state) override {
+    session = std::make_unique<ReplaySession>();
+    const auto capturePath =
+        juce::SystemStats::getEnvironmentVariable("MIDIQY_REPLAY_CAPTURE", {});
+    const auto presetPath =
+        juce::SystemStats::getEnvironmentVariable("MIDIQY_REPLAY_PRESET", {});
+    if (capturePath.isNotEmpty()) {
+      if (!capture.loadFromFile(juce::File(capturePath))) {
+        state.SkipWithError("Could not read MIDIQY_REPLAY_CAPTURE");
+        return;
+      }
+      if (presetPath.isNotEmpty())
+        session->loadPreset(juce::File(presetPath));
+    } else {
+      capture = makeSyntheticCapture();
+      addSyntheticMappings(session->presetMgr);
+      session->proc.forceRebuildMappings();
+    }
+  }
+
+  void TearDown(benchmark::State &state) override { session.reset(); }
+};
+
+// Whole-capture replay: p50/p99/p99.9 input-to-MIDI latency (over every
+// replayed event that produced MIDI) and sustained events per second.
+BENCHMARK_DEFINE_F(ReplayBenchmarkFixture, Replay_Capture_Latency)
+(benchmark::State &state) {
+  auto &probe = session->probe;
+  probe.reset();
+  for (auto _ : state)
+    session->replayTimed(capture);
+
+  const double events =
+      (double)capture.events.size() * (double)state.iterations();
+  state.counters["events_per_sec"] =
+      benchmark::Counter(events, benchmark::Counter::kIsRate);
+  state.counters["events"] = (double)capture.events.size();
+  state.counters["p50_us"] = probe.percentileUs(50.0);
+  state.counters["p99_us"] = probe.percentileUs(99.0);
+  state.counters["p99.9_us"] = probe.percentileUs(99.9);
+}
+BENCHMARK_REGISTER_F(ReplayBenchmarkFixture, Replay_Capture_Latency)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Same capture while the compiled context is rebuilt continuously (e.g. the
+// user editing mappings mid-performance): shows tail latency under churn.
+BENCHMARK_DEFINE_F(ReplayBenchmarkFixture, Replay_Capture_Latency_WithRebuilds)
+(benchmark::State &state) {
+  auto &probe = session->probe;
+  probe.reset();
+  std::atomic<bool> stop{false};
+  std::thread rebuilder([&] {
+    while (!stop.load(std::memory_order_relaxed))
+      session->proc.forceRebuildMappings();
+  });
+
+  for (auto _ : state)
+    session->replayTimed(capture);
+
+  stop.store(true, std::memory_order_relaxed);
+  rebuilder.join();
+
+  const double events =
+      (double)capture.events.size() * (double)state.iterations();
+  state.counters["events_per_sec"] =
+      benchmark::Counter(events, benchmark::Counter::kIsRate);
+  state.counters["p50_us"] = probe.percentileUs(50.0);
+  state.counters["p99_us"] = probe.percentileUs(99.0);
+  state.counters["p99.9_us"] = probe.percentileUs(99.9);
+}
+BENCHMARK_REGISTER_F(ReplayBenchmarkFixture,
+                     Replay_Capture_Latency_WithRebuilds)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
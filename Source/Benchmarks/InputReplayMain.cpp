@@ -0,0 +1,65 @@
+// MIDIQy_Replay: headless replayer for input captures.
+//
+//   MIDIQy_Replay <capture.mqir> [preset.xml] [--paced]
+//
+// Drives a headless InputProcessor (no RawInputManager, no window, no MIDI
+// device) with a recorded input stream and prints input-to-MIDI latency
+// percentiles and throughput. --paced replays at the recorded timing so
+// time-based behaviour (strum, glide, envelopes) plays out as captured.
+
+#include "ReplayHarness.h"
+#include <cstdio>
+
+int main(int argc, char *argv[]) {
+  juce::File captureFile, presetFile;
+  bool paced = false;
+  for (int i = 1; i < argc; ++i) {
+    const juce::String arg(argv[i]);
+    if (arg == "--paced")
+      paced = true;
+    else if (captureFile == juce::File())
+      captureFile = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+    else
+      presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+  }
+  if (captureFile == juce::File()) {
+    std::fprintf(stderr,
+                 "usage: MIDIQy_Replay <capture.mqir> [preset.xml] [--paced]\n");
+    return 2;
+  }
+
+  InputRecording capture;
+  if (!capture.loadFromFile(captureFile)) {
+    std::fprintf(stderr, "Could not read capture: %s\n",
+                 captureFile.getFullPathName().toRawUTF8());
+    return 1;
+  }
+
+  ReplaySession session;
+  if (presetFile != juce::File())
+    session.loadPreset(presetFile);
+
+  const double t0 = juce::Time::getMillisecondCounterHiRes();
+  if (paced) {
+    // Paced replays measure end-to-end behaviour, not per-event latency.
+    InputReplayer::replay(capture, session.proc, true);
+  } else {
+    session.replayTimed(capture);
+  }
+  const double elapsedMs = juce::Time::getMillisecondCounterHiRes() - t0;
+
+  auto &probe = session.probe;
+  std::printf("events:          %zu (%.1f ms captured)\n",
+              capture.events.size(), capture.durationMs());
+  std::printf("midi messages:   %zu\n", probe.messagesSent);
+  std::printf("elapsed:         %.3f ms\n", elapsedMs);
+  if (elapsedMs > 0.0)
+    std::printf("events/sec:      %.0f\n",
+                (double)capture.events.size() * 1000.0 / elapsedMs);
+  if (!paced) {
+    std::printf("latency p50:     %.2f us\n", probe.percentileUs(50.0));
+    std::printf("latency p99:     %.2f us\n", probe.percentileUs(99.0));
+    std::printf("latency p99.9:   %.2f us\n", probe.percentileUs(99.9));
+  }
+  return 0;
+}
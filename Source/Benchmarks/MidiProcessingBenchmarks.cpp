@@ -1,9 +1,14 @@
 // MIDI Processing Performance Benchmarks
 // Uses Google Benchmark to measure latency and throughput of various MIDI paths
 
+#include "../HidTouchpadDecoder.h"
 #include "../MappingCompiler.h"
+#include "../TaskPool.h"
 #include "../TouchpadTypes.h"
+#include "AllocationCounter.h"
 #include "BenchmarkFixtures.h"
+#include <atomic>
+#include <thread>
 
 // =============================================================================
 // Category 1: Manual Mapping Tests
@@ -142,6 +147,40 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Expression_ADSRTimerTick)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Expression_ADSRTimerTick)
     ->Unit(benchmark::kMicrosecond);
 
+// One ADSR tick with a full keyboard of moving per-key CC envelopes
+// (16 channels x 16 CCs). Envelopes are retriggered whenever all of them
+// have settled, so every measured tick advances 256 envelopes.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Expression_ADSRTimerTick_256)
+(benchmark::State &state) {
+  constexpr int kEnvelopes = 256;
+  ExpressionEngine engine(mockMidi);
+  AdsrSettings adsr;
+  adsr.attackMs = 400;
+  adsr.decayMs = 600;
+  adsr.sustainLevel = 0.5f;
+  adsr.releaseMs = 800;
+  adsr.useCustomEnvelope = true;
+  auto triggerAll = [&] {
+    for (int i = 0; i < kEnvelopes; ++i) {
+      adsr.ccNumber = 20 + i % 16;
+      engine.triggerEnvelope(InputID{0, i}, 1 + i / 16, adsr, 127);
+    }
+  };
+  triggerAll();
+
+  for (auto _ : state) {
+    if (!engine.processOneTick()) {
+      state.PauseTiming();
+      mockMidi.clear();
+      triggerAll();
+      state.ResumeTiming();
+    }
+  }
+  state.counters["envelopes"] = kEnvelopes;
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Expression_ADSRTimerTick_256)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Category 3: Layer/Command Tests
 // =============================================================================
@@ -499,6 +538,38 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Zone_Chord_WithBass)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Zone_Chord_WithBass)
     ->Unit(benchmark::kMicrosecond);
 
+// Triad zone note-on with chromatic + degree transpose active: counts heap
+// allocations on the input thread per key press (expected 0 once warm).
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Zone_Triad_NoteOn_Allocations)
+(benchmark::State &state) {
+  auto zone = createPianoZone("AllocTriad", 0, {81, 87, 69},
+                              ChordUtilities::ChordType::Triad,
+                              Zone::PianoVoicingStyle::Close, true, 0);
+  proc.getZoneManager().addZone(zone);
+  proc.getZoneManager().setGlobalTranspose(2, 1);
+  proc.forceRebuildMappings();
+
+  InputID input{0, 81};
+  proc.processEvent(input, true); // Warm up (mock event capacity etc.)
+  proc.processEvent(input, false);
+  mockMidi.clear();
+
+  size_t noteOnAllocations = 0;
+  for (auto _ : state) {
+    const size_t before = AllocationCounter::threadAllocations();
+    proc.processEvent(input, true);
+    noteOnAllocations += AllocationCounter::threadAllocations() - before;
+    proc.processEvent(input, false);
+    mockMidi.clear();
+  }
+  state.counters["allocs_per_noteon"] = benchmark::Counter(
+      (double)noteOnAllocations, benchmark::Counter::kAvgIterations);
+  proc.getZoneManager().setGlobalTranspose(0, 0);
+  proc.getZoneManager().removeZone(zone);
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Zone_Triad_NoteOn_Allocations)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Category 6: Zone Release Mode Tests
 // =============================================================================
@@ -648,6 +719,42 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Stress_PolyChords_10Keys)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Stress_PolyChords_10Keys)
     ->Unit(benchmark::kMicrosecond);
 
+// N chord keys (3 notes each) held under the sustain pedal, then pedal up:
+// 40 keys keep 120 voices alive while the rest of the keys are handled.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Stress_PolyChords_Sustained)
+(benchmark::State &state) {
+  const int numKeys = static_cast<int>(state.range(0));
+  std::vector<int> keyCodes;
+  for (int i = 0; i < numKeys; ++i) {
+    keyCodes.push_back(40 + i);
+  }
+  auto zone = createPianoZone("StressSustain", 0, keyCodes,
+                              ChordUtilities::ChordType::Triad,
+                              Zone::PianoVoicingStyle::Close, false, 0);
+  zone->rootNote = 24; // Keep 40 keys of triads inside the MIDI range
+  proc.getZoneManager().addZone(zone);
+  proc.forceRebuildMappings();
+  mockMidi.clear();
+
+  for (auto _ : state) {
+    voiceMgr.setSustain(true);
+    for (int i = 0; i < numKeys; ++i) {
+      proc.processEvent(InputID{0, 40 + i}, true);
+    }
+    for (int i = 0; i < numKeys; ++i) {
+      proc.processEvent(InputID{0, 40 + i}, false);
+    }
+    voiceMgr.setSustain(false); // Releases every sustained voice
+    mockMidi.clear();
+  }
+  state.counters["heldNotes"] = numKeys * 3;
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Stress_PolyChords_Sustained)
+    ->Arg(10)
+    ->Arg(20)
+    ->Arg(40)
+    ->Unit(benchmark::kMicrosecond);
+
 // Rapid layer toggling while playing notes
 BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Stress_RapidLayerSwitch)
 (benchmark::State &state) {
@@ -758,6 +865,68 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, HotPath_MappingCompiler_FullRebuild)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, HotPath_MappingCompiler_FullRebuild)
     ->Unit(benchmark::kMicrosecond);
 
+// Compile scaling vs thread count (Arg = threads incl. the caller): large
+// preset with 8 aliases, 360 alias mappings + 45 global ones, 8 zones.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, HotPath_MappingCompiler_Scaling)
+(benchmark::State &state) {
+  for (int layer = 0; layer < 9; ++layer)
+    for (int k = 0; k < 5; ++k)
+      addNoteMapping(layer, 0x41 + layer * 2 + k, 48 + k, 100, 1);
+
+  std::vector<std::shared_ptr<Zone>> zonesToRemove;
+  for (int a = 0; a < 8; ++a) {
+    const juce::String alias = "ScaleAlias" + juce::String(a);
+    deviceMgr.createAlias(alias);
+    const uintptr_t hash = DeviceManager::getAliasHash(alias);
+    for (int layer = 0; layer < 9; ++layer) {
+      auto mappings = presetMgr.getMappingsListForLayer(layer);
+      for (int k = 0; k < 5; ++k) {
+        juce::ValueTree m("Mapping");
+        m.setProperty("inputKey", 0x30 + (a + layer + k) % 10, nullptr);
+        m.setProperty("inputAlias", alias, nullptr);
+        m.setProperty("deviceHash",
+                      juce::String::toHexString((juce::int64)hash)
+                          .toUpperCase(),
+                      nullptr);
+        m.setProperty("type", k == 4 ? "Expression" : "Note", nullptr);
+        m.setProperty("data1", 60 + a + k, nullptr);
+        m.setProperty("data2", 100, nullptr);
+        m.setProperty("channel", 1 + a, nullptr);
+        m.setProperty("layerID", layer, nullptr);
+        mappings.addChild(m, -1, nullptr);
+      }
+    }
+    auto z = createZone("ScaleZone" + juce::String(a), a % 9,
+                        {0x5A - a, 0x5B - a},
+                        ChordUtilities::ChordType::Triad, PolyphonyMode::Poly);
+    z->targetAliasHash = hash;
+    proc.getZoneManager().addZone(z);
+    zonesToRemove.push_back(z);
+  }
+  proc.forceRebuildMappings();
+  mockMidi.clear();
+
+  TaskPool pool((int)state.range(0) - 1);
+  for (auto _ : state) {
+    (void)MappingCompiler::compile(presetMgr, deviceMgr, proc.getZoneManager(),
+                                   touchpadLayoutMgr, settingsMgr, nullptr,
+                                   MappingCompiler::Scope::all(), &pool);
+  }
+  state.counters["threads"] = (double)state.range(0);
+  for (auto &z : zonesToRemove) {
+    proc.getZoneManager().removeZone(z);
+  }
+  for (int a = 0; a < 8; ++a)
+    deviceMgr.deleteAlias("ScaleAlias" + juce::String(a));
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, HotPath_MappingCompiler_Scaling)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 // ZoneManager: add 5 zones (each triggers rebuildLookupTable)
 BENCHMARK_DEFINE_F(MidiBenchmarkFixture, HotPath_ZoneManager_AddFiveZones)
 (benchmark::State &state) {
@@ -849,6 +1018,102 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_Touchpad_FingerDownUp)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Feature_Touchpad_FingerDownUp)
     ->Unit(benchmark::kMicrosecond);
 
+// Touchpad: one moving 5-finger frame through an 8-mapping preset (notes,
+// CC/pitch ranges, slide and encoder) - per-frame touchpad state cost.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture,
+                   Feature_Touchpad_FiveFingers_EightMappings)
+(benchmark::State &state) {
+  auto addMapping = [this](int event, const juce::String &type,
+                           const juce::String &target,
+                           const juce::String &ccMode, int data1) {
+    TouchpadMappingConfig cfg;
+    cfg.name = "Bench " + juce::String(data1);
+    cfg.layerId = 0;
+    cfg.midiChannel = 1;
+    juce::ValueTree m("Mapping");
+    m.setProperty("inputAlias", "Touchpad", nullptr);
+    m.setProperty("inputTouchpadEvent", event, nullptr);
+    m.setProperty("type", type, nullptr);
+    m.setProperty("channel", 1, nullptr);
+    m.setProperty("data1", data1, nullptr);
+    m.setProperty("data2", type == "Note" ? 127 : 2, nullptr);
+    if (target.isNotEmpty())
+      m.setProperty("adsrTarget", target, nullptr);
+    if (ccMode.isNotEmpty())
+      m.setProperty("expressionCCMode", ccMode, nullptr);
+    m.setProperty("touchpadInputMin", 0.0, nullptr);
+    m.setProperty("touchpadInputMax", 1.0, nullptr);
+    m.setProperty("touchpadOutputMin", target == "PitchBend" ? -2 : 0,
+                  nullptr);
+    m.setProperty("touchpadOutputMax", target == "PitchBend" ? 2 : 127,
+                  nullptr);
+    cfg.mapping = m;
+    touchpadLayoutMgr.addTouchpadMapping(cfg);
+  };
+  addMapping(TouchpadEvent::Finger1Down, "Note", "", "", 60);
+  addMapping(TouchpadEvent::Finger2Down, "Note", "", "", 64);
+  addMapping(TouchpadEvent::Finger1X, "Expression", "PitchBend", "", 0);
+  addMapping(TouchpadEvent::Finger1Y, "Expression", "CC", "", 1);
+  addMapping(TouchpadEvent::Finger2Y, "Expression", "CC", "", 2);
+  addMapping(TouchpadEvent::Finger1And2Dist, "Expression", "CC", "", 3);
+  addMapping(TouchpadEvent::Finger1Y, "Expression", "CC", "Slide", 20);
+  addMapping(TouchpadEvent::Finger1Y, "Expression", "CC", "Encoder", 22);
+  proc.forceRebuildMappings();
+  mockMidi.clear();
+
+  uintptr_t deviceHandle = 0x9001;
+  std::vector<TouchpadContact> contacts;
+  for (int i = 0; i < 5; ++i)
+    contacts.push_back({i, 0, 0, 0.1f + 0.2f * (float)i, 0.5f, true});
+
+  int frame = 0;
+  for (auto _ : state) {
+    const float dy = 0.01f * (float)(frame++ % 40);
+    for (auto &c : contacts)
+      c.normY = 0.3f + dy;
+    proc.processTouchpadContacts(deviceHandle, contacts);
+    mockMidi.clear();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture,
+                     Feature_Touchpad_FiveFingers_EightMappings)
+    ->Unit(benchmark::kMicrosecond);
+
+// Touchpad: 5 resting contacts over 36 stacked drum-pad layouts (6x2 tiles on
+// each of layers 0-2; only layer 0 active) - contact -> layout hit-testing.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_Touchpad_ManyLayouts_HitTest)
+(benchmark::State &state) {
+  for (int layer = 0; layer < 3; ++layer) {
+    for (int tile = 0; tile < 12; ++tile) {
+      TouchpadLayoutConfig cfg;
+      cfg.type = TouchpadType::DrumPad;
+      cfg.layerId = layer;
+      const float left = (float)(tile % 6) / 6.0f;
+      const float top = (float)(tile / 6) / 2.0f;
+      cfg.region = {left, top, left + 1.0f / 6.0f, top + 0.5f};
+      cfg.zIndex = layer;
+      touchpadLayoutMgr.addLayout(cfg);
+    }
+  }
+  proc.forceRebuildMappings();
+
+  uintptr_t deviceHandle = 0x9002;
+  std::vector<TouchpadContact> contacts;
+  for (int i = 0; i < 5; ++i)
+    contacts.push_back({i, 0, 0, 0.1f + 0.2f * (float)i, 0.7f, true});
+  proc.processTouchpadContacts(deviceHandle, contacts);
+  mockMidi.clear();
+
+  for (auto _ : state) {
+    proc.processTouchpadContacts(deviceHandle, contacts);
+    mockMidi.clear();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Feature_Touchpad_ManyLayouts_HitTest)
+    ->Unit(benchmark::kMicrosecond);
+
 // Axis/pitch-pad path: handleAxisEvent (scroll or pointer)
 BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_HandleAxisEvent)
 (benchmark::State &state) {
@@ -868,6 +1133,76 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_HandleAxisEvent)
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Feature_HandleAxisEvent)
     ->Unit(benchmark::kMicrosecond);
 
+// Axis -> CC throughput on a mapped slot: the grid lookup hands back a view
+// into the compiled action, so a value stream allocates nothing per event.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_HandleAxisEvent_MappedCC)
+(benchmark::State &state) {
+  const int axisCode = 0x50;
+  addExpressionCCMapping(0, axisCode, 7, 1, false);
+  proc.forceRebuildMappings();
+  mockMidi.clear();
+
+  size_t allocations = 0;
+  int step = 0;
+  for (auto _ : state) {
+    const size_t before = AllocationCounter::threadAllocations();
+    for (int i = 0; i < 64; ++i)
+      proc.handleAxisEvent(0, axisCode, (float)((step + i) & 127) / 127.0f);
+    allocations += AllocationCounter::threadAllocations() - before;
+    step += 64;
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+  state.counters["allocs_per_event"] = benchmark::Counter(
+      (double)allocations / 64.0, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Feature_HandleAxisEvent_MappedCC)
+    ->Unit(benchmark::kMicrosecond);
+
+// Precision Touchpad report decode (WM_INPUT path): a five-finger descriptor
+// compiled once, then 64 reports bit-sliced per iteration.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Feature_Touchpad_DecodeHidReport)
+(benchmark::State &state) {
+  std::vector<uint8_t> descriptor = {0x05, 0x0D, 0x09, 0x05, 0xA1, 0x01,
+                                     0x85, 0x01}; // Touch Pad, Report ID 1
+  for (int finger = 0; finger < 5; ++finger)
+    descriptor.insert(descriptor.end(),
+                      {0x05, 0x0D, 0x09, 0x22, 0xA1, 0x02, // Finger
+                       0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x01,
+                       0x09, 0x42, 0x81, 0x02, // Tip Switch, 1 bit
+                       0x25, 0x7F, 0x75, 0x07, 0x09, 0x51,
+                       0x81, 0x02, // Contact ID, 7 bits
+                       0x05, 0x01, 0x26, 0xFF, 0x0F, 0x75, 0x10,
+                       0x09, 0x30, 0x81, 0x02, // X, 16 bits
+                       0x09, 0x31, 0x81, 0x02, // Y, 16 bits
+                       0xC0});
+  descriptor.insert(descriptor.end(), {0x05, 0x0D, 0x25, 0x7F, 0x75, 0x08,
+                                       0x09, 0x54, 0x81, 0x02, // Count
+                                       0xC0});
+  const HidTouchpadPlan plan =
+      compileTouchpadPlan(descriptor.data(), descriptor.size());
+
+  std::vector<std::vector<uint8_t>> reports(64);
+  for (size_t r = 0; r < reports.size(); ++r) {
+    reports[r].resize(plan.reportBytes);
+    for (size_t i = 1; i < reports[r].size(); ++i)
+      reports[r][i] = (uint8_t)(r * 31 + i * 7);
+    reports[r][0] = 0x01;
+    reports[r].back() = 5;
+  }
+
+  TouchpadContactFrame frame;
+  for (auto _ : state) {
+    for (const auto &report : reports) {
+      decodeTouchpadReport(plan, report.data(), report.size(), frame);
+      benchmark::DoNotOptimize(frame);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (int64_t)reports.size());
+  state.counters["contacts"] = (double)frame.count;
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Feature_Touchpad_DecodeHidReport)
+    ->Unit(benchmark::kMicrosecond);
+
 // =============================================================================
 // Category 10: Stress - Many zones, layer search
 // =============================================================================
@@ -922,3 +1257,39 @@ BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Stress_LayerSearch_AllNineActive)
 }
 BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Stress_LayerSearch_AllNineActive)
     ->Unit(benchmark::kMicrosecond);
+
+// =============================================================================
+// Category 11: Concurrency - Rebuild while playing
+// =============================================================================
+
+// Key presses on the input thread while another thread continuously rebuilds
+// the grid. The input path only loads the published context/layer snapshots,
+// so this should stay close to ManualNote_RapidFire.
+BENCHMARK_DEFINE_F(MidiBenchmarkFixture, Contention_RebuildWhilePlaying)
+(benchmark::State &state) {
+  for (int i = 0; i < 10; ++i) {
+    addNoteMapping(0, 81 + i, 60 + i, 100, 1);
+  }
+  proc.forceRebuildMappings();
+  mockMidi.clear();
+
+  std::atomic<bool> stop{false};
+  std::thread rebuilder([&] {
+    while (!stop.load(std::memory_order_relaxed))
+      proc.forceRebuildMappings();
+  });
+
+  for (auto _ : state) {
+    for (int i = 0; i < 10; ++i) {
+      InputID input{0, 81 + i};
+      proc.processEvent(input, true);
+      proc.processEvent(input, false);
+    }
+    mockMidi.clear();
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  rebuilder.join();
+}
+BENCHMARK_REGISTER_F(MidiBenchmarkFixture, Contention_RebuildWhilePlaying)
+    ->Unit(benchmark::kMicrosecond);
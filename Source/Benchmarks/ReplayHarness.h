@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../DeviceManager.h"
+#include "../InputProcessor.h"
+#include "../InputRecording.h"
+#include "../MidiEngine.h"
+#include "../PresetManager.h"
+#include "../ScaleLibrary.h"
+#include "../SettingsManager.h"
+#include "../TouchpadLayoutManager.h"
+#include "../VoiceManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// LatencyProbeMidiEngine: Timestamps MIDI output relative to the input event
+// being replayed, without opening a device. Input-to-MIDI latency is the time
+// from handing an event to InputProcessor to its first MIDI send (scheduled
+// sends count when they are queued).
+class LatencyProbeMidiEngine : public MidiEngine {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<int64_t> latenciesNs; // One per input that produced MIDI
+  size_t messagesSent = 0;
+
+  void beginInput() {
+    inputStart = Clock::now();
+    sawOutput = false;
+  }
+  void endInput() {
+    if (sawOutput)
+      latenciesNs.push_back(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(firstOutput -
+                                                               inputStart)
+              .count());
+  }
+  void reset() {
+    latenciesNs.clear();
+    messagesSent = 0;
+  }
+
+  // Latency at percentile p (0-100) in microseconds; 0 if nothing was sent.
+  // Sorts latenciesNs.
+  double percentileUs(double p) {
+    if (latenciesNs.empty())
+      return 0.0;
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    const double rank = p / 100.0 * (double)(latenciesNs.size() - 1);
+    return (double)latenciesNs[(size_t)(rank + 0.5)] / 1000.0;
+  }
+
+  void sendNoteOn(int, int, float) override { mark(); }
+  void sendNoteOff(int, int) override { mark(); }
+  void sendCC(int, int, int) override { mark(); }
+  void sendPitchBend(int, int) override { mark(); }
+  void sendProgramChange(int, int) override { mark(); }
+  void sendNoteOnAt(int, int, float, double) override { mark(); }
+  void sendNoteOffAt(int, int, double) override { mark(); }
+
+private:
+  void mark() {
+    ++messagesSent;
+    if (!sawOutput) {
+      firstOutput = Clock::now();
+      sawOutput = true;
+    }
+  }
+
+  Clock::time_point inputStart, firstOutput;
+  bool sawOutput = false;
+};
+
+// ReplaySession: A headless InputProcessor (no RawInputManager, no window)
+// wired to a LatencyProbeMidiEngine, for replaying InputRecordings.
+struct ReplaySession {
+  PresetManager presetMgr;
+  DeviceManager deviceMgr;
+  ScaleLibrary scaleLib;
+  SettingsManager settingsMgr;
+  LatencyProbeMidiEngine probe;
+  TouchpadLayoutManager touchpadLayoutMgr;
+  VoiceManager voiceMgr{probe, settingsMgr};
+  InputProcessor proc{voiceMgr, presetMgr,   deviceMgr,       scaleLib,
+                      probe,    settingsMgr, touchpadLayoutMgr};
+
+  ReplaySession() {
+    presetMgr.getLayersList().removeAllChildren(nullptr);
+    presetMgr.ensureStaticLayers();
+    settingsMgr.setMidiModeActive(true);
+    proc.initialize();
+  }
+
+  // Loads a saved preset (mappings, zones, touchpad layouts) as the UI does.
+  void loadPreset(const juce::File &file) {
+    presetMgr.loadFromFile(file);
+    touchpadLayoutMgr.restoreFromValueTree(presetMgr.getTouchpadDataNode());
+    auto zoneTree = presetMgr.getZoneManagerNode();
+    if (zoneTree.isValid())
+      proc.getZoneManager().restoreFromValueTree(zoneTree);
+    proc.forceRebuildMappings();
+  }
+
+  // Replays every event as fast as possible, timing each one.
+  void replayTimed(const InputRecording &recording) {
+    std::vector<TouchpadContact> frame;
+    for (size_t i = 0; i < recording.events.size(); ++i) {
+      probe.beginInput();
+      InputReplayer::dispatch(recording, i, proc, frame);
+      probe.endInput();
+    }
+  }
+};
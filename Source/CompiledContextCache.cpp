@@ -0,0 +1,459 @@
+#include "CompiledContextCache.h"
+#include "DeviceManager.h"
+#include "PresetManager.h"
+#include "ScaleLibrary.h"
+#include "SettingsManager.h"
+#include "TouchpadLayoutManager.h"
+#include "ZoneManager.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+constexpr int kMagic = 0x4343514D; // "MQCC"
+constexpr int kHeaderBytes = 4 + 4 + 8 + 8;
+constexpr int kSlotsPerGrid = InputTypes::kGridSlots;
+constexpr int kLayers = 9;
+
+// 64-bit FNV-1a over the serialized inputs.
+juce::uint64 fnv1a(const void *data, size_t size) {
+  juce::uint64 h = 14695981039346656037ull;
+  const auto *bytes = static_cast<const juce::uint8 *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    h ^= bytes[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// Bounds-checked reads from the mapped file. Any short read or implausible
+// count clears ok; values read afterwards are zero.
+class CacheReader {
+public:
+  CacheReader(const void *data, size_t size) : in(data, size, false) {}
+
+  bool ok = true;
+
+  bool atEnd() const { return in.getNumBytesRemaining() == 0; }
+  int readByte() { return need(1) ? (int)(juce::uint8)in.readByte() : 0; }
+  bool readBool() { return readByte() != 0; }
+  int readShort() { return need(2) ? in.readShort() : 0; }
+  int readInt() { return need(4) ? in.readInt() : 0; }
+  juce::int64 readInt64() { return need(8) ? in.readInt64() : 0; }
+  float readFloat() { return need(4) ? in.readFloat() : 0.0f; }
+  juce::String readString() { return need(1) ? in.readString() : juce::String(); }
+
+  // An element count no larger than the remaining bytes could hold.
+  int readCount(int minBytesPerItem) {
+    const int n = readInt();
+    if (n < 0 || (juce::int64)n * minBytesPerItem > in.getNumBytesRemaining())
+      ok = false;
+    return ok ? n : 0;
+  }
+
+  // An enum stored as an int; anything past its last enumerator clears ok.
+  template <typename E> E readEnum(E last) {
+    const int value = readInt();
+    if (value < 0 || value > (int)last)
+      ok = false;
+    return ok ? (E)value : E{};
+  }
+
+  // An index in [-1, size).
+  int readIndex(size_t size) {
+    const int index = readInt();
+    if (index < -1 || (index >= 0 && (size_t)index >= size))
+      ok = false;
+    return ok ? index : -1;
+  }
+
+private:
+  bool need(int bytes) {
+    if (in.getNumBytesRemaining() < bytes)
+      ok = false;
+    return ok;
+  }
+
+  juce::MemoryInputStream in;
+};
+
+void writeAction(juce::OutputStream &out, const MidiAction &a) {
+  out.writeByte((char)a.type);
+  out.writeInt(a.channel);
+  out.writeInt(a.data1);
+  out.writeInt(a.data2);
+  out.writeInt(a.velocityRandom);
+  const AdsrSettings &s = a.adsrSettings;
+  out.writeInt(s.attackMs);
+  out.writeInt(s.decayMs);
+  out.writeFloat(s.sustainLevel);
+  out.writeInt(s.releaseMs);
+  out.writeInt((int)s.target);
+  out.writeInt(s.ccNumber);
+  out.writeBool(s.useCustomEnvelope);
+  out.writeInt(s.valueWhenOn);
+  out.writeInt(s.valueWhenOff);
+  out.writeInt((int)a.smartBendLookup.size());
+  for (int value : a.smartBendLookup)
+    out.writeInt(value);
+  out.writeInt((int)a.releaseBehavior);
+  out.writeInt((int)a.touchpadHoldBehavior);
+  out.writeBool(a.sendReleaseValue);
+  out.writeInt(a.releaseValue);
+  out.writeBool(a.releaseLatchedOnLatchToggleOff);
+  out.writeBool(a.transposeLocal);
+  out.writeInt(a.transposeModify);
+  out.writeInt(a.transposeSemitones);
+  out.writeInt(a.rootModify);
+  out.writeInt(a.rootNote);
+  out.writeInt(a.scaleModify);
+  out.writeInt(a.scaleIndex);
+  out.writeInt(a.touchpadLayoutGroupId);
+  out.writeInt(a.touchpadSoloScope);
+  out.writeInt(a.keyboardLayoutGroupId);
+  out.writeInt(a.keyboardSoloScope);
+}
+
+MidiAction readAction(CacheReader &in) {
+  MidiAction a{};
+  const int type = in.readByte();
+  if (type > (int)ActionType::Macro)
+    in.ok = false;
+  a.type = (ActionType)type;
+  a.channel = in.readInt();
+  a.data1 = in.readInt();
+  a.data2 = in.readInt();
+  a.velocityRandom = in.readInt();
+  AdsrSettings &s = a.adsrSettings;
+  s.attackMs = in.readInt();
+  s.decayMs = in.readInt();
+  s.sustainLevel = in.readFloat();
+  s.releaseMs = in.readInt();
+  s.target = in.readEnum(AdsrTarget::SmartScaleBend);
+  s.ccNumber = in.readInt();
+  s.useCustomEnvelope = in.readBool();
+  s.valueWhenOn = in.readInt();
+  s.valueWhenOff = in.readInt();
+  a.smartBendLookup.resize((size_t)in.readCount(4));
+  for (int &value : a.smartBendLookup)
+    value = in.readInt();
+  a.releaseBehavior = in.readEnum(NoteReleaseBehavior::AlwaysLatch);
+  a.touchpadHoldBehavior =
+      in.readEnum(TouchpadHoldBehavior::IgnoreSendNoteOffImmediately);
+  a.sendReleaseValue = in.readBool();
+  a.releaseValue = in.readInt();
+  a.releaseLatchedOnLatchToggleOff = in.readBool();
+  a.transposeLocal = in.readBool();
+  a.transposeModify = in.readInt();
+  a.transposeSemitones = in.readInt();
+  a.rootModify = in.readInt();
+  a.rootNote = in.readInt();
+  a.scaleModify = in.readInt();
+  a.scaleIndex = in.readInt();
+  a.touchpadLayoutGroupId = in.readInt();
+  a.touchpadSoloScope = in.readInt();
+  a.keyboardLayoutGroupId = in.readInt();
+  a.keyboardSoloScope = in.readInt();
+  return a;
+}
+
+// Grids are shared between layers, aliases and hardware IDs, so each
+// distinct grid is written once and referenced by index (-1 = none).
+template <typename Grid> class GridTable {
+public:
+  int add(const std::shared_ptr<const Grid> &grid) {
+    if (!grid)
+      return -1;
+    auto [it, inserted] = ids.emplace(grid.get(), (int)grids.size());
+    if (inserted)
+      grids.push_back(grid.get());
+    return it->second;
+  }
+  const std::vector<const Grid *> &all() const { return grids; }
+
+private:
+  std::unordered_map<const Grid *, int> ids;
+  std::vector<const Grid *> grids;
+};
+
+void writeAudioGrid(juce::OutputStream &out, const AudioGrid &grid) {
+  for (const auto &slot : grid) {
+    out.writeByte((char)slot.type);
+    out.writeByte((char)slot.channel);
+    out.writeBool(slot.isActive);
+    out.writeShort(slot.data1);
+    out.writeShort(slot.data2);
+    out.writeInt(slot.actionIndex);
+    out.writeInt(slot.chordIndex);
+    out.writeInt(slot.keyboardGroupId);
+    out.writeInt(slot.zoneIndex);
+  }
+}
+
+void readAudioGrid(CacheReader &in, AudioGrid &grid,
+                   const CompiledMapContext &context) {
+  for (auto &slot : grid) {
+    const int type = in.readByte();
+    if (type > (int)ActionType::Macro)
+      in.ok = false;
+    slot.type = (ActionType)type;
+    slot.channel = (uint8_t)in.readByte();
+    slot.isActive = in.readBool();
+    slot.data1 = (int16_t)in.readShort();
+    slot.data2 = (int16_t)in.readShort();
+    slot.actionIndex = in.readIndex(context.actionPool.size());
+    slot.chordIndex = in.readIndex(context.chordPool.size());
+    slot.keyboardGroupId = in.readInt();
+    slot.zoneIndex = in.readIndex(context.zoneTable.size());
+    if (slot.isActive && slot.actionIndex < 0)
+      in.ok = false;
+  }
+}
+
+void writeVisualGrid(juce::OutputStream &out, const VisualGrid &grid) {
+  for (const auto &slot : grid) {
+    out.writeByte((char)slot.state);
+    out.writeInt((int)slot.displayColor.getARGB());
+    out.writeInt((int)slot.labelId);
+    out.writeInt((int)slot.sourceNameId);
+    out.writeBool(slot.isGhost);
+    out.writeInt(slot.keyboardGroupId);
+  }
+}
+
+void readVisualGrid(CacheReader &in, VisualGrid &grid,
+                    const VisualStringPool &strings) {
+  auto readStringId = [&]() {
+    const int id = in.readIndex(strings.size());
+    if (id < 0)
+      in.ok = false;
+    return (VisualStringPool::Id)std::max(0, id);
+  };
+  for (auto &slot : grid) {
+    const int state = in.readByte();
+    if (state > (int)VisualState::Conflict)
+      in.ok = false;
+    slot.state = (VisualState)state;
+    slot.displayColor = juce::Colour((juce::uint32)in.readInt());
+    slot.labelId = readStringId();
+    slot.sourceNameId = readStringId();
+    slot.isGhost = in.readBool();
+    slot.keyboardGroupId = in.readInt();
+  }
+}
+
+void writeGridRefs(juce::OutputStream &out, const std::vector<int> &refs) {
+  out.writeInt((int)refs.size());
+  for (int ref : refs)
+    out.writeInt(ref);
+}
+
+} // namespace
+
+juce::uint64 CompiledContextCache::computeKey(
+    PresetManager &presetMgr, const DeviceManager &deviceMgr,
+    const ZoneManager &zoneMgr, const TouchpadLayoutManager &touchpadMgr,
+    const SettingsManager &settingsMgr, const ScaleLibrary &scaleLib) {
+  juce::MemoryOutputStream out;
+  out.writeInt(formatVersion);
+  // A new build may compile the same session differently.
+  out.writeString(ProjectInfo::versionString);
+  presetMgr.getRootNode().writeToStream(out);
+  zoneMgr.toValueTree().writeToStream(out);
+  touchpadMgr.toValueTree().writeToStream(out);
+  scaleLib.toValueTree().writeToStream(out);
+  for (const auto &alias : deviceMgr.getAllAliasNames()) {
+    out.writeString(alias);
+    for (auto hwId : deviceMgr.getHardwareForAlias(alias))
+      out.writeInt64((juce::int64)hwId);
+  }
+  out.writeInt(settingsMgr.getPitchBendRange());
+  for (auto type : {ActionType::Note, ActionType::Expression,
+                    ActionType::Command, ActionType::Macro})
+    out.writeInt((int)settingsMgr.getTypeColor(type).getARGB());
+  return fnv1a(out.getData(), out.getDataSize());
+}
+
+bool CompiledContextCache::write(const juce::File &file, juce::uint64 key,
+                                 const CompiledMapContext &context,
+                                 const ZoneManager &zoneMgr) {
+  juce::MemoryOutputStream body;
+
+  // Strings first: id i is the i-th interned string (0 = empty).
+  body.writeInt((int)context.visualStrings.size());
+  for (VisualStringPool::Id id = 1; id < context.visualStrings.size(); ++id)
+    body.writeString(context.visualStrings.get(id));
+
+  body.writeInt((int)context.actionPool.size());
+  for (const auto &action : context.actionPool)
+    writeAction(body, action);
+
+  body.writeInt((int)context.chordPool.size());
+  for (const auto &chord : context.chordPool) {
+    body.writeInt((int)chord.size());
+    for (const auto &action : chord)
+      writeAction(body, action);
+  }
+
+  // Zones are live objects owned by the ZoneManager: store list positions.
+  const auto zones = zoneMgr.getZones();
+  body.writeInt((int)context.zoneTable.size());
+  for (const auto &zone : context.zoneTable) {
+    auto it = std::find(zones.begin(), zones.end(), zone);
+    if (it == zones.end())
+      return false;
+    body.writeInt((int)(it - zones.begin()));
+  }
+
+  GridTable<AudioGrid> audioGrids;
+  std::vector<int> globalRefs;
+  for (const auto &grid : context.globalGrids)
+    globalRefs.push_back(audioGrids.add(grid));
+  std::vector<std::pair<uintptr_t, std::vector<int>>> deviceRefs;
+  for (const auto &[hash, layers] : context.deviceGrids) {
+    std::vector<int> refs;
+    for (const auto &grid : layers)
+      refs.push_back(audioGrids.add(grid));
+    deviceRefs.emplace_back(hash, std::move(refs));
+  }
+  body.writeInt((int)audioGrids.all().size());
+  for (const AudioGrid *grid : audioGrids.all())
+    writeAudioGrid(body, *grid);
+  writeGridRefs(body, globalRefs);
+  body.writeInt((int)deviceRefs.size());
+  for (const auto &[hash, refs] : deviceRefs) {
+    body.writeInt64((juce::int64)hash);
+    writeGridRefs(body, refs);
+  }
+
+  GridTable<VisualGrid> visualGrids;
+  std::vector<std::pair<uintptr_t, std::vector<int>>> visualRefs;
+  for (const auto &[hash, layers] : context.visualLookup) {
+    std::vector<int> refs;
+    for (const auto &grid : layers)
+      refs.push_back(visualGrids.add(grid));
+    visualRefs.emplace_back(hash, std::move(refs));
+  }
+  body.writeInt((int)visualGrids.all().size());
+  for (const VisualGrid *grid : visualGrids.all())
+    writeVisualGrid(body, *grid);
+  body.writeInt((int)visualRefs.size());
+  for (const auto &[hash, refs] : visualRefs) {
+    body.writeInt64((juce::int64)hash);
+    writeGridRefs(body, refs);
+  }
+
+  for (const auto &keys : context.globalKeysWrittenByLayer) {
+    body.writeInt((int)keys.size());
+    for (bool written : keys)
+      body.writeBool(written);
+  }
+
+  juce::MemoryOutputStream out;
+  out.writeInt(kMagic);
+  out.writeInt(formatVersion);
+  out.writeInt64((juce::int64)key);
+  out.writeInt64((juce::int64)body.getDataSize());
+  out.write(body.getData(), body.getDataSize());
+  return file.replaceWithData(out.getData(), out.getDataSize());
+}
+
+std::shared_ptr<CompiledMapContext>
+CompiledContextCache::read(const juce::File &file, juce::uint64 key,
+                           const ZoneManager &zoneMgr) {
+  if (!file.existsAsFile())
+    return nullptr;
+  juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+  if (mapped.getData() == nullptr || mapped.getSize() < (size_t)kHeaderBytes)
+    return nullptr;
+
+  CacheReader header(mapped.getData(), (size_t)kHeaderBytes);
+  if (header.readInt() != kMagic || header.readInt() != formatVersion ||
+      (juce::uint64)header.readInt64() != key ||
+      header.readInt64() != (juce::int64)(mapped.getSize() - kHeaderBytes))
+    return nullptr;
+
+  CacheReader in(static_cast<const char *>(mapped.getData()) + kHeaderBytes,
+                 mapped.getSize() - kHeaderBytes);
+  auto context = std::make_shared<CompiledMapContext>();
+
+  const int numStrings = in.readCount(1);
+  for (int id = 1; id < numStrings && in.ok; ++id) {
+    if (context->visualStrings.intern(in.readString()) != (juce::uint32)id)
+      in.ok = false; // Empty or duplicate: ids would shift
+  }
+
+  const int numActions = in.readCount(1);
+  context->actionPool.reserve((size_t)numActions);
+  for (int i = 0; i < numActions && in.ok; ++i)
+    context->actionPool.push_back(readAction(in));
+
+  const int numChords = in.readCount(4);
+  context->chordPool.resize((size_t)numChords);
+  for (auto &chord : context->chordPool) {
+    const int notes = in.readCount(1);
+    for (int i = 0; i < notes && in.ok; ++i)
+      chord.push_back(readAction(in));
+  }
+
+  const auto zones = zoneMgr.getZones();
+  const int numZones = in.readCount(4);
+  for (int i = 0; i < numZones && in.ok; ++i) {
+    const int index = in.readIndex(zones.size());
+    if (index >= 0)
+      context->zoneTable.push_back(zones[(size_t)index]);
+    else
+      in.ok = false;
+  }
+
+  std::vector<std::shared_ptr<const AudioGrid>> audioGrids(
+      (size_t)in.readCount(kSlotsPerGrid));
+  for (auto &grid : audioGrids) {
+    auto filled = std::make_shared<AudioGrid>();
+    readAudioGrid(in, *filled, *context);
+    grid = std::move(filled);
+  }
+  auto readAudioRefs = [&](auto &layers) {
+    if (in.readCount(4) != kLayers)
+      in.ok = false;
+    for (auto &grid : layers) {
+      const int ref = in.readIndex(audioGrids.size());
+      grid = ref >= 0 ? audioGrids[(size_t)ref] : nullptr;
+    }
+  };
+  readAudioRefs(context->globalGrids);
+  const int numDevices = in.readCount(8);
+  for (int i = 0; i < numDevices && in.ok; ++i) {
+    const auto hash = (uintptr_t)in.readInt64();
+    readAudioRefs(context->deviceGrids[hash]);
+  }
+
+  std::vector<std::shared_ptr<const VisualGrid>> visualGrids(
+      (size_t)in.readCount(kSlotsPerGrid));
+  for (auto &grid : visualGrids) {
+    auto filled = std::make_shared<VisualGrid>();
+    readVisualGrid(in, *filled, context->visualStrings);
+    grid = std::move(filled);
+  }
+  const int numVisualStacks = in.readCount(8);
+  for (int i = 0; i < numVisualStacks && in.ok; ++i) {
+    auto &layers = context->visualLookup[(uintptr_t)in.readInt64()];
+    layers.resize((size_t)in.readCount(4));
+    for (auto &grid : layers) {
+      const int ref = in.readIndex(visualGrids.size());
+      grid = ref >= 0 ? visualGrids[(size_t)ref] : nullptr;
+    }
+  }
+
+  for (auto &keys : context->globalKeysWrittenByLayer) {
+    keys.resize((size_t)in.readCount(1));
+    for (size_t k = 0; k < keys.size(); ++k)
+      keys[k] = in.readBool();
+  }
+
+  // The incremental compile paths expect a complete global stack.
+  if (!in.ok || !in.atEnd() || context->globalGrids[0] == nullptr ||
+      context->visualLookup.count(0) == 0)
+    return nullptr;
+  return context;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "MappingTypes.h"
+#include <JuceHeader.h>
+#include <memory>
+
+class DeviceManager;
+class PresetManager;
+class ScaleLibrary;
+class SettingsManager;
+class TouchpadLayoutManager;
+class ZoneManager;
+
+// Versioned on-disk cache of the keyboard part of a CompiledMapContext
+// (audio + visual grids and the action, chord, zone and string pools), so a
+// launch with an unchanged session skips the keyboard compile. The file is
+// keyed by a content hash of every input the compiler reads; any mismatch,
+// version change or corruption makes read() return null and the caller
+// compiles normally. Touchpad entries are not stored: the caller rebuilds
+// them with MappingCompiler::Scope::touchpadOnly(), which is cheap.
+class CompiledContextCache {
+public:
+  // Hash of the preset, zones, touchpad layouts, device aliases, scales and
+  // the settings the compiler reads, plus the file format version.
+  static juce::uint64 computeKey(PresetManager &presetMgr,
+                                 const DeviceManager &deviceMgr,
+                                 const ZoneManager &zoneMgr,
+                                 const TouchpadLayoutManager &touchpadMgr,
+                                 const SettingsManager &settingsMgr,
+                                 const ScaleLibrary &scaleLib);
+
+  // Write context's keyboard part under key. Zones are stored as indices into
+  // zoneMgr's list. Returns false if the file could not be written.
+  static bool write(const juce::File &file, juce::uint64 key,
+                    const CompiledMapContext &context,
+                    const ZoneManager &zoneMgr);
+
+  // Memory-map file and rebuild the keyboard part if it was written under
+  // key. Every count and index is bounds-checked; returns null on any
+  // mismatch.
+  static std::shared_ptr<CompiledMapContext>
+  read(const juce::File &file, juce::uint64 key, const ZoneManager &zoneMgr);
+
+  // Bump when the layout of anything written (MidiAction, KeyAudioSlot,
+  // KeyVisualSlot, pools) changes.
+  static constexpr int formatVersion = 2;
+};
@@ -3,9 +3,13 @@
 #include <algorithm>
 #include <set>
 #include <vector>
+
+#if JUCE_WINDOWS
 #include <windows.h>
+#endif
 
 namespace {
+#if JUCE_WINDOWS
 // Same criteria as RawInputManager: Precision Touchpad (HID Usage Page 0x0D, Usage 0x05).
 // Used so we include touchpad devices in the live list and can re-assign Touchpad alias on startup.
 bool isPrecisionTouchpadHandle(HANDLE deviceHandle) {
@@ -21,6 +25,45 @@ bool isPrecisionTouchpadHandle(HANDLE deviceHandle) {
          deviceInfo.hid.usUsagePage == 0x000D &&
          deviceInfo.hid.usUsage == 0x0005;
 }
+#endif
+
+// Handles of the live keyboards and Precision Touchpads (touchpads also in
+// touchpadHandles). Returns false if the device list is unavailable, as on
+// platforms without Raw Input.
+bool collectLiveDevices(std::set<uintptr_t> &liveHandles,
+                        std::vector<uintptr_t> &touchpadHandles) {
+#if JUCE_WINDOWS
+  UINT numDevices = 0;
+  if (GetRawInputDeviceList(nullptr, &numDevices, sizeof(RAWINPUTDEVICELIST)) !=
+      0) {
+    // Error getting device count
+    return false;
+  }
+
+  std::vector<RAWINPUTDEVICELIST> deviceList(numDevices);
+  if (GetRawInputDeviceList(deviceList.data(), &numDevices,
+                            sizeof(RAWINPUTDEVICELIST)) ==
+      static_cast<UINT>(-1)) {
+    // Error getting device list
+    return false;
+  }
+
+  for (const auto &device : deviceList) {
+    uintptr_t handle = reinterpret_cast<uintptr_t>(device.hDevice);
+    if (device.dwType == RIM_TYPEKEYBOARD) {
+      liveHandles.insert(handle);
+    } else if (device.dwType == RIM_TYPEHID &&
+               isPrecisionTouchpadHandle(device.hDevice)) {
+      liveHandles.insert(handle);
+      touchpadHandles.push_back(handle);
+    }
+  }
+  return true;
+#else
+  juce::ignoreUnused(liveHandles, touchpadHandles);
+  return false;
+#endif
+}
 } // namespace
 
 DeviceManager::DeviceManager() {
@@ -458,40 +501,11 @@ juce::StringArray DeviceManager::getEmptyAliases(
 }
 
 void DeviceManager::validateConnectedDevices() {
-  // Step 1: Get list of currently live devices using GetRawInputDeviceList
-  UINT numDevices = 0;
-  if (GetRawInputDeviceList(nullptr, &numDevices, sizeof(RAWINPUTDEVICELIST)) !=
-      0) {
-    // Error getting device count
-    return;
-  }
-
-  if (numDevices == 0) {
-    // No devices, but we can still clean up dead handles
-    numDevices = 0;
-  }
-
-  std::vector<RAWINPUTDEVICELIST> deviceList(numDevices);
-  if (GetRawInputDeviceList(deviceList.data(), &numDevices,
-                            sizeof(RAWINPUTDEVICELIST)) ==
-      static_cast<UINT>(-1)) {
-    // Error getting device list
-    return;
-  }
-
-  // Step 2: Extract valid hDevice handles into a set (keyboards + precision touchpads)
+  // Steps 1-2: Get the live device handles (keyboards + precision touchpads)
   std::set<uintptr_t> liveHandles;
   std::vector<uintptr_t> touchpadHandles;
-  for (const auto &device : deviceList) {
-    uintptr_t handle = reinterpret_cast<uintptr_t>(device.hDevice);
-    if (device.dwType == RIM_TYPEKEYBOARD) {
-      liveHandles.insert(handle);
-    } else if (device.dwType == RIM_TYPEHID &&
-               isPrecisionTouchpadHandle(device.hDevice)) {
-      liveHandles.insert(handle);
-      touchpadHandles.push_back(handle);
-    }
-  }
+  if (!collectLiveDevices(liveHandles, touchpadHandles))
+    return;
 
   // Phase 46: rebuild the unassigned device list
   unassignedDevices.clear();
@@ -9,17 +9,151 @@ static bool isPitchBendTarget(const AdsrTarget target) {
 }
 } // namespace
 
+void ExpressionEngine::EnvelopeColumns::reserve(size_t n) {
+  level.reserve(n);
+  rate.reserve(n);
+  goal.reserve(n);
+  awake.reserve(n);
+  offValue.reserve(n);
+  span.reserve(n);
+  maxOutput.reserve(n);
+  output.reserve(n);
+  lastSent.reserve(n);
+  stage.reserve(n);
+  source.reserve(n);
+  channel.reserve(n);
+  settings.reserve(n);
+}
+
+void ExpressionEngine::EnvelopeColumns::push(InputID src, int ch,
+                                             const AdsrSettings &s,
+                                             int valueWhenOn,
+                                             int valueWhenOff) {
+  level.push_back(0.0f);
+  rate.push_back(0.0f);
+  goal.push_back(0.0f);
+  awake.push_back(1.0f);
+  offValue.push_back(valueWhenOff);
+  span.push_back(static_cast<float>(valueWhenOn - valueWhenOff));
+  maxOutput.push_back(isPitchBendTarget(s.target) ? 16383 : 127);
+  output.push_back(valueWhenOff);
+  lastSent.push_back(-1); // First value is always sent
+  stage.push_back(Stage::Attack);
+  source.push_back(src);
+  channel.push_back(ch);
+  settings.push_back(s);
+}
+
+void ExpressionEngine::EnvelopeColumns::removeAt(size_t i) {
+  auto swapPop = [i](auto &column) {
+    column[i] = column.back();
+    column.pop_back();
+  };
+  swapPop(level);
+  swapPop(rate);
+  swapPop(goal);
+  swapPop(awake);
+  swapPop(offValue);
+  swapPop(span);
+  swapPop(maxOutput);
+  swapPop(output);
+  swapPop(lastSent);
+  swapPop(stage);
+  swapPop(source);
+  swapPop(channel);
+  swapPop(settings);
+}
+
+void ExpressionEngine::EnvelopeColumns::clear() {
+  level.clear();
+  rate.clear();
+  goal.clear();
+  awake.clear();
+  offValue.clear();
+  span.clear();
+  maxOutput.clear();
+  output.clear();
+  lastSent.clear();
+  stage.clear();
+  source.clear();
+  channel.clear();
+  settings.clear();
+}
+
 ExpressionEngine::ExpressionEngine(MidiEngine &engine) : midiEngine(engine) {
   for (int ch = 0; ch < 17; ++ch)
     currentPitchBendValues[ch] = 8192;
-  startTimer(static_cast<int>(timerIntervalMs));
+  // A full keyboard of per-key envelopes without reallocating.
+  envelopes.reserve(256);
+  scheduler->registerClient(*this, RealtimeScheduler::Order::Expression);
 }
 
 ExpressionEngine::~ExpressionEngine() {
-  stopTimer(); // HighResolutionTimer
+  scheduler->unregisterClient(*this);
 
   const juce::ScopedLock sl(lock);
-  activeEnvelopes.clear();
+  envelopes.clear();
+}
+
+int ExpressionEngine::findEnvelope(InputID source) const {
+  for (size_t i = 0; i < envelopes.size(); ++i) {
+    if (envelopes.source[i] == source)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void ExpressionEngine::enterStage(size_t i, Stage stage) {
+  const AdsrSettings &s = envelopes.settings[i];
+  float &level = envelopes.level[i];
+  const float dt = static_cast<float>(timerIntervalMs);
+  float rate = 0.0f;
+  float goal = level;
+
+  switch (stage) {
+  case Stage::Attack:
+    // From the current level to 1.0 in attackMs
+    if (s.attackMs <= 0) {
+      level = 1.0f; // Instant attack
+      enterStage(i, Stage::Decay);
+      return;
+    }
+    rate = dt / static_cast<float>(s.attackMs);
+    goal = 1.0f;
+    break;
+
+  case Stage::Decay:
+    // From 1.0 to sustainLevel in decayMs
+    if (s.decayMs <= 0 || level <= s.sustainLevel) {
+      level = s.sustainLevel; // Instant decay
+      enterStage(i, Stage::Sustain);
+      return;
+    }
+    rate = -(1.0f - s.sustainLevel) * dt / static_cast<float>(s.decayMs);
+    goal = s.sustainLevel;
+    break;
+
+  case Stage::Sustain:
+    // Hold sustain level (no change)
+    goal = level = s.sustainLevel;
+    break;
+
+  case Stage::Release:
+    // From the current level to 0.0 in releaseMs. An instant release (or one
+    // starting at 0) lands on the next tick.
+    rate = (s.releaseMs > 0 && level > 0.0f)
+               ? -level * dt / static_cast<float>(s.releaseMs)
+               : -1.0f;
+    goal = 0.0f;
+    break;
+
+  case Stage::Finished:
+    break; // Removed at the end of the next tick
+  }
+
+  envelopes.stage[i] = stage;
+  envelopes.rate[i] = rate;
+  envelopes.goal[i] = goal;
 }
 
 void ExpressionEngine::triggerEnvelope(InputID source, int channel,
@@ -38,278 +172,199 @@ void ExpressionEngine::triggerEnvelope(InputID source, int channel,
     return;
   }
 
+  const bool isPB = isPitchBendTarget(settings.target);
+
   // If this source exists in the PB stack for this channel, remove it (re-press
   // moves to top)
-  if (isPitchBendTarget(settings.target)) {
+  if (isPB) {
     auto &stack = pitchBendStacks[channel];
     stack.erase(std::remove(stack.begin(), stack.end(), source), stack.end());
   }
 
   // Remove any existing envelope for this source (voice stealing)
-  activeEnvelopes.erase(std::remove_if(activeEnvelopes.begin(),
-                                       activeEnvelopes.end(),
-                                       [source](const ActiveEnvelope &env) {
-                                         return env.source == source;
-                                       }),
-                        activeEnvelopes.end());
-
-  // Create new envelope: ADSR goes value when off -> value when on -> sustain
-  // -> value when off
-  ActiveEnvelope env;
-  env.source = source;
-  env.channel = channel;
-  env.settings = settings;
-  env.peakValue = peakValue;
-  if (settings.target == AdsrTarget::SmartScaleBend ||
-      settings.target == AdsrTarget::PitchBend) {
-    env.valueWhenOn = peakValue; // 0-16383 (from lookup or semitones)
-    env.valueWhenOff = 8192;     // neutral
-  } else {
-    env.valueWhenOn = settings.valueWhenOn; // 0-127
-    env.valueWhenOff = settings.valueWhenOff;
-  }
-  env.stage = Stage::Attack;
-  env.currentLevel = 0.0;
-  env.stageProgress = 0.0;
-  env.lastSentValue = -1; // Initialize to -1 so first value is always sent
-  env.isDormant = false;
+  if (const int existing = findEnvelope(source); existing >= 0)
+    envelopes.removeAt(static_cast<size_t>(existing));
 
-  if (isPitchBendTarget(settings.target)) {
+  if (isPB) {
     auto &stack = pitchBendStacks[channel];
     // If another envelope is currently driving this channel, make it dormant
     if (!stack.empty()) {
-      InputID prevTop = stack.back();
-      for (auto &e : activeEnvelopes) {
-        if (e.source == prevTop && e.channel == channel &&
-            isPitchBendTarget(e.settings.target)) {
-          e.isDormant = true;
+      const InputID prevTop = stack.back();
+      for (size_t i = 0; i < envelopes.size(); ++i) {
+        if (envelopes.source[i] == prevTop && envelopes.channel[i] == channel &&
+            isPitchBendTarget(envelopes.settings[i].target)) {
+          envelopes.awake[i] = 0.0f;
           break;
         }
       }
     }
     // Push new owner to top of stack
     stack.push_back(source);
-    // Dynamic handoff: start from current physical pitch
-    env.dynamicStartValue = currentPitchBendValues[channel];
-  } else {
-    // CC: start at value when off
-    env.dynamicStartValue = settings.valueWhenOff;
   }
 
-  // Calculate step size for Attack: from 0.0 to 1.0 in attackMs
-  if (settings.attackMs > 0) {
-    env.stepSize = timerIntervalMs / static_cast<double>(settings.attackMs);
-  } else {
-    // Instant attack
-    env.stepSize = 1.0;
-    env.currentLevel = 1.0;
-    env.stage = Stage::Decay;
-  }
+  // ADSR goes value when off -> value when on -> sustain -> value when off.
+  // For PB the peak is 0-16383 (from lookup or semitones), rest is neutral.
+  envelopes.push(source, channel, settings,
+                 isPB ? peakValue : settings.valueWhenOn,
+                 isPB ? 8192 : settings.valueWhenOff);
+  enterStage(envelopes.size() - 1, Stage::Attack);
 
-  activeEnvelopes.push_back(env);
+  scheduler->scheduleAfter(*this, timerIntervalMs);
 }
 
 void ExpressionEngine::releaseEnvelope(InputID source) {
   juce::ScopedLock scopedLock(lock);
 
-  auto findEnvIt = std::find_if(
-      activeEnvelopes.begin(), activeEnvelopes.end(),
-      [source](const ActiveEnvelope &e) { return e.source == source; });
-
-  if (findEnvIt == activeEnvelopes.end())
+  const int found = findEnvelope(source);
+  if (found < 0)
+    return;
+  const size_t i = static_cast<size_t>(found);
+  if (envelopes.stage[i] == Stage::Finished)
     return;
 
-  auto &env = *findEnvIt;
-  if (env.stage == Stage::Finished)
+  // Every branch below either starts a release/re-attack or marks an envelope
+  // Finished (removed on the next tick), so the engine must wake up.
+  scheduler->scheduleAfter(*this, timerIntervalMs);
+
+  // CC: Standard release
+  if (!isPitchBendTarget(envelopes.settings[i].target)) {
+    enterStage(i, Stage::Release);
     return;
+  }
 
   // Pitch Bend priority stack behavior (Phase 23.7)
-  if (isPitchBendTarget(env.settings.target)) {
-    auto &stack = pitchBendStacks[env.channel];
-    auto it = std::find(stack.begin(), stack.end(), source);
-    if (it == stack.end()) {
-      // Fallback: behave like normal release
-      env.stage = Stage::Release;
-      if (env.settings.releaseMs > 0 && env.currentLevel > 0.0) {
-        env.stepSize = env.currentLevel * timerIntervalMs /
-                       static_cast<double>(env.settings.releaseMs);
-      } else {
-        env.stepSize = env.currentLevel;
-      }
-      return;
-    }
+  const int channel = envelopes.channel[i];
+  auto &stack = pitchBendStacks[channel];
+  auto it = std::find(stack.begin(), stack.end(), source);
+  if (it == stack.end()) {
+    // Fallback: behave like normal release
+    enterStage(i, Stage::Release);
+    return;
+  }
 
-    const bool wasTop = (!stack.empty() && stack.back() == source);
-    stack.erase(it);
+  const bool wasTop = (!stack.empty() && stack.back() == source);
+  stack.erase(it);
 
-    if (!wasTop) {
-      // Background key released: remove silently
-      env.isDormant = true;
-      env.stage = Stage::Finished;
-      return;
-    }
+  if (!wasTop) {
+    // Background key released: remove silently
+    envelopes.awake[i] = 0.0f;
+    enterStage(i, Stage::Finished);
+    return;
+  }
 
-    if (!stack.empty()) {
-      // Active driver released -> handoff back to previous key, re-attack it
-      env.isDormant = true;
-      env.stage = Stage::Finished; // Kill released owner immediately
-
-      const InputID newTop = stack.back();
-      for (auto &e : activeEnvelopes) {
-        if (e.source == newTop && e.channel == env.channel &&
-            isPitchBendTarget(e.settings.target) &&
-            e.stage != Stage::Finished) {
-          e.isDormant = false;
-          e.dynamicStartValue = currentPitchBendValues[env.channel];
-          e.currentLevel = 0.0;
-          e.stageProgress = 0.0;
-          e.lastSentValue = -1;
-          e.stage = Stage::Attack;
-
-          if (e.settings.attackMs > 0) {
-            e.stepSize =
-                timerIntervalMs / static_cast<double>(e.settings.attackMs);
-          } else {
-            e.stepSize = 1.0;
-            e.currentLevel = 1.0;
-            e.stage = Stage::Decay;
-          }
-          break;
-        }
+  if (!stack.empty()) {
+    // Active driver released -> handoff back to previous key, re-attack it
+    envelopes.awake[i] = 0.0f;
+    enterStage(i, Stage::Finished); // Kill released owner immediately
+
+    const InputID newTop = stack.back();
+    for (size_t j = 0; j < envelopes.size(); ++j) {
+      if (envelopes.source[j] == newTop && envelopes.channel[j] == channel &&
+          isPitchBendTarget(envelopes.settings[j].target) &&
+          envelopes.stage[j] != Stage::Finished) {
+        envelopes.awake[j] = 1.0f;
+        envelopes.level[j] = 0.0f;
+        envelopes.lastSent[j] = -1;
+        enterStage(j, Stage::Attack);
+        break;
       }
-      return;
-    }
-
-    // Stack empty: let this envelope release to value when off
-    env.isDormant = false;
-    env.stage = Stage::Release;
-    env.lastSentValue = -1;
-    env.dynamicStartValue = (env.settings.target == AdsrTarget::SmartScaleBend)
-                                ? 8192
-                                : env.valueWhenOff;
-    env.peakValue = currentPitchBendValues[env.channel];
-    env.currentLevel = 1.0;
-    env.stageProgress = 0.0;
-
-    if (env.settings.releaseMs > 0) {
-      env.stepSize =
-          timerIntervalMs / static_cast<double>(env.settings.releaseMs);
-    } else {
-      env.stepSize = 1.0;
     }
     return;
   }
 
-  // CC: Standard release
-  env.stage = Stage::Release;
-
-  // Calculate step size for Release: from currentLevel to 0.0 in releaseMs
-  if (env.settings.releaseMs > 0 && env.currentLevel > 0.0) {
-    env.stepSize = env.currentLevel * timerIntervalMs /
-                   static_cast<double>(env.settings.releaseMs);
-  } else {
-    // Instant release
-    env.stepSize = env.currentLevel;
-  }
+  // Stack empty: let this envelope release from its peak to value when off
+  envelopes.awake[i] = 1.0f;
+  envelopes.lastSent[i] = -1;
+  envelopes.level[i] = 1.0f;
+  enterStage(i, Stage::Release);
 }
 
-void ExpressionEngine::hiResTimerCallback() { processOneTick(); }
+double ExpressionEngine::onSchedulerTick(double nowMs) {
+  return processOneTick() ? nowMs + timerIntervalMs : RealtimeScheduler::idle;
+}
 
-void ExpressionEngine::processOneTick() {
+bool ExpressionEngine::processOneTick() {
   juce::ScopedLock scopedLock(lock);
 
-  for (auto &env : activeEnvelopes) {
-    if (env.isDormant)
-      continue;
+  const size_t n = envelopes.size();
+  float *level = envelopes.level.data();
+  const float *rate = envelopes.rate.data();
+  const float *goal = envelopes.goal.data();
+  const float *awake = envelopes.awake.data();
+
+  // 1. Advance every level towards its stage goal (dormant rows: rate 0).
+  // Pure min/max arithmetic over contiguous floats, so it vectorizes.
+  for (size_t i = 0; i < n; ++i) {
+    const float current = level[i];
+    const float next = current + rate[i] * awake[i];
+    const float lo = std::min(current, goal[i]);
+    const float hi = std::max(current, goal[i]);
+    level[i] = std::min(std::max(next, lo), hi);
+  }
 
-    // Update level based on current stage
-    switch (env.stage) {
-    case Stage::Attack: {
-      env.currentLevel += env.stepSize;
-      if (env.currentLevel >= 1.0) {
-        env.currentLevel = 1.0;
-        // Transition to Decay
-        env.stage = Stage::Decay;
-        if (env.settings.decayMs > 0) {
-          double levelRange = 1.0 - env.settings.sustainLevel;
-          env.stepSize = levelRange * timerIntervalMs /
-                         static_cast<double>(env.settings.decayMs);
-        } else {
-          // Instant decay
-          env.currentLevel = env.settings.sustainLevel;
-          env.stage = Stage::Sustain;
-        }
-      }
+  // 2. Stage changes for rows that just reached their goal
+  for (size_t i = 0; i < n; ++i) {
+    if (rate[i] == 0.0f || awake[i] == 0.0f || level[i] != goal[i])
+      continue;
+    switch (envelopes.stage[i]) {
+    case Stage::Attack:
+      enterStage(i, Stage::Decay);
       break;
-    }
-
-    case Stage::Decay: {
-      env.currentLevel -= env.stepSize;
-      if (env.currentLevel <= env.settings.sustainLevel) {
-        env.currentLevel = env.settings.sustainLevel;
-        // Transition to Sustain
-        env.stage = Stage::Sustain;
-        env.stepSize = 0.0; // No change in Sustain
-      }
+    case Stage::Decay:
+      enterStage(i, Stage::Sustain);
       break;
-    }
-
-    case Stage::Sustain: {
-      // Hold sustain level (no change)
-      env.currentLevel = env.settings.sustainLevel;
+    case Stage::Release:
+      enterStage(i, Stage::Finished);
       break;
-    }
-
-    case Stage::Release: {
-      env.currentLevel -= env.stepSize;
-      if (env.currentLevel <= 0.0) {
-        env.currentLevel = 0.0;
-        env.stage = Stage::Finished;
-      }
-      break;
-    }
-
+    case Stage::Sustain:
     case Stage::Finished:
-      // Already finished, will be removed below
       break;
     }
+  }
 
-    const bool isPB = isPitchBendTarget(env.settings.target);
-    const bool isSmartBend =
-        (env.settings.target == AdsrTarget::SmartScaleBend);
-
-    // ADSR: output = valueWhenOff + level * (valueWhenOn - valueWhenOff)
-    // For CC: valueWhenOn/Off are 0–127. For PitchBend/SmartScaleBend they are
-    // already 0–16383 (no extra scaling).
-    int outputVal = env.valueWhenOff +
-                    static_cast<int>(env.currentLevel *
-                                     static_cast<double>(env.valueWhenOn -
-                                                         env.valueWhenOff));
-
-    // Clamp to valid ranges
-    if (isPB) {
-      outputVal = juce::jlimit(0, 16383, outputVal);
-    } else {
-      outputVal = juce::jlimit(0, 127, outputVal);
-    }
+  // 3. Quantize: output = valueWhenOff + level * (valueWhenOn - valueWhenOff)
+  // For CC the values are 0-127, for PitchBend/SmartScaleBend 0-16383.
+  const int *offValue = envelopes.offValue.data();
+  const float *span = envelopes.span.data();
+  const int *maxOutput = envelopes.maxOutput.data();
+  int *output = envelopes.output.data();
+  for (size_t i = 0; i < n; ++i) {
+    const int value = offValue[i] + static_cast<int>(level[i] * span[i]);
+    output[i] = std::min(std::max(value, 0), maxOutput[i]);
+  }
 
-    // Delta check: only send MIDI if value changed
-    if (outputVal != env.lastSentValue) {
-      if (isPB) {
-        currentPitchBendValues[env.channel] = outputVal;
-        midiEngine.sendPitchBend(env.channel, outputVal);
-      } else {
-        midiEngine.sendCC(env.channel, env.settings.ccNumber, outputVal);
-      }
-      env.lastSentValue = outputVal;
+  // 4. Delta check: only send MIDI for values that changed
+  bool anyMoving = false;
+  for (size_t i = 0; i < n; ++i) {
+    if (awake[i] == 0.0f)
+      continue;
+    const Stage stage = envelopes.stage[i];
+    if (stage != Stage::Sustain && stage != Stage::Finished)
+      anyMoving = true;
+    if (output[i] == envelopes.lastSent[i])
+      continue;
+    const int channel = envelopes.channel[i];
+    if (isPitchBendTarget(envelopes.settings[i].target)) {
+      currentPitchBendValues[channel] = output[i];
+      midiEngine.sendPitchBend(channel, output[i]);
+    } else {
+      midiEngine.sendCC(channel, envelopes.settings[i].ccNumber, output[i]);
     }
+    envelopes.lastSent[i] = output[i];
   }
 
   // Remove finished envelopes
-  activeEnvelopes.erase(std::remove_if(activeEnvelopes.begin(),
-                                       activeEnvelopes.end(),
-                                       [](const ActiveEnvelope &env) {
-                                         return env.stage == Stage::Finished;
-                                       }),
-                        activeEnvelopes.end());
+  for (size_t i = n; i-- > 0;) {
+    if (envelopes.stage[i] == Stage::Finished)
+      envelopes.removeAt(i);
+  }
+
+  // Sustaining and dormant envelopes hold their value; no further ticks
+  // needed until a trigger/release changes something.
+  return anyMoving;
+}
+
+int ExpressionEngine::getNumActiveEnvelopes() const {
+  const juce::ScopedLock sl(lock);
+  return static_cast<int>(envelopes.size());
 }
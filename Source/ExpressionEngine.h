@@ -1,11 +1,12 @@
 #pragma once
 #include "MappingTypes.h"
 #include "MidiEngine.h"
+#include "RealtimeScheduler.h"
 #include <JuceHeader.h>
 #include <map>
 #include <vector>
 
-class ExpressionEngine : public juce::HighResolutionTimer {
+class ExpressionEngine : public RealtimeScheduler::Client {
 public:
   explicit ExpressionEngine(MidiEngine &engine);
   ~ExpressionEngine() override;
@@ -17,37 +18,60 @@ public:
   // Release an envelope (key release)
   void releaseEnvelope(InputID source);
 
-  // HighResolutionTimer callback
-  void hiResTimerCallback() override;
+  // Scheduler tick: advances envelopes every timerIntervalMs while any
+  // envelope is moving; idle while all are sustaining/dormant.
+  double onSchedulerTick(double nowMs) override;
 
-  // Run one timer tick (same logic as hiResTimerCallback). For
-  // benchmarks/tests.
-  void processOneTick();
+  // Run one envelope step (same logic as onSchedulerTick). For
+  // benchmarks/tests. Returns true if any envelope is still moving.
+  bool processOneTick();
+
+  // Envelopes currently tracked (including sustaining / dormant ones).
+  int getNumActiveEnvelopes() const;
 
 private:
-  enum class Stage { Attack, Decay, Sustain, Release, Finished };
-
-  struct ActiveEnvelope {
-    InputID source;
-    int channel;
-    AdsrSettings settings;
-    int valueWhenOn = 127; // Peak of envelope (0-127; scaled for PB in output)
-    int valueWhenOff = 0;  // Rest and release end
-    int peakValue; // Kept for SmartScaleBend (per-note peak from lookup)
-    int dynamicStartValue = -1; // Value at Level 0.0 (Phase 23.7)
-    bool isDormant =
-        false; // If true, envelope exists but does not send MIDI (Phase 23.7)
-    Stage stage = Stage::Attack;
-    double currentLevel = 0.0;  // 0.0-1.0
-    double stageProgress = 0.0; // 0.0-1.0 (for progress tracking)
-    double stepSize = 0.0;      // Step per timer tick
-    int lastSentValue =
-        -1; // Last MIDI value sent (for delta check optimization)
+  enum class Stage : uint8_t { Attack, Decay, Sustain, Release, Finished };
+
+  // Envelopes stored struct-of-arrays: one column per field, row i is one
+  // envelope. Each stage is encoded as a signed per-tick rate towards a goal
+  // level (Attack: +rate to 1, Decay: -rate to sustain, Release: -rate to 0,
+  // Sustain/Finished: 0), so one branch-free kernel advances every envelope
+  // regardless of stage. Stage changes (a level reaching its goal) are rare
+  // and handled per row afterwards.
+  struct EnvelopeColumns {
+    // Hot: read/written by the per-tick kernels
+    std::vector<float> level; // 0.0-1.0
+    std::vector<float> rate;  // Signed level change per tick
+    std::vector<float> goal;  // Level where the current stage ends
+    std::vector<float> awake; // 1 = running, 0 = dormant (frozen, silent)
+    std::vector<int> offValue;  // Output at level 0 (value when off)
+    std::vector<float> span;    // valueWhenOn - valueWhenOff
+    std::vector<int> maxOutput; // 127 (CC) or 16383 (PB)
+    std::vector<int> output;    // This tick's quantized value
+    std::vector<int> lastSent;  // Last value sent (-1 = none)
+    // Cold: touched on trigger / release / stage change
+    std::vector<Stage> stage;
+    std::vector<InputID> source;
+    std::vector<int> channel;
+    std::vector<AdsrSettings> settings;
+
+    size_t size() const { return level.size(); }
+    void reserve(size_t n);
+    void push(InputID src, int ch, const AdsrSettings &s, int valueWhenOn,
+              int valueWhenOff);
+    // Swap-with-last removal (row order is not significant)
+    void removeAt(size_t i);
+    void clear();
   };
 
+  int findEnvelope(InputID source) const; // Row index or -1
+  // Enter a stage from the row's current level. Zero-length stages fall
+  // through to the next one immediately.
+  void enterStage(size_t i, Stage stage);
+
   MidiEngine &midiEngine;
-  std::vector<ActiveEnvelope> activeEnvelopes;
-  juce::CriticalSection lock;
+  EnvelopeColumns envelopes;
+  mutable juce::CriticalSection lock;
 
   // Pitch Bend Priority Stack (per-channel, LIFO) (Phase 23.7)
   std::map<int, std::vector<InputID>> pitchBendStacks; // channel -> stack
@@ -55,4 +79,5 @@ private:
       0}; // channel 1-16, cached output (default 8192)
 
   static constexpr double timerIntervalMs = 5.0; // 5ms = 200Hz
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
 };
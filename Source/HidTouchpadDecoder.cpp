@@ -0,0 +1,365 @@
+#include "HidTouchpadDecoder.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr uint16_t kPageGenericDesktop = 0x01;
+constexpr uint16_t kPageDigitizer = 0x0D;
+constexpr uint16_t kUsageX = 0x30;
+constexpr uint16_t kUsageY = 0x31;
+constexpr uint16_t kUsageTouchPad = 0x05;
+constexpr uint16_t kUsageFinger = 0x22;
+constexpr uint16_t kUsageTipSwitch = 0x42;
+constexpr uint16_t kUsageContactId = 0x51;
+constexpr uint16_t kUsageContactCount = 0x54;
+// Real touchpad reports are tens of bytes; anything larger is corrupt.
+constexpr uint64_t kMaxReportBits = 8 * 4096;
+
+constexpr uint32_t fullUsage(uint16_t page, uint16_t usage) {
+  return (static_cast<uint32_t>(page) << 16) | usage;
+}
+
+// HID short item data is little-endian, 0/1/2/4 bytes.
+uint32_t itemData(const uint8_t *data, int size) {
+  uint32_t value = 0;
+  for (int i = 0; i < size; ++i)
+    value |= static_cast<uint32_t>(data[i]) << (8 * i);
+  return value;
+}
+
+// Sign-extend the low `bytes` bytes of value (0 and 4 need no extension).
+int32_t signExtend(uint32_t value, int bytes) {
+  if (bytes == 0 || bytes == 4)
+    return static_cast<int32_t>(value);
+  const uint32_t signBit = 1u << (8 * bytes - 1);
+  return static_cast<int32_t>((value ^ signBit) - signBit);
+}
+
+// Global item state (pushed and popped as a whole).
+struct GlobalState {
+  uint16_t usagePage = 0;
+  int32_t logicalMin = 0;
+  uint32_t logicalMaxRaw = 0;
+  int logicalMaxSize = 0;
+  uint32_t reportSize = 0;
+  uint32_t reportCount = 0;
+  uint8_t reportId = 0;
+
+  // Logical Maximum is signed only when the minimum is negative.
+  int32_t logicalMax() const {
+    return logicalMin < 0 ? signExtend(logicalMaxRaw, logicalMaxSize)
+                          : static_cast<int32_t>(logicalMaxRaw);
+  }
+};
+
+// Local item state (cleared after every main item).
+struct LocalState {
+  std::vector<uint32_t> usages;
+  uint32_t usageMin = 0;
+  uint32_t usageMax = 0;
+  bool hasRange = false;
+
+  // Usage for element k of a main item, and how far past the last declared
+  // usage it is (the last usage repeats for the remaining elements).
+  uint32_t usageAt(uint32_t k, int &repeat) const {
+    repeat = 0;
+    if (hasRange) {
+      const uint32_t span = usageMax >= usageMin ? usageMax - usageMin : 0;
+      if (k > span)
+        repeat = static_cast<int>(k - span);
+      return usageMin + std::min(k, span);
+    }
+    if (usages.empty())
+      return 0;
+    const uint32_t last = static_cast<uint32_t>(usages.size()) - 1;
+    if (k > last)
+      repeat = static_cast<int>(k - last);
+    return usages[std::min(k, last)];
+  }
+
+  void clear() {
+    usages.clear();
+    hasRange = false;
+  }
+};
+
+uint32_t readBits(const uint8_t *report, uint32_t bitOffset, uint8_t bitSize) {
+  const uint8_t *p = report + bitOffset / 8;
+  const uint32_t shift = bitOffset % 8;
+  const int bytes = static_cast<int>((shift + bitSize + 7) / 8);
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i)
+    value |= static_cast<uint64_t>(p[i]) << (8 * i);
+  value >>= shift;
+  if (bitSize < 32)
+    value &= (uint64_t{1} << bitSize) - 1;
+  return static_cast<uint32_t>(value);
+}
+
+int32_t readField(const uint8_t *report, const HidField &field) {
+  const uint32_t raw = readBits(report, field.bitOffset, field.bitSize);
+  if (!field.isSigned || field.bitSize >= 32)
+    return static_cast<int32_t>(raw);
+  const uint32_t signBit = 1u << (field.bitSize - 1);
+  return static_cast<int32_t>((raw ^ signBit) - signBit);
+}
+
+float normalizeFromLogical(int32_t value, const HidField &field) {
+  const int64_t range =
+      static_cast<int64_t>(field.logicalMax) - field.logicalMin;
+  if (range <= 0)
+    return 0.5f;
+  // 64-bit: a 32-bit field's span can exceed INT32_MAX.
+  const int64_t offset = static_cast<int64_t>(value) - field.logicalMin;
+  const float norm =
+      static_cast<float>(offset) / static_cast<float>(range);
+  return std::clamp(norm, 0.0f, 1.0f);
+}
+} // namespace
+
+bool HidTouchpadPlan::isValid() const {
+  for (int i = 0; i < contactSlots; ++i)
+    if (contacts[(size_t)i].x.present() && contacts[(size_t)i].y.present())
+      return true;
+  return false;
+}
+
+bool HidTouchpadPlan::addField(uint16_t usagePage, uint16_t usage, int slot,
+                               const HidField &field) {
+  if (!field.present())
+    return false;
+  const uint32_t full = fullUsage(usagePage, usage);
+  if (full == fullUsage(kPageDigitizer, kUsageContactCount)) {
+    if (contactCount.present())
+      return false;
+    contactCount = field;
+    return true;
+  }
+  if (slot < 0 || slot >= kMaxContacts)
+    return false;
+
+  Contact &contact = contacts[(size_t)slot];
+  HidField *target = nullptr;
+  if (full == fullUsage(kPageDigitizer, kUsageContactId))
+    target = &contact.contactId;
+  else if (full == fullUsage(kPageDigitizer, kUsageTipSwitch))
+    target = &contact.tip;
+  else if (full == fullUsage(kPageGenericDesktop, kUsageX))
+    target = &contact.x;
+  else if (full == fullUsage(kPageGenericDesktop, kUsageY))
+    target = &contact.y;
+  if (target == nullptr || target->present())
+    return false;
+
+  *target = field;
+  contactSlots = std::max(contactSlots, slot + 1);
+  return true;
+}
+
+HidTouchpadPlan compileTouchpadPlan(const uint8_t *descriptor, size_t size) {
+  HidTouchpadPlan plan;
+  if (descriptor == nullptr)
+    return plan;
+
+  GlobalState global;
+  std::vector<GlobalState> globalStack;
+  LocalState local;
+  std::array<uint32_t, 256> inputBits{}; // Next input bit per report ID
+  bool usesReportIds = false;
+  bool haveReport = false;
+
+  int depth = 0;
+  int touchpadDepth = -1;
+  int fingerDepth = -1;
+  int fingerSlot = -1;
+
+  for (size_t i = 0; i < size;) {
+    const uint8_t prefix = descriptor[i];
+    if (prefix == 0xFE) { // Long item: skip its data
+      if (i + 1 >= size)
+        break;
+      i += 3 + static_cast<size_t>(descriptor[i + 1]);
+      continue;
+    }
+    const int dataSize = (prefix & 0x03) == 3 ? 4 : (prefix & 0x03);
+    if (i + 1 + static_cast<size_t>(dataSize) > size)
+      break; // Truncated item
+    const uint8_t *data = descriptor + i + 1;
+    const uint32_t value = itemData(data, dataSize);
+    const int type = (prefix >> 2) & 0x03;
+    const int tag = prefix >> 4;
+    i += 1 + static_cast<size_t>(dataSize);
+
+    if (type == 1) { // Global
+      switch (tag) {
+      case 0x0:
+        global.usagePage = static_cast<uint16_t>(value);
+        break;
+      case 0x1:
+        global.logicalMin = signExtend(value, dataSize);
+        break;
+      case 0x2:
+        global.logicalMaxRaw = value;
+        global.logicalMaxSize = dataSize;
+        break;
+      case 0x7:
+        global.reportSize = value;
+        break;
+      case 0x8:
+        global.reportId = static_cast<uint8_t>(value);
+        usesReportIds = true;
+        break;
+      case 0x9:
+        global.reportCount = value;
+        break;
+      case 0xA:
+        globalStack.push_back(global);
+        break;
+      case 0xB:
+        if (!globalStack.empty()) {
+          global = globalStack.back();
+          globalStack.pop_back();
+        }
+        break;
+      default:
+        break;
+      }
+      continue;
+    }
+
+    if (type == 2) { // Local; 1- and 2-byte usages take the current page
+      const uint32_t usage =
+          dataSize == 4 ? value : fullUsage(global.usagePage, (uint16_t)value);
+      if (tag == 0x0) {
+        local.usages.push_back(usage);
+      } else if (tag == 0x1) {
+        local.usageMin = usage;
+        local.hasRange = true;
+      } else if (tag == 0x2) {
+        local.usageMax = usage;
+        local.hasRange = true;
+      }
+      continue;
+    }
+
+    if (type != 0)
+      continue; // Reserved
+
+    int repeat = 0;
+    switch (tag) {
+    case 0xA: { // Collection
+      const uint32_t usage = local.usageAt(0, repeat);
+      ++depth;
+      if (touchpadDepth < 0 && value == 0x01 &&
+          usage == fullUsage(kPageDigitizer, kUsageTouchPad)) {
+        touchpadDepth = depth;
+      } else if (touchpadDepth >= 0 && fingerDepth < 0 &&
+                 usage == fullUsage(kPageDigitizer, kUsageFinger)) {
+        fingerDepth = depth;
+        ++fingerSlot;
+      }
+      break;
+    }
+    case 0xC: // End Collection
+      if (depth == fingerDepth)
+        fingerDepth = -1;
+      if (depth == touchpadDepth)
+        touchpadDepth = -1;
+      depth = std::max(0, depth - 1);
+      break;
+    case 0x8: { // Input
+      uint32_t &bit = inputBits[global.reportId];
+      const uint32_t start = bit;
+      const uint64_t end = static_cast<uint64_t>(start) +
+                           static_cast<uint64_t>(global.reportSize) *
+                               global.reportCount;
+      if (end > kMaxReportBits)
+        return HidTouchpadPlan{}; // Corrupt descriptor
+      bit = static_cast<uint32_t>(end);
+
+      // Data (bit 0 clear), Variable (bit 1 set) fields of the touchpad only.
+      const bool isData = (value & 0x01) == 0;
+      const bool isVariable = (value & 0x02) != 0;
+      if (touchpadDepth < 0 || !isData || !isVariable ||
+          global.reportSize == 0 || global.reportSize > 32)
+        break;
+      if (haveReport && global.reportId != plan.reportId)
+        break; // Contacts are taken from a single report
+
+      HidField field;
+      field.bitSize = static_cast<uint8_t>(global.reportSize);
+      field.logicalMin = global.logicalMin;
+      field.logicalMax = global.logicalMax();
+      field.isSigned = global.logicalMin < 0;
+
+      const int baseSlot = fingerDepth >= 0 ? fingerSlot : 0;
+      for (uint32_t k = 0; k < global.reportCount; ++k) {
+        const uint32_t usage = local.usageAt(k, repeat);
+        field.bitOffset = start + k * global.reportSize;
+        if (plan.addField(static_cast<uint16_t>(usage >> 16),
+                          static_cast<uint16_t>(usage), baseSlot + repeat,
+                          field) &&
+            !haveReport) {
+          haveReport = true;
+          plan.reportId = global.reportId;
+        }
+      }
+      break;
+    }
+    default: // Output, Feature
+      break;
+    }
+    local.clear();
+  }
+
+  if (!plan.isValid())
+    return HidTouchpadPlan{};
+
+  // The report ID byte, when present, precedes the fields.
+  const uint32_t idBits = usesReportIds ? 8 : 0;
+  auto shift = [idBits](HidField &field) {
+    if (field.present())
+      field.bitOffset += idBits;
+  };
+  shift(plan.contactCount);
+  for (auto &contact : plan.contacts) {
+    shift(contact.contactId);
+    shift(contact.tip);
+    shift(contact.x);
+    shift(contact.y);
+  }
+  plan.reportBytes = (idBits + inputBits[plan.reportId] + 7) / 8;
+  return plan;
+}
+
+bool decodeTouchpadReport(const HidTouchpadPlan &plan, const uint8_t *report,
+                          size_t size, TouchpadContactFrame &frame) {
+  frame.count = 0;
+  if (report == nullptr || plan.reportBytes == 0 || size < plan.reportBytes)
+    return false;
+  if (plan.reportId != 0 && report[0] != plan.reportId)
+    return false;
+
+  const int limit = plan.contactCount.present()
+                        ? readField(report, plan.contactCount)
+                        : 0;
+  for (int slot = 0; slot < plan.contactSlots; ++slot) {
+    const auto &fields = plan.contacts[(size_t)slot];
+    if (!fields.x.present() || !fields.y.present())
+      continue;
+    TouchpadContact &contact = frame.contacts[(size_t)frame.count++];
+    contact.contactId = fields.contactId.present()
+                            ? readField(report, fields.contactId)
+                            : slot;
+    contact.x = readField(report, fields.x);
+    contact.y = readField(report, fields.y);
+    contact.normX = normalizeFromLogical(contact.x, fields.x);
+    contact.normY = normalizeFromLogical(contact.y, fields.y);
+    contact.tipDown =
+        !fields.tip.present() || readField(report, fields.tip) != 0;
+    if (limit > 0 && frame.count >= limit)
+      break;
+  }
+  return true;
+}
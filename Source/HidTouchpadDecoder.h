@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "TouchpadTypes.h"
+
+// Platform-independent decoder for HID Precision Touchpad input reports. A
+// device's layout is compiled once (at attach) into a HidTouchpadPlan of bit
+// offsets and sizes; each report is then decoded by bit-slicing into a
+// fixed-capacity frame. Plans come from a raw report descriptor
+// (compileTouchpadPlan) or, on Windows, from preparsed data
+// (buildPrecisionTouchpadPlan in TouchpadHidParser).
+
+// One report field. Bit offsets count from the first byte of the report,
+// report ID byte included.
+struct HidField {
+  uint32_t bitOffset = 0;
+  uint8_t bitSize = 0; // 0 = not present
+  bool isSigned = false;
+  int32_t logicalMin = 0;
+  int32_t logicalMax = 0;
+
+  bool present() const { return bitSize != 0; }
+};
+
+struct HidTouchpadPlan {
+  static constexpr int kMaxContacts = 10;
+
+  struct Contact {
+    HidField contactId;
+    HidField tip;
+    HidField x;
+    HidField y;
+  };
+
+  uint8_t reportId = 0;   // 0 = reports carry no ID byte
+  size_t reportBytes = 0; // Minimum input report length
+  HidField contactCount;
+  std::array<Contact, kMaxContacts> contacts{};
+  int contactSlots = 0; // Highest slot with any field + 1
+
+  bool isValid() const;
+
+  // Route a field by usage (page, id) to contact slot; Contact Count ignores
+  // slot. Absent fields, unknown usages and slots beyond kMaxContacts are
+  // dropped, and the first field seen for a usage wins. Returns true if the
+  // field was used.
+  bool addField(uint16_t usagePage, uint16_t usage, int slot,
+                const HidField &field);
+};
+
+// Contacts decoded from one report.
+struct TouchpadContactFrame {
+  std::array<TouchpadContact, HidTouchpadPlan::kMaxContacts> contacts{};
+  int count = 0;
+
+  const TouchpadContact *begin() const { return contacts.data(); }
+  const TouchpadContact *end() const { return contacts.data() + count; }
+};
+
+// Parse a raw HID report descriptor. Contacts come from the first input report
+// inside the Digitizer / Touch Pad application collection: one slot per
+// Finger collection, or one per element for parallel arrays (Report Count > 1
+// with a single usage). Returns an invalid plan when no X/Y contact is found.
+HidTouchpadPlan compileTouchpadPlan(const uint8_t *descriptor, size_t size);
+
+// Decode one input report. Slots without X and Y are skipped; a non-zero
+// Contact Count limits the number of contacts. Returns false (and an empty
+// frame) when the report is too short or has another report ID.
+bool decodeTouchpadReport(const HidTouchpadPlan &plan, const uint8_t *report,
+                          size_t size, TouchpadContactFrame &frame);
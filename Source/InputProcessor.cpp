@@ -1,5 +1,6 @@
 #include "InputProcessor.h"
 #include "ChordUtilities.h"
+#include "CompiledContextCache.h"
 #include "MappingCompiler.h"
 #include "MappingTypes.h"
 #include "MidiEngine.h"
@@ -12,6 +13,7 @@
 #include <array>
 #include <cmath>
 #include <optional>
+#include <set>
 #include <tuple>
 
 // Phase 39.9: Modifier key aliasing (Left/Right -> Generic).
@@ -55,7 +57,10 @@ InputProcessor::InputProcessor(VoiceManager &voiceMgr, PresetManager &presetMgr,
   }
   touchpadSoloLayoutGroupGlobal = 0;
   keyboardSoloLayoutGroupGlobal = 0;
-  activeContext = std::make_shared<CompiledMapContext>();
+  noteBuffer.reserve(Zone::TransposedChord::kMaxNotes);
+  activeContext.store(std::make_shared<const CompiledMapContext>());
+  publishLayerState();
+  scheduler->registerClient(axisCoalescer, RealtimeScheduler::Order::Axis);
 }
 
 bool InputProcessor::isLayerActive(int layerIdx) const {
@@ -67,22 +72,40 @@ bool InputProcessor::isLayerActive(int layerIdx) const {
          (layerMomentaryCounts[(size_t)layerIdx] > 0);
 }
 
-int InputProcessor::getEffectiveSoloLayoutGroupForLayer(int layerIdx) const {
+void InputProcessor::publishLayerState() {
   juce::ScopedLock sl(stateLock);
-  if (touchpadSoloLayoutGroupGlobal > 0)
-    return touchpadSoloLayoutGroupGlobal;
+  auto snapshot = std::make_shared<LayerStateSnapshot>();
+  snapshot->touchpadSoloGlobal = touchpadSoloLayoutGroupGlobal;
+  snapshot->keyboardSoloGlobal = keyboardSoloLayoutGroupGlobal;
+  for (int i = 0; i < 9; ++i) {
+    const size_t idx = (size_t)i;
+    snapshot->active[idx] = isLayerActive(i);
+    if (snapshot->active[idx]) {
+      snapshot->highestActive = i;
+      snapshot->activeMask |= (uint16_t)(1u << i);
+    }
+    snapshot->touchpadSolo[idx] = touchpadSoloLayoutGroupGlobal > 0
+                                      ? touchpadSoloLayoutGroupGlobal
+                                      : touchpadSoloLayoutGroupPerLayer[idx];
+    snapshot->keyboardSolo[idx] = keyboardSoloLayoutGroupGlobal > 0
+                                      ? keyboardSoloLayoutGroupGlobal
+                                      : keyboardSoloLayoutGroupPerLayer[idx];
+  }
+  layerStateSnapshot.store(std::move(snapshot), std::memory_order_release);
+}
+
+int InputProcessor::getEffectiveSoloLayoutGroupForLayer(int layerIdx) const {
+  auto layers = loadLayerState();
   if (layerIdx < 0 || layerIdx >= 9)
-    return 0;
-  return touchpadSoloLayoutGroupPerLayer[(size_t)layerIdx];
+    return layers->touchpadSoloGlobal;
+  return layers->touchpadSolo[(size_t)layerIdx];
 }
 
 int InputProcessor::getEffectiveKeyboardSoloGroupForLayer(int layerIdx) const {
-  juce::ScopedLock sl(stateLock);
-  if (keyboardSoloLayoutGroupGlobal > 0)
-    return keyboardSoloLayoutGroupGlobal;
+  auto layers = loadLayerState();
   if (layerIdx < 0 || layerIdx >= 9)
-    return 0;
-  return keyboardSoloLayoutGroupPerLayer[(size_t)layerIdx];
+    return layers->keyboardSoloGlobal;
+  return layers->keyboardSolo[(size_t)layerIdx];
 }
 
 // Shared helpers for touchpad mapping region logic. These centralize the
@@ -147,6 +170,7 @@ void InputProcessor::clearForgetScopeSolosForInactiveLayers() {
       keyboardSoloScopeForgetPerLayer[(size_t)i] = false;
     }
   }
+  publishLayerState();
 }
 
 void InputProcessor::initialize() {
@@ -157,7 +181,10 @@ void InputProcessor::initialize() {
   settingsManager.addChangeListener(this);
   zoneManager.addChangeListener(this);
   touchpadLayoutManager.addChangeListener(this);
-  rebuildGrid();
+  // With a context cache set, the startup forceRebuildMappings() builds the
+  // first context, once the session is loaded.
+  if (!cacheReadPending)
+    rebuildGrid();
   applySustainDefaultFromPreset();
 }
 
@@ -166,6 +193,7 @@ void InputProcessor::runExpressionEngineOneTick() {
 }
 
 InputProcessor::~InputProcessor() {
+  scheduler->unregisterClient(axisCoalescer);
   stopTimer(); // Touch glide release timer
   // Remove listeners
   presetManager.getRootNode().removeListener(this);
@@ -179,9 +207,12 @@ InputProcessor::~InputProcessor() {
 }
 
 void InputProcessor::changeListenerCallback(juce::ChangeBroadcaster *source) {
-  if (source == &presetManager || source == &deviceManager ||
-      source == &settingsManager || source == &zoneManager ||
-      source == &touchpadLayoutManager) {
+  if (source == &touchpadLayoutManager) {
+    rebuildGrid(MappingCompiler::Scope::touchpadOnly());
+  } else if (source == &deviceManager) {
+    rebuildGrid(MappingCompiler::Scope::keyboardOnly());
+  } else if (source == &presetManager || source == &settingsManager ||
+             source == &zoneManager) {
     rebuildGrid();
     if (source == &presetManager)
       applySustainDefaultFromPreset(); // Preset load: apply sustain default
@@ -215,49 +246,127 @@ void InputProcessor::applySustainDefaultFromPreset() {
 }
 
 void InputProcessor::rebuildGrid() {
+  rebuildGrid(MappingCompiler::Scope::all());
+}
+
+void InputProcessor::rebuildGrid(const MappingCompiler::Scope &scope) {
   ++rebuildCount_;
-  auto newContext =
-      MappingCompiler::compile(presetManager, deviceManager, zoneManager,
-                            touchpadLayoutManager, settingsManager);
-  {
-    juce::ScopedWriteLock sl(mapLock);
-    activeContext = std::move(newContext);
+  juce::uint64 sessionKey = 0;
+  if (scope.isFull() && contextCacheFile != juce::File()) {
+    // The change messages of a session load arrive after the startup
+    // rebuild has made that session live; nothing to compile for them.
+    sessionKey = contextCacheKey();
+    if (sessionKey == liveContextKey) {
+      resetLayerStateFromPreset();
+      sendChangeMessage();
+      return;
+    }
+  }
+  // Incremental: grids/touchpad entries outside `scope` are reused from the
+  // current generation.
+  auto previous = loadContext();
+  std::shared_ptr<const CompiledMapContext> newContext;
+  if (sessionKey != 0 && cacheReadPending)
+    newContext = compileFromCache(sessionKey);
+  if (newContext == nullptr)
+    newContext = MappingCompiler::compile(presetManager, deviceManager,
+                                          zoneManager, touchpadLayoutManager,
+                                          settingsManager, previous.get(),
+                                          scope);
+  // Publish the new generation; in-flight readers keep the old one alive.
+  activeContext.store(std::move(newContext), std::memory_order_release);
+  liveContextKey = sessionKey;
+  if (scope.touchpad)
+    resetTouchpadRuntimeState(previous.get());
+  // Held axis values belong to the old mappings' CCs.
+  axisCoalescer.clear();
+  previous.reset();
+  // Keyboard-only edits (e.g. a mapping's velocity) keep the performer's
+  // layer/solo state; structural rebuilds restore it from the preset.
+  if (scope.isFull())
+    resetLayerStateFromPreset();
+  sendChangeMessage();
+}
+
+void InputProcessor::setContextCacheFile(const juce::File &file) {
+  contextCacheFile = file;
+  cacheFileKey = 0;
+  liveContextKey = 0;
+  cacheReadPending = file != juce::File();
+}
+
+juce::uint64 InputProcessor::contextCacheKey() {
+  return CompiledContextCache::computeKey(presetManager, deviceManager,
+                                          zoneManager, touchpadLayoutManager,
+                                          settingsManager, scaleLibrary);
+}
+
+std::shared_ptr<const CompiledMapContext>
+InputProcessor::compileFromCache(juce::uint64 key) {
+  auto cached = CompiledContextCache::read(contextCacheFile, key, zoneManager);
+  if (cached == nullptr)
+    return nullptr;
+  cacheFileKey = key;
+  // Touchpad entries are not cached; compiling them alone is cheap.
+  return MappingCompiler::compile(presetManager, deviceManager, zoneManager,
+                                  touchpadLayoutManager, settingsManager,
+                                  cached.get(),
+                                  MappingCompiler::Scope::touchpadOnly());
+}
+
+void InputProcessor::saveContextCache() {
+  if (contextCacheFile == juce::File())
+    return;
+  const juce::uint64 key = contextCacheKey();
+  if (key == cacheFileKey)
+    return;
+  // Compile afresh rather than store the live context: a change message may
+  // still be pending, and the key must describe exactly what is written.
+  auto context = MappingCompiler::compile(presetManager, deviceManager,
+                                          zoneManager, touchpadLayoutManager,
+                                          settingsManager);
+  if (CompiledContextCache::write(contextCacheFile, key, *context,
+                                  zoneManager))
+    cacheFileKey = key;
+}
+
+// Touchpad contact/fader/pad state refers to compiled touchpad entries by
+// index, so it is only valid for the touchpad part it was built against.
+void InputProcessor::resetTouchpadRuntimeState(
+    const CompiledMapContext *previous) {
+  // BoolToCC envelopes still held by a finger would never see their release
+  // once the rows are gone.
+  if (previous != nullptr &&
+      previous->touchpadMappings.size() == touchpadState.numMappings()) {
+    for (int slot = 0; slot < touchpadState.numDevices(); ++slot) {
+      for (size_t mapIdx = 0; mapIdx < touchpadState.numMappings(); ++mapIdx) {
+        if (touchpadState.mapping
+                .expressionActive[touchpadState.mappingRow(slot, mapIdx)])
+          expressionEngine.releaseEnvelope(
+              InputID{touchpadState.deviceAt(slot),
+                      previous->touchpadMappings[mapIdx].eventId});
+      }
+    }
   }
-  touchpadNoteOnSent.clear();
-  touchpadPrevState.clear();
-  touchpadPitchGlideState.clear();
-  stopTouchGlideTimerIfIdle();
   {
     juce::ScopedWriteLock wl(mixerStateLock);
-    touchpadMixerContactPrev.clear();
+    juce::ScopedLock al(anchorLock);
+    touchpadState.clear();
     contactLayoutLock.clear();
-    touchpadMixerLockedFader.clear();
-    touchpadMixerApplierDownPrev.clear();
-    touchpadMixerRelativeValue.clear();
-    touchpadMixerRelativeAnchor.clear();
-    touchpadMixerLastFaderIndex.clear();
-    touchpadMixerMuteState.clear();
-    lastTouchpadMixerCCValues.clear();
-    touchpadMixerValueBeforeMute.clear();
     drumPadActiveNotes.clear();
     chordPadActiveChords.clear();
     chordPadLatchedPads.clear();
   }
+  stopTouchGlideTimerIfIdle();
   contactMappingLock.clear();
-  touchpadMappingPrevState.clear();
-  // SlideToCC / EncoderCC state: clear so mappings work after rebuild (no stale
-  // lastTouchpadSlideCCValues preventing first send).
-  lastTouchpadSlideCCValues.clear();
-  touchpadSlideRelativeValue.clear();
-  touchpadSlideRelativeAnchor.clear();
-  touchpadSlideLockedContact.clear();
-  touchpadSlideContactPrev.clear();
-  touchpadSlideApplierDownPrev.clear();
-  touchpadSlideReturnState.clear();
+}
+
+void InputProcessor::resetLayerStateFromPreset() {
   // Phase 53.7: Layer state under stateLock only
   {
     juce::ScopedLock sl(stateLock);
     momentaryLayerHolds.clear(); // Momentary chain: stale after grid rebuild
+    hasMomentaryLayerHolds.store(false, std::memory_order_release);
     for (int i = 0; i < 9; ++i) {
       juce::ValueTree layerNode = presetManager.getLayerNode(i);
       if (layerNode.isValid())
@@ -272,35 +381,30 @@ void InputProcessor::rebuildGrid() {
     }
     touchpadSoloLayoutGroupGlobal = 0;
     keyboardSoloLayoutGroupGlobal = 0;
+    publishLayerState();
   }
-  sendChangeMessage();
 }
 
 // Phase 52.1: Grid lookup (replaces findMapping). Returns action if slot is
-// active. Phase 53.7: Snapshot layer state under stateLock to avoid data race.
-std::optional<MidiAction>
+// active. Layer state and context are read from published snapshots (no
+// mutex; never blocks on stateLock); the returned view keeps that context
+// alive.
+InputProcessor::ActionRef
 InputProcessor::lookupActionInGrid(InputID input) const {
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
 
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  auto ctx = loadContext();
   if (!ctx)
-    return std::nullopt;
+    return {};
 
   uintptr_t effectiveDevice = input.deviceHandle;
-  if (!settingsManager.isStudioMode())
+  if (!settingsManager.getRuntimeSettings()->studioMode)
     effectiveDevice = 0;
 
-  const int keyCode = input.keyCode;
-  if (keyCode < 0 || keyCode > 0xFF)
-    return std::nullopt;
+  const int keyCode = InputTypes::gridSlot(input.keyCode);
+  if (keyCode < 0)
+    return {};
 
   const int genericKey = getGenericKey(keyCode);
 
@@ -308,41 +412,53 @@ InputProcessor::lookupActionInGrid(InputID input) const {
     if (!activeLayersSnapshot[(size_t)i])
       continue;
 
-    std::shared_ptr<const AudioGrid> grid;
+    // Grids are owned by ctx; no per-layer shared_ptr copies.
+    const AudioGrid *grid = nullptr;
     if (effectiveDevice != 0) {
       auto it = ctx->deviceGrids.find(effectiveDevice);
-      if (it != ctx->deviceGrids.end() && it->second[(size_t)i])
-        grid = it->second[(size_t)i];
+      if (it != ctx->deviceGrids.end())
+        grid = it->second[(size_t)i].get();
     }
     if (!grid)
-      grid = ctx->globalGrids[(size_t)i];
+      grid = ctx->globalGrids[(size_t)i].get();
     if (!grid)
       continue;
 
     const auto &slot = (*grid)[(size_t)keyCode];
     if (slot.isActive) {
-      int keyboardSolo = getEffectiveKeyboardSoloGroupForLayer(i);
+      int keyboardSolo = layers->keyboardSolo[(size_t)i];
       if ((keyboardSolo == 0 && slot.keyboardGroupId != 0) ||
           (keyboardSolo > 0 && slot.keyboardGroupId != keyboardSolo))
         continue;
-      return slot.action;
+      const MidiAction *action = &ctx->actionFor(slot);
+      return {std::move(ctx), action};
     }
     if (genericKey != 0) {
       const auto &genSlot = (*grid)[(size_t)genericKey];
       if (genSlot.isActive) {
-        int keyboardSolo = getEffectiveKeyboardSoloGroupForLayer(i);
+        int keyboardSolo = layers->keyboardSolo[(size_t)i];
         if ((keyboardSolo == 0 && genSlot.keyboardGroupId != 0) ||
             (keyboardSolo > 0 && genSlot.keyboardGroupId != keyboardSolo))
           continue;
-        return genSlot.action;
+        const MidiAction *action = &ctx->actionFor(genSlot);
+        return {std::move(ctx), action};
       }
     }
   }
-  return std::nullopt;
+  return {};
 }
 
 // Helper to convert alias name to hash lives in DeviceManager::getAliasHash.
 
+// Mappings on the "Touchpad" alias compile into the touchpad part, not the
+// keyboard grids.
+static bool isTouchpadAliasMapping(const juce::ValueTree &mapping) {
+  return mapping.getProperty("inputAlias", "")
+      .toString()
+      .trim()
+      .equalsIgnoreCase("Touchpad");
+}
+
 void InputProcessor::valueTreeChildAdded(
     juce::ValueTree &parentTree, juce::ValueTree &childWhichHasBeenAdded) {
   if (presetManager.getIsLoading())
@@ -358,14 +474,18 @@ void InputProcessor::valueTreeChildAdded(
   if (parentTree.hasType("Mappings")) {
     auto layerNode = parentTree.getParent();
     if (layerNode.isValid() && layerNode.hasType("Layer")) {
-      rebuildGrid();
+      rebuildGrid(scopeForMappingChange(childWhichHasBeenAdded,
+                                        (int)layerNode.getProperty("id", 0),
+                                        false));
       return;
     }
   }
 
   auto mappingsNode = presetManager.getMappingsNode();
   if (parentTree.isEquivalentTo(mappingsNode)) {
-    rebuildGrid();
+    auto scope = MappingCompiler::Scope::keyboardOnly();
+    scope.touchpad = isTouchpadAliasMapping(childWhichHasBeenAdded);
+    rebuildGrid(scope);
   }
 }
 
@@ -384,17 +504,43 @@ void InputProcessor::valueTreeChildRemoved(
   if (parentTree.hasType("Mappings")) {
     auto layerNode = parentTree.getParent();
     if (layerNode.isValid() && layerNode.hasType("Layer")) {
-      rebuildGrid();
+      rebuildGrid(scopeForMappingChange(childWhichHasBeenRemoved,
+                                        (int)layerNode.getProperty("id", 0),
+                                        false));
       return;
     }
   }
 
   auto mappingsNode = presetManager.getMappingsNode();
   if (parentTree.isEquivalentTo(mappingsNode)) {
-    rebuildGrid();
+    auto scope = MappingCompiler::Scope::keyboardOnly();
+    scope.touchpad = isTouchpadAliasMapping(childWhichHasBeenRemoved);
+    rebuildGrid(scope);
   }
 }
 
+MappingCompiler::Scope
+InputProcessor::scopeForMappingChange(const juce::ValueTree &mapping,
+                                      int layerId,
+                                      bool aliasOrLayerChanged) const {
+  // The tree is already updated, so the old layer/alias are unknown:
+  // recompile every keyboard layer, and the touchpad part in case the
+  // mapping was on the Touchpad alias.
+  if (aliasOrLayerChanged) {
+    auto scope = MappingCompiler::Scope::keyboardOnly();
+    scope.touchpad = true;
+    return scope;
+  }
+  // A named alias pins the change to that device stack; global and
+  // hardware-hash mappings can land in the global stack (inherited by all).
+  const juce::String aliasName =
+      mapping.getProperty("inputAlias", "").toString().trim();
+  auto scope = MappingCompiler::Scope::keyboardOnly(
+      juce::jlimit(0, 8, layerId), DeviceManager::getAliasHash(aliasName));
+  scope.touchpad = isTouchpadAliasMapping(mapping);
+  return scope;
+}
+
 void InputProcessor::valueTreePropertyChanged(
     juce::ValueTree &treeWhosePropertyHasChanged,
     const juce::Identifier &property) {
@@ -406,14 +552,14 @@ void InputProcessor::valueTreePropertyChanged(
   if (treeWhosePropertyHasChanged.hasType("Layer")) {
     if (property == juce::Identifier("name") ||
         property == juce::Identifier("isActive")) {
-      juce::ScopedWriteLock lock(mapLock);
       int layerId = treeWhosePropertyHasChanged.getProperty("id", -1);
       if (layerId >= 0 && layerId < 9) {
+        juce::ScopedLock sl(stateLock);
         layerLatchedState[(size_t)layerId] =
             (bool)treeWhosePropertyHasChanged.getProperty("isActive",
                                                           layerId == 0);
       }
-      clearForgetScopeSolosForInactiveLayers();
+      clearForgetScopeSolosForInactiveLayers(); // Also publishes layer state
       sendChangeMessage();
       return;
     }
@@ -424,10 +570,12 @@ void InputProcessor::valueTreePropertyChanged(
 
   // Phase 41: Check if this is a mapping in a layer
   bool isLayerMapping = false;
+  int mappingLayerId = 0;
   if (treeWhosePropertyHasChanged.hasType("Mapping")) {
     auto layerNode = parent.getParent();
     if (layerNode.isValid() && layerNode.hasType("Layer")) {
       isLayerMapping = true;
+      mappingLayerId = (int)layerNode.getProperty("id", 0);
     }
   }
 
@@ -492,21 +640,38 @@ void InputProcessor::valueTreePropertyChanged(
       property == juce::Identifier("keyboardGroupId") ||
       property == juce::Identifier("keyboardLayoutGroupId") ||
       property == juce::Identifier("keyboardSoloScope")) {
-    if (isLayerMapping || parent.isEquivalentTo(mappingsNode) ||
-        treeWhosePropertyHasChanged.isEquivalentTo(mappingsNode)) {
-      // SAFER: Rebuild everything.
-      // The logic to "Remove Old -> Add New" is impossible here because
-      // we don't know the Old values anymore (the Tree is already updated).
-      juce::ScopedWriteLock lock(mapLock);
-      rebuildGrid(); // Phase 50.5: Only rebuild grid
+    if (isLayerMapping) {
+      // Only this mapping's layer (and the layers above, which inherit it)
+      // and its alias stack are recompiled. Moving a mapping to another
+      // layer/alias recompiles all keyboard layers since the old value is
+      // gone from the tree.
+      const bool aliasOrLayerChanged =
+          property == juce::Identifier("layerID") ||
+          property == juce::Identifier("deviceHash") ||
+          property == juce::Identifier("inputAlias");
+      rebuildGrid(scopeForMappingChange(treeWhosePropertyHasChanged,
+                                        mappingLayerId, aliasOrLayerChanged));
+    } else if (parent.isEquivalentTo(mappingsNode) ||
+               treeWhosePropertyHasChanged.isEquivalentTo(mappingsNode)) {
+      auto scope = MappingCompiler::Scope::keyboardOnly();
+      scope.touchpad = property == juce::Identifier("inputAlias") ||
+                       isTouchpadAliasMapping(treeWhosePropertyHasChanged);
+      rebuildGrid(scope);
     }
   }
 }
 
-std::optional<MidiAction> InputProcessor::getMappingForInput(InputID input) {
+InputProcessor::ActionRef
+InputProcessor::findMappingForInput(InputID input) const {
   return lookupActionInGrid(input);
 }
 
+std::optional<MidiAction> InputProcessor::getMappingForInput(InputID input) {
+  if (auto action = lookupActionInGrid(input))
+    return *action;
+  return std::nullopt;
+}
+
 int InputProcessor::calculateVelocity(int base, int range) {
   if (range <= 0)
     return base;
@@ -542,36 +707,31 @@ void InputProcessor::triggerManualNoteRelease(InputID id,
 bool InputProcessor::updateLayerState() { return false; }
 
 void InputProcessor::processEvent(InputID input, bool isDown) {
+  inputRecorder.recordKey(input.deviceHandle, input.keyCode, isDown);
+
+  // One settings snapshot per event (published; no mutex)
+  const auto settings = settingsManager.getRuntimeSettings();
+
   // Gate: If MIDI mode is not active, don't generate MIDI
-  if (!settingsManager.isMidiModeActive()) {
+  if (!settings->midiModeActive) {
     return;
   }
 
-  // Phase 40.1: Track held keys and recompute momentary layers.
+  // Phase 40.1: Momentary layer holds are keyed per device only in Studio
+  // Mode.
   InputID held = input;
-  if (!settingsManager.isStudioMode())
+  if (!settings->studioMode)
     held.deviceHandle = 0;
 
-  {
-    juce::ScopedWriteLock wl(mapLock);
-    if (isDown)
-      currentlyHeldKeys.insert(held);
-    else
-      currentlyHeldKeys.erase(held);
-  }
-
-  // Phase 53.7: Snapshot active layers under state lock (no lock inside loop)
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
+  // Phase 53.7: Snapshot active layers once per event (published; never
+  // blocks on stateLock)
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
 
-  // Momentary layer chain: key-up of a key holding a layer (Phantom Key fix)
-  if (!isDown) {
+  // Momentary layer chain: key-up of a key holding a layer (Phantom Key fix).
+  // momentaryLayerHolds is only non-empty while a layer key is held, so the
+  // common case skips stateLock entirely.
+  if (!isDown && hasMomentaryLayerHolds.load(std::memory_order_acquire)) {
     juce::ScopedLock sl(stateLock);
     auto it = momentaryLayerHolds.find(held);
     if (it != momentaryLayerHolds.end()) {
@@ -579,23 +739,25 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
       if (layerMomentaryCounts[(size_t)target] > 0)
         layerMomentaryCounts[(size_t)target]--;
       momentaryLayerHolds.erase(it);
+      hasMomentaryLayerHolds.store(!momentaryLayerHolds.empty(),
+                                   std::memory_order_release);
+      publishLayerState();
       sendChangeMessage();
       return;
     }
   }
 
   {
-    juce::ScopedReadLock rl(mapLock);
-    auto ctx = activeContext;
+    auto ctx = loadContext();
     if (!ctx)
       return;
 
     uintptr_t effectiveDevice = input.deviceHandle;
-    if (!settingsManager.isStudioMode())
+    if (!settings->studioMode)
       effectiveDevice = 0;
 
-    const int keyCode = input.keyCode;
-    if (keyCode < 0 || keyCode > 0xFF)
+    const int keyCode = InputTypes::gridSlot(input.keyCode);
+    if (keyCode < 0)
       return;
 
     for (int layerIdx = 8; layerIdx >= 0; --layerIdx) {
@@ -622,31 +784,23 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
       if (!slot.isActive)
         continue;
 
-      int keyboardSolo = getEffectiveKeyboardSoloGroupForLayer(layerIdx);
+      int keyboardSolo = layers->keyboardSolo[(size_t)layerIdx];
       if ((keyboardSolo == 0 && slot.keyboardGroupId != 0) ||
           (keyboardSolo > 0 && slot.keyboardGroupId != keyboardSolo))
         continue;
 
-      // Hit! Process this action
-      const auto &midiAction = slot.action;
+      // Hit! Only now read the full action from the pool; the layer scan
+      // above touched just the compact slots.
+      const auto &midiAction = ctx->actionFor(slot);
 
-      // Check if this is a zone (by checking ZoneManager - zones need special
-      // handling)
-      std::shared_ptr<Zone> zone;
-      if (midiAction.type == ActionType::Note) {
-        // Resolve alias for zone lookup
-        juce::String aliasName =
-            deviceManager.getAliasForHardware(effectiveDevice);
-        uintptr_t aliasHash = 0;
-        if (aliasName != "Unassigned" && !aliasName.isEmpty()) {
-          aliasHash = DeviceManager::getAliasHash(aliasName);
-        }
-        zone =
-            zoneManager.getZoneForInput(InputID{aliasHash, keyCode}, layerIdx);
-        if (!zone) {
-          zone = zoneManager.getZoneForInput(InputID{0, keyCode}, layerIdx);
-        }
-      }
+      // Zone slots carry a compile-time handle into ctx->zoneTable (zones
+      // need special handling); no alias or ZoneManager lookup on key-down.
+      static const std::shared_ptr<Zone> noZone;
+      const std::shared_ptr<Zone> &zone =
+          (midiAction.type == ActionType::Note && slot.zoneIndex >= 0 &&
+           slot.zoneIndex < (int)ctx->zoneTable.size())
+              ? ctx->zoneTable[(size_t)slot.zoneIndex]
+              : noZone;
 
       if (!isDown) {
         // Key-up handling
@@ -659,7 +813,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
               if (layerMomentaryCounts[(size_t)target] > 0)
                 layerMomentaryCounts[(size_t)target]--;
             }
-            clearForgetScopeSolosForInactiveLayers();
+            clearForgetScopeSolosForInactiveLayers(); // Publishes layer state
             sendChangeMessage();
             return;
           }
@@ -682,6 +836,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 touchpadSoloScopeForgetPerLayer[(size_t)currentLayer] = false;
               }
             }
+            publishLayerState();
             sendChangeMessage();
           } else if (cmd == static_cast<int>(
                                  MIDIQy::CommandID::
@@ -697,6 +852,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 keyboardSoloScopeForgetPerLayer[(size_t)currentLayer] = false;
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         }
@@ -746,7 +902,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
       if (midiAction.type == ActionType::Expression) {
         int peakValue = midiAction.data2;
         if (midiAction.adsrSettings.target == AdsrTarget::PitchBend) {
-          double stepsPerSemitone = settingsManager.getStepsPerSemitone();
+          double stepsPerSemitone = settings->stepsPerSemitone;
           peakValue =
               static_cast<int>(8192.0 + (midiAction.data2 * stepsPerSemitone));
           peakValue = juce::jlimit(0, 16383, peakValue);
@@ -773,8 +929,9 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
             juce::ScopedLock sl(stateLock);
             layerMomentaryCounts[(size_t)target]++;
             momentaryLayerHolds[held] = target;
+            hasMomentaryLayerHolds.store(true, std::memory_order_release);
           }
-          clearForgetScopeSolosForInactiveLayers();
+          clearForgetScopeSolosForInactiveLayers(); // Publishes layer state
           sendChangeMessage();
           return;
         }
@@ -810,6 +967,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
               touchpadSoloLayoutGroupGlobal = 0;
               keyboardSoloLayoutGroupGlobal = 0;
               momentaryLayerHolds.clear();
+              hasMomentaryLayerHolds.store(false, std::memory_order_release);
             }
             clearForgetScopeSolosForInactiveLayers();
             sendChangeMessage();
@@ -838,8 +996,10 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
               lastSustainChordSource = InputID{0, -1};
               lastSustainZone = nullptr;
             }
-          } else
+          } else {
             voiceManager.panic();
+            axisCoalescer.clear();
+          }
         } else if (cmd == static_cast<int>(MIDIQy::CommandID::PanicLatch)) {
           voiceManager.panicLatch(); // Backward compat: old Panic Latch mapping
         } else if (cmd ==
@@ -857,6 +1017,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 touchpadSoloScopeForgetPerLayer[(size_t)currentLayer] = (scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -879,6 +1040,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                     (!wasActive && scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -896,6 +1058,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 touchpadSoloScopeForgetPerLayer[(size_t)currentLayer] = (scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -912,6 +1075,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 touchpadSoloScopeForgetPerLayer[(size_t)currentLayer] = false;
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -929,6 +1093,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 keyboardSoloScopeForgetPerLayer[(size_t)currentLayer] = (scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -951,6 +1116,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                     (!wasActive && scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -968,6 +1134,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 keyboardSoloScopeForgetPerLayer[(size_t)currentLayer] = (scope == 1);
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd ==
@@ -984,6 +1151,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
                 keyboardSoloScopeForgetPerLayer[(size_t)currentLayer] = false;
               }
             }
+            publishLayerState();
             sendChangeMessage();
           }
         } else if (cmd == static_cast<int>(MIDIQy::CommandID::Transpose) ||
@@ -1101,7 +1269,7 @@ void InputProcessor::processEvent(InputID input, bool isDown) {
         return; // Stop searching lower layers
       }
     }
-  } // release read lock
+  } // release context generation
   // No match found in any active layer
 }
 
@@ -1111,44 +1279,51 @@ std::vector<int> InputProcessor::getBufferedNotes() {
 }
 
 std::shared_ptr<const CompiledMapContext> InputProcessor::getContext() const {
-  juce::ScopedReadLock rl(mapLock);
-  return activeContext;
+  return loadContext();
+}
+
+size_t InputProcessor::fillZoneChordVoicing(
+    const Zone &zone, const Zone::TransposedChord &chord,
+    std::array<int, Zone::TransposedChord::kMaxNotes> &notes,
+    std::array<int, Zone::TransposedChord::kMaxNotes> &velocities) {
+  // Per-note velocities from base + velocity random (velocity random slider
+  // controls variation)
+  const size_t count = (size_t)chord.size;
+  for (size_t i = 0; i < count; ++i) {
+    notes[i] = chord.pitch[i];
+    int vel = calculateVelocity(zone.baseVelocity, zone.velocityRandom);
+    if (chord.isGhost[i]) {
+      int ghostVel = static_cast<int>(vel * zone.ghostVelocityScale);
+      velocities[i] = juce::jlimit(1, 127, ghostVel);
+    } else {
+      velocities[i] = vel;
+    }
+  }
+  if (zone.strumGhostNotes && count > 2) {
+    for (size_t i = 1; i < count - 1; ++i)
+      velocities[i] =
+          juce::jlimit(1, 127, static_cast<int>(velocities[i] * 0.85f));
+  }
+  return count;
 }
 
 // Phase 50.5: Process a single note from a zone (with zone-specific behavior)
-void InputProcessor::processZoneNote(InputID input, std::shared_ptr<Zone> zone,
+void InputProcessor::processZoneNote(InputID input,
+                                     const std::shared_ptr<Zone> &zone,
                                      const MidiAction &action) {
   if (!zone)
     return;
 
-  auto chordNotes = zone->getNotesForKey(
-      input.keyCode, zoneManager.getGlobalChromaticTranspose(),
-      zoneManager.getGlobalDegreeTranspose());
+  // Chord with the global transpose already applied (no allocation).
+  const Zone::TransposedChord *chord = zone->getTransposedChord(input.keyCode);
   bool allowSustain = !zone->ignoreGlobalSustain;
 
-  if (chordNotes.has_value() && !chordNotes->empty()) {
-    // Per-note velocities from base + velocity random (velocity random slider
-    // controls variation)
-    std::vector<int> finalNotes;
-    std::vector<int> finalVelocities;
-    finalNotes.reserve(chordNotes->size());
-    finalVelocities.reserve(chordNotes->size());
-
-    for (const auto &cn : *chordNotes) {
-      finalNotes.push_back(cn.pitch);
-      int vel = calculateVelocity(zone->baseVelocity, zone->velocityRandom);
-      if (cn.isGhost) {
-        int ghostVel = static_cast<int>(vel * zone->ghostVelocityScale);
-        finalVelocities.push_back(juce::jlimit(1, 127, ghostVel));
-      } else {
-        finalVelocities.push_back(vel);
-      }
-    }
-    if (zone->strumGhostNotes && finalVelocities.size() > 2) {
-      for (size_t i = 1; i < finalVelocities.size() - 1; ++i)
-        finalVelocities[i] =
-            juce::jlimit(1, 127, static_cast<int>(finalVelocities[i] * 0.85f));
-    }
+  if (chord != nullptr && chord->size > 0) {
+    std::array<int, Zone::TransposedChord::kMaxNotes> noteBuf;
+    std::array<int, Zone::TransposedChord::kMaxNotes> velBuf;
+    const size_t count = fillZoneChordVoicing(*zone, *chord, noteBuf, velBuf);
+    std::span<const int> finalNotes(noteBuf.data(), count);
+    std::span<const int> finalVelocities(velBuf.data(), count);
     // Direct: send instantly (strum 0, no timing variation). Strum: use slider
     // values.
     int strumMsForCall =
@@ -1227,7 +1402,7 @@ void InputProcessor::processZoneNote(InputID input, std::shared_ptr<Zone> zone,
         lastTriggeredNote = finalNotes.front();
       {
         juce::ScopedWriteLock bufferWriteLock(bufferLock);
-        noteBuffer = finalNotes;
+        noteBuffer.assign(finalNotes.begin(), finalNotes.end());
         bufferedStrumSpeedMs = strumMsForCall;
       }
     }
@@ -1248,18 +1423,16 @@ void InputProcessor::processZoneNote(InputID input, std::shared_ptr<Zone> zone,
 
 // Phase 50.5: Process a chord from chordPool with zone-specific behavior
 void InputProcessor::processZoneChord(
-    InputID input, std::shared_ptr<Zone> zone,
+    InputID input, const std::shared_ptr<Zone> &zone,
     const std::vector<MidiAction> &chordActions, const MidiAction &rootAction) {
   if (!zone)
     return;
 
-  // Reconstruct chord notes with ghost note info from zone
-  auto chordNotes = zone->getNotesForKey(
-      input.keyCode, zoneManager.getGlobalChromaticTranspose(),
-      zoneManager.getGlobalDegreeTranspose());
+  // Chord notes with ghost note info from the zone (transpose applied)
+  const Zone::TransposedChord *chord = zone->getTransposedChord(input.keyCode);
   bool allowSustain = !zone->ignoreGlobalSustain;
 
-  if (!chordNotes.has_value() || chordNotes->empty()) {
+  if (chord == nullptr || chord->size <= 0) {
     // Fallback: use chordActions directly
     std::vector<int> notes;
     std::vector<int> velocities;
@@ -1276,27 +1449,11 @@ void InputProcessor::processZoneChord(
     return;
   }
 
-  // Per-note velocities from base + velocity random
-  std::vector<int> finalNotes;
-  std::vector<int> finalVelocities;
-  finalNotes.reserve(chordNotes->size());
-  finalVelocities.reserve(chordNotes->size());
-
-  for (const auto &cn : *chordNotes) {
-    finalNotes.push_back(cn.pitch);
-    int vel = calculateVelocity(zone->baseVelocity, zone->velocityRandom);
-    if (cn.isGhost) {
-      int ghostVel = static_cast<int>(vel * zone->ghostVelocityScale);
-      finalVelocities.push_back(juce::jlimit(1, 127, ghostVel));
-    } else {
-      finalVelocities.push_back(vel);
-    }
-  }
-  if (zone->strumGhostNotes && finalVelocities.size() > 2) {
-    for (size_t i = 1; i < finalVelocities.size() - 1; ++i)
-      finalVelocities[i] =
-          juce::jlimit(1, 127, static_cast<int>(finalVelocities[i] * 0.85f));
-  }
+  std::array<int, Zone::TransposedChord::kMaxNotes> noteBuf;
+  std::array<int, Zone::TransposedChord::kMaxNotes> velBuf;
+  const size_t count = fillZoneChordVoicing(*zone, *chord, noteBuf, velBuf);
+  std::span<const int> finalNotes(noteBuf.data(), count);
+  std::span<const int> finalVelocities(velBuf.data(), count);
   // Direct: send instantly (strum 0, no timing variation). Strum: use slider
   // values.
   int strumMsForCall =
@@ -1364,7 +1521,7 @@ void InputProcessor::processZoneChord(
       lastTriggeredNote = finalNotes.front();
     {
       juce::ScopedWriteLock bufferWriteLock(bufferLock);
-      noteBuffer = finalNotes;
+      noteBuffer.assign(finalNotes.begin(), finalNotes.end());
       bufferedStrumSpeedMs = strumMsForCall;
     }
   }
@@ -1394,24 +1551,27 @@ juce::StringArray InputProcessor::getActiveLayerNames() {
 }
 
 int InputProcessor::getHighestActiveLayerIndex() const {
-  juce::ScopedLock lock(stateLock);
-  for (int i = 8; i >= 0; --i) {
-    if (i == 0 || layerLatchedState[(size_t)i] ||
-        (layerMomentaryCounts[(size_t)i] > 0))
-      return i;
-  }
-  return 0;
+  return loadLayerState()->highestActive;
 }
 
 std::optional<float>
 InputProcessor::getPitchPadRelativeAnchorNormX(uintptr_t deviceHandle,
                                                int layerId, int eventId) const {
+  auto ctx = loadContext();
+  if (!ctx)
+    return std::nullopt;
+  juce::ScopedReadLock rl(mixerStateLock);
   juce::ScopedLock lock(anchorLock);
-  for (const auto &pair : pitchPadRelativeAnchorT) {
-    const auto &key = pair.first;
-    if (std::get<0>(key) == deviceHandle && std::get<1>(key) == layerId &&
-        std::get<2>(key) == eventId)
-      return pair.second;
+  const int slot = touchpadState.findDevice(deviceHandle);
+  if (slot == TouchpadStateTable::kNoValue ||
+      ctx->touchpadMappings.size() != touchpadState.numMappings())
+    return std::nullopt;
+  for (size_t mapIdx = 0; mapIdx < ctx->touchpadMappings.size(); ++mapIdx) {
+    const auto &entry = ctx->touchpadMappings[mapIdx];
+    const size_t row = touchpadState.mappingRow(slot, mapIdx);
+    if (entry.layerId == layerId && entry.eventId == eventId &&
+        touchpadState.mapping.hasPitchAnchor[row])
+      return touchpadState.mapping.pitchAnchorT[row];
   }
   return std::nullopt;
 }
@@ -1420,11 +1580,13 @@ std::vector<int> InputProcessor::getTouchpadMixerStripCCValues(
     uintptr_t deviceHandle, int stripIndex, int numFaders) const {
   std::vector<int> out(static_cast<size_t>(juce::jmax(0, numFaders)), 0);
   juce::ScopedReadLock rl(mixerStateLock);
-  for (int i = 0; i < numFaders; ++i) {
-    auto key = std::make_tuple(deviceHandle, stripIndex, i);
-    auto it = lastTouchpadMixerCCValues.find(key);
-    if (it != lastTouchpadMixerCCValues.end())
-      out[(size_t)i] = it->second;
+  const int slot = touchpadState.findDevice(deviceHandle);
+  const int n = juce::jmin(numFaders, touchpadState.fadersInStrip(stripIndex));
+  for (int i = 0; slot != TouchpadStateTable::kNoValue && i < n; ++i) {
+    const int v = touchpadState.fader.lastCC[touchpadState.faderRow(
+        slot, (size_t)stripIndex, i)];
+    if (v != TouchpadStateTable::kNoValue)
+      out[(size_t)i] = v;
   }
   return out;
 }
@@ -1433,12 +1595,11 @@ std::vector<bool> InputProcessor::getTouchpadMixerStripMuteState(
     uintptr_t deviceHandle, int stripIndex, int numFaders) const {
   std::vector<bool> out(static_cast<size_t>(juce::jmax(0, numFaders)), false);
   juce::ScopedReadLock rl(mixerStateLock);
-  for (int i = 0; i < numFaders; ++i) {
-    auto key = std::make_tuple(deviceHandle, stripIndex, i);
-    auto it = touchpadMixerMuteState.find(key);
-    if (it != touchpadMixerMuteState.end())
-      out[(size_t)i] = it->second;
-  }
+  const int slot = touchpadState.findDevice(deviceHandle);
+  const int n = juce::jmin(numFaders, touchpadState.fadersInStrip(stripIndex));
+  for (int i = 0; slot != TouchpadStateTable::kNoValue && i < n; ++i)
+    out[(size_t)i] = touchpadState.fader.muted[touchpadState.faderRow(
+                         slot, (size_t)stripIndex, i)] != 0;
   return out;
 }
 
@@ -1456,24 +1617,16 @@ InputProcessor::getTouchpadMixerStripState(uintptr_t deviceHandle,
   out.displayValues.resize(static_cast<size_t>(juce::jmax(0, numFaders)), 0);
   out.muted.resize(static_cast<size_t>(juce::jmax(0, numFaders)), false);
   juce::ScopedReadLock rl(mixerStateLock);
-  for (int i = 0; i < numFaders; ++i) {
-    auto key = std::make_tuple(deviceHandle, stripIndex, i);
-    bool isMuted = false;
-    {
-      auto itMute = touchpadMixerMuteState.find(key);
-      if (itMute != touchpadMixerMuteState.end())
-        isMuted = itMute->second;
-    }
+  const int slot = touchpadState.findDevice(deviceHandle);
+  const int n = juce::jmin(numFaders, touchpadState.fadersInStrip(stripIndex));
+  for (int i = 0; slot != TouchpadStateTable::kNoValue && i < n; ++i) {
+    const size_t row = touchpadState.faderRow(slot, (size_t)stripIndex, i);
+    const bool isMuted = touchpadState.fader.muted[row] != 0;
     out.muted[(size_t)i] = isMuted;
-    if (isMuted) {
-      auto itPre = touchpadMixerValueBeforeMute.find(key);
-      if (itPre != touchpadMixerValueBeforeMute.end())
-        out.displayValues[(size_t)i] = itPre->second;
-    } else {
-      auto itLast = lastTouchpadMixerCCValues.find(key);
-      if (itLast != lastTouchpadMixerCCValues.end())
-        out.displayValues[(size_t)i] = itLast->second;
-    }
+    const int v = isMuted ? touchpadState.fader.valueBeforeMute[row]
+                          : touchpadState.fader.lastCC[row];
+    if (v != TouchpadStateTable::kNoValue)
+      out.displayValues[(size_t)i] = v;
   }
   return out;
 }
@@ -1483,11 +1636,7 @@ InputProcessor::getEffectiveContactPositions(
     uintptr_t deviceHandle,
     const std::vector<TouchpadContact> &contacts) const {
   std::vector<EffectiveContactPosition> result;
-  std::shared_ptr<const CompiledMapContext> ctx;
-  {
-    juce::ScopedReadLock rl(mapLock);
-    ctx = activeContext;
-  }
+  auto ctx = loadContext();
   if (!ctx)
     return result;
 
@@ -1535,6 +1684,37 @@ InputProcessor::getEffectiveContactPositions(
   return result;
 }
 
+int InputProcessor::findTouchpadMappingRow(
+    uintptr_t deviceHandle, const TouchpadMappingEntry &entry) const {
+  const int slot = touchpadState.findDevice(deviceHandle);
+  auto ctx = loadContext();
+  if (slot == TouchpadStateTable::kNoValue || !ctx ||
+      ctx->touchpadMappings.size() != touchpadState.numMappings())
+    return -1;
+
+  const auto &mappings = ctx->touchpadMappings;
+  const std::less<const TouchpadMappingEntry *> before;
+  if (!mappings.empty() && !before(&entry, mappings.data()) &&
+      before(&entry, mappings.data() + mappings.size()))
+    return (int)touchpadState.mappingRow(
+        slot, static_cast<size_t>(&entry - mappings.data()));
+
+  // Not one of the compiled entries (caller-built): match on the fields the
+  // mapping's output is identified by.
+  auto ccOrMinusOne = [](const MidiAction &a) {
+    return a.adsrSettings.target == AdsrTarget::CC ? a.adsrSettings.ccNumber
+                                                   : -1;
+  };
+  for (size_t mapIdx = 0; mapIdx < mappings.size(); ++mapIdx) {
+    const auto &m = mappings[mapIdx];
+    if (m.layerId == entry.layerId && m.eventId == entry.eventId &&
+        m.action.channel == entry.action.channel &&
+        ccOrMinusOne(m.action) == ccOrMinusOne(entry.action))
+      return (int)touchpadState.mappingRow(slot, mapIdx);
+  }
+  return -1;
+}
+
 std::optional<float> InputProcessor::getTouchpadMappingValue01(
     uintptr_t deviceHandle, const TouchpadMappingEntry &entry) const {
   if (deviceHandle == 0)
@@ -1549,35 +1729,33 @@ std::optional<float> InputProcessor::getTouchpadMappingValue01(
       (act.adsrSettings.target == AdsrTarget::PitchBend ||
        act.adsrSettings.target == AdsrTarget::SmartScaleBend);
 
-  const int layerId = juce::jlimit(0, 8, entry.layerId);
-  const int eventId = entry.eventId;
-  const int channel = act.channel;
+  juce::ScopedReadLock rl(mixerStateLock);
+  const int row = findTouchpadMappingRow(deviceHandle, entry);
+  if (row < 0)
+    return std::nullopt;
+  const auto &state = touchpadState.mapping;
 
   // SlideToCC: single-CC fader remembers last CC value.
   if (entry.conversionKind == TouchpadConversionKind::SlideToCC && isCC) {
-    auto key = std::make_tuple(deviceHandle, layerId, eventId, channel,
-                               act.adsrSettings.ccNumber);
-    auto it = lastTouchpadSlideCCValues.find(key);
-    if (it == lastTouchpadSlideCCValues.end())
+    const int last = state.lastSlideValue[(size_t)row];
+    if (last == TouchpadStateTable::kNoValue)
       return std::nullopt;
-    int ccVal = juce::jlimit(0, 127, it->second);
+    int ccVal = juce::jlimit(0, 127, last);
     return static_cast<float>(ccVal) / 127.0f;
   }
 
   // EncoderCC: derive value when operating in absolute/NRPN mode.
   if (entry.conversionKind == TouchpadConversionKind::EncoderCC && isCC) {
-    auto keyEnc = std::make_tuple(deviceHandle, layerId, eventId, channel,
-                                  act.adsrSettings.ccNumber);
-    auto it = lastTouchpadEncoderCCValues.find(keyEnc);
-    if (it == lastTouchpadEncoderCCValues.end())
+    const int last = state.lastEncoderValue[(size_t)row];
+    if (last == TouchpadStateTable::kNoValue)
       return std::nullopt;
 
     if (p.encoderOutputMode == 0) {
-      int ccVal = juce::jlimit(0, 127, it->second);
+      int ccVal = juce::jlimit(0, 127, last);
       return static_cast<float>(ccVal) / 127.0f;
     }
     if (p.encoderOutputMode == 2) {
-      int nrpnVal = juce::jlimit(0, 16383, it->second);
+      int nrpnVal = juce::jlimit(0, 16383, last);
       return static_cast<float>(nrpnVal) / 16383.0f;
     }
 
@@ -1586,20 +1764,17 @@ std::optional<float> InputProcessor::getTouchpadMappingValue01(
   }
 
   // Continuous CC/PB, including pitch-pad based mappings.
-  const int ccOrMinusOne = isCC ? act.adsrSettings.ccNumber : -1;
-  auto keyCont = std::make_tuple(deviceHandle, layerId, eventId, channel,
-                                 ccOrMinusOne);
-  auto itCont = lastTouchpadContinuousValues.find(keyCont);
-  if (itCont == lastTouchpadContinuousValues.end())
+  const int last = state.lastContinuousValue[(size_t)row];
+  if (last == TouchpadStateTable::kNoValue)
     return std::nullopt;
 
   if (isCC) {
-    int ccVal = juce::jlimit(0, 127, itCont->second);
+    int ccVal = juce::jlimit(0, 127, last);
     return static_cast<float>(ccVal) / 127.0f;
   }
 
   if (isPitch) {
-    int pbVal = juce::jlimit(0, 16383, itCont->second);
+    int pbVal = juce::jlimit(0, 16383, last);
     return static_cast<float>(pbVal) / 16383.0f;
   }
 
@@ -1618,19 +1793,17 @@ std::optional<float> InputProcessor::getTouchpadPitchSemitoneOffset(
   if (!isPitch)
     return std::nullopt;
 
-  const int layerId = juce::jlimit(0, 8, entry.layerId);
-  const int eventId = entry.eventId;
-  const int channel = act.channel;
-
-  // Pitch-bend values are stored in lastTouchpadContinuousValues with
-  // ccNumber = -1.
-  auto key =
-      std::make_tuple(deviceHandle, layerId, eventId, channel, -1);
-  auto it = lastTouchpadContinuousValues.find(key);
-  if (it == lastTouchpadContinuousValues.end())
+  int last = TouchpadStateTable::kNoValue;
+  {
+    juce::ScopedReadLock rl(mixerStateLock);
+    const int row = findTouchpadMappingRow(deviceHandle, entry);
+    if (row >= 0)
+      last = touchpadState.mapping.lastContinuousValue[(size_t)row];
+  }
+  if (last == TouchpadStateTable::kNoValue)
     return std::nullopt;
 
-  int pbVal = juce::jlimit(0, 16383, it->second);
+  int pbVal = juce::jlimit(0, 16383, last);
 
   int pbRange = juce::jmax(1, settingsManager.getPitchBendRange());
   double stepsPerSemitone = 8192.0 / static_cast<double>(pbRange);
@@ -1640,16 +1813,10 @@ std::optional<float> InputProcessor::getTouchpadPitchSemitoneOffset(
 }
 
 bool InputProcessor::hasManualMappingForKey(int keyCode) {
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  keyCode = InputTypes::gridSlot(keyCode);
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
+  auto ctx = loadContext();
   if (!ctx)
     return false;
 
@@ -1667,7 +1834,7 @@ bool InputProcessor::hasManualMappingForKey(int keyCode) {
             visIt->second[(size_t)i]) {
           const auto &visSlot = (*visIt->second[(size_t)i])[(size_t)keyCode];
           if (visSlot.state != VisualState::Empty &&
-              !visSlot.sourceName.startsWith("Zone: ")) {
+              !ctx->sourceNameFor(visSlot).startsWith("Zone: ")) {
             return true; // Manual mapping found
           }
         }
@@ -1679,16 +1846,10 @@ bool InputProcessor::hasManualMappingForKey(int keyCode) {
 
 std::optional<ActionType> InputProcessor::getMappingType(int keyCode,
                                                          uintptr_t aliasHash) {
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  keyCode = InputTypes::gridSlot(keyCode);
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
+  auto ctx = loadContext();
   if (!ctx)
     return std::nullopt;
 
@@ -1707,13 +1868,13 @@ std::optional<ActionType> InputProcessor::getMappingType(int keyCode,
       if (keyCode >= 0 && keyCode < (int)visGrid->size()) {
         const auto &visSlot = (*visGrid)[(size_t)keyCode];
         if (visSlot.state != VisualState::Empty &&
-            !visSlot.sourceName.startsWith("Zone: ")) {
+            !ctx->sourceNameFor(visSlot).startsWith("Zone: ")) {
           // Found manual mapping - get type from audio grid
           auto grid = ctx->globalGrids[(size_t)i];
           if (grid && keyCode >= 0 && keyCode < (int)grid->size()) {
             const auto &slot = (*grid)[(size_t)keyCode];
             if (slot.isActive)
-              return slot.action.type;
+              return slot.type;
           }
         }
       }
@@ -1724,8 +1885,7 @@ std::optional<ActionType> InputProcessor::getMappingType(int keyCode,
 
 int InputProcessor::getManualMappingCountForKey(int keyCode,
                                                 uintptr_t aliasHash) const {
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  auto ctx = loadContext();
   if (!ctx)
     return 0;
 
@@ -1741,7 +1901,7 @@ int InputProcessor::getManualMappingCountForKey(int keyCode,
       if (keyCode >= 0 && keyCode < (int)visGrid->size()) {
         const auto &visSlot = (*visGrid)[(size_t)keyCode];
         if (visSlot.state != VisualState::Empty &&
-            !visSlot.sourceName.startsWith("Zone: ")) {
+            !ctx->sourceNameFor(visSlot).startsWith("Zone: ")) {
           count++;
         }
       }
@@ -1752,22 +1912,17 @@ int InputProcessor::getManualMappingCountForKey(int keyCode,
 
 void InputProcessor::forceRebuildMappings() {
   rebuildGrid();
+  // The cache only serves the startup rebuild; later ones compile.
+  cacheReadPending = false;
   applySustainDefaultFromPreset();
 }
 
 SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
                                                int keyCode) {
   SimulationResult result;
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
+  auto ctx = loadContext();
   if (!ctx)
     return result;
 
@@ -1775,7 +1930,8 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
     viewDeviceHash = 0;
 
   int genericKey = getGenericKey(keyCode);
-  if (keyCode < 0 || keyCode > 0xFF)
+  keyCode = InputTypes::gridSlot(keyCode);
+  if (keyCode < 0)
     return result;
 
   auto visIt = ctx->visualLookup.find(viewDeviceHash);
@@ -1808,9 +1964,9 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
           if (audioGrid && genericKey < (int)audioGrid->size()) {
             const auto &audioSlot = (*audioGrid)[(size_t)genericKey];
             if (audioSlot.isActive) {
-              result.action = audioSlot.action;
-              result.isZone = genSlot.sourceName.startsWith("Zone: ");
-              result.sourceName = genSlot.sourceName;
+              result.action = ctx->actionFor(audioSlot);
+              result.sourceName = ctx->sourceNameFor(genSlot);
+              result.isZone = result.sourceName.startsWith("Zone: ");
               result.state = genSlot.state;
               result.updateLegacyFields();
               return result;
@@ -1826,9 +1982,9 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
     if (audioGrid && keyCode < (int)audioGrid->size()) {
       const auto &audioSlot = (*audioGrid)[(size_t)keyCode];
       if (audioSlot.isActive) {
-        result.action = audioSlot.action;
-        result.isZone = visSlot.sourceName.startsWith("Zone: ");
-        result.sourceName = visSlot.sourceName;
+        result.action = ctx->actionFor(audioSlot);
+        result.sourceName = ctx->sourceNameFor(visSlot);
+        result.isZone = result.sourceName.startsWith("Zone: ");
         result.state = visSlot.state;
         result.updateLegacyFields();
         return result;
@@ -1842,8 +1998,7 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
 SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
                                                int keyCode, int targetLayerId) {
   SimulationResult result;
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
+  auto ctx = loadContext();
   if (!ctx)
     return result;
 
@@ -1854,7 +2009,8 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
     targetLayerId = 8;
 
   int genericKey = getGenericKey(keyCode);
-  if (keyCode < 0 || keyCode > 0xFF)
+  keyCode = InputTypes::gridSlot(keyCode);
+  if (keyCode < 0)
     return result;
 
   // Find the visual grid for this alias
@@ -1888,9 +2044,9 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
           if (audioGrid && genericKey < (int)audioGrid->size()) {
             const auto &audioSlot = (*audioGrid)[(size_t)genericKey];
             if (audioSlot.isActive) {
-              result.action = audioSlot.action;
-              result.isZone = genSlot.sourceName.startsWith("Zone: ");
-              result.sourceName = genSlot.sourceName;
+              result.action = ctx->actionFor(audioSlot);
+              result.sourceName = ctx->sourceNameFor(genSlot);
+              result.isZone = result.sourceName.startsWith("Zone: ");
               result.state = (i == targetLayerId ? VisualState::Active
                                                  : VisualState::Inherited);
               result.updateLegacyFields();
@@ -1907,9 +2063,9 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
     if (audioGrid && keyCode < (int)audioGrid->size()) {
       const auto &audioSlot = (*audioGrid)[(size_t)keyCode];
       if (audioSlot.isActive) {
-        result.action = audioSlot.action;
-        result.isZone = visSlot.sourceName.startsWith("Zone: ");
-        result.sourceName = visSlot.sourceName;
+        result.action = ctx->actionFor(audioSlot);
+        result.sourceName = ctx->sourceNameFor(visSlot);
+        result.isZone = result.sourceName.startsWith("Zone: ");
         result.state =
             (i == targetLayerId ? VisualState::Active : VisualState::Inherited);
         result.updateLegacyFields();
@@ -1923,12 +2079,14 @@ SimulationResult InputProcessor::simulateInput(uintptr_t viewDeviceHash,
 
 void InputProcessor::handleAxisEvent(uintptr_t deviceHandle, int inputCode,
                                      float value) {
+  inputRecorder.recordAxis(deviceHandle, inputCode, value);
   InputID input = {deviceHandle, inputCode};
-  auto opt = lookupActionInGrid(input);
-  if (!opt || opt->type != ActionType::Expression ||
-      opt->adsrSettings.target != AdsrTarget::CC)
+  const auto settings = settingsManager.getRuntimeSettings();
+  const auto ref = lookupActionInGrid(input);
+  if (!ref || ref->type != ActionType::Expression ||
+      ref->adsrSettings.target != AdsrTarget::CC)
     return;
-  const MidiAction &action = *opt;
+  const MidiAction &action = *ref;
 
   float currentVal = 0.0f;
   // Note: Scroll is now handled as discrete key events (ScrollUp/ScrollDown)
@@ -1951,182 +2109,81 @@ void InputProcessor::handleAxisEvent(uintptr_t deviceHandle, int inputCode,
   int ccValue =
       static_cast<int>(std::round(std::clamp(currentVal, 0.0f, 127.0f)));
 
-  voiceManager.sendCC(action.channel, action.adsrSettings.ccNumber, ccValue);
+  // Coalesced per (device, axis): the first change goes out now, bursts
+  // inside the interval collapse to their newest value.
+  const double flushAtMs = axisCoalescer.push(
+      input, action.channel, action.adsrSettings.ccNumber, ccValue,
+      RealtimeScheduler::nowMs(), (double)settings->axisCoalesceMs);
+  if (flushAtMs != RealtimeScheduler::idle)
+    scheduler->scheduleAt(axisCoalescer, flushAtMs);
 }
 
 bool InputProcessor::hasPointerMappings() {
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
-  juce::ScopedReadLock lock(mapLock);
-  auto ctx = activeContext;
-  if (!ctx)
-    return false;
-
-  // Check for touchpad mappings (Finger1X, Finger1Y, etc.)
-  for (const auto &entry : ctx->touchpadMappings) {
-    if (activeLayersSnapshot[(size_t)entry.layerId]) {
-      // Found at least one touchpad mapping in an active layer
-      return true;
-    }
-  }
-
-  // Check for touchpad mixer layouts (CC faders)
-  for (const auto &strip : ctx->touchpadMixerStrips) {
-    if (activeLayersSnapshot[(size_t)strip.layerId]) {
-      return true;
-    }
-  }
-
-  // Check for touchpad drum pad / harmonic grid layouts
-  for (const auto &strip : ctx->touchpadDrumPadStrips) {
-    if (activeLayersSnapshot[(size_t)strip.layerId]) {
-      return true;
-    }
-  }
-
-  // Check for Chord Pad layouts
-  for (const auto &cp : ctx->touchpadChordPads) {
-    if (activeLayersSnapshot[(size_t)cp.layerId]) {
-      return true;
-    }
-  }
-
-  // Also check for legacy PointerX/PointerY mappings in grids
-  for (int i = 8; i >= 0; --i) {
-    if (!activeLayersSnapshot[(size_t)i])
-      continue;
-
-    auto grid = ctx->globalGrids[(size_t)i];
-    if (!grid)
-      continue;
-
-    // Check for PointerX (0x2000) and PointerY (0x2001)
-    if ((0x2000 < (int)grid->size() && (*grid)[0x2000].isActive) ||
-        (0x2001 < (int)grid->size() && (*grid)[0x2001].isActive)) {
-      return true;
-    }
-  }
-  return false;
+  // Touchpad entries and PointerX/PointerY slots are folded into a per-layer
+  // mask at compile time; no scan per frame.
+  auto ctx = loadContext();
+  return ctx && (ctx->pointerLayerMask & loadLayerState()->activeMask) != 0;
 }
 
 bool InputProcessor::hasTouchpadLayouts() const {
-  juce::ScopedReadLock rl(mapLock);
-  return activeContext &&
-         (!activeContext->touchpadMixerStrips.empty() ||
-          !activeContext->touchpadDrumPadStrips.empty() ||
-          !activeContext->touchpadChordPads.empty());
+  auto ctx = loadContext();
+  return ctx && (!ctx->touchpadMixerStrips.empty() ||
+                 !ctx->touchpadDrumPadStrips.empty() ||
+                 !ctx->touchpadChordPads.empty());
+}
+
+int InputProcessor::prepareTouchpadState(const CompiledMapContext &ctx,
+                                         uintptr_t deviceHandle) {
+  // Steady state: layout and device row block already exist, so a frame
+  // takes no lock and allocates nothing here.
+  if (touchpadState.hasShape(ctx.touchpadMappings.size(),
+                             ctx.touchpadMixerStrips)) {
+    const int slot = touchpadState.findDevice(deviceHandle);
+    if (slot != TouchpadStateTable::kNoValue)
+      return slot;
+  }
+  juce::ScopedWriteLock wl(mixerStateLock);
+  juce::ScopedLock al(anchorLock);
+  if (!touchpadState.hasShape(ctx.touchpadMappings.size(),
+                              ctx.touchpadMixerStrips))
+    touchpadState.setShape(ctx.touchpadMappings.size(),
+                           ctx.touchpadMixerStrips);
+  return touchpadState.addDevice(deviceHandle);
 }
 
 void InputProcessor::processTouchpadContacts(
     uintptr_t deviceHandle, const std::vector<TouchpadContact> &contacts) {
-  if (!settingsManager.isMidiModeActive())
+  inputRecorder.recordTouchpad(deviceHandle, contacts);
+  const auto settings = settingsManager.getRuntimeSettings();
+  if (!settings->midiModeActive)
     return;
 
-  std::array<bool, 9> activeLayersSnapshot{};
-  {
-    juce::ScopedLock sl(stateLock);
-    for (int i = 0; i < 9; ++i)
-      activeLayersSnapshot[(size_t)i] = (i == 0) ||
-                                        layerLatchedState[(size_t)i] ||
-                                        (layerMomentaryCounts[(size_t)i] > 0);
-  }
+  const auto layers = loadLayerState();
+  const auto &activeLayersSnapshot = layers->active;
 
-  std::shared_ptr<const CompiledMapContext> ctx;
-  {
-    juce::ScopedReadLock rl(mapLock);
-    ctx = activeContext;
-  }
+  auto ctx = loadContext();
   if (!ctx)
     return;
 
-  TouchpadPrevState &prev = touchpadPrevState[deviceHandle];
-  bool tip1 = false, tip2 = false;
-  float x1 = 0.0f, y1 = 0.0f, x2 = 0.0f, y2 = 0.0f;
-  // Finger 1/2 are taken by array index (contacts[0], contacts[1]) so that
-  // continuous mappings (e.g. PitchBend on Finger1X) receive updated positions
-  // every frame regardless of driver contactId. The accumulator keeps contact
-  // order stable, so the same physical finger stays at the same index.
-  int idxFinger1 = -1;
-  int idxFinger2 = -1;
-  if (contacts.size() >= 1) {
-    idxFinger1 = 0;
-    tip1 = contacts[0].tipDown;
-    x1 = contacts[0].normX;
-    y1 = contacts[0].normY;
-  }
-  if (contacts.size() >= 2) {
-    idxFinger2 = 1;
-    tip2 = contacts[1].tipDown;
-    x2 = contacts[1].normX;
-    y2 = contacts[1].normY;
-  }
+  const int devSlot = prepareTouchpadState(*ctx, deviceHandle);
+  auto &mapState = touchpadState.mapping;
 
-  float dist = 0.0f, avgX = x1, avgY = y1;
-  if (tip1 && tip2) {
-    float dx = x2 - x1, dy = y2 - y1;
-    dist = std::sqrt(dx * dx + dy * dy);
-    avgX = (x1 + x2) * 0.5f;
-    avgY = (y1 + y2) * 0.5f;
-  }
-
-  bool finger1Down = tip1 && !prev.tip1;
-  bool finger1Up = !tip1 && prev.tip1;
-  bool finger2Down = tip2 && !prev.tip2;
-  bool finger2Up = !tip2 && prev.tip2;
-
-  // Helper: find first layout in touchpadLayoutOrder whose region contains
-  // (nx,ny)
+  // Helper: topmost visible layout whose region contains (nx,ny). Only the
+  // layouts overlapping the point's bucket are tested, in z-order.
+  const auto &layoutIndex = ctx->touchpadLayoutIndex;
+  const auto &layoutVisible = touchpadLayoutVisibility(ctx, layers);
   auto findLayoutForPoint =
       [&](float nx,
           float ny) -> std::optional<std::pair<TouchpadType, size_t>> {
-    for (size_t i = 0; i < ctx->touchpadLayoutOrder.size(); ++i) {
-      const auto &ref = ctx->touchpadLayoutOrder[i];
-      if (ref.type == TouchpadType::Mixer &&
-          ref.index < ctx->touchpadMixerStrips.size()) {
-        const auto &s = ctx->touchpadMixerStrips[ref.index];
-        if (!activeLayersSnapshot[(size_t)s.layerId])
-          continue;
-        int soloGroup =
-            getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, s.layerId));
-        // Hide grouped layouts when no solo is active, or hide non-matching layouts when solo is active
-        if ((soloGroup == 0 && s.layoutGroupId != 0) || (soloGroup > 0 && s.layoutGroupId != soloGroup))
-          continue;
-        if (nx >= s.regionLeft && nx < s.regionRight && ny >= s.regionTop &&
-            ny < s.regionBottom)
-          return {{TouchpadType::Mixer, ref.index}};
-      } else if (ref.type == TouchpadType::DrumPad &&
-                 ref.index < ctx->touchpadDrumPadStrips.size()) {
-        const auto &s = ctx->touchpadDrumPadStrips[ref.index];
-        if (!activeLayersSnapshot[(size_t)s.layerId] || s.numPads <= 0)
-          continue;
-        int soloGroup =
-            getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, s.layerId));
-        // Hide grouped layouts when no solo is active, or hide non-matching layouts when solo is active
-        if ((soloGroup == 0 && s.layoutGroupId != 0) || (soloGroup > 0 && s.layoutGroupId != soloGroup))
-          continue;
-        if (nx >= s.regionLeft && nx < s.regionRight && ny >= s.regionTop &&
-            ny < s.regionBottom)
-          return {{TouchpadType::DrumPad, ref.index}};
-      } else if (ref.type == TouchpadType::ChordPad &&
-                 ref.index < ctx->touchpadChordPads.size()) {
-        const auto &s = ctx->touchpadChordPads[ref.index];
-        if (!activeLayersSnapshot[(size_t)s.layerId])
-          continue;
-        int soloGroup =
-            getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, s.layerId));
-        // Hide grouped layouts when no solo is active, or hide non-matching layouts when solo is active
-        if ((soloGroup == 0 && s.layoutGroupId != 0) || (soloGroup > 0 && s.layoutGroupId != soloGroup))
-          continue;
-        if (nx >= s.regionLeft && nx < s.regionRight && ny >= s.regionTop &&
-            ny < s.regionBottom)
-          return {{TouchpadType::ChordPad, ref.index}};
-      }
+    if (layoutIndex.bucketStart.empty())
+      return std::nullopt;
+    const size_t b = (size_t)TouchpadLayoutIndex::bucketFor(nx, ny);
+    for (uint32_t e = layoutIndex.bucketStart[b];
+         e < layoutIndex.bucketStart[b + 1]; ++e) {
+      const uint32_t i = layoutIndex.bucketEntries[e];
+      const auto &c = layoutIndex.candidates[i];
+      if (layoutVisible[i] && TouchpadLayoutIndex::contains(c, nx, ny))
+        return {{c.type, c.index}};
     }
     return std::nullopt;
   };
@@ -2300,7 +2357,7 @@ void InputProcessor::processTouchpadContacts(
 
       // Layout group solo: apply the same visibility rules as touchpad layouts
       int soloGroup =
-          getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, entry.layerId));
+          layers->touchpadSolo[(size_t)juce::jlimit(0, 8, entry.layerId)];
       if ((soloGroup == 0 && entry.layoutGroupId != 0) ||
           (soloGroup > 0 && entry.layoutGroupId != soloGroup))
         continue;
@@ -2311,20 +2368,15 @@ void InputProcessor::processTouchpadContacts(
         continue;
 
       // Per-mapping finger 1/2 and edge detection
-      auto mapPrevKey = std::make_tuple(deviceHandle, static_cast<int>(mapIdx));
-      bool prevTip1 = false, prevTip2 = false;
-      {
-        auto itPrev = touchpadMappingPrevState.find(mapPrevKey);
-        if (itPrev != touchpadMappingPrevState.end()) {
-          prevTip1 = itPrev->second.tip1;
-          prevTip2 = itPrev->second.tip2;
-        }
-      }
+      const size_t row = touchpadState.mappingRow(devSlot, mapIdx);
+      const bool prevTip1 = mapState.prevTip1[row] != 0;
+      const bool prevTip2 = mapState.prevTip2[row] != 0;
       bool localFinger1Down = local.tip1 && !prevTip1;
       bool localFinger1Up = !local.tip1 && prevTip1;
       bool localFinger2Down = local.tip2 && !prevTip2;
       bool localFinger2Up = !local.tip2 && prevTip2;
-      touchpadMappingPrevState[mapPrevKey] = {local.tip1, local.tip2};
+      mapState.prevTip1[row] = local.tip1;
+      mapState.prevTip2[row] = local.tip2;
 
       bool layoutConsumesLocalFinger1 =
           local.tip1 &&
@@ -2377,7 +2429,6 @@ void InputProcessor::processTouchpadContacts(
 
       const auto &act = entry.action;
       const auto &p = entry.conversionParams;
-      auto key = std::make_tuple(deviceHandle, entry.layerId, entry.eventId);
 
       switch (entry.conversionKind) {
       case TouchpadConversionKind::BoolToGate:
@@ -2393,8 +2444,7 @@ void InputProcessor::processTouchpadContacts(
             continue; // Layout (mixer/drum) owns finger; skip fixed-note mapping
 
           // Track note state: check if note is currently active
-          bool noteIsActive =
-              (touchpadNoteOnSent.find(key) != touchpadNoteOnSent.end());
+          bool noteIsActive = mapState.noteOnSent[row] != 0;
 
           bool releaseThisFrame =
               (entry.eventId == TouchpadEvent::Finger1Down && localFinger1Up) ||
@@ -2410,12 +2460,12 @@ void InputProcessor::processTouchpadContacts(
             if (!noteIsActive) {
               triggerManualNoteOn(touchpadInput, act,
                                   true); // Latch applies to Down
-              touchpadNoteOnSent.insert(key);
+              mapState.noteOnSent[row] = 1;
               
               // If hold behavior is "Ignore, send note off immediately", send note off right away
               if (shouldSendNoteOffImmediately) {
                 triggerManualNoteRelease(touchpadInput, act);
-                touchpadNoteOnSent.erase(key);
+                mapState.noteOnSent[row] = 0;
               }
             }
           } else if (releaseThisFrame && noteIsActive) {
@@ -2424,7 +2474,7 @@ void InputProcessor::processTouchpadContacts(
             if (!shouldSendNoteOffImmediately) {
               triggerManualNoteRelease(touchpadInput, act);
             }
-            touchpadNoteOnSent.erase(key);
+            mapState.noteOnSent[row] = 0;
           } else if ((entry.eventId == TouchpadEvent::Finger1Up || entry.eventId == TouchpadEvent::Finger2Up) && boolVal) {
             // Finger1Up/Finger2Up: trigger note when finger lifts (one-shot);
             // no Send Note Off, Latch only applies to Down so pass false
@@ -2437,9 +2487,10 @@ void InputProcessor::processTouchpadContacts(
             voiceManager.setSustain(true);
           else if (cmd == static_cast<int>(MIDIQy::CommandID::SustainToggle))
             voiceManager.setSustain(!voiceManager.isSustainActive());
-          else if (cmd == static_cast<int>(MIDIQy::CommandID::Panic))
+          else if (cmd == static_cast<int>(MIDIQy::CommandID::Panic)) {
             voiceManager.panic();
-          else if (cmd == static_cast<int>(MIDIQy::CommandID::PanicLatch))
+            axisCoalescer.clear();
+          } else if (cmd == static_cast<int>(MIDIQy::CommandID::PanicLatch))
             voiceManager.panicLatch();
         }
         break;
@@ -2461,7 +2512,7 @@ void InputProcessor::processTouchpadContacts(
                 peakValue = act.adsrSettings.valueWhenOn;
               } else if (act.adsrSettings.target == AdsrTarget::PitchBend) {
                 double stepsPerSemitone =
-                    settingsManager.getStepsPerSemitone();
+                    settings->stepsPerSemitone;
                 peakValue = static_cast<int>(
                     8192.0 + (act.data2 * stepsPerSemitone));
                 peakValue = juce::jlimit(0, 16383, peakValue);
@@ -2474,19 +2525,13 @@ void InputProcessor::processTouchpadContacts(
               }
               expressionEngine.triggerEnvelope(touchpadExprInput, act.channel,
                                                act.adsrSettings, peakValue);
-              touchpadExpressionActive.insert(
-                  std::make_tuple(deviceHandle, entry.layerId, entry.eventId));
+              mapState.expressionActive[row] = 1;
             }
           } else if (isCcTarget) {
             // Latch mode for CC Position: first press sends valueWhenOn,
             // second press sends valueWhenOff, releases do nothing.
             if (boolVal) {
-              auto latchKey =
-                  std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                                  act.channel, act.adsrSettings.ccNumber);
-              const bool currentlyLatched =
-                  touchpadCcLatchedOn.find(latchKey) !=
-                  touchpadCcLatchedOn.end();
+              const bool currentlyLatched = mapState.ccLatchedOn[row] != 0;
 
               const int valueToSend = currentlyLatched
                                           ? act.adsrSettings.valueWhenOff
@@ -2495,10 +2540,7 @@ void InputProcessor::processTouchpadContacts(
               voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber,
                                   valueToSend);
 
-              if (currentlyLatched)
-                touchpadCcLatchedOn.erase(latchKey);
-              else
-                touchpadCcLatchedOn.insert(latchKey);
+              mapState.ccLatchedOn[row] = !currentlyLatched;
             }
           }
         }
@@ -2508,13 +2550,13 @@ void InputProcessor::processTouchpadContacts(
         bool trigger = p.triggerAbove ? above : !above;
         InputID touchpadInput{deviceHandle, 0};
         if (trigger) {
-          if (touchpadNoteOnSent.find(key) == touchpadNoteOnSent.end()) {
-            touchpadNoteOnSent.insert(key);
+          if (!mapState.noteOnSent[row]) {
+            mapState.noteOnSent[row] = 1;
             triggerManualNoteOn(touchpadInput, act);
           }
-        } else {
-          if (touchpadNoteOnSent.erase(key))
-            triggerManualNoteRelease(touchpadInput, act);
+        } else if (mapState.noteOnSent[row]) {
+          mapState.noteOnSent[row] = 0;
+          triggerManualNoteRelease(touchpadInput, act);
         }
         break;
       }
@@ -2541,34 +2583,27 @@ void InputProcessor::processTouchpadContacts(
             break;
           }
 
-          const int ccNumberOrMinusOne =
-              (act.adsrSettings.target == AdsrTarget::CC)
-                  ? act.adsrSettings.ccNumber
-                  : -1;
-          auto keyCont =
-              std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                              act.channel, ccNumberOrMinusOne);
+          int &lastValue = mapState.lastContinuousValue[row];
 
           // If the event is no longer active and we previously sent a value,
           // send the configured release value (for CC) or center pitch (for PB)
           // when requested, then clear the last-value entry so this happens
           // only once.
           if (!eventActive) {
-            auto itLast = lastTouchpadContinuousValues.find(keyCont);
-            if (itLast != lastTouchpadContinuousValues.end()) {
+            if (lastValue != TouchpadStateTable::kNoValue) {
               const bool isPB =
                   (act.adsrSettings.target == AdsrTarget::PitchBend ||
                    act.adsrSettings.target == AdsrTarget::SmartScaleBend);
               if (isPB && entry.touchGlideMs > 0 && act.sendReleaseValue) {
                 // Touch glide: transition to center over duration; timer will send.
-                auto &g = touchpadPitchGlideState[keyCont];
+                auto &g = mapState.pitchGlide[row];
                 g.phase = TouchGlidePhase::GlidingToCenter;
-                g.startValue = itLast->second;
+                g.startValue = lastValue;
                 g.targetValue = 8192;
                 g.startTimeMs = static_cast<uint32_t>(juce::Time::getMillisecondCounter());
                 g.durationMs = entry.touchGlideMs;
-                g.lastSentValue = itLast->second;
-                lastTouchpadContinuousValues.erase(itLast);
+                g.lastSentValue = lastValue;
+                lastValue = TouchpadStateTable::kNoValue;
                 startTouchGlideTimerIfNeeded();
               } else {
                 if (act.sendReleaseValue) {
@@ -2581,7 +2616,7 @@ void InputProcessor::processTouchpadContacts(
                     voiceManager.sendPitchBend(act.channel, 8192);
                   }
                 }
-                lastTouchpadContinuousValues.erase(itLast);
+                lastValue = TouchpadStateTable::kNoValue;
               }
             }
             break;
@@ -2593,6 +2628,7 @@ void InputProcessor::processTouchpadContacts(
           float outVal = static_cast<float>(p.outputMin) +
                          static_cast<float>(p.outputMax - p.outputMin) * t;
           float stepOffset = 0.0f;
+          int bakedPitchBend = -1; // Final PB from the pad table, if baked
 
           // Precompute region-local normalized axis for pitch-pad mappings so
           // runtime matches the visualizer's region-relative bands. This is
@@ -2646,9 +2682,13 @@ void InputProcessor::processTouchpadContacts(
             const PitchPadLayout &layout = p.cachedPitchPadLayout
                                                ? *p.cachedPitchPadLayout
                                                : buildPitchPadLayout(cfg);
-
-            auto relKey = std::make_tuple(deviceHandle, entry.layerId,
-                                          entry.eventId, act.channel);
+            // Compiled entries carry a baked table: one multiply and one
+            // load per sample. The band walk is only for entries without it.
+            const PitchPadTable *table = p.pitchPadTable.get();
+            auto stepAt = [&](float x01) {
+              return table ? table->stepAt(x01)
+                           : mapXToStep(layout, x01).step;
+            };
 
             if (cfg.mode == PitchPadMode::Relative) {
               // Relative mode: anchor point (where user first touches) becomes
@@ -2670,37 +2710,27 @@ void InputProcessor::processTouchpadContacts(
                 // Store anchor X position and the absolute step it maps to.
                 {
                   juce::ScopedLock al(anchorLock);
-                  pitchPadRelativeAnchorT[relKey] = tPitchPad;
-                  float anchorXClamped =
-                      juce::jlimit(0.0f, 1.0f, tPitchPad);
-                  PitchSample anchorSample = mapXToStep(layout, anchorXClamped);
-                  pitchPadRelativeAnchorStep[relKey] = anchorSample.step;
+                  mapState.pitchAnchorT[row] = tPitchPad;
+                  mapState.pitchAnchorStep[row] = stepAt(tPitchPad);
+                  mapState.hasPitchAnchor[row] = 1;
                 }
               }
 
-              float anchorStepVal = 0.0f;
-              bool hasAnchor = false;
-              {
-                juce::ScopedLock al(anchorLock);
-                auto itAnchorStep = pitchPadRelativeAnchorStep.find(relKey);
-                if (itAnchorStep != pitchPadRelativeAnchorStep.end()) {
-                  anchorStepVal = itAnchorStep->second;
-                  hasAnchor = true;
-                }
-              }
+              // Only this thread writes the anchor: no lock needed to read.
+              const bool hasAnchor = mapState.hasPitchAnchor[row] != 0;
+              const float anchorStepVal = mapState.pitchAnchorStep[row];
               if (hasAnchor) {
-                float xClamped = juce::jlimit(0.0f, 1.0f, tPitchPad);
-                PitchSample sample = mapXToStep(layout, xClamped);
-                stepOffset = sample.step - anchorStepVal;
+                stepOffset = stepAt(tPitchPad) - anchorStepVal;
               } else {
                 stepOffset = 0.0f;
               }
             } else {
               // Absolute mode: use normalized coordinate directly. zeroStep is
               // the configured center (currently 0.0f so middle of range).
-              float xClamped = juce::jlimit(0.0f, 1.0f, tPitchPad);
-              PitchSample sample = mapXToStep(layout, xClamped);
-              stepOffset = sample.step - cfg.zeroStep;
+              stepOffset = stepAt(tPitchPad) - cfg.zeroStep;
+              if (table && !table->pitchBend.empty() &&
+                  table->pitchBendRange == settings->pitchBendRange)
+                bakedPitchBend = table->pitchBendAt(tPitchPad);
             }
           } else {
             // No pitch-pad config: fall back to simple linear mapping of the
@@ -2716,17 +2746,14 @@ void InputProcessor::processTouchpadContacts(
           if (act.adsrSettings.target == AdsrTarget::CC) {
             int ccVal =
                 juce::jlimit(0, 127, static_cast<int>(std::round(outVal)));
-            auto itLast = lastTouchpadContinuousValues.find(keyCont);
-            if (itLast != lastTouchpadContinuousValues.end() &&
-                itLast->second == ccVal) {
+            if (lastValue == ccVal)
               break; // No CC change – skip send
-            }
             voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber, ccVal);
-            lastTouchpadContinuousValues[keyCont] = ccVal;
+            lastValue = ccVal;
           } else {
             // Pitch-based targets: interpret the (possibly fractional) step
             // offset and convert to a PB value.
-            int pbRange = juce::jmax(1, settingsManager.getPitchBendRange());
+            int pbRange = juce::jmax(1, settings->pitchBendRange);
             int pbVal = 8192;
 
             if (act.adsrSettings.target == AdsrTarget::SmartScaleBend) {
@@ -2764,13 +2791,15 @@ void InputProcessor::processTouchpadContacts(
                 pbVal = juce::jlimit(0, 16383,
                                      static_cast<int>(std::round(blended)));
               }
+            } else if (bakedPitchBend >= 0) {
+              pbVal = bakedPitchBend; // Absolute pad: baked at compile time
             } else {
               // Standard PitchBend: stepOffset is in semitones. Clamp to global
               // PB range and allow extrapolation up to that range.
               float clampedOffset =
                   juce::jlimit(static_cast<float>(-pbRange),
                                static_cast<float>(pbRange), stepOffset);
-              double stepsPerSemitone = settingsManager.getStepsPerSemitone();
+              double stepsPerSemitone = settings->stepsPerSemitone;
               pbVal = static_cast<int>(std::round(
                   8192.0 +
                   (static_cast<double>(clampedOffset) * stepsPerSemitone)));
@@ -2778,24 +2807,20 @@ void InputProcessor::processTouchpadContacts(
             }
 
             if (entry.touchGlideMs <= 0) {
-              auto itLast = lastTouchpadContinuousValues.find(keyCont);
-              if (itLast != lastTouchpadContinuousValues.end() &&
-                  itLast->second == pbVal) {
+              if (lastValue == pbVal)
                 break; // No PB change – skip send
-              }
               voiceManager.sendPitchBend(act.channel, pbVal);
-              lastTouchpadContinuousValues[keyCont] = pbVal;
+              lastValue = pbVal;
             } else {
               // Touch glide: state machine
               const uint32_t nowMs =
                   static_cast<uint32_t>(juce::Time::getMillisecondCounter());
-              TouchGlideState &g = touchpadPitchGlideState[keyCont];
+              TouchGlideState &g = mapState.pitchGlide[row];
               if (g.phase == TouchGlidePhase::Idle ||
                   g.phase == TouchGlidePhase::GlidingToCenter) {
                 g.phase = TouchGlidePhase::GlidingToFinger;
-                auto itLast = lastTouchpadContinuousValues.find(keyCont);
-                g.startValue = (itLast != lastTouchpadContinuousValues.end())
-                                   ? itLast->second
+                g.startValue = (lastValue != TouchpadStateTable::kNoValue)
+                                   ? lastValue
                                    : 8192;
                 g.targetValue = pbVal;
                 g.startTimeMs = nowMs;
@@ -2824,18 +2849,15 @@ void InputProcessor::processTouchpadContacts(
                 if (output != g.lastSentValue) {
                   voiceManager.sendPitchBend(act.channel, output);
                   g.lastSentValue = output;
-                  lastTouchpadContinuousValues[keyCont] = output;
+                  lastValue = output;
                 }
                 if (progress >= 1.0)
                   g.phase = TouchGlidePhase::FollowingFinger;
               } else if (g.phase == TouchGlidePhase::FollowingFinger) {
-                auto itLast = lastTouchpadContinuousValues.find(keyCont);
-                if (itLast != lastTouchpadContinuousValues.end() &&
-                    itLast->second == pbVal) {
+                if (lastValue == pbVal)
                   break;
-                }
                 voiceManager.sendPitchBend(act.channel, pbVal);
-                lastTouchpadContinuousValues[keyCont] = pbVal;
+                lastValue = pbVal;
                 g.lastSentValue = pbVal;
               }
             }
@@ -2861,13 +2883,12 @@ void InputProcessor::processTouchpadContacts(
       const auto &p = entry.conversionParams;
 
       int soloGroup =
-          getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, entry.layerId));
+          layers->touchpadSolo[(size_t)juce::jlimit(0, 8, entry.layerId)];
       if ((soloGroup == 0 && entry.layoutGroupId != 0) ||
           (soloGroup > 0 && entry.layoutGroupId != soloGroup))
         continue;
-      auto keySlideEnc = std::make_tuple(deviceHandle, entry.layerId,
-          entry.eventId, act.channel, act.adsrSettings.ccNumber);
-      auto entryKey = std::make_tuple(deviceHandle, entry.layerId, entry.eventId);
+      const size_t row = touchpadState.mappingRow(devSlot, mapIdx);
+      int &lastSlideValue = mapState.lastSlideValue[row];
 
       switch (entry.eventId) {
       case TouchpadEvent::Finger1X:
@@ -2897,44 +2918,31 @@ void InputProcessor::processTouchpadContacts(
         bool usePrecision = (p.slideModeFlags & kMixerModeUseFinger1) == 0;
         bool applierDownNow =
             usePrecision ? (active.size() >= 2) : !active.empty();
-        bool prevApplierDown = false;
-        {
-          auto it = touchpadSlideApplierDownPrev.find(entryKey);
-          if (it != touchpadSlideApplierDownPrev.end())
-            prevApplierDown = it->second;
-        }
+        const bool prevApplierDown = mapState.slideApplierDownPrev[row] != 0;
         bool applierDownEdge = applierDownNow && !prevApplierDown;
         bool applierUpEdge = !applierDownNow && prevApplierDown;
-        touchpadSlideApplierDownPrev[entryKey] = applierDownNow;
+        mapState.slideApplierDownPrev[row] = applierDownNow;
 
         // Any new touch cancels an in-progress return-to-rest glide.
-        if (applierDownNow) {
-          auto itGlide = touchpadSlideReturnState.find(
-              std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                              act.channel, act.adsrSettings.ccNumber));
-          if (itGlide != touchpadSlideReturnState.end())
-            touchpadSlideReturnState.erase(itGlide);
-        }
+        if (applierDownNow)
+          mapState.slideReturn[row] = TouchGlideState{};
 
         if (!applierDownNow) {
           // When the controlling finger(s) lift and rest-on-release is enabled,
           // optionally glide the last CC value back to the configured rest
           // value.
           if (applierUpEdge && p.slideReturnOnRelease) {
-            auto itLast = lastTouchpadSlideCCValues.find(keySlideEnc);
-            if (itLast != lastTouchpadSlideCCValues.end()) {
-              const int currentVal = itLast->second;
+            if (lastSlideValue != TouchpadStateTable::kNoValue) {
+              const int currentVal = lastSlideValue;
               const int restVal = juce::jlimit(p.outputMin, p.outputMax,
                                                p.slideRestValue);
               if (currentVal != restVal) {
                 if (p.slideReturnGlideMs <= 0) {
                   voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber,
                                       restVal);
-                  lastTouchpadSlideCCValues[keySlideEnc] = restVal;
+                  lastSlideValue = restVal;
                 } else {
-                  TouchGlideState &g = touchpadSlideReturnState[
-                      std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                                      act.channel, act.adsrSettings.ccNumber)];
+                  TouchGlideState &g = mapState.slideReturn[row];
                   g.phase = TouchGlidePhase::GlidingToCenter;
                   g.startValue = currentVal;
                   g.targetValue = restVal;
@@ -2948,15 +2956,7 @@ void InputProcessor::processTouchpadContacts(
             }
           }
 
-          auto itLock = touchpadSlideLockedContact.find(entryKey);
-          if (itLock != touchpadSlideLockedContact.end())
-            touchpadSlideLockedContact.erase(itLock);
-          for (const auto &pairs : local.inRegion) {
-            auto k = std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                pairs.second->contactId);
-            touchpadSlideContactPrev[k] = {pairs.second->tipDown,
-                pairs.second->normX, pairs.second->normY};
-          }
+          mapState.slideLockedContact[row] = TouchpadStateTable::kNoValue;
           continue;
         }
 
@@ -2965,14 +2965,13 @@ void InputProcessor::processTouchpadContacts(
         float positionX = local.x1;
         float positionY = local.y1;
         if (positionContact && (p.slideModeFlags & kMixerModeLock) != 0) {
-          auto itLock = touchpadSlideLockedContact.find(entryKey);
+          const int lockedContact = mapState.slideLockedContact[row];
           if (applierDownEdge) {
-            touchpadSlideLockedContact[entryKey] = positionContact->contactId;
-          } else if (itLock != touchpadSlideLockedContact.end() &&
-              itLock->second >= 0) {
+            mapState.slideLockedContact[row] = positionContact->contactId;
+          } else if (lockedContact >= 0) {
             bool found = false;
             for (const auto &pairs : active) {
-              if (pairs.second->contactId == itLock->second) {
+              if (pairs.second->contactId == lockedContact) {
                 positionContact = pairs.second;
                 positionX = positionContact->normX;
                 positionY = positionContact->normY;
@@ -2990,15 +2989,8 @@ void InputProcessor::processTouchpadContacts(
                 break;
               }
             }
-            if (!found) {
-              for (const auto &pairs : local.inRegion) {
-                auto k = std::make_tuple(deviceHandle, entry.layerId,
-                    entry.eventId, pairs.second->contactId);
-                touchpadSlideContactPrev[k] = {pairs.second->tipDown,
-                    pairs.second->normX, pairs.second->normY};
-              }
+            if (!found)
               continue; // Locked contact lifted; don't drive from other finger
-            }
           }
         }
 
@@ -3035,27 +3027,19 @@ void InputProcessor::processTouchpadContacts(
         // keep anchor pinned to the nearest window edge so re-entry doesn't jump.
         if (!inWindow) {
           if ((p.slideModeFlags & kMixerModeRelative) != 0) {
-            float &base = touchpadSlideRelativeValue[keySlideEnc];
-            float &anchor = touchpadSlideRelativeAnchor[keySlideEnc];
+            float &base = mapState.slideRelativeValue[row];
+            float &anchor = mapState.slideRelativeAnchor[row];
             if (applierDownEdge) {
-              auto itStored = lastTouchpadSlideCCValues.find(keySlideEnc);
-              if (itStored != lastTouchpadSlideCCValues.end()) {
-                base = static_cast<float>(itStored->second);
+              if (lastSlideValue != TouchpadStateTable::kNoValue) {
+                base = static_cast<float>(lastSlideValue);
               } else {
                 base = static_cast<float>(p.outputMin) +
                        outputRange * tAbs;
-                lastTouchpadSlideCCValues[keySlideEnc] =
-                    static_cast<int>(std::round(base));
+                lastSlideValue = static_cast<int>(std::round(base));
               }
             }
             anchor = posInWindow;
           }
-          for (const auto &pairs : local.inRegion) {
-            auto k = std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                pairs.second->contactId);
-            touchpadSlideContactPrev[k] = {pairs.second->tipDown,
-                pairs.second->normX, pairs.second->normY};
-          }
           continue;
         }
 
@@ -3064,16 +3048,14 @@ void InputProcessor::processTouchpadContacts(
               static_cast<int>(std::round(static_cast<float>(p.outputMin) +
                   outputRange * tAbs)));
         } else {
-          float &base = touchpadSlideRelativeValue[keySlideEnc];
-          float &anchor = touchpadSlideRelativeAnchor[keySlideEnc];
+          float &base = mapState.slideRelativeValue[row];
+          float &anchor = mapState.slideRelativeAnchor[row];
           if (applierDownEdge) {
-            auto itStored = lastTouchpadSlideCCValues.find(keySlideEnc);
-            if (itStored != lastTouchpadSlideCCValues.end()) {
-              base = static_cast<float>(itStored->second);
+            if (lastSlideValue != TouchpadStateTable::kNoValue) {
+              base = static_cast<float>(lastSlideValue);
             } else {
               base = static_cast<float>(p.outputMin) + outputRange * tAbs;
-              lastTouchpadSlideCCValues[keySlideEnc] =
-                  static_cast<int>(std::round(base));
+              lastSlideValue = static_cast<int>(std::round(base));
             }
             anchor = posInWindow;
             skipSendThisFrame = true;
@@ -3090,20 +3072,14 @@ void InputProcessor::processTouchpadContacts(
         // Expression CC Slide produces a value immediately; change-only below
         // avoids duplicates on subsequent frames.
         if (!skipSendThisFrame) {
-          auto itLast = lastTouchpadSlideCCValues.find(keySlideEnc);
           const bool firstTouch =
-              (itLast == lastTouchpadSlideCCValues.end()) || applierDownEdge;
-          if (firstTouch || itLast->second != ccVal) {
+              (lastSlideValue == TouchpadStateTable::kNoValue) ||
+              applierDownEdge;
+          if (firstTouch || lastSlideValue != ccVal) {
             voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber, ccVal);
-            lastTouchpadSlideCCValues[keySlideEnc] = ccVal;
+            lastSlideValue = ccVal;
           }
         }
-        for (const auto &pairs : local.inRegion) {
-          auto k = std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-              pairs.second->contactId);
-          touchpadSlideContactPrev[k] = {pairs.second->tipDown,
-              pairs.second->normX, pairs.second->normY};
-        }
         continue;
       }
     }
@@ -3124,7 +3100,7 @@ void InputProcessor::processTouchpadContacts(
       const auto &p = entry.conversionParams;
 
       int soloGroup =
-          getEffectiveSoloLayoutGroupForLayer(juce::jlimit(0, 8, entry.layerId));
+          layers->touchpadSolo[(size_t)juce::jlimit(0, 8, entry.layerId)];
       if ((soloGroup == 0 && entry.layoutGroupId != 0) ||
           (soloGroup > 0 && entry.layoutGroupId != soloGroup))
         continue;
@@ -3139,9 +3115,7 @@ void InputProcessor::processTouchpadContacts(
           active.push_back(pair);
       }
 
-      auto keyEnc = std::make_tuple(deviceHandle, entry.layerId, entry.eventId,
-                                   act.channel, act.adsrSettings.ccNumber);
-      auto entryKey = std::make_tuple(deviceHandle, entry.layerId, entry.eventId);
+      const size_t row = touchpadState.mappingRow(devSlot, mapIdx);
 
       float posX = 0.0f, posY = 0.0f;
       if (!active.empty()) {
@@ -3156,80 +3130,45 @@ void InputProcessor::processTouchpadContacts(
       int stepCount = 0;
       if (!active.empty() && p.encoderAxis <= 2) {
         const int activeCount = static_cast<int>(active.size());
-        int prevCount = -1;
-        {
-          auto it = touchpadEncoderActiveCount.find(entryKey);
-          if (it != touchpadEncoderActiveCount.end())
-            prevCount = it->second;
-        }
-        touchpadEncoderActiveCount[entryKey] = activeCount;
+        const int prevCount = mapState.encoderActiveCount[row];
+        mapState.encoderActiveCount[row] = activeCount;
         const bool fingerCountChanged = (prevCount >= 0 && prevCount != activeCount);
 
         const float stepScale = 1.0f / (p.encoderSensitivity * kEncoderBaselineMovement);
         float distanceFromAnchor = 0.0f;
-        bool hadAnchor = false;
-
-        if (p.encoderAxis == 0) {
-          float current = 1.0f - posY;
-          if (fingerCountChanged) {
-            touchpadEncoderAnchor[keyEnc] = current;
-            touchpadEncoderLastSentSteps[keyEnc] = 0;
-          }
-          auto itAnchor = touchpadEncoderAnchor.find(keyEnc);
-          if (itAnchor != touchpadEncoderAnchor.end()) {
-            distanceFromAnchor = current - itAnchor->second;
-            hadAnchor = true;
-          } else {
-            touchpadEncoderAnchor[keyEnc] = current;
-          }
-          touchpadEncoderPrevPos[keyEnc] = current;
-        } else if (p.encoderAxis == 1) {
-          float current = posX;
-          if (fingerCountChanged) {
-            touchpadEncoderAnchor[keyEnc] = current;
-            touchpadEncoderLastSentSteps[keyEnc] = 0;
-          }
-          auto itAnchor = touchpadEncoderAnchor.find(keyEnc);
-          if (itAnchor != touchpadEncoderAnchor.end()) {
-            distanceFromAnchor = current - itAnchor->second;
-            hadAnchor = true;
-          } else {
-            touchpadEncoderAnchor[keyEnc] = current;
-          }
-          touchpadEncoderPrevPos[keyEnc] = current;
+        // A finger count change re-anchors (no steps from the jump).
+        const bool hadAnchor =
+            mapState.hasEncoderAnchor[row] != 0 && !fingerCountChanged;
+        if (fingerCountChanged)
+          mapState.encoderLastSentSteps[row] = 0;
+
+        if (p.encoderAxis <= 1) {
+          const float current = (p.encoderAxis == 0) ? 1.0f - posY : posX;
+          if (hadAnchor)
+            distanceFromAnchor = current - mapState.encoderAnchor[row];
+          else
+            mapState.encoderAnchor[row] = current;
         } else {
           float currX = posX, currY = 1.0f - posY;
-          if (fingerCountChanged) {
-            touchpadEncoderAnchorX[keyEnc] = currX;
-            touchpadEncoderAnchorY[keyEnc] = currY;
-            touchpadEncoderLastSentSteps[keyEnc] = 0;
-          }
-          auto itAX = touchpadEncoderAnchorX.find(keyEnc);
-          auto itAY = touchpadEncoderAnchorY.find(keyEnc);
-          if (itAX != touchpadEncoderAnchorX.end() && itAY != touchpadEncoderAnchorY.end()) {
-            float dX = (currX - itAX->second) * static_cast<float>(p.encoderStepSizeX);
-            float dY = (currY - itAY->second) * static_cast<float>(p.encoderStepSizeY);
+          if (hadAnchor) {
+            float dX = (currX - mapState.encoderAnchorX[row]) * static_cast<float>(p.encoderStepSizeX);
+            float dY = (currY - mapState.encoderAnchorY[row]) * static_cast<float>(p.encoderStepSizeY);
             distanceFromAnchor = dX + dY;
-            hadAnchor = true;
           } else {
-            touchpadEncoderAnchorX[keyEnc] = currX;
-            touchpadEncoderAnchorY[keyEnc] = currY;
+            mapState.encoderAnchorX[row] = currX;
+            mapState.encoderAnchorY[row] = currY;
           }
-          touchpadEncoderPrevPosX[keyEnc] = currX;
-          touchpadEncoderPrevPosY[keyEnc] = currY;
         }
+        mapState.hasEncoderAnchor[row] = 1;
 
         if (hadAnchor) {
           if (std::abs(distanceFromAnchor) < p.encoderDeadZone)
             distanceFromAnchor = 0.0f;
           float idealSteps = distanceFromAnchor * stepScale;
           int idealStepsRounded = static_cast<int>(std::round(idealSteps));
-          int lastSent = 0;
-          auto itLast = touchpadEncoderLastSentSteps.find(keyEnc);
-          if (itLast != touchpadEncoderLastSentSteps.end())
-            lastSent = itLast->second;
-          int stepsToSend = idealStepsRounded - lastSent;
-          touchpadEncoderLastSentSteps[keyEnc] = idealStepsRounded;
+          int stepsToSend =
+              idealStepsRounded - mapState.encoderLastSentSteps[row];
+          mapState.encoderLastSentSteps[row] = idealStepsRounded;
           int mult = (p.encoderAxis == 2) ? 1 : p.encoderStepSize;
           stepCount = stepsToSend * mult;
         }
@@ -3237,28 +3176,21 @@ void InputProcessor::processTouchpadContacts(
 
       // Only clear when gesture actually ends (transition from active to empty).
       if (active.empty()) {
-        auto itHad = touchpadEncoderHadActivePrev.find(entryKey);
-        if (itHad != touchpadEncoderHadActivePrev.end() && itHad->second) {
-          touchpadEncoderPrevPos.erase(keyEnc);
-          touchpadEncoderPrevPosX.erase(keyEnc);
-          touchpadEncoderPrevPosY.erase(keyEnc);
-          touchpadEncoderAnchor.erase(keyEnc);
-          touchpadEncoderAnchorX.erase(keyEnc);
-          touchpadEncoderAnchorY.erase(keyEnc);
-          touchpadEncoderLastSentSteps.erase(keyEnc);
-          touchpadEncoderHadActivePrev[entryKey] = false;
-          touchpadEncoderActiveCount.erase(entryKey);
+        if (mapState.encoderHadActivePrev[row]) {
+          mapState.hasEncoderAnchor[row] = 0;
+          mapState.encoderLastSentSteps[row] = 0;
+          mapState.encoderHadActivePrev[row] = 0;
+          mapState.encoderActiveCount[row] = TouchpadStateTable::kNoValue;
         }
       } else {
-        touchpadEncoderHadActivePrev[entryKey] = true;
+        mapState.encoderHadActivePrev[row] = 1;
       }
 
       if (stepCount != 0) {
         if (p.encoderOutputMode == 0) {
-          int currentVal = p.encoderInitialValue;
-          auto it = lastTouchpadEncoderCCValues.find(keyEnc);
-          if (it != lastTouchpadEncoderCCValues.end())
-            currentVal = it->second;
+          int currentVal = mapState.lastEncoderValue[row];
+          if (currentVal == TouchpadStateTable::kNoValue)
+            currentVal = p.encoderInitialValue;
           currentVal += stepCount;
           if (p.encoderWrap) {
             while (currentVal > p.outputMax) currentVal -= (p.outputMax - p.outputMin + 1);
@@ -3267,7 +3199,7 @@ void InputProcessor::processTouchpadContacts(
             currentVal = juce::jlimit(p.outputMin, p.outputMax, currentVal);
           }
           voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber, currentVal);
-          lastTouchpadEncoderCCValues[keyEnc] = currentVal;
+          mapState.lastEncoderValue[row] = currentVal;
         } else if (p.encoderOutputMode == 1) {
           int n = juce::jlimit(-63, 63, stepCount);
           int ccVal = 64;
@@ -3291,10 +3223,9 @@ void InputProcessor::processTouchpadContacts(
           ccVal = juce::jlimit(0, 127, ccVal);
           voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber, ccVal);
         } else if (p.encoderOutputMode == 2) {
-          int currentVal = 8192;
-          auto it = lastTouchpadEncoderCCValues.find(keyEnc);
-          if (it != lastTouchpadEncoderCCValues.end())
-            currentVal = it->second;
+          int currentVal = mapState.lastEncoderValue[row];
+          if (currentVal == TouchpadStateTable::kNoValue)
+            currentVal = 8192;
           currentVal += stepCount * 128;
           currentVal = juce::jlimit(0, 16383, currentVal);
           int nrpnMsb = (p.encoderNRPNNumber >> 7) & 0x7F;
@@ -3303,27 +3234,22 @@ void InputProcessor::processTouchpadContacts(
           voiceManager.sendCC(act.channel, 98, nrpnLsb);
           voiceManager.sendCC(act.channel, 6, (currentVal >> 7) & 0x7F);
           voiceManager.sendCC(act.channel, 38, currentVal & 0x7F);
-          lastTouchpadEncoderCCValues[keyEnc] = currentVal;
+          mapState.lastEncoderValue[row] = currentVal;
         }
       }
 
       bool pushActive = (p.encoderPushDetection == 0 && active.size() >= 2) ||
                         (p.encoderPushDetection == 1 && active.size() >= 3);
-      bool pushPrev = false;
-      {
-        auto it = touchpadEncoderPushPrev.find(entryKey);
-        if (it != touchpadEncoderPushPrev.end())
-          pushPrev = it->second;
-      }
-      touchpadEncoderPushPrev[entryKey] = pushActive;
+      const bool pushPrev = mapState.encoderPushPrev[row] != 0;
+      mapState.encoderPushPrev[row] = pushActive;
       bool pushEdgeOn = pushActive && !pushPrev;
       bool pushEdgeOff = !pushActive && pushPrev;
 
       if (p.encoderPushMode != 0) {
         if (pushEdgeOn) {
           if (p.encoderPushMode == 2) {
-            bool &on = touchpadEncoderPushOn[entryKey];
-            on = !on;
+            const bool on = !mapState.encoderPushOn[row];
+            mapState.encoderPushOn[row] = on;
             if (p.encoderPushOutputType == 0) {
               voiceManager.sendCC(p.encoderPushChannel, p.encoderPushCCNumber,
                                  on ? p.encoderPushValue : 0);
@@ -3400,7 +3326,11 @@ void InputProcessor::processTouchpadContacts(
       }
 
       bool usePrecision = (strip.modeFlags & kMixerModeUseFinger1) == 0;
-      auto stripKey = std::make_tuple(deviceHandle, static_cast<int>(stripIdx));
+      const size_t stripRow = touchpadState.stripRow(devSlot, stripIdx);
+      auto faderRow = [&](int fader) {
+        return touchpadState.faderRow(devSlot, stripIdx, fader);
+      };
+      auto &faders = touchpadState.fader;
 
       // Region lock: when strip has regionLock, clamp position to region bounds
       auto getEffectivePos = [&](int contactId, float nx,
@@ -3419,32 +3349,38 @@ void InputProcessor::processTouchpadContacts(
         return {ex, ey};
       };
 
+      // Effective Y of each contact in the strip, for next frame's fader-exit
+      // position (Free relative mode).
+      auto rememberContacts = [&]() {
+        auto *prevContacts = touchpadState.stripContacts(stripRow);
+        int n = 0;
+        for (const auto &p : inRegion) {
+          if (n == TouchpadStateTable::kMaxStripContacts)
+            break;
+          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
+                                          p.second->normY);
+          juce::ignoreUnused(ex);
+          prevContacts[n++] = {p.second->contactId, ey};
+        }
+        for (; n < TouchpadStateTable::kMaxStripContacts; ++n)
+          prevContacts[n] = {};
+      };
+
       // Precision: applier (finger2) is considered down iff we have 2+ active
       // contacts. Track this per-strip so finger2 down/up edges are reliable
       // even when we early-out (active.size() < 2).
       bool applierDownNow =
           usePrecision ? (active.size() >= 2) : !active.empty();
-      bool prevApplierDownNow = false;
-      {
-        auto itPrev = touchpadMixerApplierDownPrev.find(stripKey);
-        if (itPrev != touchpadMixerApplierDownPrev.end())
-          prevApplierDownNow = itPrev->second;
-      }
+      const bool prevApplierDownNow =
+          touchpadState.strip.applierDownPrev[stripRow] != 0;
       bool applierDownEdge = applierDownNow && !prevApplierDownNow;
-      touchpadMixerApplierDownPrev[stripKey] = applierDownNow;
+      touchpadState.strip.applierDownPrev[stripRow] = applierDownNow;
 
       if (!applierDownNow) {
-        auto itLock = touchpadMixerLockedFader.find(stripKey);
-        if (itLock != touchpadMixerLockedFader.end())
-          touchpadMixerLockedFader.erase(itLock);
-        touchpadMixerLastFaderIndex.erase(stripKey);
-        for (const auto &p : inRegion) {
-          auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                   p.second->contactId);
-          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                          p.second->normY);
-          touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-        }
+        touchpadState.strip.lockedFader[stripRow] = TouchpadStateTable::kNoValue;
+        touchpadState.strip.lastFaderIndex[stripRow] =
+            TouchpadStateTable::kNoValue;
+        rememberContacts();
         continue;
       }
 
@@ -3463,9 +3399,16 @@ void InputProcessor::processTouchpadContacts(
 
       // In Precision: first finger drives value; second finger only enables.
       // In Quick: first finger = only finger, drives value.
-      auto prevPositionKey = std::make_tuple(
-          deviceHandle, static_cast<int>(stripIdx), positionContact->contactId);
-      auto itPrevPosition = touchpadMixerContactPrev.find(prevPositionKey);
+      std::optional<float> prevPositionY;
+      {
+        const auto *prevContacts = touchpadState.stripContacts(stripRow);
+        for (int i = 0; i < TouchpadStateTable::kMaxStripContacts; ++i) {
+          if (prevContacts[i].contactId == positionContact->contactId) {
+            prevPositionY = prevContacts[i].y;
+            break;
+          }
+        }
+      }
 
       // First finger position drives fader index and CC value (both modes)
       float localX = (positionX - strip.regionLeft) * strip.invRegionWidth;
@@ -3479,14 +3422,12 @@ void InputProcessor::processTouchpadContacts(
       if (faderIndex >= N)
         faderIndex = N - 1;
 
-      auto lockKey = stripKey;
       if ((strip.modeFlags & kMixerModeLock) != 0) {
-        auto itLock = touchpadMixerLockedFader.find(lockKey);
-        if (applierDownEdge) {
-          touchpadMixerLockedFader[lockKey] = faderIndex;
-        } else if (itLock != touchpadMixerLockedFader.end()) {
-          faderIndex = itLock->second;
-        }
+        int &lockedFader = touchpadState.strip.lockedFader[stripRow];
+        if (applierDownEdge)
+          lockedFader = faderIndex;
+        else if (lockedFader != TouchpadStateTable::kNoValue)
+          faderIndex = lockedFader;
       }
 
       // Mute: first finger dictates which fader; second finger down = apply
@@ -3500,17 +3441,11 @@ void InputProcessor::processTouchpadContacts(
         int col = static_cast<int>(sx * static_cast<float>(N));
         if (col >= N)
           col = N - 1;
-        auto muteKey =
-            std::make_tuple(deviceHandle, static_cast<int>(stripIdx), col);
-        bool &muted = touchpadMixerMuteState[muteKey];
-        if (!muted) {
-          auto lastKey =
-              std::make_tuple(deviceHandle, static_cast<int>(stripIdx), col);
-          auto itLast = lastTouchpadMixerCCValues.find(lastKey);
-          if (itLast != lastTouchpadMixerCCValues.end())
-            touchpadMixerValueBeforeMute[muteKey] = itLast->second;
-        }
-        muted = !muted;
+        const size_t colRow = faderRow(col);
+        const bool muted = !faders.muted[colRow];
+        if (muted && faders.lastCC[colRow] != TouchpadStateTable::kNoValue)
+          faders.valueBeforeMute[colRow] = faders.lastCC[colRow];
+        faders.muted[colRow] = muted;
         touchpadMixerStateChanged = true;
         int ccNum = strip.ccStart + col;
         voiceManager.sendCC(strip.midiChannel, ccNum, muted ? 0 : 64);
@@ -3519,32 +3454,12 @@ void InputProcessor::processTouchpadContacts(
       // Fader area: finger in mute zone must not drive fader.
       if ((strip.modeFlags & kMixerModeMuteButtons) != 0 &&
           localY >= kMuteButtonRegionTop) {
-        for (const auto &p : inRegion) {
-          auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                   p.second->contactId);
-          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                          p.second->normY);
-          touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-        }
+        rememberContacts();
         continue;
       }
 
-      auto muteKey =
-          std::make_tuple(deviceHandle, static_cast<int>(stripIdx), faderIndex);
-      bool isMuted = false;
-      {
-        auto itMute = touchpadMixerMuteState.find(muteKey);
-        if (itMute != touchpadMixerMuteState.end())
-          isMuted = itMute->second;
-      }
-      if (isMuted) {
-        for (const auto &p : inRegion) {
-          auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                   p.second->contactId);
-          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                          p.second->normY);
-          touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-        }
+      if (faders.muted[faderRow(faderIndex)]) {
+        rememberContacts();
         continue;
       }
 
@@ -3572,16 +3487,12 @@ void InputProcessor::processTouchpadContacts(
         // Relative: finger2 down = anchor (starting position). Finger1 movement
         // from anchor => delta => fader value. Free mode: on fader switch,
         // apply to old fader then set anchor at entry point for new fader.
-        auto relKey = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                      faderIndex);
-        int lastFader = -1;
-        {
-          auto itLF = touchpadMixerLastFaderIndex.find(stripKey);
-          if (itLF != touchpadMixerLastFaderIndex.end())
-            lastFader = itLF->second;
-        }
-        float &base = touchpadMixerRelativeValue[relKey];
-        float &anchor = touchpadMixerRelativeAnchor[relKey];
+        int &lastFaderIndex = touchpadState.strip.lastFaderIndex[stripRow];
+        const int lastFader = lastFaderIndex;
+        const size_t relRow = faderRow(faderIndex);
+        float &base = faders.relativeValue[relRow];
+        float &anchor = faders.relativeAnchor[relRow];
+        int &storedCC = faders.lastCC[relRow];
         auto normYToEffectiveClamped = [&](float ny) -> float {
           float ly = (ny - strip.regionTop) * strip.invRegionHeight;
           ly = std::clamp(ly, 0.0f, 1.0f);
@@ -3593,33 +3504,26 @@ void InputProcessor::processTouchpadContacts(
           // Finger2 down: establish anchor/base only. Do NOT emit CC this frame.
           // Base should be the current fader value; prefer last-sent CC if we
           // have it, otherwise fall back to value-under-finger.
-          auto faderKey = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                          faderIndex);
-          auto itStored = lastTouchpadMixerCCValues.find(faderKey);
-          if (itStored != lastTouchpadMixerCCValues.end()) {
-            base = static_cast<float>(itStored->second);
+          if (storedCC != TouchpadStateTable::kNoValue) {
+            base = static_cast<float>(storedCC);
           } else {
             base = static_cast<float>(strip.outputMin) + outputRange * t;
             // Seed last value so we don't immediately send on the next frame
             // when delta is still 0.
-            lastTouchpadMixerCCValues[faderKey] =
-                static_cast<int>(std::round(base));
+            storedCC = static_cast<int>(std::round(base));
           }
           anchor = effectiveYClamped;
-          touchpadMixerLastFaderIndex[stripKey] = faderIndex;
+          lastFaderIndex = faderIndex;
           skipSendThisFrame = true;
         } else if ((strip.modeFlags & kMixerModeLock) == 0 && lastFader >= 0 &&
                    lastFader != faderIndex) {
           // Free mode: switched fader. Apply to old fader (value at exit), then
           // set anchor at entry for new fader.
-          float exitY = itPrevPosition != touchpadMixerContactPrev.end()
-                            ? itPrevPosition->second.y
-                            : positionY;
+          float exitY = prevPositionY.value_or(positionY);
           float exitEffectiveY = normYToEffectiveClamped(exitY);
-          auto oldRelKey = std::make_tuple(
-              deviceHandle, static_cast<int>(stripIdx), lastFader);
-          float oldBase = touchpadMixerRelativeValue[oldRelKey];
-          float oldAnchor = touchpadMixerRelativeAnchor[oldRelKey];
+          const size_t oldRow = faderRow(lastFader);
+          float oldBase = faders.relativeValue[oldRow];
+          float oldAnchor = faders.relativeAnchor[oldRow];
           float deltaY = exitEffectiveY - oldAnchor;
           float oldVal = oldBase - deltaY * strip.invInputRange * outputRange;
           oldVal = std::clamp(oldVal, static_cast<float>(strip.outputMin),
@@ -3627,28 +3531,22 @@ void InputProcessor::processTouchpadContacts(
           int oldCc = static_cast<int>(std::round(oldVal));
           voiceManager.sendCC(strip.midiChannel, strip.ccStart + lastFader,
                               oldCc);
-          lastTouchpadMixerCCValues[std::make_tuple(
-              deviceHandle, static_cast<int>(stripIdx), lastFader)] = oldCc;
+          faders.lastCC[oldRow] = oldCc;
           touchpadMixerStateChanged = true;
 
           // Entering a new fader: establish anchor/base only. Do NOT emit CC
           // for the new fader until finger1 moves.
-          auto newFaderKey = std::make_tuple(deviceHandle,
-                                             static_cast<int>(stripIdx),
-                                             faderIndex);
-          auto itStored = lastTouchpadMixerCCValues.find(newFaderKey);
-          if (itStored != lastTouchpadMixerCCValues.end()) {
-            base = static_cast<float>(itStored->second);
+          if (storedCC != TouchpadStateTable::kNoValue) {
+            base = static_cast<float>(storedCC);
           } else {
             base = static_cast<float>(strip.outputMin) + outputRange * t;
-            lastTouchpadMixerCCValues[newFaderKey] =
-                static_cast<int>(std::round(base));
+            storedCC = static_cast<int>(std::round(base));
           }
           anchor = effectiveYClamped; // entry point for new fader
-          touchpadMixerLastFaderIndex[stripKey] = faderIndex;
+          lastFaderIndex = faderIndex;
           skipSendThisFrame = true;
         } else {
-          touchpadMixerLastFaderIndex[stripKey] = faderIndex;
+          lastFaderIndex = faderIndex;
           float deltaY = effectiveYClamped - anchor;
           float val = base - deltaY * strip.invInputRange * outputRange;
           val = std::clamp(val, static_cast<float>(strip.outputMin),
@@ -3658,42 +3556,21 @@ void InputProcessor::processTouchpadContacts(
       }
 
       if (skipSendThisFrame) {
-        for (const auto &p : inRegion) {
-          auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                   p.second->contactId);
-          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                          p.second->normY);
-          touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-        }
+        rememberContacts();
         continue;
       }
 
       int ccNum = strip.ccStart + faderIndex;
-      auto lastKey =
-          std::make_tuple(deviceHandle, static_cast<int>(stripIdx), faderIndex);
-      auto itLast = lastTouchpadMixerCCValues.find(lastKey);
-      if (itLast != lastTouchpadMixerCCValues.end() &&
-          itLast->second == ccVal) {
-        for (const auto &p : inRegion) {
-          auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                   p.second->contactId);
-          auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                          p.second->normY);
-          touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-        }
+      int &lastCC = faders.lastCC[faderRow(faderIndex)];
+      if (lastCC == ccVal) {
+        rememberContacts();
         continue;
       }
       voiceManager.sendCC(strip.midiChannel, ccNum, ccVal);
-      lastTouchpadMixerCCValues[lastKey] = ccVal;
+      lastCC = ccVal;
       touchpadMixerStateChanged = true;
 
-      for (const auto &p : inRegion) {
-        auto k = std::make_tuple(deviceHandle, static_cast<int>(stripIdx),
-                                 p.second->contactId);
-        auto [ex, ey] = getEffectivePos(p.second->contactId, p.second->normX,
-                                        p.second->normY);
-        touchpadMixerContactPrev[k] = {p.second->tipDown, ex, ey};
-      }
+      rememberContacts();
     }
     if (touchpadMixerStateChanged) {
       int64_t now = juce::Time::getMillisecondCounter();
@@ -4202,158 +4079,137 @@ void InputProcessor::processTouchpadContacts(
     }
   }
 
-  // Release touchpad Expression envelopes when no mapping with this
-  // (layerId, eventId) has its local finger still active (per-mapping finger
-  // counting).
-  for (auto it = touchpadExpressionActive.begin();
-       it != touchpadExpressionActive.end();) {
-    uintptr_t dev = std::get<0>(*it);
-    int layerId = std::get<1>(*it);
-    int evId = std::get<2>(*it);
-    bool fingerActive = false;
-    if (dev == deviceHandle && ctx && !ctx->touchpadMappings.empty()) {
-      for (size_t mapIdx = 0; mapIdx < ctx->touchpadMappings.size();
-           ++mapIdx) {
-        const auto &entry = ctx->touchpadMappings[mapIdx];
-        if (entry.layerId != layerId ||
-            static_cast<int>(entry.eventId) != evId)
-          continue;
-        MappingLocalState local = buildMappingContactList(entry, mapIdx);
-        if ((evId == TouchpadEvent::Finger1Down && local.tip1) ||
-            (evId == TouchpadEvent::Finger1Up && !local.tip1) ||
-            (evId == TouchpadEvent::Finger2Down && local.tip2) ||
-            (evId == TouchpadEvent::Finger2Up && !local.tip2)) {
-          fingerActive = true;
-          break;
-        }
-      }
-    } else if (dev != deviceHandle) {
-      fingerActive = true; // other device: keep entry
-    }
-    if (!fingerActive) {
-      // For Expression CC, send release value when finger lifts. When ADSR is
-      // off (fast path) no envelope is in ExpressionEngine so releaseEnvelope
-      // does nothing; sending here is the only way to get value-when-off.
-      for (const auto &entry : ctx->touchpadMappings) {
-        if (entry.layerId == layerId &&
-            static_cast<int>(entry.eventId) == evId &&
-            entry.action.type == ActionType::Expression &&
-            entry.action.adsrSettings.target == AdsrTarget::CC &&
-            entry.action.sendReleaseValue) {
-          voiceManager.sendCC(entry.action.channel,
-                              entry.action.adsrSettings.ccNumber,
-                              entry.action.releaseValue);
-          break;
-        }
-      }
-      expressionEngine.releaseEnvelope(InputID{dev, evId});
-      it = touchpadExpressionActive.erase(it);
-    } else {
-      ++it;
+  // Release touchpad Expression envelopes when the mapping's local finger is
+  // no longer active (per-mapping finger counting).
+  for (size_t mapIdx = 0; mapIdx < ctx->touchpadMappings.size(); ++mapIdx) {
+    const size_t row = touchpadState.mappingRow(devSlot, mapIdx);
+    if (!mapState.expressionActive[row])
+      continue;
+    const auto &entry = ctx->touchpadMappings[mapIdx];
+    const int evId = static_cast<int>(entry.eventId);
+    MappingLocalState local = buildMappingContactList(entry, mapIdx);
+    const bool fingerActive =
+        (evId == TouchpadEvent::Finger1Down && local.tip1) ||
+        (evId == TouchpadEvent::Finger1Up && !local.tip1) ||
+        (evId == TouchpadEvent::Finger2Down && local.tip2) ||
+        (evId == TouchpadEvent::Finger2Up && !local.tip2);
+    if (fingerActive)
+      continue;
+    // For Expression CC, send release value when finger lifts. When ADSR is
+    // off (fast path) no envelope is in ExpressionEngine so releaseEnvelope
+    // does nothing; sending here is the only way to get value-when-off.
+    if (entry.action.type == ActionType::Expression &&
+        entry.action.adsrSettings.target == AdsrTarget::CC &&
+        entry.action.sendReleaseValue) {
+      voiceManager.sendCC(entry.action.channel,
+                          entry.action.adsrSettings.ccNumber,
+                          entry.action.releaseValue);
     }
+    expressionEngine.releaseEnvelope(InputID{deviceHandle, evId});
+    mapState.expressionActive[row] = 0;
   }
-
-  prev.tip1 = tip1;
-  prev.tip2 = tip2;
-  prev.x1 = x1;
-  prev.y1 = y1;
-  prev.x2 = x2;
-  prev.y2 = y2;
 }
 
-void InputProcessor::startTouchGlideTimerIfNeeded() {
-  for (const auto &kv : touchpadPitchGlideState) {
-    if (kv.second.phase == TouchGlidePhase::GlidingToCenter) {
-      if (!isTimerRunning())
-        startTimer(5);
-      return;
-    }
+const std::vector<uint8_t> &InputProcessor::touchpadLayoutVisibility(
+    const std::shared_ptr<const CompiledMapContext> &ctx,
+    const std::shared_ptr<const LayerStateSnapshot> &layers) {
+  if (ctx == touchpadLayoutMaskCtx && layers == touchpadLayoutMaskLayers)
+    return touchpadLayoutVisible;
+  const auto &candidates = ctx->touchpadLayoutIndex.candidates;
+  touchpadLayoutVisible.resize(candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const auto &c = candidates[i];
+    const int soloGroup = layers->touchpadSolo[(size_t)c.layerId];
+    // Hide grouped layouts when no solo is active, or hide non-matching
+    // layouts when solo is active
+    const bool soloHidden = (soloGroup == 0 && c.layoutGroupId != 0) ||
+                            (soloGroup > 0 && c.layoutGroupId != soloGroup);
+    touchpadLayoutVisible[i] =
+        layers->active[(size_t)c.layerId] && !soloHidden ? 1 : 0;
   }
-  for (const auto &kv : touchpadSlideReturnState) {
-    if (kv.second.phase == TouchGlidePhase::GlidingToCenter) {
-      if (!isTimerRunning())
-        startTimer(5);
-      return;
-    }
+  touchpadLayoutMaskCtx = ctx;
+  touchpadLayoutMaskLayers = layers;
+  return touchpadLayoutVisible;
+}
+
+bool InputProcessor::hasReturningTouchGlide() const {
+  const auto &state = touchpadState.mapping;
+  for (size_t row = 0; row < state.pitchGlide.size(); ++row) {
+    if (state.pitchGlide[row].phase == TouchGlidePhase::GlidingToCenter ||
+        state.slideReturn[row].phase == TouchGlidePhase::GlidingToCenter)
+      return true;
   }
+  return false;
+}
+
+void InputProcessor::startTouchGlideTimerIfNeeded() {
+  if (!isTimerRunning() && hasReturningTouchGlide())
+    startTimer(5);
 }
 
 void InputProcessor::stopTouchGlideTimerIfIdle() {
-  for (const auto &kv : touchpadPitchGlideState) {
-    if (kv.second.phase == TouchGlidePhase::GlidingToCenter)
-      return;
-  }
-  for (const auto &kv : touchpadSlideReturnState) {
-    if (kv.second.phase == TouchGlidePhase::GlidingToCenter)
-      return;
-  }
-  stopTimer();
+  if (!hasReturningTouchGlide())
+    stopTimer();
 }
 
 void InputProcessor::timerCallback() {
   const uint32_t nowMs =
       static_cast<uint32_t>(juce::Time::getMillisecondCounter());
-  std::vector<TouchpadPitchGlideKey> toRemove;
-  for (auto &kv : touchpadPitchGlideState) {
-    if (kv.second.phase != TouchGlidePhase::GlidingToCenter)
-      continue;
-    TouchGlideState &g = kv.second;
-    double progress = (g.durationMs > 0)
-        ? std::min(1.0, static_cast<double>(nowMs - g.startTimeMs) /
-                            static_cast<double>(g.durationMs))
-        : 1.0;
-    int output = juce::jlimit(
-        0, 16383,
-        static_cast<int>(std::round(
-            g.startValue + progress * (8192 - g.startValue))));
-    if (output != g.lastSentValue) {
-      int ch = std::get<3>(kv.first);
-      voiceManager.sendPitchBend(ch, output);
-      g.lastSentValue = output;
-    }
-    if (progress >= 1.0) {
-      int ch = std::get<3>(kv.first);
-      voiceManager.sendPitchBend(ch, 8192);
-      lastTouchpadContinuousValues.erase(kv.first);
-      toRemove.push_back(kv.first);
-    }
+  auto ctx = loadContext();
+  auto &state = touchpadState.mapping;
+  const size_t numMappings = touchpadState.numMappings();
+  if (!ctx || ctx->touchpadMappings.size() != numMappings) {
+    stopTimer();
+    return;
   }
-  for (const auto &k : toRemove)
-    touchpadPitchGlideState.erase(k);
 
-  // Slide CC: glide back to rest value when configured.
-  std::vector<TouchpadSlideReturnKey> slideToRemove;
-  for (auto &kv : touchpadSlideReturnState) {
-    if (kv.second.phase != TouchGlidePhase::GlidingToCenter)
-      continue;
-    TouchGlideState &g = kv.second;
-    double progress = (g.durationMs > 0)
-        ? std::min(1.0, static_cast<double>(nowMs - g.startTimeMs) /
-                            static_cast<double>(g.durationMs))
-        : 1.0;
-    const int target = g.targetValue;
-    int output = juce::jlimit(
-        0, 127,
-        static_cast<int>(std::round(
-            g.startValue + progress * (target - g.startValue))));
-    if (output != g.lastSentValue) {
-      int ch = std::get<3>(kv.first);
-      int cc = std::get<4>(kv.first);
-      voiceManager.sendCC(ch, cc, output);
-      g.lastSentValue = output;
-      // Keep slide CC last-value map in sync so future gestures pick up from
-      // the latest value.
-      auto slideKey = std::make_tuple(std::get<0>(kv.first),
-                                      std::get<1>(kv.first),
-                                      std::get<2>(kv.first), ch, cc);
-      lastTouchpadSlideCCValues[slideKey] = output;
+  for (size_t row = 0; row < state.pitchGlide.size(); ++row) {
+    const auto &act = ctx->touchpadMappings[row % numMappings].action;
+
+    TouchGlideState &g = state.pitchGlide[row];
+    if (g.phase == TouchGlidePhase::GlidingToCenter) {
+      double progress = (g.durationMs > 0)
+          ? std::min(1.0, static_cast<double>(nowMs - g.startTimeMs) /
+                              static_cast<double>(g.durationMs))
+          : 1.0;
+      int output = juce::jlimit(
+          0, 16383,
+          static_cast<int>(std::round(
+              g.startValue + progress * (8192 - g.startValue))));
+      if (output != g.lastSentValue) {
+        voiceManager.sendPitchBend(act.channel, output);
+        g.lastSentValue = output;
+      }
+      if (progress >= 1.0) {
+        voiceManager.sendPitchBend(act.channel, 8192);
+        state.lastContinuousValue[row] = TouchpadStateTable::kNoValue;
+        g = TouchGlideState{};
+      }
     }
-    if (progress >= 1.0) {
-      slideToRemove.push_back(kv.first);
+
+    // Slide CC: glide back to rest value when configured.
+    TouchGlideState &r = state.slideReturn[row];
+    if (r.phase == TouchGlidePhase::GlidingToCenter) {
+      double progress = (r.durationMs > 0)
+          ? std::min(1.0, static_cast<double>(nowMs - r.startTimeMs) /
+                              static_cast<double>(r.durationMs))
+          : 1.0;
+      const int target = r.targetValue;
+      int output = juce::jlimit(
+          0, 127,
+          static_cast<int>(std::round(
+              r.startValue + progress * (target - r.startValue))));
+      if (output != r.lastSentValue) {
+        voiceManager.sendCC(act.channel, act.adsrSettings.ccNumber, output);
+        r.lastSentValue = output;
+        // Keep slide CC last value in sync so future gestures pick up from
+        // the latest value.
+        state.lastSlideValue[row] = output;
+      }
+      if (progress >= 1.0)
+        r = TouchGlideState{};
     }
   }
-  for (const auto &k : slideToRemove)
-    touchpadSlideReturnState.erase(k);
 
   stopTouchGlideTimerIfIdle();
 }
\ No newline at end of file
@@ -1,19 +1,23 @@
 #pragma once
+#include "AxisCoalescer.h"
 #include "DeviceManager.h"
 #include "ExpressionEngine.h"
+#include "InputRecording.h"
 #include "MappingCompiler.h"
 #include "MappingTypes.h"
 #include "PresetManager.h"
 #include "RhythmAnalyzer.h"
 #include "TouchpadLayoutManager.h"
+#include "TouchpadStateTable.h"
 #include "TouchpadTypes.h"
 #include "VoiceManager.h"
 #include "ZoneManager.h"
 #include <JuceHeader.h>
+#include <array>
 #include <atomic>
-#include <map>
+#include <memory>
 #include <optional>
-#include <set>
+#include <span>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -36,15 +40,6 @@ struct Tuple3Hash {
 };
 class Zone;
 
-// Phase 40.1: ordering for std::set<InputID>
-struct InputIDLess {
-  bool operator()(const InputID &a, const InputID &b) const {
-    if (a.deviceHandle != b.deviceHandle)
-      return a.deviceHandle < b.deviceHandle;
-    return a.keyCode < b.keyCode;
-  }
-};
-
 class MidiEngine;
 class SettingsManager;
 
@@ -77,7 +72,32 @@ public:
   // "Touchpad" alias).
   bool hasTouchpadLayouts() const;
 
+  // Borrowed view of a compiled action. Pins the context generation the
+  // action was found in, so the reference stays valid while the view lives
+  // (one event) even if a rebuild publishes a new context meanwhile. Copying
+  // or destroying a view never allocates.
+  class ActionRef {
+  public:
+    ActionRef() = default;
+    ActionRef(std::shared_ptr<const CompiledMapContext> ctx,
+              const MidiAction *action)
+        : context(std::move(ctx)), action(action) {}
+
+    explicit operator bool() const { return action != nullptr; }
+    const MidiAction &operator*() const { return *action; }
+    const MidiAction *operator->() const { return action; }
+
+  private:
+    std::shared_ptr<const CompiledMapContext> context;
+    const MidiAction *action = nullptr;
+  };
+
+  // Hot-path lookup: the action the grid maps input to, without copying it.
+  ActionRef findMappingForInput(InputID input) const;
+
   // Phase 41.3: Return copy by value to avoid dangling pointer after unlock
+  // (for callers that keep the action beyond the event; prefer
+  // findMappingForInput otherwise)
   std::optional<MidiAction> getMappingForInput(InputID input);
 
   // Simulate input and return action with source description (Phase 39: returns
@@ -94,6 +114,10 @@ public:
   // Zone management
   ZoneManager &getZoneManager() { return zoneManager; }
 
+  // Captures every event reaching the three input entry points while started
+  // (for headless replay / latency benchmarks).
+  InputRecorder &getInputRecorder() { return inputRecorder; }
+
   // Run one ExpressionEngine timer tick (for benchmarks only).
   void runExpressionEngineOneTick();
 
@@ -190,6 +214,16 @@ public:
   // Phase 42: Two-stage init – call after object graph is built
   void initialize();
 
+  // Persistent compiled-context cache (stored next to autoload.xml). Set it
+  // before initialize(): the first context is then built by the next
+  // forceRebuildMappings() (startup), from the file when the session it was
+  // written for is unchanged. Later full rebuilds of an unchanged session
+  // (e.g. the load's change messages) are skipped.
+  void setContextCacheFile(const juce::File &file);
+  // Compile the current session into the cache file unless it is already
+  // current. Call when the session is saved for good (e.g. on shutdown).
+  void saveContextCache();
+
   // Test support: number of times rebuildGrid() has been called (for asserting
   // recompile on dependency change).
   int getRebuildCountForTest() const { return rebuildCount_.load(); }
@@ -209,17 +243,53 @@ private:
   TouchpadLayoutManager &touchpadLayoutManager;
   ExpressionEngine expressionEngine;
   SettingsManager &settingsManager;
+  InputRecorder inputRecorder;
+
+  // Axis -> CC rate limiting (RuntimeSettings::axisCoalesceMs); held values
+  // are flushed on the shared scheduler thread.
+  AxisCoalescer axisCoalescer{[this](int channel, int ccNumber, int value) {
+    voiceManager.sendCC(channel, ccNumber, value);
+  }};
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
 
   // Thread Safety
-  juce::ReadWriteLock mapLock;
+  juce::ReadWriteLock mapLock; // currentCCValues only
   juce::ReadWriteLock bufferLock;
   juce::ReadWriteLock
-      mixerStateLock; // Touchpad mixer state only (reduces contention)
-  mutable juce::CriticalSection stateLock; // Phase 53.7: layer state only
+      mixerStateLock; // Touchpad layout state + touchpadState layout/mixer
+  mutable juce::CriticalSection stateLock; // Phase 53.7: layer state writers
+
+  // Phase 50.5 / 52.1: Grid-based compiled context (audio + visuals).
+  // RCU-style publication: rebuildGrid() builds a new context off to the side
+  // and swaps it in atomically; readers take a shared_ptr copy and keep the
+  // old generation alive until they are done with it. Readers take no mutex,
+  // though std::atomic<shared_ptr> itself is not guaranteed lock-free.
+  std::atomic<std::shared_ptr<const CompiledMapContext>> activeContext;
+
+  // Immutable view of layer activity and effective solo groups, derived from
+  // the mutable state below. Writers mutate under stateLock and then call
+  // publishLayerState(); the input and touchpad paths only ever load this
+  // snapshot, so they never contend on stateLock.
+  struct LayerStateSnapshot {
+    std::array<bool, 9> active{};      // Layer 0 always true
+    std::array<int, 9> keyboardSolo{}; // Effective keyboard solo per layer
+    std::array<int, 9> touchpadSolo{}; // Effective touchpad solo per layer
+    int keyboardSoloGlobal = 0;
+    int touchpadSoloGlobal = 0;
+    int highestActive = 0;
+    uint16_t activeMask = 0; // Bit i set when active[i]
+  };
+  std::atomic<std::shared_ptr<const LayerStateSnapshot>> layerStateSnapshot;
 
-  // Phase 50.5 / 52.1: Grid-based compiled context (audio + visuals). Protected
-  // by mapLock.
-  std::shared_ptr<const CompiledMapContext> activeContext;
+  // Rebuild layerStateSnapshot from the mutable layer/solo state. Takes
+  // stateLock (re-entrant, so callers may already hold it).
+  void publishLayerState();
+  std::shared_ptr<const LayerStateSnapshot> loadLayerState() const {
+    return layerStateSnapshot.load(std::memory_order_acquire);
+  }
+  std::shared_ptr<const CompiledMapContext> loadContext() const {
+    return activeContext.load(std::memory_order_acquire);
+  }
 
   // Phase 53.2: Layer state – Latched (persistent) vs Momentary (ref count).
   std::vector<bool> layerLatchedState; // 9 elements, from preset / Toggle/Solo
@@ -242,13 +312,13 @@ private:
   // Momentary layer chain: track which keys hold which layer (for Phantom Key)
   std::unordered_map<InputID, int>
       momentaryLayerHolds; // InputID -> target layer 0-8
+  // Mirrors !momentaryLayerHolds.empty() so key-up can skip stateLock.
+  std::atomic<bool> hasMomentaryLayerHolds{false};
 
   // Helper: Layer 0 always active; else active if latched or momentary count >
   // 0
   bool isLayerActive(int layerIdx) const;
 
-  // Phase 40.1: currently held keys for state reconstruction
-  std::set<InputID, InputIDLess> currentlyHeldKeys;
   bool updateLayerState(); // returns true if momentary state changed
 
   // Note buffer for Strum mode (for visualizer; strum is triggered on key
@@ -270,60 +340,40 @@ private:
   // Current CC values for relative inputs (scroll)
   std::unordered_map<InputID, float> currentCCValues;
 
-  // Touchpad continuous CC/PB: last sent value per (device, layer, eventId,
-  // channel, ccNumber/-1 for PB) to avoid spamming identical values when held.
-  std::map<std::tuple<uintptr_t, int, int, int, int>, int>
-      lastTouchpadContinuousValues;
-
   // Track last triggered note for SmartScaleBend
   int lastTriggeredNote = 60; // Default to middle C
 
-  // Relative-mode pitch-pad state: per-gesture anchor X and anchor step, keyed
-  // by (deviceHandle, layerId, eventId, channel) so multiple mappings for the
-  // same touchpad event do not interfere. Protected by anchorLock.
+  // Guards the relative pitch-pad anchor columns of touchpadState (read by
+  // the visualizer via getPitchPadRelativeAnchorNormX).
   mutable juce::CriticalSection anchorLock;
-  std::map<std::tuple<uintptr_t, int, int, int>, float> pitchPadRelativeAnchorT;
-  std::map<std::tuple<uintptr_t, int, int, int>, float>
-      pitchPadRelativeAnchorStep;
 
   // Rhythm analyzer for adaptive glide (Phase 26.1)
   RhythmAnalyzer rhythmAnalyzer;
 
-  // Touchpad: previous state per device for edge detection (Finger Down/Up)
-  struct TouchpadPrevState {
-    bool tip1 = false;
-    bool tip2 = false;
-    float x1 = 0.0f, y1 = 0.0f, x2 = 0.0f, y2 = 0.0f;
-  };
-  std::unordered_map<uintptr_t, TouchpadPrevState> touchpadPrevState;
-
-  // Touch glide: smooth transition on touch/release for touchpad PitchBend.
-  // Key = (deviceHandle, layerId, eventId, channel, -1) same as lastTouchpadContinuousValues.
-  enum class TouchGlidePhase { Idle, GlidingToFinger, FollowingFinger, GlidingToCenter };
-  struct TouchGlideState {
-    TouchGlidePhase phase = TouchGlidePhase::Idle;
-    int startValue = 8192;
-    int targetValue = 8192;
-    uint32_t startTimeMs = 0;
-    int durationMs = 0;
-    int lastSentValue = -1;
-  };
-  using TouchpadPitchGlideKey = std::tuple<uintptr_t, int, int, int, int>;
-  std::map<TouchpadPitchGlideKey, TouchGlideState> touchpadPitchGlideState;
-  using TouchpadSlideReturnKey = std::tuple<uintptr_t, int, int, int, int>;
-  std::map<TouchpadSlideReturnKey, TouchGlideState> touchpadSlideReturnState;
+  // Per-(device, compiled mapping/strip) touchpad runtime state: finger edges,
+  // last sent values, glides, slide/encoder/mixer state. Shape changes and new
+  // device row blocks are made under mixerStateLock (write).
+  TouchpadStateTable touchpadState;
+  // Sizes touchpadState for ctx and returns the device's slot (input thread).
+  int prepareTouchpadState(const CompiledMapContext &ctx,
+                           uintptr_t deviceHandle);
+  // Row of the compiled mapping `entry` refers to (by address, else by
+  // layer/event/channel/target match), or -1. Caller holds mixerStateLock.
+  int findTouchpadMappingRow(uintptr_t deviceHandle,
+                             const TouchpadMappingEntry &entry) const;
+  // Visible flag per touchpadLayoutIndex candidate for the current layer and
+  // solo state (touchpad input thread only). Recomputed only when the
+  // context or layer snapshot it was built from changes.
+  std::vector<uint8_t> touchpadLayoutVisible;
+  std::shared_ptr<const CompiledMapContext> touchpadLayoutMaskCtx;
+  std::shared_ptr<const LayerStateSnapshot> touchpadLayoutMaskLayers;
+  const std::vector<uint8_t> &
+  touchpadLayoutVisibility(const std::shared_ptr<const CompiledMapContext> &ctx,
+                           const std::shared_ptr<const LayerStateSnapshot> &layers);
+  bool hasReturningTouchGlide() const;
   void startTouchGlideTimerIfNeeded();
   void stopTouchGlideTimerIfIdle();
 
-  // Continuous->Note: track whether note is currently "on" per (device,
-  // layerId, eventId) to send note off
-  std::set<std::tuple<uintptr_t, int, int>> touchpadNoteOnSent;
-  // Touchpad BoolToCC Expression: active envelopes to release when finger lifts
-  std::set<std::tuple<uintptr_t, int, int>> touchpadExpressionActive;
-  // Touchpad BoolToCC Expression (CC Position): latched-on state per
-  // (deviceHandle, layerId, eventId, channel, ccNumber) when using
-  // CcReleaseBehavior::AlwaysLatch.
-  std::set<std::tuple<uintptr_t, int, int, int, int>> touchpadCcLatchedOn;
   // Per-contact mapping lock: when a contact first touches inside a mapping's
   // region and that mapping has regionLock, we assign the contact to that
   // mapping for the rest of the gesture. (deviceHandle, contactId) -> index
@@ -331,94 +381,11 @@ private:
   // sees only contacts in its region or locked to it (like layouts).
   std::unordered_map<std::tuple<uintptr_t, int>, size_t, Tuple2Hash>
       contactMappingLock;
-  // Per-mapping prev tip state for edge detection (Finger1Down/Up etc.).
-  // Key = (deviceHandle, mapIdx). Cleared on grid rebuild.
-  struct TouchpadMappingPrevState {
-    bool tip1 = false;
-    bool tip2 = false;
-  };
-  std::unordered_map<std::tuple<uintptr_t, int>, TouchpadMappingPrevState,
-                    Tuple2Hash>
-      touchpadMappingPrevState;
-
-  // Touchpad mixer: per-strip per-contact prev state for edge detection
-  struct TouchpadContactPrev {
-    bool tipDown = false;
-    float x = 0.0f, y = 0.0f;
-  };
-  std::unordered_map<std::tuple<uintptr_t, int, int>, TouchpadContactPrev,
-                    Tuple3Hash>
-      touchpadMixerContactPrev;
-
   // Region lock: (deviceHandle, contactId) -> (TouchpadType, stripIndex)
   std::unordered_map<std::tuple<uintptr_t, int>, std::pair<TouchpadType, size_t>,
                     Tuple2Hash>
       contactLayoutLock;
 
-  // Touchpad mixer strips: lock mode (device, stripIndex) -> locked fader index
-  // (-1 = none). unordered_map for O(1) lookups.
-  std::unordered_map<std::tuple<uintptr_t, int>, int, Tuple2Hash>
-      touchpadMixerLockedFader;
-  // Touchpad mixer: per-strip applier (finger2) down state for edge detection.
-  // Needed so Precision mode can detect finger2 down/up even when we have <2
-  // active contacts (where the main mixer processing early-outs).
-  std::unordered_map<std::tuple<uintptr_t, int>, bool, Tuple2Hash>
-      touchpadMixerApplierDownPrev;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, float, Tuple3Hash>
-      touchpadMixerRelativeValue;
-  // Relative mode: anchor Y (effectiveYClamped) when gesture started or entered fader
-  std::unordered_map<std::tuple<uintptr_t, int, int>, float, Tuple3Hash>
-      touchpadMixerRelativeAnchor;
-  // (device, stripIdx) -> last fader index for free-mode switch detection (-1 = none)
-  std::unordered_map<std::tuple<uintptr_t, int>, int, Tuple2Hash>
-      touchpadMixerLastFaderIndex;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, bool, Tuple3Hash>
-      touchpadMixerMuteState;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, int, Tuple3Hash>
-      lastTouchpadMixerCCValues;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, int, Tuple3Hash>
-      touchpadMixerValueBeforeMute;
-
-  // SlideToCC: last sent CC, relative base/anchor, locked contact, contact prev
-  std::map<std::tuple<uintptr_t, int, int, int, int>, int>
-      lastTouchpadSlideCCValues;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadSlideRelativeValue;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadSlideRelativeAnchor;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, int, Tuple3Hash>
-      touchpadSlideLockedContact; // (device, layerId, eventId) -> contactId or -1
-  std::map<std::tuple<uintptr_t, int, int, int>, TouchpadContactPrev>
-      touchpadSlideContactPrev;
-  std::unordered_map<std::tuple<uintptr_t, int, int>, bool, Tuple3Hash>
-      touchpadSlideApplierDownPrev;
-
-  // EncoderCC: rotation state (device, layerId, eventId, channel, ccNumber)
-  std::map<std::tuple<uintptr_t, int, int, int, int>, int>
-      lastTouchpadEncoderCCValues;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderPrevPos;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderPrevPosX;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderPrevPosY;
-  // EncoderCC: anchor (gesture start) and cumulative steps sent (distance-based)
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderAnchor;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderAnchorX;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, float>
-      touchpadEncoderAnchorY;
-  std::map<std::tuple<uintptr_t, int, int, int, int>, int>
-      touchpadEncoderLastSentSteps;
-  // EncoderCC push state (device, layerId, eventId)
-  std::map<std::tuple<uintptr_t, int, int>, bool> touchpadEncoderPushOn;
-  std::map<std::tuple<uintptr_t, int, int>, bool> touchpadEncoderPushPrev;
-  // EncoderCC: had active contacts last frame (only clear prev on transition to empty)
-  std::map<std::tuple<uintptr_t, int, int>, bool> touchpadEncoderHadActivePrev;
-  // EncoderCC: previous active finger count; when it changes we re-anchor to avoid spurious steps (e.g. 2→1 on release)
-  std::map<std::tuple<uintptr_t, int, int>, int> touchpadEncoderActiveCount;
-
   // Drum pad / Harmonic grid: active notes per (deviceHandle, stripIdx,
   // contactId). Value stores InputID and padIndex so we can send note off when
   // finger moves outside or to a different pad.
@@ -458,6 +425,19 @@ private:
   // Test support: incremented in rebuildGrid()
   mutable std::atomic<int> rebuildCount_{0};
 
+  // Compiled-context cache (message thread only). cacheFileKey: key the
+  // file was last read or written with this session (0 = unknown).
+  // cacheReadPending: the startup rebuild has not happened yet.
+  // liveContextKey: key of the session the live context was fully compiled
+  // from (0 = unknown, e.g. after an incremental rebuild).
+  juce::File contextCacheFile;
+  juce::uint64 cacheFileKey = 0;
+  juce::uint64 liveContextKey = 0;
+  bool cacheReadPending = false;
+  juce::uint64 contextCacheKey();
+  // Full context for session `key` from the cache file, or null on a miss.
+  std::shared_ptr<const CompiledMapContext> compileFromCache(juce::uint64 key);
+
   // ValueTree Callbacks
   void valueTreeChildAdded(juce::ValueTree &parentTree,
                            juce::ValueTree &child) override;
@@ -467,7 +447,14 @@ private:
                                 const juce::Identifier &property) override;
 
   // Helpers
-  void rebuildGrid();
+  void rebuildGrid(); // Full rebuild
+  void rebuildGrid(const MappingCompiler::Scope &scope);
+  // Scope for a changed/added/removed Mapping node (layer + alias).
+  MappingCompiler::Scope scopeForMappingChange(const juce::ValueTree &mapping,
+                                               int layerId,
+                                               bool aliasOrLayerChanged) const;
+  void resetTouchpadRuntimeState(const CompiledMapContext *previous);
+  void resetLayerStateFromPreset();
 
   // Sustain default/cleanup: called on init and when sustain-related mappings
   // change
@@ -475,7 +462,7 @@ private:
 
   // Phase 52.1: Grid lookup for getMappingForInput / handleAxisEvent (replaces
   // findMapping)
-  std::optional<MidiAction> lookupActionInGrid(InputID input) const;
+  ActionRef lookupActionInGrid(InputID input) const;
 
   // Velocity randomization helper
   int calculateVelocity(int base, int range);
@@ -489,9 +476,15 @@ private:
   void triggerManualNoteRelease(InputID id, const MidiAction &act);
 
   // Phase 50.5: Zone processing helpers (extract complex zone logic)
-  void processZoneNote(InputID input, std::shared_ptr<Zone> zone,
+  // Zone chord -> notes and per-note velocities (ghost scaling, strum ghost
+  // notes) in caller-provided fixed buffers; returns the note count.
+  size_t fillZoneChordVoicing(
+      const Zone &zone, const Zone::TransposedChord &chord,
+      std::array<int, Zone::TransposedChord::kMaxNotes> &notes,
+      std::array<int, Zone::TransposedChord::kMaxNotes> &velocities);
+  void processZoneNote(InputID input, const std::shared_ptr<Zone> &zone,
                        const MidiAction &action);
-  void processZoneChord(InputID input, std::shared_ptr<Zone> zone,
+  void processZoneChord(InputID input, const std::shared_ptr<Zone> &zone,
                         const std::vector<MidiAction> &chordActions,
                         const MidiAction &rootAction);
 
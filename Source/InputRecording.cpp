@@ -0,0 +1,200 @@
+#include "InputRecording.h"
+#include "InputProcessor.h"
+
+namespace {
+constexpr int kMagic = 0x5249514D; // "MQIR" little-endian
+// Serialized record sizes (all fields fixed width).
+constexpr juce::int64 kEventBytes = 8 + 8 + 4 + 4 + 4 + 2 + 1 + 1;
+constexpr juce::int64 kContactBytes = 4 + 4 + 4 + 4 + 4 + 1;
+} // namespace
+
+void InputRecording::writeTo(juce::OutputStream &out) const {
+  out.writeInt(kMagic);
+  out.writeInt(kVersion);
+  out.writeInt((int)events.size());
+  out.writeInt((int)contacts.size());
+  for (const auto &e : events) {
+    out.writeDouble(e.timeMs);
+    out.writeInt64((juce::int64)e.device);
+    out.writeInt(e.code);
+    out.writeFloat(e.value);
+    out.writeInt((int)e.firstContact);
+    out.writeShort((short)e.numContacts);
+    out.writeByte((char)e.kind);
+    out.writeByte(e.isDown ? 1 : 0);
+  }
+  for (const auto &c : contacts) {
+    out.writeInt(c.contactId);
+    out.writeInt(c.x);
+    out.writeInt(c.y);
+    out.writeFloat(c.normX);
+    out.writeFloat(c.normY);
+    out.writeByte(c.tipDown ? 1 : 0);
+  }
+}
+
+bool InputRecording::readFrom(juce::InputStream &in) {
+  clear();
+  if (in.readInt() != kMagic || in.readInt() != kVersion)
+    return false;
+  const int numEvents = in.readInt();
+  const int numContacts = in.readInt();
+  if (numEvents < 0 || numContacts < 0)
+    return false;
+  // Reject truncated captures before allocating for them.
+  if (in.getTotalLength() >= 0 &&
+      in.getNumBytesRemaining() <
+          numEvents * kEventBytes + numContacts * kContactBytes)
+    return false;
+
+  events.resize((size_t)numEvents);
+  for (auto &e : events) {
+    e.timeMs = in.readDouble();
+    e.device = (uintptr_t)in.readInt64();
+    e.code = in.readInt();
+    e.value = in.readFloat();
+    e.firstContact = (uint32_t)in.readInt();
+    e.numContacts = (uint16_t)in.readShort();
+    const int kind = (int)(uint8_t)in.readByte();
+    e.isDown = in.readByte() != 0;
+    if (kind > (int)Kind::Touchpad ||
+        (size_t)e.firstContact + e.numContacts > (size_t)numContacts) {
+      clear();
+      return false;
+    }
+    e.kind = (Kind)kind;
+  }
+  contacts.resize((size_t)numContacts);
+  for (auto &c : contacts) {
+    c.contactId = in.readInt();
+    c.x = in.readInt();
+    c.y = in.readInt();
+    c.normX = in.readFloat();
+    c.normY = in.readFloat();
+    c.tipDown = in.readByte() != 0;
+  }
+  return true;
+}
+
+bool InputRecording::saveToFile(const juce::File &file) const {
+  file.deleteFile();
+  juce::FileOutputStream out(file);
+  if (!out.openedOk())
+    return false;
+  writeTo(out);
+  out.flush();
+  return out.getStatus().wasOk();
+}
+
+bool InputRecording::loadFromFile(const juce::File &file) {
+  juce::FileInputStream in(file);
+  if (!in.openedOk()) {
+    clear();
+    return false;
+  }
+  return readFrom(in);
+}
+
+// --- InputRecorder ---
+
+void InputRecorder::start() {
+  juce::ScopedLock sl(lock);
+  data.clear();
+  startMs = juce::Time::getMillisecondCounterHiRes();
+  recording.store(true, std::memory_order_relaxed);
+}
+
+InputRecording InputRecorder::stop() {
+  juce::ScopedLock sl(lock);
+  recording.store(false, std::memory_order_relaxed);
+  InputRecording out;
+  std::swap(out, data);
+  return out;
+}
+
+InputRecording::Event &InputRecorder::append(InputRecording::Kind kind,
+                                             uintptr_t device) {
+  auto &e = data.events.emplace_back();
+  e.timeMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+  e.kind = kind;
+  e.device = device;
+  return e;
+}
+
+void InputRecorder::recordKey(uintptr_t device, int keyCode, bool isDown) {
+  if (!isRecording())
+    return;
+  juce::ScopedLock sl(lock);
+  if (!isRecording())
+    return;
+  auto &e = append(InputRecording::Kind::Key, device);
+  e.code = keyCode;
+  e.isDown = isDown;
+}
+
+void InputRecorder::recordAxis(uintptr_t device, int inputCode, float value) {
+  if (!isRecording())
+    return;
+  juce::ScopedLock sl(lock);
+  if (!isRecording())
+    return;
+  auto &e = append(InputRecording::Kind::Axis, device);
+  e.code = inputCode;
+  e.value = value;
+}
+
+void InputRecorder::recordTouchpad(
+    uintptr_t device, const std::vector<TouchpadContact> &contacts) {
+  if (!isRecording())
+    return;
+  juce::ScopedLock sl(lock);
+  if (!isRecording())
+    return;
+  auto &e = append(InputRecording::Kind::Touchpad, device);
+  e.firstContact = (uint32_t)data.contacts.size();
+  e.numContacts = (uint16_t)std::min<size_t>(contacts.size(), 0xFFFF);
+  data.contacts.insert(data.contacts.end(), contacts.begin(),
+                       contacts.begin() + e.numContacts);
+}
+
+// --- InputReplayer ---
+
+namespace InputReplayer {
+
+void dispatch(const InputRecording &recording, size_t index,
+              InputProcessor &proc, std::vector<TouchpadContact> &frame) {
+  const auto &e = recording.events[index];
+  switch (e.kind) {
+  case InputRecording::Kind::Key:
+    proc.processEvent(InputID{e.device, e.code}, e.isDown);
+    break;
+  case InputRecording::Kind::Axis:
+    proc.handleAxisEvent(e.device, e.code, e.value);
+    break;
+  case InputRecording::Kind::Touchpad: {
+    const auto first = recording.contacts.begin() + e.firstContact;
+    frame.assign(first, first + e.numContacts);
+    proc.processTouchpadContacts(e.device, frame);
+    break;
+  }
+  }
+}
+
+void replay(const InputRecording &recording, InputProcessor &proc,
+            bool paced) {
+  std::vector<TouchpadContact> frame;
+  const double t0 = juce::Time::getMillisecondCounterHiRes();
+  for (size_t i = 0; i < recording.events.size(); ++i) {
+    if (paced) {
+      const double due = t0 + recording.events[i].timeMs;
+      for (double now = juce::Time::getMillisecondCounterHiRes(); now < due;
+           now = juce::Time::getMillisecondCounterHiRes()) {
+        if (due - now > 2.0)
+          juce::Thread::sleep((int)(due - now) - 1);
+      }
+    }
+    dispatch(recording, i, proc, frame);
+  }
+}
+
+} // namespace InputReplayer
@@ -0,0 +1,89 @@
+#pragma once
+#include "TouchpadTypes.h"
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+class InputProcessor;
+
+// Timestamped capture of the input stream reaching InputProcessor
+// (processEvent, handleAxisEvent, processTouchpadContacts). Stored as a
+// compact little-endian binary file so real performances can be replayed
+// headless, without RawInputManager, for profiling and latency benchmarks.
+struct InputRecording {
+  enum class Kind : uint8_t { Key, Axis, Touchpad };
+
+  struct Event {
+    double timeMs = 0.0; // Since recording start
+    uintptr_t device = 0;
+    int code = 0;        // Key: virtual key; Axis: input code
+    float value = 0.0f;  // Axis value
+    uint32_t firstContact = 0; // Touchpad: range in 'contacts'
+    uint16_t numContacts = 0;
+    Kind kind = Kind::Key;
+    bool isDown = false; // Key
+  };
+
+  // File format version (bumped on layout changes; older files are rejected).
+  static constexpr int kVersion = 1;
+
+  std::vector<Event> events;
+  std::vector<TouchpadContact> contacts; // Touchpad frames, concatenated
+
+  double durationMs() const {
+    return events.empty() ? 0.0 : events.back().timeMs;
+  }
+  void clear() {
+    events.clear();
+    contacts.clear();
+  }
+
+  void writeTo(juce::OutputStream &out) const;
+  // Returns false (and leaves the recording empty) on a bad header, an
+  // unsupported version or a truncated stream.
+  bool readFrom(juce::InputStream &in);
+
+  bool saveToFile(const juce::File &file) const;
+  bool loadFromFile(const juce::File &file);
+};
+
+// Captures events into an InputRecording while started. The input thread
+// pays one relaxed atomic load when idle; while recording, appends are
+// serialized by a lock (capture is a diagnostic mode, not the live path).
+class InputRecorder {
+public:
+  void start();
+  // Stops capturing and returns what was recorded.
+  InputRecording stop();
+  bool isRecording() const {
+    return recording.load(std::memory_order_relaxed);
+  }
+
+  void recordKey(uintptr_t device, int keyCode, bool isDown);
+  void recordAxis(uintptr_t device, int inputCode, float value);
+  void recordTouchpad(uintptr_t device,
+                      const std::vector<TouchpadContact> &contacts);
+
+private:
+  InputRecording::Event &append(InputRecording::Kind kind, uintptr_t device);
+
+  std::atomic<bool> recording{false};
+  juce::CriticalSection lock;
+  InputRecording data;
+  double startMs = 0.0;
+};
+
+// Feeds a recording back into an InputProcessor on the calling thread.
+namespace InputReplayer {
+// Dispatches events[index] to the processor's matching entry point.
+// 'frame' is reused scratch for touchpad contacts.
+void dispatch(const InputRecording &recording, size_t index,
+              InputProcessor &proc, std::vector<TouchpadContact> &frame);
+
+// Dispatches every event. When paced, waits until each event's original
+// timestamp (relative to the call) so time-based behaviour (strum, glide,
+// envelopes) plays out as recorded; otherwise runs as fast as possible.
+void replay(const InputRecording &recording, InputProcessor &proc,
+            bool paced);
+} // namespace InputReplayer
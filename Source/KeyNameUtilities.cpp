@@ -1,8 +1,9 @@
 #include "KeyNameUtilities.h"
 #include "MappingTypes.h"
 
-// Windows header must be included first
+#if JUCE_WINDOWS
 #include <windows.h>
+#endif
 
 juce::String KeyNameUtilities::getKeyName(int virtualKeyCode) {
   // 1. Check for Internal Pseudo-Codes
@@ -15,6 +16,7 @@ juce::String KeyNameUtilities::getKeyName(int virtualKeyCode) {
   if (virtualKeyCode == InputTypes::PointerY)
     return "Trackpad Y";
 
+#if JUCE_WINDOWS
   // 2. Manual Overrides for Windows Ambiguities
   // These keys often map to Numpad names if we don't handle them explicitly.
   switch (virtualKeyCode) {
@@ -96,11 +98,20 @@ juce::String KeyNameUtilities::getKeyName(int virtualKeyCode) {
   if (GetKeyNameTextA(lParam, name, 128) > 0) {
     return juce::String(name);
   }
+#else
+  // No keyboard layout API: letters and digits share their ASCII codes.
+  if ((virtualKeyCode >= '0' && virtualKeyCode <= '9') ||
+      (virtualKeyCode >= 'A' && virtualKeyCode <= 'Z'))
+    return juce::String::charToString((juce::juce_wchar)virtualKeyCode);
+  if (virtualKeyCode >= 0x70 && virtualKeyCode <= 0x87) // F1-F24
+    return "F" + juce::String(virtualKeyCode - 0x70 + 1);
+#endif
 
   return "Key " + juce::String(virtualKeyCode);
 }
 
 juce::String KeyNameUtilities::getFriendlyDeviceName(uintptr_t deviceHandle) {
+#if JUCE_WINDOWS
   HANDLE hDevice = reinterpret_cast<HANDLE>(deviceHandle);
   if (hDevice == nullptr)
     return "Device [" +
@@ -139,6 +150,7 @@ juce::String KeyNameUtilities::getFriendlyDeviceName(uintptr_t deviceHandle) {
       return "Device [" + vid + "]";
     }
   }
+#endif
 
   // Fallback to hex handle if extraction fails
   return "Device [" +
@@ -1,28 +1,24 @@
 #include "LogComponent.h"
 
-LogComponent *LogComponent::s_instance = nullptr;
-
 LogComponent::LogComponent() {
-  s_instance = this; // Set static instance
-  console.setMultiLine(true);
-  console.setReadOnly(true);
-  console.setFont(juce::Font("Consolas", 14.0f, juce::Font::plain));
-  console.setColour(juce::TextEditor::backgroundColourId,
-                    juce::Colour(0xff111111));
-  console.setColour(juce::TextEditor::textColourId, juce::Colours::lightgreen);
-  console.setScrollbarsShown(true);
+  lines.resize((size_t)kCapacity);
 
-  // Disable text editor's internal caret to speed up repaints
-  console.setCaretVisible(false);
+  list.setModel(this);
+  list.setRowHeight(18);
+  list.setColour(juce::ListBox::backgroundColourId, juce::Colour(0xff111111));
+  list.setMultipleSelectionEnabled(false);
 
   addAndMakeVisible(clearButton);
   clearButton.setButtonText("Clear Log");
   clearButton.onClick = [this] { clear(); };
 
-  addAndMakeVisible(console);
+  addAndMakeVisible(list);
 }
 
-LogComponent::~LogComponent() {}
+LogComponent::~LogComponent() {
+  cancelPendingUpdate();
+  list.setModel(nullptr);
+}
 
 void LogComponent::paint(juce::Graphics &g) {
   g.fillAll(juce::Colour(0xff222222));
@@ -34,36 +30,58 @@ void LogComponent::resized() {
   auto area = getLocalBounds().reduced(1);
   auto bar = area.removeFromTop(28);
   clearButton.setBounds(bar.removeFromRight(80).reduced(2));
-  console.setBounds(area);
+  list.setBounds(area);
+}
+
+void LogComponent::paintListBoxItem(int rowNumber, juce::Graphics &g,
+                                    int width, int height, bool) {
+  if (rowNumber < 0 || rowNumber >= count)
+    return;
+  g.setColour(juce::Colours::lightgreen);
+  g.setFont(font);
+  g.drawText(lineAt(rowNumber), 4, 0, width - 8, height,
+             juce::Justification::centredLeft, false);
+}
+
+const juce::String &LogComponent::lineAt(int row) const {
+  return lines[(size_t)((head + row) % kCapacity)];
+}
+
+void LogComponent::appendLine(const juce::String &text) {
+  if (count < kCapacity) {
+    lines[(size_t)((head + count) % kCapacity)] = text;
+    ++count;
+  } else {
+    lines[(size_t)head] = text; // Overwrite the oldest line
+    head = (head + 1) % kCapacity;
+  }
+  triggerAsyncUpdate();
 }
 
 void LogComponent::addEntry(const juce::String &text) {
-  // Create a SafePointer to 'this'
+  if (juce::MessageManager::existsAndIsCurrentThread()) {
+    appendLine(text);
+    return;
+  }
   // If LogComponent is deleted, safeThis becomes null automatically.
   juce::Component::SafePointer<LogComponent> safeThis(this);
-
   juce::MessageManager::callAsync([safeThis, text]() {
-    // Check if we are still alive
-    if (safeThis == nullptr) return;
-
-    // Use safeThis-> instead of implicit this->
-    safeThis->logBuffer.push_back(text);
-
-    while (safeThis->logBuffer.size() > safeThis->maxLines) {
-      safeThis->logBuffer.pop_front();
-    }
-
-    juce::String combinedText;
-    for (const auto &line : safeThis->logBuffer) {
-      combinedText += line + "\n";
-    }
-
-    safeThis->console.setText(combinedText, false);
-    safeThis->console.moveCaretToEnd();
+    if (safeThis != nullptr)
+      safeThis->appendLine(text);
   });
 }
 
+void LogComponent::handleAsyncUpdate() {
+  list.updateContent();
+  if (count > 0)
+    list.scrollToEnsureRowIsOnscreen(count - 1);
+  list.repaint();
+}
+
 void LogComponent::clear() {
-  logBuffer.clear();
-  console.clear();
-}
\ No newline at end of file
+  for (auto &line : lines)
+    line = juce::String();
+  head = 0;
+  count = 0;
+  triggerAsyncUpdate();
+}
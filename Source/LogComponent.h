@@ -1,27 +1,49 @@
 #pragma once
 #include <JuceHeader.h>
-#include <deque>
+#include <vector>
 
-class LogComponent : public juce::Component {
+// Virtualized log view. Lines live in a fixed-capacity ring (oldest lines
+// are overwritten) and a ListBox paints only the rows that are on screen, so
+// adding a line costs one string move instead of rebuilding the whole text.
+class LogComponent : public juce::Component,
+                     private juce::ListBoxModel,
+                     private juce::AsyncUpdater {
 public:
+  static constexpr int kCapacity = 512;
+
   LogComponent();
   ~LogComponent() override;
 
   void paint(juce::Graphics &) override;
   void resized() override;
 
+  // Any thread; appends on the message thread. Several entries added in the
+  // same message-loop turn are shown with a single list update.
   void addEntry(const juce::String &text);
   void clear();
 
+  int getNumLines() const { return count; }
+
 private:
-  juce::TextEditor console;
-  juce::TextButton clearButton;
+  // juce::ListBoxModel
+  int getNumRows() override { return count; }
+  void paintListBoxItem(int rowNumber, juce::Graphics &g, int width,
+                        int height, bool rowIsSelected) override;
 
-  // The efficient buffer
-  std::deque<juce::String> logBuffer;
-  const size_t maxLines = 10; // Keep it snappy
+  // juce::AsyncUpdater
+  void handleAsyncUpdate() override;
+
+  void appendLine(const juce::String &text);
+  const juce::String &lineAt(int row) const;
+
+  juce::ListBox list;
+  juce::TextButton clearButton;
+  juce::Font font{juce::Font("Consolas", 14.0f, juce::Font::plain)};
 
-  static LogComponent *s_instance;
+  // Ring of display lines: 'head' is the oldest line once the ring is full.
+  std::vector<juce::String> lines;
+  int head = 0;
+  int count = 0;
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LogComponent)
-};
\ No newline at end of file
+};
@@ -0,0 +1,8 @@
+#include "LogEventQueue.h"
+
+bool LogEventQueue::push(const LogEvent &event) {
+  if (ring.push(event))
+    return true;
+  dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "MpscRing.h"
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+
+// Raw input event captured for the log view. Plain data only: the input
+// thread never formats strings or resolves mappings; that happens when the
+// message thread drains the queue once per frame.
+struct LogEvent {
+  enum class Kind : uint8_t { Key, Axis };
+  Kind kind = Kind::Key;
+  bool isDown = false;   // Key
+  int code = 0;          // Virtual key / axis input code
+  uintptr_t device = 0;
+  float value = 0.0f;    // Axis
+};
+
+// Bounded lock-free multi-producer / single-consumer ring of LogEvents (an
+// MpscRing, like MidiOutputQueue). When the ring is full new events are
+// dropped and counted, so a stalled UI can never block or slow the input
+// thread.
+class LogEventQueue {
+public:
+  // capacity is rounded up to a power of two.
+  explicit LogEventQueue(size_t capacity = 1024) : ring(capacity) {}
+
+  // Any thread. Returns false (and counts a drop) if the ring is full.
+  bool push(const LogEvent &event);
+
+  // Consumer thread only. Returns false if empty.
+  bool pop(LogEvent &out) { return ring.pop(out); }
+
+  // Consumer thread only. Returns events dropped since the last call.
+  uint32_t takeDroppedCount() {
+    return dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return ring.capacity(); }
+
+private:
+  MpscRing<LogEvent> ring;
+  std::atomic<uint32_t> dropped{0};
+
+  JUCE_DECLARE_NON_COPYABLE(LogEventQueue)
+};
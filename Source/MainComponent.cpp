@@ -77,6 +77,7 @@ MainComponent::MainComponent()
   // --- Restore UI: create the five content components and wire into
   // containers/tabs ---
   logComponent = std::make_unique<LogComponent>();
+  logBatch.reserve(logQueue.capacity());
   visualizer = std::make_unique<VisualizerComponent>(
       &inputProcessor.getZoneManager(), &deviceManager, voiceManager,
       &settingsManager, &presetManager, &inputProcessor, &scaleLibrary);
@@ -396,6 +397,7 @@ MainComponent::MainComponent()
   setSize(800, 600);
 
   // --- Phase 42: SAFE INITIALIZATION SEQUENCE ---
+  inputProcessor.setContextCacheFile(startupManager.getContextCacheFile());
   inputProcessor.initialize();
   mappingEditor->initialize();
   visualizer->initialize();
@@ -403,6 +405,9 @@ MainComponent::MainComponent()
   settingsPanel->initialize();
   settingsPanel->onResetUiLayout = [this]() { resetUiLayoutAndRestart(); };
   startupManager.initApp();
+  // Go live now (from the compiled cache when the session is unchanged)
+  // instead of after the load's change messages, while the UI still builds.
+  inputProcessor.forceRebuildMappings();
 
   // Now that settings have been loaded from disk, apply any persisted main
   // window state. We must do this after the MainComponent has been attached
@@ -513,6 +518,7 @@ MainComponent::~MainComponent() {
   // the real state.
   saveLayoutPositions();
   startupManager.saveImmediate();
+  inputProcessor.saveContextCache();
 
   // 3. CRITICAL: Manually clear tabs.
   // This detaches the MappingEditor/ZoneEditor/SettingsPanel safely so the
@@ -599,11 +605,12 @@ void MainComponent::logEvent(uintptr_t device, int keyCode, bool isDown) {
       grid = it0->second[(size_t)layer];
   }
 
-  if (grid && keyCode >= 0 && keyCode < 256) {
-    const auto &slot = (*grid)[(size_t)keyCode];
+  const int gridSlot = InputTypes::gridSlot(keyCode);
+  if (grid && gridSlot >= 0) {
+    const auto &slot = (*grid)[(size_t)gridSlot];
     if (slot.state != VisualState::Empty) {
-      logLine += " -> [MIDI] " + slot.label;
-      logLine += " | Source: " + slot.sourceName;
+      logLine += " -> [MIDI] " + ctx->labelFor(slot);
+      logLine += " | Source: " + ctx->sourceNameFor(slot);
       if (slot.state == VisualState::Override)
         logLine += " [OVERRIDE]";
       else if (slot.state == VisualState::Conflict)
@@ -615,6 +622,32 @@ void MainComponent::logEvent(uintptr_t device, int keyCode, bool isDown) {
     logComponent->addEntry(logLine);
 }
 
+void MainComponent::logAxisEvent(uintptr_t device, int inputCode,
+                                 float value) {
+  juce::String devStr =
+      "Dev: " + juce::String::toHexString((juce::int64)device).toUpperCase();
+  juce::String keyName = KeyNameUtilities::getKeyName(inputCode);
+  juce::String keyInfo = "(" +
+                         juce::String::toHexString(inputCode).toUpperCase() +
+                         ") " + keyName;
+  keyInfo = keyInfo.paddedRight(' ', 20);
+
+  juce::String logLine =
+      devStr + " | VAL  | " + keyInfo + " | val: " + juce::String(value, 3);
+
+  InputID id = {device, inputCode};
+  if (const auto ref = inputProcessor.findMappingForInput(id)) {
+    const auto &action = *ref;
+    if (action.type == ActionType::Expression &&
+        action.adsrSettings.target == AdsrTarget::CC) {
+      logLine += " -> [MIDI] CC " + juce::String(action.adsrSettings.ccNumber) +
+                 " | ch: " + juce::String(action.channel);
+    }
+  }
+
+  logComponent->addEntry(logLine);
+}
+
 // ApplicationCommandTarget implementation
 void MainComponent::getAllCommands(juce::Array<juce::CommandID> &commands) {
   commands.add(juce::StandardApplicationCommandIDs::undo);
@@ -788,14 +821,16 @@ void MainComponent::changeListenerCallback(juce::ChangeBroadcaster *source) {
 
 void MainComponent::handleRawKeyEvent(uintptr_t deviceHandle, int keyCode,
                                       bool isDown) {
+  const auto settings = settingsManager.getRuntimeSettings();
+
   // Check for toggle key press (must be checked before other processing)
-  if (isDown && keyCode == settingsManager.getToggleKey()) {
-    settingsManager.setMidiModeActive(!settingsManager.isMidiModeActive());
+  if (isDown && keyCode == settings->toggleKey) {
+    settingsManager.setMidiModeActive(!settings->midiModeActive);
     return; // Don't process this key for MIDI
   }
 
   // Check for Performance Mode shortcut key
-  if (isDown && keyCode == settingsManager.getPerformanceModeKey()) {
+  if (isDown && keyCode == settings->performanceModeKey) {
     bool currentState = performanceModeButton.getToggleState();
     performanceModeButton.setToggleState(!currentState,
                                          juce::dontSendNotification);
@@ -872,12 +907,9 @@ void MainComponent::handleRawKeyEvent(uintptr_t deviceHandle, int keyCode,
   // For scroll events, only process and queue log if mapping exists
   if (isScrollEvent) {
     InputID id = {deviceHandle, keyCode};
-    auto actionOpt = inputProcessor.getMappingForInput(id);
-    if (actionOpt.has_value()) {
-      {
-        juce::ScopedLock lock(queueLock);
-        eventQueue.push_back({deviceHandle, keyCode, isDown});
-      }
+    if (inputProcessor.findMappingForInput(id)) {
+      if (logCaptureEnabled.load(std::memory_order_relaxed))
+        logQueue.push({LogEvent::Kind::Key, isDown, keyCode, deviceHandle});
       inputProcessor.processEvent(id, isDown);
     }
     return;
@@ -885,43 +917,17 @@ void MainComponent::handleRawKeyEvent(uintptr_t deviceHandle, int keyCode,
 
   // For regular keys: push to log queue (no string formatting here), then
   // process MIDI
-  {
-    juce::ScopedLock lock(queueLock);
-    eventQueue.push_back({deviceHandle, keyCode, isDown});
-  }
+  if (logCaptureEnabled.load(std::memory_order_relaxed))
+    logQueue.push({LogEvent::Kind::Key, isDown, keyCode, deviceHandle});
   InputID id = {deviceHandle, keyCode};
   inputProcessor.processEvent(id, isDown);
 }
 
 void MainComponent::handleAxisEvent(uintptr_t deviceHandle, int inputCode,
                                     float value) {
-  if (logComponent && logComponent->isShowing()) {
-    juce::String devStr =
-        "Dev: " +
-        juce::String::toHexString((juce::int64)deviceHandle).toUpperCase();
-    juce::String keyName = KeyNameUtilities::getKeyName(inputCode);
-    juce::String keyInfo = "(" +
-                           juce::String::toHexString(inputCode).toUpperCase() +
-                           ") " + keyName;
-    keyInfo = keyInfo.paddedRight(' ', 20);
-
-    juce::String logLine =
-        devStr + " | VAL  | " + keyInfo + " | val: " + juce::String(value, 3);
-
-    InputID id = {deviceHandle, inputCode};
-    auto actionOpt = inputProcessor.getMappingForInput(id);
-    if (actionOpt.has_value()) {
-      const auto &action = *actionOpt;
-      if (action.type == ActionType::Expression &&
-          action.adsrSettings.target == AdsrTarget::CC) {
-        logLine += " -> [MIDI] CC " +
-                   juce::String(action.adsrSettings.ccNumber) +
-                   " | ch: " + juce::String(action.channel);
-      }
-    }
-
-    logComponent->addEntry(logLine);
-  }
+  if (logCaptureEnabled.load(std::memory_order_relaxed))
+    logQueue.push(
+        {LogEvent::Kind::Axis, false, inputCode, deviceHandle, value});
 
   inputProcessor.handleAxisEvent(deviceHandle, inputCode, value);
 }
@@ -1117,6 +1123,10 @@ juce::PopupMenu MainComponent::getMenuForIndex(int topLevelMenuIndex,
     result.addSeparator();
     result.addItem(FileResetEverything, "Reset Everything");
     result.addItem(FileExportVoicingReport, "Export Voicing Report");
+    result.addItem(FileToggleInputCapture,
+                   inputProcessor.getInputRecorder().isRecording()
+                       ? "Stop Input Capture"
+                       : "Start Input Capture");
     result.addSeparator();
     result.addItem(FileExit, "Exit");
   } else if (topLevelMenuIndex == 1) {
@@ -1161,6 +1171,26 @@ void MainComponent::menuItemSelected(int menuItemID, int topLevelMenuIndex) {
                                targetFile.getFullPathName());
       break;
     }
+    case FileToggleInputCapture: {
+      auto &recorder = inputProcessor.getInputRecorder();
+      if (!recorder.isRecording()) {
+        recorder.start();
+        if (logComponent)
+          logComponent->addEntry("Input capture started");
+        break;
+      }
+      const auto recording = recorder.stop();
+      juce::File targetFile =
+          juce::File::getSpecialLocation(juce::File::userDesktopDirectory)
+              .getNonexistentChildFile("MIDIQy_Capture", ".mqir");
+      const bool saved = recording.saveToFile(targetFile);
+      if (logComponent)
+        logComponent->addEntry(
+            saved ? "Input capture (" + juce::String(recording.events.size()) +
+                        " events) saved to: " + targetFile.getFullPathName()
+                  : "Input capture could not be saved");
+      break;
+    }
     case FileResetEverything:
       juce::AlertWindow::showOkCancelBox(
           juce::AlertWindow::WarningIcon, "Reset Everything",
@@ -1337,6 +1367,7 @@ void MainComponent::timerCallback() {
   }
   if (isMinimized) {
     restoreCheckMode_ = true;
+    logCaptureEnabled.store(false, std::memory_order_relaxed);
     stopTimer();
     if (visualizer)
       visualizer->stopTimer();
@@ -1344,16 +1375,37 @@ void MainComponent::timerCallback() {
     return;
   }
 
-  // 1. Swap Queue (Thread Safe)
-  std::vector<PendingEvent> tempQueue;
-  {
-    juce::ScopedLock lock(queueLock);
-    tempQueue.swap(eventQueue);
-    // eventQueue is now empty, Input Thread is free to write
-  }
+  drainLogQueue();
+}
 
-  // 2. Process Queue (only when not minimized)
-  for (const auto &ev : tempQueue) {
-    logEvent(ev.device, ev.keyCode, ev.isDown);
+void MainComponent::drainLogQueue() {
+  const bool capture = logComponent && logComponent->isShowing();
+  logCaptureEnabled.store(capture, std::memory_order_relaxed);
+
+  // Only the newest events can stay on screen: skip formatting the rest of a
+  // burst (e.g. a fast axis sweep) beyond the log's line capacity.
+  LogEvent ev;
+  int skipped = (int)logQueue.takeDroppedCount();
+  auto &batch = logBatch;
+  batch.clear();
+  while (logQueue.pop(ev))
+    batch.push_back(ev);
+  if (!capture)
+    return;
+
+  size_t first = 0;
+  if (batch.size() > (size_t)LogComponent::kCapacity) {
+    first = batch.size() - (size_t)LogComponent::kCapacity;
+    skipped += (int)first;
+  }
+  if (skipped > 0)
+    logComponent->addEntry("... " + juce::String(skipped) +
+                           " events not shown ...");
+  for (size_t i = first; i < batch.size(); ++i) {
+    const auto &e = batch[i];
+    if (e.kind == LogEvent::Kind::Axis)
+      logAxisEvent(e.device, e.code, e.value);
+    else
+      logEvent(e.device, e.code, e.isDown);
   }
 }
\ No newline at end of file
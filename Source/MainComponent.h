@@ -3,6 +3,7 @@
 #include "DeviceManager.h"
 #include "InputProcessor.h"
 #include "LogComponent.h" // <--- NEW
+#include "LogEventQueue.h"
 #include "KeyboardMappingEditorComponent.h"
 #include "MidiEngine.h"
 #include "MiniStatusWindow.h"
@@ -19,6 +20,7 @@
 #include "ZoneEditorComponent.h"
 
 #include <JuceHeader.h>
+#include <atomic>
 #include <unordered_set>
 #include <vector>
 
@@ -122,20 +124,18 @@ private:
       false; // when true, timer runs at 1s to restart when visible
 
   // Async logging: Input thread pushes POD only; timer processes batches
-  // (Phase 21.1)
-  struct PendingEvent {
-    uintptr_t device;
-    int keyCode;
-    bool isDown;
-  };
-  std::vector<PendingEvent> eventQueue;
-  juce::CriticalSection queueLock;
+  // (Phase 21.1). Lock-free, and skipped entirely while the log is hidden.
+  LogEventQueue logQueue;
+  std::atomic<bool> logCaptureEnabled{false};
+  std::vector<LogEvent> logBatch; // Drain scratch (capacity reserved once)
+  void drainLogQueue();
 
   // Command Manager for Undo/Redo
   juce::ApplicationCommandManager commandManager;
 
   // Log formatting (called from timer batch only, not from input path)
   void logEvent(uintptr_t device, int keyCode, bool isDown);
+  void logAxisEvent(uintptr_t device, int inputCode, float value);
   juce::String getNoteName(int noteNumber);
 
   // Layout persistence
@@ -179,6 +179,7 @@ private:
     FileLoadPreset = 2,
     FileResetEverything = 4,
     FileExportVoicingReport = 5,
+    FileToggleInputCapture = 6,
     FileExit = 3
   };
 
@@ -5,6 +5,7 @@
 #include "PitchPadUtilities.h"
 #include "ScaleUtilities.h"
 #include "SettingsManager.h"
+#include "TaskPool.h"
 #include "TouchpadLayoutTypes.h"
 #include <algorithm>
 #include <cmath>
@@ -77,25 +78,106 @@ static void clearSlotsForKeys(AudioGrid &aGrid, VisualGrid &vGrid,
   for (int k = 0; k < n; ++k) {
     if (!keysToClear[(size_t)k])
       continue;
-    aGrid[(size_t)k].isActive = false;
-    aGrid[(size_t)k].chordIndex = -1;
+    aGrid[(size_t)k] = KeyAudioSlot{};
     vGrid[(size_t)k].state = VisualState::Empty;
     vGrid[(size_t)k].displayColor = juce::Colours::transparentBlack;
-    vGrid[(size_t)k].label.clear();
-    vGrid[(size_t)k].sourceName.clear();
+    vGrid[(size_t)k].labelId = 0;
+    vGrid[(size_t)k].sourceNameId = 0;
   }
 }
 
 // Create a fresh AudioGrid with all slots inactive.
 std::shared_ptr<AudioGrid> makeAudioGrid() {
   auto grid = std::make_shared<AudioGrid>();
-  for (auto &slot : *grid) {
-    slot.isActive = false;
-    slot.chordIndex = -1;
-  }
+  grid->fill(KeyAudioSlot{});
   return grid;
 }
 
+size_t hashCombine(size_t seed, size_t value) {
+  return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+// Interns MidiActions into CompiledContext::actionPool: a mapping inherited
+// by every layer and alias stack is stored once, not once per grid slot.
+// Returned indices start at firstIndex, so a task-local pool can number its
+// entries after those of the shared pool it is merged into later.
+class ActionInterner {
+public:
+  explicit ActionInterner(std::vector<MidiAction> &poolToFill,
+                          int firstIndex = 0)
+      : pool(poolToFill), base(firstIndex) {
+    for (size_t i = 0; i < pool.size(); ++i)
+      index.emplace(hashAction(pool[i]), (int)i);
+  }
+
+  int intern(const MidiAction &action) {
+    const size_t h = hashAction(action);
+    auto [first, last] = index.equal_range(h);
+    for (auto it = first; it != last; ++it) {
+      if (pool[(size_t)it->second] == action)
+        return base + it->second;
+    }
+    pool.push_back(action);
+    const int added = (int)pool.size() - 1;
+    index.emplace(h, added);
+    return base + added;
+  }
+
+private:
+  // The fields that usually tell actions apart; equality settles the rest.
+  static size_t hashAction(const MidiAction &a) {
+    size_t h = (size_t)a.type;
+    h = hashCombine(h, (size_t)a.channel);
+    h = hashCombine(h, (size_t)a.data1);
+    h = hashCombine(h, (size_t)a.data2);
+    h = hashCombine(h, (size_t)a.adsrSettings.ccNumber);
+    return hashCombine(h, (size_t)a.releaseBehavior);
+  }
+
+  std::vector<MidiAction> &pool;
+  const int base;
+  std::unordered_multimap<size_t, int> index;
+};
+
+size_t hashAudioGrid(const AudioGrid &grid) {
+  size_t h = 0;
+  for (const auto &slot : grid) {
+    if (!slot.isActive)
+      continue;
+    h = hashCombine(h, (size_t)(&slot - grid.data()));
+    h = hashCombine(h, (size_t)slot.actionIndex);
+    h = hashCombine(h, (size_t)slot.chordIndex);
+  }
+  return h;
+}
+
+// Hash-cons the compiled audio grids: aliases (and layers) without content of
+// their own compile to copies of the global grid, so identical grids are
+// replaced by one shared instance. Grids are immutable once published.
+void shareIdenticalAudioGrids(CompiledMapContext &context) {
+  std::unordered_multimap<size_t, std::shared_ptr<const AudioGrid>> seen;
+  auto canonicalize = [&](std::shared_ptr<const AudioGrid> &grid) {
+    if (!grid)
+      return;
+    const size_t h = hashAudioGrid(*grid);
+    auto [first, last] = seen.equal_range(h);
+    for (auto it = first; it != last; ++it) {
+      if (it->second == grid)
+        return;
+      if (*it->second == *grid) {
+        grid = it->second;
+        return;
+      }
+    }
+    seen.emplace(h, grid);
+  };
+  for (auto &grid : context.globalGrids)
+    canonicalize(grid);
+  for (auto &entry : context.deviceGrids)
+    for (auto &grid : entry.second)
+      canonicalize(grid);
+}
+
 // Obtain a mutable AudioGrid from a shared_ptr<const AudioGrid> storage slot.
 // This keeps CompiledMapContext read-only for consumers while allowing the
 // compiler to fill in data.
@@ -112,12 +194,7 @@ getMutableAudioGrid(std::shared_ptr<const AudioGrid> &ptr) {
 // Create a fresh VisualGrid with default visual state.
 std::shared_ptr<VisualGrid> makeVisualGrid() {
   auto grid = std::make_shared<VisualGrid>();
-  for (auto &slot : *grid) {
-    slot.state = VisualState::Empty;
-    slot.displayColor = juce::Colours::transparentBlack;
-    slot.label.clear();
-    slot.sourceName.clear();
-  }
+  grid->fill(KeyVisualSlot{});
   return grid;
 }
 
@@ -249,17 +326,28 @@ juce::String makeLabelForAction(const MidiAction &action) {
   }
 }
 
+// Fill a slot's hot fields from an action interned into the action pool.
+void setSlotAction(KeyAudioSlot &slot, const MidiAction &action,
+                   ActionInterner &actions) {
+  slot.isActive = true;
+  slot.type = action.type;
+  slot.channel = (uint8_t)juce::jlimit(0, 255, action.channel);
+  slot.data1 = (int16_t)juce::jlimit(-32768, 32767, action.data1);
+  slot.data2 = (int16_t)juce::jlimit(-32768, 32767, action.data2);
+  slot.actionIndex = actions.intern(action);
+}
+
 // Write a MidiAction into an AudioGrid slot and handle generic modifier
 // replication for that grid.
 void writeAudioSlot(AudioGrid &grid, int keyCode, const MidiAction &action,
-                    int keyboardGroupId) {
+                    int keyboardGroupId, ActionInterner &actions) {
   if (keyCode < 0 || keyCode >= (int)grid.size())
     return;
 
   auto &slot = grid[(size_t)keyCode];
-  slot.isActive = true;
-  slot.action = action;
+  setSlotAction(slot, action, actions);
   slot.chordIndex = -1;
+  slot.zoneIndex = -1;
   slot.keyboardGroupId = keyboardGroupId;
 
   // Generic -> specific replication
@@ -287,11 +375,30 @@ void writeAudioSlot(AudioGrid &grid, int keyCode, const MidiAction &action,
   }
 }
 
+// Interned text for one mapping or zone key. Built once per mapping, then
+// stamped into every slot it covers. The conflict label is only interned if
+// a conflict actually occurs.
+struct VisualText {
+  VisualStringPool *strings = nullptr;
+  VisualStringPool::Id label = 0;
+  VisualStringPool::Id sourceName = 0;
+
+  VisualStringPool::Id conflictLabel() const {
+    return strings->intern(strings->get(label) + " (!)");
+  }
+};
+
+VisualText internVisualText(VisualStringPool &strings,
+                            const juce::String &label,
+                            const juce::String &sourceName) {
+  return {&strings, strings.intern(label), strings.intern(sourceName)};
+}
+
 // Phase 53.5: targetState = Active for "current layer" content, Inherited for
 // "lower layer" content (device Pass 2). When slot already has content, Active
 // -> Override, Inherited -> stays Inherited.
 void applyVisualSlot(VisualGrid &grid, int keyCode, const juce::Colour &color,
-                     const juce::String &label, const juce::String &sourceName,
+                     const VisualText &text,
                      std::vector<bool> *touchedKeys = nullptr,
                      VisualState targetState = VisualState::Active,
                      int keyboardGroupId = 0) {
@@ -314,12 +421,12 @@ void applyVisualSlot(VisualGrid &grid, int keyCode, const juce::Colour &color,
   if (isConflict) {
     slot.state = VisualState::Conflict;
     slot.displayColor = juce::Colours::red;
-    slot.label = label + " (!)";
-    slot.sourceName = sourceName;
+    slot.labelId = text.conflictLabel();
+    slot.sourceNameId = text.sourceName;
   } else {
     slot.displayColor = color;
-    slot.label = label;
-    slot.sourceName = sourceName;
+    slot.labelId = text.label;
+    slot.sourceNameId = text.sourceName;
     if (!hadContent)
       slot.state = targetState;
     else
@@ -333,13 +440,12 @@ void applyVisualSlot(VisualGrid &grid, int keyCode, const juce::Colour &color,
 // a generic modifier. Phase 53.5: targetState passed through for inheritance.
 void applyVisualWithModifiers(VisualGrid &grid, int keyCode,
                               const juce::Colour &color,
-                              const juce::String &label,
-                              const juce::String &sourceName,
+                              const VisualText &text,
                               std::vector<bool> *touchedKeys = nullptr,
                               VisualState targetState = VisualState::Active,
                               int keyboardGroupId = 0) {
-  applyVisualSlot(grid, keyCode, color, label, sourceName, touchedKeys,
-                  targetState, keyboardGroupId);
+  applyVisualSlot(grid, keyCode, color, text, touchedKeys, targetState,
+                  keyboardGroupId);
 
   auto shouldExpandTo = [&](int sideKey) -> bool {
     if (!touchedKeys || sideKey < 0 || sideKey >= (int)touchedKeys->size())
@@ -349,25 +455,25 @@ void applyVisualWithModifiers(VisualGrid &grid, int keyCode,
 
   if (isGenericShift(keyCode)) {
     if (shouldExpandTo(InputTypes::Key_LShift))
-      applyVisualSlot(grid, InputTypes::Key_LShift, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_LShift, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
     if (shouldExpandTo(InputTypes::Key_RShift))
-      applyVisualSlot(grid, InputTypes::Key_RShift, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_RShift, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
   } else if (isGenericControl(keyCode)) {
     if (shouldExpandTo(InputTypes::Key_LControl))
-      applyVisualSlot(grid, InputTypes::Key_LControl, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_LControl, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
     if (shouldExpandTo(InputTypes::Key_RControl))
-      applyVisualSlot(grid, InputTypes::Key_RControl, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_RControl, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
   } else if (isGenericAlt(keyCode)) {
     if (shouldExpandTo(InputTypes::Key_LAlt))
-      applyVisualSlot(grid, InputTypes::Key_LAlt, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_LAlt, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
     if (shouldExpandTo(InputTypes::Key_RAlt))
-      applyVisualSlot(grid, InputTypes::Key_RAlt, color, label, sourceName,
-                      touchedKeys, targetState, keyboardGroupId);
+      applyVisualSlot(grid, InputTypes::Key_RAlt, color, text, touchedKeys,
+                      targetState, keyboardGroupId);
   }
 }
 
@@ -433,14 +539,55 @@ static void applyNoteOptionsFromMapping(juce::ValueTree mapping,
     action.releaseBehavior = NoteReleaseBehavior::SendNoteOff;
 }
 
+// Return the index of zone in zoneTable, appending it on first use. Zone
+// counts are small, so a linear scan at compile time is fine.
+int internZone(std::vector<std::shared_ptr<Zone>> &zoneTable,
+               const std::shared_ptr<Zone> &zone) {
+  for (size_t i = 0; i < zoneTable.size(); ++i) {
+    if (zoneTable[i] == zone)
+      return static_cast<int>(i);
+  }
+  zoneTable.push_back(zone);
+  return static_cast<int>(zoneTable.size()) - 1;
+}
+
+// Pools a layer compile appends to. The global stack writes straight into
+// the context's pools; each parallel alias-layer task gets private ones,
+// numbered after the shared pools (chordBase, sharedZones) so that indices
+// below the shared sizes still refer to the shared entries.
+struct LayerPools {
+  std::vector<std::vector<MidiAction>> &chordPool;
+  std::vector<std::shared_ptr<Zone>> &zoneTable;
+  ActionInterner &actions;
+  VisualStringPool &strings;
+  int chordBase = 0;
+  // Looked up (read-only) before a zone is appended to zoneTable.
+  const std::vector<std::shared_ptr<Zone>> *sharedZones = nullptr;
+
+  int addChord(std::vector<MidiAction> chord) {
+    chordPool.push_back(std::move(chord));
+    return chordBase + static_cast<int>(chordPool.size()) - 1;
+  }
+
+  int addZone(const std::shared_ptr<Zone> &zone) {
+    if (sharedZones == nullptr)
+      return internZone(zoneTable, zone);
+    for (size_t i = 0; i < sharedZones->size(); ++i) {
+      if ((*sharedZones)[i] == zone)
+        return static_cast<int>(i);
+    }
+    return static_cast<int>(sharedZones->size()) +
+           internZone(zoneTable, zone);
+  }
+};
+
 // Phase 51.4 / 53.5: Apply zones for a single layer. targetState = Active or
 // Inherited for device Pass 2. keysWrittenOut: if non-null, mark keys written
 // by this layer (for "private to layer" inheritance stripping).
 void compileZonesForLayer(VisualGrid &vGrid, AudioGrid &aGrid,
                           ZoneManager &zoneMgr, DeviceManager &deviceMgr,
                           uintptr_t aliasHash, int layerId,
-                          std::vector<bool> &touchedKeys,
-                          std::vector<std::vector<MidiAction>> &chordPool,
+                          std::vector<bool> &touchedKeys, LayerPools &pools,
                           VisualState targetState,
                           std::vector<bool> *keysWrittenOut = nullptr) {
   const int globalChrom = zoneMgr.getGlobalChromaticTranspose();
@@ -476,11 +623,11 @@ void compileZonesForLayer(VisualGrid &vGrid, AudioGrid &aGrid,
 
       const auto &chordNotes = chordOpt.value();
       juce::Colour color = zone->zoneColor;
-      juce::String label = zone->getKeyLabel(keyCode);
-      juce::String sourceName = "Zone: " + zone->name;
+      const VisualText text = internVisualText(
+          pools.strings, zone->getKeyLabel(keyCode), "Zone: " + zone->name);
 
-      applyVisualWithModifiers(vGrid, keyCode, color, label, sourceName,
-                               &touchedKeys, targetState, zone->keyboardGroupId);
+      applyVisualWithModifiers(vGrid, keyCode, color, text, &touchedKeys,
+                               targetState, zone->keyboardGroupId);
 
       if (!chordNotes.empty() && chordNotes.front().isGhost)
         vGrid[(size_t)keyCode].isGhost = true;
@@ -504,12 +651,13 @@ void compileZonesForLayer(VisualGrid &vGrid, AudioGrid &aGrid,
           a.data1 = note.pitch;
           chordActions.push_back(a);
         }
-        chordPool.push_back(std::move(chordActions));
-        chordIndex = static_cast<int>(chordPool.size()) - 1;
+        chordIndex = pools.addChord(std::move(chordActions));
       }
 
-      writeAudioSlot(aGrid, keyCode, rootAction, zone->keyboardGroupId);
+      writeAudioSlot(aGrid, keyCode, rootAction, zone->keyboardGroupId,
+                     pools.actions);
       aGrid[(size_t)keyCode].chordIndex = chordIndex;
+      aGrid[(size_t)keyCode].zoneIndex = pools.addZone(zone);
       markKeyWritten(keyCode, keysWrittenOut);
     }
   }
@@ -525,10 +673,9 @@ static bool isGenericModifierKey(int keyCode) {
 }
 
 // Phase 53.5: Layer switching commands must not be inherited to higher layers.
-static bool isLayerCommand(const MidiAction &action) {
-  if (action.type != ActionType::Command)
+static bool isLayerCommand(ActionType type, int cmd) {
+  if (type != ActionType::Command)
     return false;
-  const int cmd = action.data1;
   return (cmd == static_cast<int>(MIDIQy::CommandID::LayerMomentary) ||
           cmd == static_cast<int>(MIDIQy::CommandID::LayerToggle) ||
           cmd == static_cast<int>(MIDIQy::CommandID::LayerRemoveOverrides));
@@ -545,14 +692,13 @@ struct ForcedMapping {
   int inputKey{};
   MidiAction action{};
   juce::Colour color;
-  juce::String label;
-  juce::String sourceName;
+  VisualText text;
   int keyboardGroupId = 0;
 };
 
 static void collectForcedMappings(
     PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
-    SettingsManager &settingsMgr,
+    SettingsManager &settingsMgr, VisualStringPool &strings,
     std::unordered_map<uintptr_t, std::vector<ForcedMapping>> &forcedByAlias) {
   forcedByAlias.clear();
 
@@ -572,8 +718,9 @@ static void collectForcedMappings(
     if (aliasName.equalsIgnoreCase("Touchpad"))
       continue;
 
-    const int inputKey = (int)mapping.getProperty("inputKey", MappingDefaults::InputKey);
-    if (inputKey < 0 || inputKey > 0xFF)
+    const int inputKey = InputTypes::gridSlot(
+        (int)mapping.getProperty("inputKey", MappingDefaults::InputKey));
+    if (inputKey < 0)
       continue;
 
     uintptr_t mappingAliasHash = DeviceManager::getAliasHash(aliasName);
@@ -735,13 +882,13 @@ static void collectForcedMappings(
     }
 
     juce::Colour color = getColorForType(action.type, settingsMgr);
-    juce::String label = makeLabelForAction(action);
-    juce::String sourceName =
-        aliasName.isNotEmpty() ? ("Mapping: " + aliasName) : "Mapping";
+    const VisualText text = internVisualText(
+        strings, makeLabelForAction(action),
+        aliasName.isNotEmpty() ? ("Mapping: " + aliasName) : "Mapping");
     int kbGroupId = (int)mapping.getProperty("keyboardGroupId", MappingDefaults::KeyboardGroupId);
 
     forcedByAlias[mappingAliasHash].push_back(
-        ForcedMapping{inputKey, action, color, label, sourceName, kbGroupId});
+        ForcedMapping{inputKey, action, color, text, kbGroupId});
   }
 }
 
@@ -1098,10 +1245,15 @@ static void compileTouchpadMappingFromValueTree(
 
         p.pitchPadConfig = cfg;
         p.cachedPitchPadLayout = buildPitchPadLayout(cfg);
+        p.pitchPadTable = bakePitchPadTable(
+            *p.cachedPitchPadLayout, cfg,
+            isPB && cfg.mode == PitchPadMode::Absolute,
+            settingsMgr.getPitchBendRange());
       } else {
         p.outputMin = (int)mapping.getProperty("touchpadOutputMin", MappingDefaults::TouchpadOutputMin);
         p.outputMax = (int)mapping.getProperty("touchpadOutputMax", MappingDefaults::TouchpadOutputMax);
         p.pitchPadConfig.reset();
+        p.pitchPadTable.reset();
       }
     }
     // Apply Expression ADSR and release behavior.
@@ -1190,7 +1342,8 @@ void compileMappingsForLayer(
     VisualGrid &vGrid, AudioGrid &aGrid, PresetManager &presetMgr,
     DeviceManager &deviceMgr, ZoneManager &zoneMgr,
     SettingsManager &settingsMgr, uintptr_t aliasHash, int layerId,
-    std::vector<bool> &touchedKeys, VisualState targetState,
+    std::vector<bool> &touchedKeys, ActionInterner &actions,
+    VisualStringPool &strings, VisualState targetState,
     std::vector<TouchpadMappingEntry> *touchpadMappingsOut,
     std::vector<bool> *keysWrittenOut = nullptr) {
   std::vector<juce::ValueTree> enabledList =
@@ -1233,8 +1386,9 @@ void compileMappingsForLayer(
     if (isTouchpadMapping)
       continue;
 
-    const int inputKey = (int)mapping.getProperty("inputKey", MappingDefaults::InputKey);
-    if (inputKey < 0 || inputKey > 0xFF)
+    const int inputKey = InputTypes::gridSlot(
+        (int)mapping.getProperty("inputKey", MappingDefaults::InputKey));
+    if (inputKey < 0)
       continue;
 
     uintptr_t mappingAliasHash = DeviceManager::getAliasHash(aliasName);
@@ -1394,30 +1548,176 @@ void compileMappingsForLayer(
     }
 
     juce::Colour color = getColorForType(action.type, settingsMgr);
-    juce::String label = makeLabelForAction(action);
-    juce::String sourceName =
-        aliasName.isNotEmpty() ? ("Mapping: " + aliasName) : "Mapping";
+    const VisualText text = internVisualText(
+        strings, makeLabelForAction(action),
+        aliasName.isNotEmpty() ? ("Mapping: " + aliasName) : "Mapping");
     const int kbGroupId = (int)mapping.getProperty("keyboardGroupId", MappingDefaults::KeyboardGroupId);
 
-    applyVisualWithModifiers(vGrid, inputKey, color, label, sourceName,
-                             &touchedKeys, targetState, kbGroupId);
+    applyVisualWithModifiers(vGrid, inputKey, color, text, &touchedKeys,
+                             targetState, kbGroupId);
 
     if (vGrid[(size_t)inputKey].state != VisualState::Conflict) {
-      writeAudioSlot(aGrid, inputKey, action, kbGroupId);
+      writeAudioSlot(aGrid, inputKey, action, kbGroupId, actions);
       markKeyWritten(inputKey, keysWrittenOut);
     }
   }
 }
 
+// Output of one (alias, layer) task. Its grids start as copies of the global
+// grid, so indices below the shared pools' sizes at fork time refer to the
+// shared pools and only higher ones to the private pools below, which hold
+// just the entries the task added (numbered from the shared sizes).
+struct AliasLayerResult {
+  std::shared_ptr<VisualGrid> visual; // Null: reused from previous
+  std::shared_ptr<AudioGrid> audio;
+  std::vector<MidiAction> actionPool;
+  std::vector<std::vector<MidiAction>> chordPool;
+  std::vector<std::shared_ptr<Zone>> zoneTable;
+  VisualStringPool strings;
+};
+
+// Shared pool sizes when the alias-layer tasks were forked.
+struct PoolBases {
+  int actions = 0;
+  int chords = 0;
+  int zones = 0;
+  VisualStringPool::Id strings = 0;
+};
+
+// Append a task's private pool entries to the context's pools and rewrite
+// its grids' indices to match. Merging the tasks in a fixed order yields the
+// same pools as compiling them one after another.
+void mergeAliasLayer(AliasLayerResult &result, const PoolBases &bases,
+                     CompiledMapContext &context, ActionInterner &actions) {
+  std::vector<int> actionIds(result.actionPool.size());
+  for (size_t i = 0; i < actionIds.size(); ++i)
+    actionIds[i] = actions.intern(result.actionPool[i]);
+
+  const int chordOffset = (int)context.chordPool.size() - bases.chords;
+  for (auto &chord : result.chordPool)
+    context.chordPool.push_back(std::move(chord));
+
+  std::vector<int> zoneIds;
+  for (const auto &zone : result.zoneTable)
+    zoneIds.push_back(internZone(context.zoneTable, zone));
+
+  std::vector<VisualStringPool::Id> stringIds;
+  for (auto id = bases.strings; id < result.strings.size(); ++id)
+    stringIds.push_back(context.visualStrings.intern(result.strings.get(id)));
+  auto remapString = [&](VisualStringPool::Id &id) {
+    if (id >= bases.strings)
+      id = stringIds[id - bases.strings];
+  };
+
+  for (auto &slot : *result.audio) {
+    if (slot.actionIndex >= bases.actions)
+      slot.actionIndex = actionIds[(size_t)(slot.actionIndex - bases.actions)];
+    if (slot.chordIndex >= bases.chords)
+      slot.chordIndex += chordOffset;
+    if (slot.zoneIndex >= bases.zones)
+      slot.zoneIndex = zoneIds[(size_t)(slot.zoneIndex - bases.zones)];
+  }
+  for (auto &slot : *result.visual) {
+    remapString(slot.labelId);
+    remapString(slot.sourceNameId);
+  }
+}
+
+// Pool used when compile() is not given one. parallelFor may be called from
+// several threads at once, so one process-wide pool serves every compile.
+TaskPool &sharedCompilePool() {
+  static TaskPool pool;
+  return pool;
+}
+
+// Layers with pointer-driven content: touchpad mappings and layouts, plus
+// PointerX/PointerY slots in any audio grid.
+uint16_t computePointerLayerMask(const CompiledMapContext &context) {
+  uint16_t mask = 0;
+  auto addLayer = [&mask](int layerId) {
+    if (layerId >= 0 && layerId < 9)
+      mask |= (uint16_t)(1u << layerId);
+  };
+  for (const auto &entry : context.touchpadMappings)
+    addLayer(entry.layerId);
+  for (const auto &strip : context.touchpadMixerStrips)
+    addLayer(strip.layerId);
+  for (const auto &strip : context.touchpadDrumPadStrips)
+    addLayer(strip.layerId);
+  for (const auto &chordPad : context.touchpadChordPads)
+    addLayer(chordPad.layerId);
+
+  static constexpr int pointerSlots[] = {
+      InputTypes::gridSlot(InputTypes::PointerX),
+      InputTypes::gridSlot(InputTypes::PointerY)};
+  auto addGrids = [&](const std::array<std::shared_ptr<const AudioGrid>, 9>
+                          &grids) {
+    for (int layer = 0; layer < 9; ++layer) {
+      const auto &grid = grids[(size_t)layer];
+      if (!grid)
+        continue;
+      for (int slot : pointerSlots)
+        if ((*grid)[(size_t)slot].isActive)
+          addLayer(layer);
+    }
+  };
+  addGrids(context.globalGrids);
+  for (const auto &[hash, grids] : context.deviceGrids)
+    addGrids(grids);
+  return mask;
+}
+
 } // namespace
 
 std::shared_ptr<CompiledMapContext> MappingCompiler::compile(
     PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
     TouchpadLayoutManager &touchpadLayoutMgr, SettingsManager &settingsMgr) {
+  return compile(presetMgr, deviceMgr, zoneMgr, touchpadLayoutMgr, settingsMgr,
+                 nullptr, Scope::all());
+}
+
+std::shared_ptr<CompiledMapContext> MappingCompiler::compile(
+    PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
+    TouchpadLayoutManager &touchpadLayoutMgr, SettingsManager &settingsMgr,
+    const CompiledMapContext *previous, const Scope &scope, TaskPool *pool) {
   auto context = std::make_shared<CompiledMapContext>();
-  compileTouchpadPart(*context, presetMgr, deviceMgr, zoneMgr, touchpadLayoutMgr,
-                     settingsMgr);
-  compileKeyboardPart(*context, presetMgr, deviceMgr, zoneMgr, settingsMgr);
+  TaskPool &tasks = pool != nullptr ? *pool : sharedCompilePool();
+
+  const bool touchpadStale = previous == nullptr || scope.touchpad;
+  if (!touchpadStale) {
+    context->touchpadMappings = previous->touchpadMappings;
+    context->touchpadMixerStrips = previous->touchpadMixerStrips;
+    context->touchpadDrumPadStrips = previous->touchpadDrumPadStrips;
+    context->touchpadChordPads = previous->touchpadChordPads;
+    context->touchpadDrumFxSplits = previous->touchpadDrumFxSplits;
+    context->touchpadLayoutOrder = previous->touchpadLayoutOrder;
+    context->touchpadLayoutIndex = previous->touchpadLayoutIndex;
+  }
+
+  const bool keyboardStale = previous == nullptr || scope.keyboard ||
+                             previous->globalGrids[0] == nullptr;
+  if (!keyboardStale) {
+    context->deviceGrids = previous->deviceGrids;
+    context->globalGrids = previous->globalGrids;
+    context->actionPool = previous->actionPool;
+    context->chordPool = previous->chordPool;
+    context->zoneTable = previous->zoneTable;
+    context->visualLookup = previous->visualLookup;
+    context->visualStrings = previous->visualStrings;
+    context->globalKeysWrittenByLayer = previous->globalKeysWrittenByLayer;
+  }
+
+  // The touchpad and keyboard parts fill disjoint members of the context and
+  // only read the managers, so they compile concurrently.
+  tasks.parallelFor(2, [&](int part) {
+    if (part == 0 && touchpadStale)
+      compileTouchpadPart(*context, presetMgr, deviceMgr, zoneMgr,
+                          touchpadLayoutMgr, settingsMgr);
+    else if (part == 1 && keyboardStale)
+      compileKeyboardPart(*context, presetMgr, deviceMgr, zoneMgr,
+                          settingsMgr, previous, scope, tasks);
+  });
+  context->pointerLayerMask = computePointerLayerMask(*context);
   return context;
 }
 
@@ -1427,14 +1727,17 @@ void MappingCompiler::compileTouchpadPart(CompiledMapContext &context,
   // Collect touchpad mappings (one pass over all layers)
   const uintptr_t touchpadAliasHash = static_cast<uintptr_t>(
       std::hash<juce::String>{}(juce::String("Touchpad").trim()));
+  std::vector<MidiAction> dummyPool;
+  ActionInterner dummyActions(dummyPool);
+  VisualStringPool dummyStrings;
   for (int layerId = 0; layerId < 9; ++layerId) {
     VisualGrid dummyV;
     AudioGrid dummyA;
-    std::vector<bool> touchedKeys(256, false);
+    std::vector<bool> touchedKeys(InputTypes::kGridSlots, false);
     compileMappingsForLayer(dummyV, dummyA, presetMgr, deviceMgr, zoneMgr,
                             settingsMgr, touchpadAliasHash, layerId,
-                            touchedKeys, VisualState::Active,
-                            &context.touchpadMappings);
+                            touchedKeys, dummyActions, dummyStrings,
+                            VisualState::Active, &context.touchpadMappings);
   }
 
   // Collect touchpad mappings defined in the Touchpad tab (TouchpadLayoutManager).
@@ -1581,25 +1884,122 @@ void MappingCompiler::compileTouchpadPart(CompiledMapContext &context,
           {TouchpadType::ChordPad, context.touchpadChordPads.size() - 1});
     }
   }
+
+  buildTouchpadLayoutIndex(context);
+}
+
+void MappingCompiler::buildTouchpadLayoutIndex(CompiledMapContext &context) {
+  auto &index = context.touchpadLayoutIndex;
+  index.candidates.clear();
+  auto addCandidate = [&](TouchpadType type, size_t idx, const auto &e) {
+    TouchpadLayoutIndex::Candidate c;
+    c.type = type;
+    c.index = idx;
+    c.layerId = juce::jlimit(0, 8, e.layerId);
+    c.layoutGroupId = e.layoutGroupId;
+    c.regionLeft = e.regionLeft;
+    c.regionTop = e.regionTop;
+    c.regionRight = e.regionRight;
+    c.regionBottom = e.regionBottom;
+    index.candidates.push_back(c);
+  };
+  for (const auto &ref : context.touchpadLayoutOrder) {
+    if (ref.type == TouchpadType::Mixer &&
+        ref.index < context.touchpadMixerStrips.size()) {
+      addCandidate(ref.type, ref.index,
+                   context.touchpadMixerStrips[ref.index]);
+    } else if (ref.type == TouchpadType::DrumPad &&
+               ref.index < context.touchpadDrumPadStrips.size()) {
+      const auto &s = context.touchpadDrumPadStrips[ref.index];
+      if (s.numPads > 0) // Empty pads never take a contact
+        addCandidate(ref.type, ref.index, s);
+    } else if (ref.type == TouchpadType::ChordPad &&
+               ref.index < context.touchpadChordPads.size()) {
+      addCandidate(ref.type, ref.index, context.touchpadChordPads[ref.index]);
+    }
+  }
+
+  // Counting sort into buckets; candidates are visited in z-order so each
+  // bucket list stays in z-order. A region's right/bottom edge is exclusive,
+  // so its last bucket may be one too many (harmless: contains() decides).
+  constexpr int G = TouchpadLayoutIndex::kGridSize;
+  auto forEachBucket = [](const TouchpadLayoutIndex::Candidate &c,
+                          auto &&fn) {
+    const int x0 = TouchpadLayoutIndex::bucketCoord(c.regionLeft);
+    const int x1 = TouchpadLayoutIndex::bucketCoord(c.regionRight);
+    const int y0 = TouchpadLayoutIndex::bucketCoord(c.regionTop);
+    const int y1 = TouchpadLayoutIndex::bucketCoord(c.regionBottom);
+    for (int y = y0; y <= y1; ++y)
+      for (int x = x0; x <= x1; ++x)
+        fn((size_t)(y * G + x));
+  };
+  index.bucketStart.assign((size_t)(G * G) + 1, 0);
+  for (const auto &c : index.candidates)
+    forEachBucket(c, [&](size_t b) { ++index.bucketStart[b + 1]; });
+  for (size_t b = 0; b < (size_t)(G * G); ++b)
+    index.bucketStart[b + 1] += index.bucketStart[b];
+  index.bucketEntries.assign(index.bucketStart.back(), 0);
+  std::vector<uint32_t> fill(index.bucketStart.begin(),
+                             index.bucketStart.end() - 1);
+  for (size_t i = 0; i < index.candidates.size(); ++i)
+    forEachBucket(index.candidates[i], [&](size_t b) {
+      index.bucketEntries[fill[b]++] = (uint32_t)i;
+    });
 }
 
 void MappingCompiler::compileKeyboardPart(CompiledMapContext &context,
     PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
-    SettingsManager &settingsMgr) {
+    SettingsManager &settingsMgr, const CompiledMapContext *previous,
+    const Scope &scope, TaskPool &tasks) {
+  // Incremental: reused grids keep their actionIndex/chordIndex/zoneIndex
+  // into the previous pools, so carry the pools over and append. Fall back to
+  // a full keyboard compile once stale entries have piled up.
+  constexpr size_t kMaxReusedChordPool = 16384;
+  constexpr size_t kMaxReusedActionPool = 16384;
+  const int fromLayer = juce::jlimit(0, 9, scope.fromLayer);
+  const bool reuse =
+      previous != nullptr && (fromLayer > 0 || scope.aliasHash != 0) &&
+      previous->globalGrids[0] != nullptr &&
+      previous->visualLookup.count(0) != 0 &&
+      previous->chordPool.size() <= kMaxReusedChordPool &&
+      previous->actionPool.size() <= kMaxReusedActionPool;
+  if (reuse) {
+    context.actionPool = previous->actionPool;
+    context.visualStrings = previous->visualStrings;
+    context.chordPool = previous->chordPool;
+    context.zoneTable = previous->zoneTable;
+  }
+  // Global stack layers below this are reused as-is.
+  const int globalFrom = !reuse ? 0 : (scope.aliasHash != 0 ? 9 : fromLayer);
+  auto aliasLayerReusable = [&](uintptr_t devHash, int L) {
+    if (!reuse || (L >= fromLayer && (scope.aliasHash == 0 ||
+                                      scope.aliasHash == devHash)))
+      return false;
+    auto itV = previous->visualLookup.find(devHash);
+    auto itA = previous->deviceGrids.find(devHash);
+    return itV != previous->visualLookup.end() && itV->second.size() == 9 &&
+           itV->second[(size_t)L] && itA != previous->deviceGrids.end() &&
+           itA->second[(size_t)L];
+  };
+
+  ActionInterner actions(context.actionPool);
+
   // Collect Base-layer mappings that should apply on all layers.
   std::unordered_map<uintptr_t, std::vector<ForcedMapping>> forcedByAlias;
   collectForcedMappings(presetMgr, deviceMgr, zoneMgr, settingsMgr,
-                        forcedByAlias);
+                        context.visualStrings, forcedByAlias);
 
   // Define Helper Lambda "applyLayerToGrid"
   // Phase 53.5: targetState = Active for current layer, Inherited for lower
   // layer (device Pass 2). keysWrittenOut: optional, record keys written by
-  // this layer for "private to layer" stripping.
-  auto applyLayerToGrid = [&](VisualGrid &vGrid, AudioGrid &aGrid, int layerId,
+  // this layer for "private to layer" stripping. Only reads shared state;
+  // everything it appends goes to `pools`.
+  auto applyLayerToGrid = [&](LayerPools &pools, VisualGrid &vGrid,
+                              AudioGrid &aGrid, int layerId,
                               uintptr_t aliasHash,
                               VisualState targetState = VisualState::Active,
                               std::vector<bool> *keysWrittenOut = nullptr) {
-    std::vector<bool> touchedKeys(256, false);
+    std::vector<bool> touchedKeys(InputTypes::kGridSlots, false);
 
     auto itForced = forcedByAlias.find(aliasHash);
     if (itForced != forcedByAlias.end()) {
@@ -1607,22 +2007,28 @@ void MappingCompiler::compileKeyboardPart(CompiledMapContext &context,
         const int key = fm.inputKey;
         if (key < 0 || key >= (int)vGrid.size())
           continue;
-        applyVisualWithModifiers(vGrid, key, fm.color, fm.label, fm.sourceName,
-                                 &touchedKeys, targetState, fm.keyboardGroupId);
+        // Ids are valid in the context's pool and every pool layered over it.
+        VisualText text = fm.text;
+        text.strings = &pools.strings;
+        applyVisualWithModifiers(vGrid, key, fm.color, text, &touchedKeys,
+                                 targetState, fm.keyboardGroupId);
         if (vGrid[(size_t)key].state != VisualState::Conflict) {
-          writeAudioSlot(aGrid, key, fm.action, fm.keyboardGroupId);
+          writeAudioSlot(aGrid, key, fm.action, fm.keyboardGroupId,
+                         pools.actions);
         }
       }
     }
 
     compileZonesForLayer(vGrid, aGrid, zoneMgr, deviceMgr, aliasHash, layerId,
-                         touchedKeys, context.chordPool, targetState,
-                         keysWrittenOut);
+                         touchedKeys, pools, targetState, keysWrittenOut);
 
     compileMappingsForLayer(vGrid, aGrid, presetMgr, deviceMgr, zoneMgr,
                             settingsMgr, aliasHash, layerId, touchedKeys,
-                            targetState, nullptr, keysWrittenOut);
+                            pools.actions, pools.strings, targetState,
+                            nullptr, keysWrittenOut);
   };
+  LayerPools contextPools{context.chordPool, context.zoneTable, actions,
+                          context.visualStrings};
 
   // PASS 1: Compile Global Stack (Vertical) – Hash 0 only
   // Layer inheritance: soloLayer, passthruInheritance, privateToLayer.
@@ -1630,9 +2036,9 @@ void MappingCompiler::compileKeyboardPart(CompiledMapContext &context,
   context.visualLookup[globalHash].resize(9);
 
   std::array<int, 9> effectiveBaseIndex{};
-  std::array<std::vector<bool>, 9> keysWrittenByLayer;
+  auto &keysWrittenByLayer = context.globalKeysWrittenByLayer;
   for (size_t i = 0; i < 9; ++i)
-    keysWrittenByLayer[i].resize(256, false);
+    keysWrittenByLayer[i].assign(InputTypes::kGridSlots, false);
 
   for (int L = 0; L < 9; ++L) {
     auto layerNode = presetMgr.getLayerNode(L);
@@ -1645,6 +2051,21 @@ void MappingCompiler::compileKeyboardPart(CompiledMapContext &context,
         layerNode.isValid() &&
         (bool)layerNode.getProperty("privateToLayer", false);
 
+    if (soloLayer || passthruInheritance)
+      effectiveBaseIndex[(size_t)L] =
+          L > 0 ? effectiveBaseIndex[(size_t)(L - 1)] : 0;
+    else
+      effectiveBaseIndex[(size_t)L] = L;
+
+    if (L < globalFrom) {
+      context.visualLookup[globalHash][(size_t)L] =
+          previous->visualLookup.at(globalHash)[(size_t)L];
+      context.globalGrids[(size_t)L] = previous->globalGrids[(size_t)L];
+      keysWrittenByLayer[(size_t)L] =
+          previous->globalKeysWrittenByLayer[(size_t)L];
+      continue;
+    }
+
     auto vGrid = std::make_shared<VisualGrid>();
     auto aGrid = std::make_shared<AudioGrid>();
 
@@ -1678,85 +2099,120 @@ void MappingCompiler::compileKeyboardPart(CompiledMapContext &context,
         }
       }
 
-      for (size_t keyCode = 0; keyCode < 256; ++keyCode) {
+      for (size_t keyCode = 0; keyCode < aGrid->size(); ++keyCode) {
         const auto &aSlot = (*aGrid)[keyCode];
-        if (aSlot.isActive && isLayerCommand(aSlot.action)) {
+        if (aSlot.isActive && isLayerCommand(aSlot.type, aSlot.data1)) {
           (*vGrid)[keyCode].state = VisualState::Empty;
           (*vGrid)[keyCode].displayColor = juce::Colours::transparentBlack;
-          (*vGrid)[keyCode].label.clear();
-          (*vGrid)[keyCode].sourceName.clear();
-          (*aGrid)[keyCode].isActive = false;
-          (*aGrid)[keyCode].chordIndex = -1;
+          (*vGrid)[keyCode].labelId = 0;
+          (*vGrid)[keyCode].sourceNameId = 0;
+          (*aGrid)[keyCode] = KeyAudioSlot{};
         }
       }
     }
 
     std::fill(keysWrittenByLayer[(size_t)L].begin(),
               keysWrittenByLayer[(size_t)L].end(), false);
-    applyLayerToGrid(*vGrid, *aGrid, L, globalHash, VisualState::Active,
-                     &keysWrittenByLayer[(size_t)L]);
-
-    if (soloLayer || passthruInheritance)
-      effectiveBaseIndex[(size_t)L] =
-          L > 0 ? effectiveBaseIndex[(size_t)(L - 1)] : 0;
-    else
-      effectiveBaseIndex[(size_t)L] = L;
+    applyLayerToGrid(contextPools, *vGrid, *aGrid, L, globalHash,
+                     VisualState::Active, &keysWrittenByLayer[(size_t)L]);
 
     context.visualLookup[globalHash][(size_t)L] = vGrid;
     context.globalGrids[(size_t)L] = aGrid;
   }
 
   // 4. PASS 2: Compile Device Stacks (Horizontal – Device inherits Global,
-  // then applies device-specific layers 0..L)
-  juce::StringArray aliases = deviceMgr.getAllAliasNames();
-  for (const auto &aliasName : aliases) {
+  // then applies device-specific layers 0..L). Each (alias, layer) grid only
+  // depends on the finished global stack, so they compile as parallel tasks
+  // into private pools, merged afterwards in alias/layer order.
+  struct AliasStack {
+    juce::String name;
+    uintptr_t hash = 0;
+  };
+  std::vector<AliasStack> aliasStacks;
+  for (const auto &aliasName : deviceMgr.getAllAliasNames()) {
     uintptr_t devHash =
         static_cast<uintptr_t>(std::hash<juce::String>{}(aliasName.trim()));
-    if (devHash == 0)
-      continue;
-
-    context.visualLookup[devHash].resize(9);
+    if (devHash != 0)
+      aliasStacks.push_back({aliasName, devHash});
+  }
 
-    for (int L = 0; L < 9; ++L) {
-      auto vGrid = std::make_shared<VisualGrid>();
-      auto aGrid = std::make_shared<AudioGrid>();
+  PoolBases bases;
+  bases.actions = (int)context.actionPool.size();
+  bases.chords = (int)context.chordPool.size();
+  bases.zones = (int)context.zoneTable.size();
+  bases.strings = (VisualStringPool::Id)context.visualStrings.size();
+  const auto &globalVisuals = context.visualLookup[globalHash];
+
+  std::vector<AliasLayerResult> results(aliasStacks.size() * 9);
+  tasks.parallelFor((int)results.size(), [&](int task) {
+    const uintptr_t devHash = aliasStacks[(size_t)task / 9].hash;
+    const int L = task % 9;
+    if (aliasLayerReusable(devHash, L))
+      return;
+
+    auto &result = results[(size_t)task];
+    result.strings = VisualStringPool::layeredOver(context.visualStrings);
+    ActionInterner localActions(result.actionPool, bases.actions);
+    LayerPools pools{result.chordPool, result.zoneTable, localActions,
+                     result.strings, bases.chords, &context.zoneTable};
+
+    // STEP A: INHERIT FROM GLOBAL AT THIS LAYER
+    auto vGrid = std::make_shared<VisualGrid>(*globalVisuals[(size_t)L]);
+    auto aGrid =
+        std::make_shared<AudioGrid>(*context.globalGrids[(size_t)L]);
+
+    // VISUAL TRANSITION: Global data is "Inherited" from the device's
+    // perspective
+    for (auto &slot : *vGrid) {
+      if (slot.state != VisualState::Empty) {
+        slot.state = VisualState::Inherited;
+        slot.displayColor =
+            slot.displayColor.withAlpha(static_cast<juce::uint8>(76));
+      }
+    }
 
-      // STEP A: INHERIT FROM GLOBAL AT THIS LAYER
-      *vGrid = *context.visualLookup[globalHash][(size_t)L];
-      *aGrid = *context.globalGrids[(size_t)L];
+    // STEP B: APPLY DEVICE SPECIFIC STACK (0 to L)
+    // Phase 53.5: k < L = lower layer content -> Inherited (dim); k == L =
+    // current layer -> Active.
+    for (int k = 0; k <= L; ++k) {
+      VisualState stateForPass =
+          (k < L) ? VisualState::Inherited : VisualState::Active;
+      applyLayerToGrid(pools, *vGrid, *aGrid, k, devHash, stateForPass);
+    }
 
-      // VISUAL TRANSITION: Global data is "Inherited" from the device's
-      // perspective
-      for (auto &slot : *vGrid) {
-        if (slot.state != VisualState::Empty) {
-          slot.state = VisualState::Inherited;
-          slot.displayColor =
-              slot.displayColor.withAlpha(static_cast<juce::uint8>(76));
-        }
-      }
+    result.visual = vGrid;
+    result.audio = aGrid;
+  });
 
-      // STEP B: APPLY DEVICE SPECIFIC STACK (0 to L)
-      // Phase 53.5: k < L = lower layer content -> Inherited (dim); k == L =
-      // current layer -> Active.
-      for (int k = 0; k <= L; ++k) {
-        VisualState stateForPass =
-            (k < L) ? VisualState::Inherited : VisualState::Active;
-        applyLayerToGrid(*vGrid, *aGrid, k, devHash, stateForPass);
+  for (size_t s = 0; s < aliasStacks.size(); ++s) {
+    const uintptr_t devHash = aliasStacks[s].hash;
+    auto &visualStack = context.visualLookup[devHash];
+    auto &audioStack = context.deviceGrids[devHash];
+    visualStack.resize(9);
+
+    for (size_t L = 0; L < 9; ++L) {
+      auto &result = results[s * 9 + L];
+      if (result.visual == nullptr) {
+        visualStack[L] = previous->visualLookup.at(devHash)[L];
+        audioStack[L] = previous->deviceGrids.at(devHash)[L];
+        continue;
       }
-
-      context.visualLookup[devHash][(size_t)L] = vGrid;
-      context.deviceGrids[devHash][(size_t)L] = aGrid;
+      mergeAliasLayer(result, bases, context, actions);
+      visualStack[L] = result.visual;
+      audioStack[L] = result.audio;
     }
 
     // Phase 53.9: InputProcessor looks up by hardware ID; store grids under
     // each hardware ID for this alias so processEvent finds device-specific
     // mappings.
-    auto hardwareIds = deviceMgr.getHardwareForAlias(aliasName);
+    auto hardwareIds = deviceMgr.getHardwareForAlias(aliasStacks[s].name);
     for (auto hwId : hardwareIds) {
       if (hwId != 0)
-        context.deviceGrids[hwId] = context.deviceGrids[devHash];
+        context.deviceGrids[hwId] = audioStack;
     }
   }
+
+  shareIdenticalAudioGrids(context);
 }
 
 // ---------------------------------------------------------------------------
@@ -1770,6 +2226,7 @@ void MappingCompiler::compileZones(CompiledMapContext &context,
   const int globalDeg = zoneMgr.getGlobalDegreeTranspose();
 
   const auto zones = zoneMgr.getZones();
+  ActionInterner actions(context.actionPool);
 
   for (const auto &zone : zones) {
     if (!zone)
@@ -1822,14 +2279,15 @@ void MappingCompiler::compileZones(CompiledMapContext &context,
 
       // AUDIO TARGETING -----------------------------------------------------
       const int zoneKbGroupId = zone->keyboardGroupId;
+      const int zoneIndex = internZone(context.zoneTable, zone);
       auto writeZoneAudioSlot = [&](AudioGrid &grid) {
         if (keyCode < 0 || keyCode >= (int)grid.size())
           return;
 
         auto &slot = grid[(size_t)keyCode];
-        slot.isActive = true;
-        slot.action = rootAction;
+        setSlotAction(slot, rootAction, actions);
         slot.chordIndex = chordIndex;
+        slot.zoneIndex = zoneIndex;
         slot.keyboardGroupId = zoneKbGroupId;
 
         // Generic modifier replication for zones.
@@ -1894,11 +2352,12 @@ void MappingCompiler::compileZones(CompiledMapContext &context,
           *std::const_pointer_cast<VisualGrid>(layerVec[(size_t)layerId]);
 
       juce::Colour color = zone->zoneColor;
-      juce::String label = zone->getKeyLabel(keyCode);
-      juce::String sourceName = "Zone: " + zone->name;
+      const VisualText text =
+          internVisualText(context.visualStrings, zone->getKeyLabel(keyCode),
+                           "Zone: " + zone->name);
 
-      applyVisualWithModifiers(visualGrid, keyCode, color, label, sourceName,
-                              nullptr, VisualState::Active, zone->keyboardGroupId);
+      applyVisualWithModifiers(visualGrid, keyCode, color, text, nullptr,
+                               VisualState::Active, zone->keyboardGroupId);
     }
   }
 }
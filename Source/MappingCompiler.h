@@ -8,25 +8,72 @@
 #include "ZoneManager.h"
 #include <memory>
 
+class TaskPool;
+
 // Phase 50.2 / 50.3: MappingCompiler
 // Responsible for converting the current preset / device / zone state
 // into a static CompiledMapContext (AudioGrid + VisualGrid structures).
 // Compiles both keyboard mappings/zones and touchpad layouts.
 class MappingCompiler {
 public:
+  // Incremental rebuild: which parts of a previous context are stale.
+  // Everything outside the scope is reused from the previous context by
+  // shared_ptr (grids) or copy (touchpad entries).
+  struct Scope {
+    bool touchpad = true; // Touchpad mappings + layouts
+    bool keyboard = true; // Keyboard grids
+    // First keyboard layer to recompile; higher layers inherit from lower
+    // ones so they are always recompiled too.
+    int fromLayer = 0;
+    // 0 = global stack (and therefore every alias stack, which inherits it);
+    // otherwise only that alias's device stack.
+    uintptr_t aliasHash = 0;
+
+    static Scope all() { return {}; }
+    static Scope touchpadOnly() {
+      Scope s;
+      s.keyboard = false;
+      return s;
+    }
+    static Scope keyboardOnly(int fromLayer = 0, uintptr_t aliasHash = 0) {
+      Scope s;
+      s.touchpad = false;
+      s.fromLayer = fromLayer;
+      s.aliasHash = aliasHash;
+      return s;
+    }
+    bool isFull() const {
+      return touchpad && keyboard && fromLayer == 0 && aliasHash == 0;
+    }
+  };
+
   // Build a new compiled context snapshot from the current engine state.
   static std::shared_ptr<CompiledMapContext>
   compile(PresetManager &presetMgr, DeviceManager &deviceMgr,
           ZoneManager &zoneMgr, TouchpadLayoutManager &touchpadLayoutMgr,
           SettingsManager &settingsMgr);
 
+  // Rebuild only `scope`, reusing the rest of `previous` (full compile when
+  // previous is null). The touchpad part, the keyboard part and each
+  // (alias, layer) device grid compile as tasks on `pool` (null: a shared
+  // process-wide pool); the result does not depend on the thread count.
+  // The managers are only read, and must not be modified meanwhile.
+  static std::shared_ptr<CompiledMapContext>
+  compile(PresetManager &presetMgr, DeviceManager &deviceMgr,
+          ZoneManager &zoneMgr, TouchpadLayoutManager &touchpadLayoutMgr,
+          SettingsManager &settingsMgr, const CompiledMapContext *previous,
+          const Scope &scope, TaskPool *pool = nullptr);
+
 private:
   static void compileTouchpadPart(CompiledMapContext &context,
       PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
       TouchpadLayoutManager &touchpadLayoutMgr, SettingsManager &settingsMgr);
+  // Fills context.touchpadLayoutIndex from touchpadLayoutOrder.
+  static void buildTouchpadLayoutIndex(CompiledMapContext &context);
   static void compileKeyboardPart(CompiledMapContext &context,
       PresetManager &presetMgr, DeviceManager &deviceMgr, ZoneManager &zoneMgr,
-      SettingsManager &settingsMgr);
+      SettingsManager &settingsMgr, const CompiledMapContext *previous,
+      const Scope &scope, TaskPool &tasks);
   // Phase 50.3: Bake zones into the grids (processed before manual mappings).
   static void compileZones(CompiledMapContext &context, ZoneManager &zoneMgr,
                            DeviceManager &deviceMgr, int layerId);
@@ -9,8 +9,10 @@
 #include <unordered_map>
 #include <vector>
 
+class Zone;
+
 // Action types for MIDI mapping
-enum class ActionType {
+enum class ActionType : uint8_t {
   Note,       // MIDI Note
   Expression, // Phase 56.1: Unified CC + Envelope (key/button → CC or PB)
   Command,    // Sustain/Latch/Panic (data1 = CommandID)
@@ -102,6 +104,30 @@ constexpr int Key_LControl = 0xA2;
 constexpr int Key_RControl = 0xA3;
 constexpr int Key_LAlt = 0xA4;
 constexpr int Key_RAlt = 0xA5;
+
+// Compiled grids hold the 256 VK codes followed by a dense block for the
+// sparse non-keyboard codes above, so scroll and pointer mappings go through
+// the same layered lookup as keys.
+constexpr int kKeySlots = 256;
+constexpr int kGridSlots = kKeySlots + 4;
+
+// Grid slot for an input code, or -1 if the grids have no slot for it.
+constexpr int gridSlot(int inputCode) {
+  if (inputCode >= 0 && inputCode < kKeySlots)
+    return inputCode;
+  switch (inputCode) {
+  case ScrollUp:
+    return kKeySlots;
+  case ScrollDown:
+    return kKeySlots + 1;
+  case PointerX:
+    return kKeySlots + 2;
+  case PointerY:
+    return kKeySlots + 3;
+  default:
+    return -1;
+  }
+}
 } // namespace InputTypes
 
 // Touchpad mapping events (0-10). Used when inputAlias == "Touchpad".
@@ -146,6 +172,8 @@ struct AdsrSettings {
     return target == AdsrTarget::PitchBend ||
            target == AdsrTarget::SmartScaleBend;
   }
+
+  bool operator==(const AdsrSettings &) const = default;
 };
 
 // Represents a MIDI action to be performed
@@ -198,6 +226,9 @@ struct MidiAction {
   // Keyboard layout group solo parameters (for CommandID::KeyboardLayoutGroupSolo*)
   int keyboardLayoutGroupId = 0;
   int keyboardSoloScope = 0;
+
+  // Field-wise; the compiler interns identical actions into one pool entry.
+  bool operator==(const MidiAction &) const = default;
 };
 
 // Represents a unique input source (device + key)
@@ -271,34 +302,107 @@ struct SimulationResult {
 // ---------------------------------------------------------------------------
 
 // Lightweight atom for the Audio Thread.
-// For simple mappings, 'action' is used directly.
+// Hot/cold split: the slot keeps only what a layer probe needs (24 bytes, so
+// a grid is 6KB instead of one full MidiAction per key). The full action
+// lives once in CompiledContext::actionPool (see actionFor()); identical
+// actions across keys, layers and aliases share one pool entry.
 // For chords or complex sequences, 'chordIndex' points into
 // CompiledContext::chordPool.
 struct KeyAudioSlot {
+  ActionType type = ActionType::Note; // Mirrors actionFor(slot).type
+  uint8_t channel = 0;                // Mirrors action.channel
   bool isActive = false;
-  MidiAction action; // The primary action
+  int16_t data1 = 0; // Mirrors action.data1 (note / CC / CommandID)
+  int16_t data2 = 0; // Mirrors action.data2 (velocity / value / layer)
+
+  // Index into CompiledContext::actionPool; -1 while inactive.
+  int32_t actionIndex = -1;
 
   // For Chords or complex sequences, we index into a pool in CompiledContext.
-  // -1 means use 'action' directly. >= 0 means look up chordPool[chordIndex].
-  int chordIndex = -1;
+  // -1 means play the action alone. >= 0 means look up chordPool[chordIndex].
+  int32_t chordIndex = -1;
 
   // 0 = no group, >0 = PresetManager keyboard group id (for solo filtering)
-  int keyboardGroupId = 0;
+  int32_t keyboardGroupId = 0;
+
+  // Owning zone for zone-compiled slots: index into CompiledContext::zoneTable.
+  // -1 = manual mapping (no zone behaviour). Resolved at compile time so
+  // key-down never needs alias strings or ZoneManager lookups.
+  int32_t zoneIndex = -1;
+
+  // Content equality (grid hash-consing)
+  bool operator==(const KeyAudioSlot &) const = default;
+};
+static_assert(sizeof(KeyAudioSlot) <= 32, "KeyAudioSlot must stay compact");
+
+// Interned strings for visual grids (labels, source names). Filled by the
+// compiler, read-only once the context is published. Id 0 is the empty
+// string, so a default KeyVisualSlot needs no lookup.
+class VisualStringPool {
+public:
+  using Id = uint32_t;
+
+  VisualStringPool() { strings.emplace_back(); }
+
+  // Task-local pool over a shared one, which must not change meanwhile: texts
+  // already in sharedPool keep their ids, new ones are numbered after them.
+  static VisualStringPool layeredOver(const VisualStringPool &sharedPool) {
+    VisualStringPool pool;
+    pool.strings.clear();
+    pool.shared = &sharedPool;
+    pool.base = static_cast<Id>(sharedPool.size());
+    return pool;
+  }
+
+  Id intern(const juce::String &text) {
+    if (text.isEmpty())
+      return 0;
+    if (shared != nullptr) {
+      auto it = shared->index.find(text);
+      if (it != shared->index.end())
+        return it->second;
+    }
+    auto it = index.find(text);
+    if (it != index.end())
+      return it->second;
+    const Id id = base + static_cast<Id>(strings.size());
+    strings.push_back(text);
+    index.emplace(text, id);
+    return id;
+  }
+
+  const juce::String &get(Id id) const {
+    if (shared != nullptr && id < base)
+      return shared->get(id);
+    return id - base < strings.size() ? strings[id - base] : get(0);
+  }
+
+  // Next id to be assigned (base + own entries).
+  size_t size() const { return base + strings.size(); }
+
+private:
+  const VisualStringPool *shared = nullptr;
+  Id base = 0;
+  std::vector<juce::String> strings;
+  std::unordered_map<juce::String, Id> index;
 };
 
-// Rich data for the UI / Visualizer thread.
+// Rich data for the UI / Visualizer thread. Text is stored as ids into
+// CompiledContext::visualStrings (resolve with labelFor / sourceNameFor), so
+// copying a grid per layer/alias copies plain values, not 512 strings.
 struct KeyVisualSlot {
   VisualState state = VisualState::Empty;
   juce::Colour displayColor = juce::Colours::transparentBlack;
-  juce::String label;      // Pre-calculated text (e.g., "C# Maj7")
-  juce::String sourceName; // e.g., "Zone: Main", "Mapping: Base"
+  VisualStringPool::Id labelId = 0;      // Pre-calculated text ("C# Maj7")
+  VisualStringPool::Id sourceNameId = 0; // "Zone: Main", "Mapping: Base"
   bool isGhost = false;    // Phase 54.1: Ghost note (quieter, dimmed in UI)
   int keyboardGroupId = 0; // 0 = no group, >0 = PresetManager keyboard group id (for solo filtering)
 };
 
-// 256 slots covering all Virtual Key Codes (0x00 - 0xFF)
-using AudioGrid = std::array<KeyAudioSlot, 256>;
-using VisualGrid = std::array<KeyVisualSlot, 256>;
+// 256 slots covering all Virtual Key Codes (0x00 - 0xFF), then the
+// non-keyboard inputs (index with InputTypes::gridSlot)
+using AudioGrid = std::array<KeyAudioSlot, InputTypes::kGridSlots>;
+using VisualGrid = std::array<KeyVisualSlot, InputTypes::kGridSlots>;
 
 // Touchpad pitch-pad configuration for Expression -> PitchBend/SmartScaleBend.
 // This is interpreted in "step space" where each integer step corresponds to
@@ -360,6 +464,27 @@ struct PitchPadLayout {
   std::vector<PitchPadBand> bands;
 };
 
+// Fixed-resolution bake of a PitchPadLayout (bakePitchPadTable): the step at
+// each of kSize evenly spaced X positions, so a contact sample is one
+// multiply and one load instead of a band walk. Absolute PitchBend pads also
+// bake the final 14-bit bend, valid while the global PB range equals
+// pitchBendRange.
+struct PitchPadTable {
+  static constexpr int kSize = 4096;
+
+  std::array<float, kSize> steps{};
+  std::vector<uint16_t> pitchBend; // Empty unless Absolute PitchBend
+  int pitchBendRange = 0;
+
+  static int indexFor(float x01) {
+    return (int)(juce::jlimit(0.0f, 1.0f, x01) * (float)(kSize - 1) + 0.5f);
+  }
+  float stepAt(float x01) const { return steps[(size_t)indexFor(x01)]; }
+  int pitchBendAt(float x01) const {
+    return pitchBend[(size_t)indexFor(x01)];
+  }
+};
+
 // Conversion parameters for touchpad mappings (use only fields for the kind)
 struct TouchpadConversionParams {
   float threshold = 0.5f;
@@ -390,6 +515,8 @@ struct TouchpadConversionParams {
   std::optional<PitchPadConfig> pitchPadConfig;
   // Pre-built layout for pitchPadConfig (avoids rebuilding every frame).
   std::optional<PitchPadLayout> cachedPitchPadLayout;
+  // Baked lookup for cachedPitchPadLayout (shared: entries are copied).
+  std::shared_ptr<const PitchPadTable> pitchPadTable;
 
   // EncoderCC fields
   uint8_t encoderAxis = 0;              // 0=Vertical, 1=Horizontal, 2=Both
@@ -453,15 +580,26 @@ struct CompiledContext {
   // Global fallback: 9 AudioGrids (one per layer 0..8)
   std::array<std::shared_ptr<const AudioGrid>, 9> globalGrids;
 
+  // Full actions referenced by KeyAudioSlot::actionIndex (interned: one
+  // entry per distinct action). Identical grids are shared between aliases
+  // and hardware IDs, so deviceGrids entries may alias globalGrids.
+  std::vector<MidiAction> actionPool;
+
   // Pool for complex chords (referenced by KeyAudioSlot::chordIndex)
   // Vector of MidiActions (one vector per chord)
   std::vector<std::vector<MidiAction>> chordPool;
 
+  // Zones referenced by KeyAudioSlot::zoneIndex. Holding shared_ptrs keeps each
+  // zone alive for as long as this context is in use by the input thread.
+  std::vector<std::shared_ptr<Zone>> zoneTable;
+
   // 2. Visual Data (Read by Visualizer/MessageThread)
   // Map AliasHash -> LayerID (0-8) -> VisualGrid
   // Using vector for layers for O(1) access [0..8]
   std::unordered_map<uintptr_t, std::vector<std::shared_ptr<const VisualGrid>>>
       visualLookup;
+  // Labels and source names referenced by KeyVisualSlot ids.
+  VisualStringPool visualStrings;
 
   // 3. Touchpad mappings (alias "Touchpad"); applied by InputProcessor
   std::vector<TouchpadMappingEntry> touchpadMappings;
@@ -486,6 +624,30 @@ struct CompiledContext {
     size_t index = 0;
   };
   std::vector<TouchpadLayoutRef> touchpadLayoutOrder;
+  // Bucketed hit-test index over touchpadLayoutOrder (contact -> layout).
+  TouchpadLayoutIndex touchpadLayoutIndex;
+
+  // Bit L set when layer L has pointer-driven content (touchpad mappings or
+  // layouts, PointerX/PointerY grid slots). Filled at the end of every
+  // compile so the per-frame hasPointerMappings check is one AND.
+  uint16_t pointerLayerMask = 0;
+
+  // 8. Compiler bookkeeping for incremental rebuilds (not read at runtime):
+  // keys written by each global-stack layer ("private to layer" stripping).
+  std::array<std::vector<bool>, 9> globalKeysWrittenByLayer;
+
+  // Full action for an active grid slot.
+  const MidiAction &actionFor(const KeyAudioSlot &slot) const {
+    return actionPool[(size_t)slot.actionIndex];
+  }
+
+  // Text of a visual slot.
+  const juce::String &labelFor(const KeyVisualSlot &slot) const {
+    return visualStrings.get(slot.labelId);
+  }
+  const juce::String &sourceNameFor(const KeyVisualSlot &slot) const {
+    return visualStrings.get(slot.sourceNameId);
+  }
 };
 
 // Backward-compatible alias used in development docs/prompts.
@@ -1,73 +1,130 @@
 #include "MidiEngine.h"
 #include "SettingsManager.h"
+#include <algorithm>
+#include <cmath>
+
+// Single consumer of outputQueue. Keeps future-timestamped messages in a
+// min-heap (ordered by time, then enqueue order) and sends everything due in
+// one sendBlockOfMessagesNow batch.
+class MidiEngine::OutputThread : public juce::Thread {
+public:
+  explicit OutputThread(MidiEngine &owner)
+      : juce::Thread("MIDIQy MIDI Output"), engine(owner) {
+    pending.reserve(engine.outputQueue.capacity());
+    batch.ensureSize(256);
+  }
 
-MidiEngine::MidiEngine(SettingsManager *settingsMgr)
-    : settingsManager(settingsMgr) {
-  if (settingsManager) {
-    settingsManager->addChangeListener(this);
-    cachedDelayMidiEnabled = settingsManager->isDelayMidiEnabled();
+  ~OutputThread() override {
+    signalThreadShouldExit();
+    wake.signal();
+    stopThread(2000);
   }
-}
 
-MidiEngine::~MidiEngine() {
-  stopTimer();
-  if (settingsManager)
-    settingsManager->removeChangeListener(this);
-  // std::unique_ptr automatically closes the device on destruction
-}
+  void notify() { wake.signal(); }
 
-void MidiEngine::changeListenerCallback(juce::ChangeBroadcaster *source) {
-  if (source == settingsManager && settingsManager)
-    cachedDelayMidiEnabled = settingsManager->isDelayMidiEnabled();
-}
+  void run() override {
+    while (!threadShouldExit()) {
+      drainQueue();
 
-void MidiEngine::queueOrSendNow(const juce::MidiMessage &msg) {
-  if (!cachedDelayMidiEnabled) {
-    sendImmediately(msg);
-    return;
-  }
-  if (!currentOutput)
-    return;
+      const double now = juce::Time::getMillisecondCounterHiRes();
+      batch.clear();
+      int sampleIndex = 0;
+      while (!pending.empty() && pending.front().msg.sendAtMs <= now) {
+        std::pop_heap(pending.begin(), pending.end(), Later{});
+        const auto &m = pending.back().msg;
+        batch.addEvent(m.bytes, (int)m.size, sampleIndex++);
+        pending.pop_back();
+      }
+      if (!batch.isEmpty()) {
+        const juce::ScopedLock sl(engine.outputLock);
+        if (engine.currentOutput)
+          engine.currentOutput->sendBlockOfMessagesNow(batch);
+      }
 
-  const double nowMs = juce::Time::getMillisecondCounterHiRes();
-  const int delaySec =
-      juce::jlimit(1, 10, settingsManager->getDelayMidiSeconds());
-  const double sendAtMs = nowMs + delaySec * 1000.0;
+      if (pending.empty()) {
+        wake.wait(-1);
+        continue;
+      }
+      // Sleep to ~1 ms before the next timestamp, then yield-spin so
+      // scheduled notes (strum spacing) land on time rather than on the OS
+      // timer tick.
+      const double remainingMs = pending.front().msg.sendAtMs - now;
+      if (remainingMs > 1.5)
+        wake.wait((int)std::floor(remainingMs - 1.0));
+      else
+        juce::Thread::yield();
+    }
+  }
 
-  {
-    const juce::ScopedLock sl(delayQueueLock);
-    delayQueue.push_back({msg, sendAtMs});
+private:
+  struct Entry {
+    MidiOutputQueue::Message msg;
+    uint64_t seq = 0;
+  };
+  struct Later {
+    bool operator()(const Entry &a, const Entry &b) const {
+      if (a.msg.sendAtMs != b.msg.sendAtMs)
+        return a.msg.sendAtMs > b.msg.sendAtMs;
+      return a.seq > b.seq;
+    }
+  };
+
+  void drainQueue() {
+    Entry e;
+    while (engine.outputQueue.pop(e.msg)) {
+      // A NoteOff enqueued after a future-timestamped NoteOn for the same
+      // channel/note (key released inside the strum lookahead) must not
+      // overtake it, or the note would stick.
+      const uint8_t status = e.msg.bytes[0] & 0xF0;
+      const size_t ch = e.msg.bytes[0] & 0x0F;
+      const size_t note = e.msg.bytes[1] & 0x7F;
+      if (status == 0x90 && e.msg.bytes[2] > 0) {
+        lastNoteOnAt[ch][note] =
+            std::max(lastNoteOnAt[ch][note], e.msg.sendAtMs);
+      } else if (status == 0x80 || status == 0x90) {
+        e.msg.sendAtMs = std::max(e.msg.sendAtMs, lastNoteOnAt[ch][note]);
+      }
+      e.seq = nextSeq++;
+      pending.push_back(e);
+      std::push_heap(pending.begin(), pending.end(), Later{});
+    }
   }
-  if (!isTimerRunning())
-    startTimer(kDelayTimerIntervalMs);
+
+  MidiEngine &engine;
+  juce::WaitableEvent wake;
+  std::vector<Entry> pending; // Min-heap by (sendAtMs, seq)
+  juce::MidiBuffer batch;
+  uint64_t nextSeq = 0;
+  double lastNoteOnAt[16][128] = {}; // Latest queued NoteOn time per note
+};
+
+MidiEngine::MidiEngine(SettingsManager *settingsMgr)
+    : settingsManager(settingsMgr) {}
+
+MidiEngine::~MidiEngine() {
+  outputThread.reset(); // Join before the device closes
+  // std::unique_ptr automatically closes the device on destruction
 }
 
-void MidiEngine::sendImmediately(const juce::MidiMessage &msg) {
-  if (currentOutput)
-    currentOutput->sendMessageNow(msg);
+void MidiEngine::queueOrSendNow(const juce::MidiMessage &msg) {
+  queueAt(msg, juce::Time::getMillisecondCounterHiRes());
 }
 
-void MidiEngine::timerCallback() {
-  const double nowMs = juce::Time::getMillisecondCounterHiRes();
-  std::vector<juce::MidiMessage> toSend;
-
-  {
-    const juce::ScopedLock sl(delayQueueLock);
-    auto it = delayQueue.begin();
-    while (it != delayQueue.end()) {
-      if (it->sendAtMs <= nowMs) {
-        toSend.push_back(it->message);
-        it = delayQueue.erase(it);
-      } else {
-        ++it;
-      }
-    }
-    if (delayQueue.empty())
-      stopTimer();
+void MidiEngine::queueAt(const juce::MidiMessage &msg, double sendAtMs) {
+  if (!hasOutput.load(std::memory_order_acquire))
+    return;
+
+  if (settingsManager) {
+    const auto settings = settingsManager->getRuntimeSettings();
+    if (settings->delayMidiEnabled)
+      sendAtMs += settings->delayMidiSeconds * 1000.0;
   }
 
-  for (const auto &msg : toSend)
-    sendImmediately(msg);
+  if (!outputQueue.push(msg, sendAtMs)) {
+    droppedMessages.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  outputThread->notify();
 }
 
 juce::StringArray MidiEngine::getDeviceNames() {
@@ -87,7 +144,14 @@ juce::StringArray MidiEngine::getDeviceNames() {
 }
 
 void MidiEngine::setOutputDevice(int deviceIndex) {
+  if (!outputThread) {
+    outputThread = std::make_unique<OutputThread>(*this);
+    outputThread->startThread();
+  }
+
+  const juce::ScopedLock sl(outputLock);
   // Close any currently open device
+  hasOutput.store(false, std::memory_order_release);
   currentOutput.reset();
 
   // Check if index is valid relative to our cached list
@@ -101,6 +165,7 @@ void MidiEngine::setOutputDevice(int deviceIndex) {
       DBG("MidiEngine: Failed to open device.");
     }
   }
+  hasOutput.store(currentOutput != nullptr, std::memory_order_release);
 }
 
 void MidiEngine::sendNoteOn(int channel, int note, float velocity) {
@@ -130,6 +195,15 @@ void MidiEngine::sendProgramChange(int channel, int program) {
   queueOrSendNow(msg);
 }
 
+void MidiEngine::sendNoteOnAt(int channel, int note, float velocity,
+                              double sendAtMs) {
+  queueAt(juce::MidiMessage::noteOn(channel, note, velocity), sendAtMs);
+}
+
+void MidiEngine::sendNoteOffAt(int channel, int note, double sendAtMs) {
+  queueAt(juce::MidiMessage::noteOff(channel, note), sendAtMs);
+}
+
 void MidiEngine::allNotesOff() {
   for (int ch = 1; ch <= 16; ++ch) {
     auto msg = juce::MidiMessage::controllerEvent(ch, 123, 0);
@@ -138,7 +212,7 @@ void MidiEngine::allNotesOff() {
 }
 
 void MidiEngine::sendPitchBendRangeRPN(int channel, int rangeSemitones) {
-  if (!currentOutput)
+  if (!hasOutput.load(std::memory_order_acquire))
     return;
 
   // RPN Setup: Pitch Bend Sensitivity is 00 00
@@ -1,13 +1,17 @@
 #pragma once
+#include "MidiOutputQueue.h"
 #include <JuceHeader.h>
+#include <atomic>
 #include <vector>
 
 class SettingsManager;
 
-class MidiEngine : public juce::Timer, public juce::ChangeListener {
+// All output goes through a timestamped lock-free queue drained by one
+// sender thread, so callers never block on the OS MIDI driver.
+class MidiEngine {
 public:
   explicit MidiEngine(SettingsManager *settingsMgr = nullptr);
-  ~MidiEngine() override;
+  virtual ~MidiEngine();
 
   // Scans for devices and returns a list of names for the UI (ComboBox)
   juce::StringArray getDeviceNames();
@@ -22,32 +26,41 @@ public:
   virtual void sendPitchBend(int channel, int value); // Value: 0-16383 (center = 8192)
   virtual void sendProgramChange(int channel, int program); // Program: 0-127
 
+  // Scheduled sends: delivered at sendAtMs (juce::Time::
+  // getMillisecondCounterHiRes clock) by the output thread. Past timestamps
+  // send on the next drain. Used by the strum lookahead.
+  virtual void sendNoteOnAt(int channel, int note, float velocity,
+                            double sendAtMs);
+  virtual void sendNoteOffAt(int channel, int note, double sendAtMs);
+
+  // How far ahead of its timestamp a scheduled event may be handed to the
+  // output queue (covers scheduler wakeup jitter).
+  static constexpr double kScheduleLookaheadMs = 2.0;
+
   // All Notes Off (CC 123) on all 16 channels
   void allNotesOff();
 
   // Send Pitch Bend Range RPN (Registered Parameter Number) to configure synth
   void sendPitchBendRangeRPN(int channel, int rangeSemitones);
 
-  void timerCallback() override;
-  void changeListenerCallback(juce::ChangeBroadcaster *source) override;
+  // Messages dropped because the output queue was full (diagnostics).
+  int getDroppedMessageCount() const { return droppedMessages.load(); }
 
 private:
+  class OutputThread;
+
   void queueOrSendNow(const juce::MidiMessage &msg);
-  void sendImmediately(const juce::MidiMessage &msg);
+  void queueAt(const juce::MidiMessage &msg, double sendAtMs);
 
   SettingsManager *settingsManager;
-  bool cachedDelayMidiEnabled = false;
   std::unique_ptr<juce::MidiOutput> currentOutput;
+  std::atomic<bool> hasOutput{false};
+  juce::CriticalSection outputLock; // currentOutput vs. output thread
 
   // We cache the device info list so indexes match between UI and Engine
   juce::Array<juce::MidiDeviceInfo> availableDevices;
 
-  // Delay MIDI: queue of (message, sendAtMs)
-  struct PendingMessage {
-    juce::MidiMessage message;
-    double sendAtMs;
-  };
-  std::vector<PendingMessage> delayQueue;
-  juce::CriticalSection delayQueueLock;
-  static constexpr int kDelayTimerIntervalMs = 50;
+  MidiOutputQueue outputQueue;
+  std::unique_ptr<OutputThread> outputThread; // Started with first device
+  std::atomic<int> droppedMessages{0};
 };
\ No newline at end of file
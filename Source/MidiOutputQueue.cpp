@@ -0,0 +1,15 @@
+#include "MidiOutputQueue.h"
+
+bool MidiOutputQueue::push(const juce::MidiMessage &msg, double sendAtMs) {
+  const int rawSize = msg.getRawDataSize();
+  if (rawSize <= 0 || rawSize > 3)
+    return false;
+
+  Message message;
+  message.sendAtMs = sendAtMs;
+  message.size = (uint8_t)rawSize;
+  const juce::uint8 *raw = msg.getRawData();
+  for (int i = 0; i < rawSize; ++i)
+    message.bytes[i] = raw[i];
+  return ring.push(message);
+}
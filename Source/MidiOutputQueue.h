@@ -0,0 +1,34 @@
+#pragma once
+#include "MpscRing.h"
+#include <JuceHeader.h>
+#include <cstdint>
+
+// Bounded lock-free multi-producer / single-consumer ring of timestamped
+// short MIDI messages (<= 3 bytes: note, CC, pitch bend, program change).
+// Producers (input, scheduler, UI threads) never block or allocate; the
+// MidiEngine output thread is the only consumer.
+class MidiOutputQueue {
+public:
+  struct Message {
+    double sendAtMs = 0.0; // juce::Time::getMillisecondCounterHiRes clock
+    uint8_t bytes[3] = {0, 0, 0};
+    uint8_t size = 0;
+  };
+
+  // capacity is rounded up to a power of two.
+  explicit MidiOutputQueue(size_t capacity = 4096) : ring(capacity) {}
+
+  // Any thread. Returns false if the ring is full or the message is longer
+  // than 3 bytes (message is dropped).
+  bool push(const juce::MidiMessage &msg, double sendAtMs);
+
+  // Consumer thread only. Returns false if empty.
+  bool pop(Message &out) { return ring.pop(out); }
+
+  size_t capacity() const { return ring.capacity(); }
+
+private:
+  MpscRing<Message> ring;
+
+  JUCE_DECLARE_NON_COPYABLE(MidiOutputQueue)
+};
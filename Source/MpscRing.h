@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free multi-producer / single-consumer ring (Vyukov bounded
+// queue). Producers claim a slot by CAS on enqueuePos and publish it by
+// bumping the cell sequence; they never block or allocate. T must be
+// default-constructible and copy-assignable.
+template <typename T> class MpscRing {
+public:
+  // capacity is rounded up to a power of two.
+  explicit MpscRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    mask = size - 1;
+    cells = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; ++i)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  MpscRing(const MpscRing &) = delete;
+  MpscRing &operator=(const MpscRing &) = delete;
+
+  // Any thread. Returns false if the ring is full.
+  bool push(const T &value) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    for (;;) {
+      cell = &cells[pos & mask];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false; // Full
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer thread only. Returns false if empty.
+  bool pop(T &out) {
+    Cell *cell = &cells[dequeuePos & mask];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(dequeuePos + 1) < 0)
+      return false; // Empty (slot not yet published)
+
+    out = cell->value;
+    cell->sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  size_t mask = 0;
+  alignas(64) std::atomic<size_t> enqueuePos{0};
+  alignas(64) size_t dequeuePos = 0;
+};
@@ -113,3 +113,30 @@ PitchSample mapXToStep(const PitchPadLayout &layout, float x) {
   sample.inRestingBand = last.isRest;
   return sample;
 }
+
+std::shared_ptr<const PitchPadTable>
+bakePitchPadTable(const PitchPadLayout &layout, const PitchPadConfig &config,
+                  bool absolutePitchBend, int pitchBendRange) {
+  auto table = std::make_shared<PitchPadTable>();
+  constexpr int kSize = PitchPadTable::kSize;
+
+  for (int i = 0; i < kSize; ++i)
+    table->steps[(size_t)i] =
+        mapXToStep(layout, (float)i / (float)(kSize - 1)).step;
+
+  if (absolutePitchBend) {
+    const int pbRange = juce::jmax(1, pitchBendRange);
+    const double stepsPerSemitone = 8192.0 / (double)pbRange;
+    table->pitchBendRange = pitchBendRange;
+    table->pitchBend.resize(kSize);
+    for (size_t i = 0; i < (size_t)kSize; ++i) {
+      const float offset =
+          juce::jlimit((float)-pbRange, (float)pbRange,
+                       table->steps[i] - config.zeroStep);
+      const int pb =
+          (int)std::round(8192.0 + (double)offset * stepsPerSemitone);
+      table->pitchBend[i] = (uint16_t)juce::jlimit(0, 16383, pb);
+    }
+  }
+  return table;
+}
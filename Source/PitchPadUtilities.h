@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MappingTypes.h"
+#include <memory>
 
 // Helper types and functions for touchpad pitch-pad layout. Both the runtime
 // (InputProcessor) and UI (VisualizerComponent) should use these so that what
@@ -26,3 +27,10 @@ PitchPadLayout buildPitchPadLayout(const PitchPadConfig &config);
 // given layout. The returned 'step' is measured in step units (semitones for
 // PitchBend, scale steps for SmartScaleBend).
 PitchSample mapXToStep(const PitchPadLayout &layout, float x);
+
+// Bake layout into a PitchPadTable. With absolutePitchBend the final PB
+// values for config.zeroStep and pitchBendRange are baked too, matching the
+// runtime's semitone clamp and rounding.
+std::shared_ptr<const PitchPadTable>
+bakePitchPadTable(const PitchPadLayout &layout, const PitchPadConfig &config,
+                  bool absolutePitchBend, int pitchBendRange);
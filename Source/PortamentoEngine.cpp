@@ -1,72 +1,143 @@
 #include "PortamentoEngine.h"
+#include <bit>
+#include <cmath>
+
+namespace {
+// Exponential ease-out: fast start, gentle landing on the target note.
+constexpr double kExponentialSharpness = 5.0;
+constexpr int kCurveSegments = 256;
+
+using CurveTable = std::array<float, kCurveSegments + 1>;
+
+CurveTable buildCurveTable(PortamentoEngine::GlideCurve curve) {
+  CurveTable table{};
+  const double norm = 1.0 - std::exp(-kExponentialSharpness);
+  for (size_t i = 0; i < table.size(); ++i) {
+    const double t = (double)i / (double)kCurveSegments;
+    table[i] = curve == PortamentoEngine::GlideCurve::Exponential
+                   ? (float)((1.0 - std::exp(-kExponentialSharpness * t)) /
+                             norm)
+                   : (float)t;
+  }
+  return table;
+}
+
+const std::array<CurveTable, 2> &curveTables() {
+  static const std::array<CurveTable, 2> tables = {
+      buildCurveTable(PortamentoEngine::GlideCurve::Linear),
+      buildCurveTable(PortamentoEngine::GlideCurve::Exponential)};
+  return tables;
+}
+} // namespace
 
 PortamentoEngine::PortamentoEngine(MidiEngine& engine)
     : midiEngine(engine) {
-  startTimer(static_cast<int>(timerIntervalMs)); // timerIntervalMs is already in milliseconds
+  curveTables(); // Build the tables off the scheduler thread
+  scheduler->registerClient(*this, RealtimeScheduler::Order::Portamento);
 }
 
 PortamentoEngine::~PortamentoEngine() {
-  stopTimer();
-  stop(); // Reset PB to center when destroyed
+  scheduler->unregisterClient(*this);
+  stopAll(); // Reset PB to center when destroyed
 }
 
-void PortamentoEngine::startGlide(int startVal, int endVal, int durationMs, int channel) {
-  currentPbValue = static_cast<double>(juce::jlimit(0, 16383, startVal));
-  targetPbValue = static_cast<double>(juce::jlimit(0, 16383, endVal));
-  midiChannel = channel;
-  active = true;
-  lastSentValue = -1;
+float PortamentoEngine::curveAt(GlideCurve curve, double t) {
+  if (t <= 0.0)
+    return 0.0f;
+  if (t >= 1.0)
+    return 1.0f;
+  const auto &table = curveTables()[(size_t)curve];
+  const double pos = t * kCurveSegments;
+  const int i = (int)pos;
+  const float frac = (float)(pos - i);
+  return table[(size_t)i] + (table[(size_t)i + 1] - table[(size_t)i]) * frac;
+}
+
+void PortamentoEngine::startGlide(int startVal, int endVal, int durationMs,
+                                  int channel, GlideCurve curve) {
+  if (channel < 1 || channel > kNumChannels)
+    return;
+  const int c = channel - 1;
+  const juce::ScopedLock sl(glideLock);
+  auto& g = glides[(size_t)c];
+  g.startValue = juce::jlimit(0, 16383, startVal);
+  g.targetValue = juce::jlimit(0, 16383, endVal);
+  g.currentValue = g.startValue;
+  g.curve = curve;
+  g.lastSentValue = -1;
 
-  // Calculate step size: how much to change per timer tick
   if (durationMs <= 0) {
     // Instant: set immediately
-    currentPbValue = targetPbValue;
-    step = 0.0;
-    active = false;
-    midiEngine.sendPitchBend(midiChannel, static_cast<int>(currentPbValue));
-    lastSentValue = static_cast<int>(currentPbValue);
+    g.currentValue = g.targetValue;
+    activeMask &= ~(1u << c);
+    midiEngine.sendPitchBend(channel, g.currentValue);
+    g.lastSentValue = g.currentValue;
   } else {
-    // Calculate steps needed (use reciprocal to avoid division in hot path)
-    double totalSteps = durationMs / timerIntervalMs;
-    if (totalSteps <= 0.0) {
-      totalSteps = 1.0;
-    }
-    double invTotalSteps = 1.0 / totalSteps;
-    step = (targetPbValue - currentPbValue) * invTotalSteps;
+    g.startMs = RealtimeScheduler::nowMs();
+    g.durationMs = (double)durationMs;
+    activeMask |= 1u << c;
+    scheduler->scheduleAfter(*this, timerIntervalMs);
   }
 }
 
-void PortamentoEngine::stop() {
-  if (active) {
+void PortamentoEngine::stop(int channel) {
+  if (channel < 1 || channel > kNumChannels)
+    return;
+  const int c = channel - 1;
+  const juce::ScopedLock sl(glideLock);
+  auto& g = glides[(size_t)c];
+  if (activeMask & (1u << c)) {
     // Reset to center (8192)
-    midiEngine.sendPitchBend(midiChannel, 8192);
-    lastSentValue = 8192;
+    midiEngine.sendPitchBend(channel, 8192);
+    g.lastSentValue = 8192;
   }
-  active = false;
-  currentPbValue = 8192.0;
-  targetPbValue = 8192.0;
-  step = 0.0;
+  activeMask &= ~(1u << c);
+  g.startValue = g.targetValue = g.currentValue = 8192;
 }
 
-void PortamentoEngine::hiResTimerCallback() {
-  if (!active)
-    return;
+void PortamentoEngine::stopAll() {
+  for (int ch = 1; ch <= kNumChannels; ++ch)
+    stop(ch);
+}
 
-  // Update current value
-  if (std::abs(targetPbValue - currentPbValue) < std::abs(step)) {
-    // Reached target
-    currentPbValue = targetPbValue;
-    active = false;
-  } else {
-    currentPbValue += step;
-  }
+bool PortamentoEngine::isActive(int channel) const {
+  if (channel < 1 || channel > kNumChannels)
+    return false;
+  const juce::ScopedLock sl(glideLock);
+  return (activeMask & (1u << (channel - 1))) != 0;
+}
 
-  // Clamp to valid range
-  int outputVal = static_cast<int>(juce::jlimit(0.0, 16383.0, currentPbValue));
+int PortamentoEngine::getCurrentValue(int channel) const {
+  if (channel < 1 || channel > kNumChannels)
+    return 8192;
+  const juce::ScopedLock sl(glideLock);
+  return glides[(size_t)(channel - 1)].currentValue;
+}
+
+bool PortamentoEngine::advance(int c, double nowMs) {
+  auto& g = glides[(size_t)c];
+  const double t = (nowMs - g.startMs) / g.durationMs;
+  const bool arrived = t >= 1.0;
+  g.currentValue =
+      arrived ? g.targetValue
+              : g.startValue +
+                    (int)std::lround((g.targetValue - g.startValue) *
+                                     (double)curveAt(g.curve, t));
+
+  // Delta check: only send if the quantized value changed
+  if (g.currentValue != g.lastSentValue) {
+    midiEngine.sendPitchBend(c + 1, g.currentValue);
+    g.lastSentValue = g.currentValue;
+  }
+  return !arrived;
+}
 
-  // Delta check: only send if value changed
-  if (outputVal != lastSentValue) {
-    midiEngine.sendPitchBend(midiChannel, outputVal);
-    lastSentValue = outputVal;
+double PortamentoEngine::onSchedulerTick(double nowMs) {
+  const juce::ScopedLock sl(glideLock);
+  for (uint32_t bits = activeMask; bits != 0; bits &= bits - 1) {
+    const int c = std::countr_zero(bits);
+    if (!advance(c, nowMs))
+      activeMask &= ~(1u << c);
   }
+  return activeMask != 0 ? nowMs + timerIntervalMs : RealtimeScheduler::idle;
 }
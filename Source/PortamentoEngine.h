@@ -1,35 +1,65 @@
 #pragma once
 #include "MidiEngine.h"
+#include "RealtimeScheduler.h"
 #include <JuceHeader.h>
+#include <array>
+#include <cstdint>
 
-class PortamentoEngine : public juce::HighResolutionTimer {
+// Pitch-bend glides for Legato zones, one independent glide per MIDI channel.
+// All active channels advance in one scheduler tick; a glide on one channel
+// never disturbs another. Values follow a precomputed curve table and are
+// only sent when the quantized 14-bit value changes.
+class PortamentoEngine : public RealtimeScheduler::Client {
 public:
+  enum class GlideCurve : uint8_t { Linear = 0, Exponential };
+
   explicit PortamentoEngine(MidiEngine& engine);
   ~PortamentoEngine() override;
 
-  // Start a glide from startVal to endVal over durationMs milliseconds
-  void startGlide(int startVal, int endVal, int durationMs, int channel);
+  // Start a glide on channel (1-16) from startVal to endVal over durationMs
+  // milliseconds. Replaces any glide already running on that channel.
+  void startGlide(int startVal, int endVal, int durationMs, int channel,
+                  GlideCurve curve = GlideCurve::Linear);
+
+  // Stop the channel's glide (reset PB to center if it was gliding)
+  void stop(int channel);
+  // Stop every channel (panic / shutdown)
+  void stopAll();
 
-  // Stop the current glide (reset PB to center)
-  void stop();
+  // Check if a glide is currently active on the channel
+  bool isActive(int channel) const;
 
-  // Check if a glide is currently active
-  bool isActive() const { return active; }
+  // Get the channel's current Pitch Bend value (for smooth handoff in Legato
+  // mode); holds the last glide value until stop()
+  int getCurrentValue(int channel) const;
 
-  // Get current Pitch Bend value (for smooth handoff in Legato mode)
-  int getCurrentValue() const { return static_cast<int>(currentPbValue); }
+  // Curve shape at progress t (0-1), from the lookup table. 0 -> 0, 1 -> 1.
+  static float curveAt(GlideCurve curve, double t);
 
-  // HighResolutionTimer callback
-  void hiResTimerCallback() override;
+  // Scheduler tick: advances every active glide; idle once all have arrived
+  double onSchedulerTick(double nowMs) override;
 
 private:
+  static constexpr int kNumChannels = 16;
+
+  struct ChannelGlide {
+    double startMs = 0.0;
+    double durationMs = 0.0;
+    int startValue = 8192;
+    int targetValue = 8192;
+    int currentValue = 8192;  // Last computed value (0-16383)
+    int lastSentValue = -1;   // Last sent PB value (for delta check)
+    GlideCurve curve = GlideCurve::Linear;
+  };
+
+  // Caller holds glideLock. Returns false once the glide has arrived.
+  bool advance(int channelIndex, double nowMs);
+
   MidiEngine& midiEngine;
-  double currentPbValue = 8192.0; // Current Pitch Bend value (0-16383)
-  double targetPbValue = 8192.0;  // Target Pitch Bend value
-  double step = 0.0;               // Step size per timer tick
-  int midiChannel = 1;              // MIDI channel for this glide
-  bool active = false;              // Is glide active?
-  int lastSentValue = -1;            // Last sent PB value (for delta check)
+  std::array<ChannelGlide, kNumChannels> glides;
+  uint32_t activeMask = 0; // Bit (channel - 1) set while gliding
+  juce::CriticalSection glideLock;
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
 
   static constexpr double timerIntervalMs = 5.0; // 5ms timer interval
 
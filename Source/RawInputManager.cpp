@@ -147,6 +147,7 @@ void RawInputManager::shutdown() {
 
   // Clear device key states
   deviceKeyStates.clear();
+  touchpadPlans.clear();
 }
 
 void RawInputManager::resetState() { deviceKeyStates.clear(); }
@@ -301,13 +302,11 @@ int64_t __stdcall RawInputManager::rawInputWndProc(void *hwnd, unsigned int msg,
               // Always broadcast if MIDI mode is active
               // Also broadcast toggle key (turn off) and performance key (turn
               // on both) even when MIDI is off
-              int toggleKey =
-                  globalManagerInstance->settingsManager->getToggleKey();
-              int perfKey =
-                  globalManagerInstance->settingsManager->getPerformanceModeKey();
-              shouldBroadcast =
-                  globalManagerInstance->settingsManager->isMidiModeActive() ||
-                  (vKey == toggleKey) || (vKey == perfKey);
+              const auto settings =
+                  globalManagerInstance->settingsManager->getRuntimeSettings();
+              shouldBroadcast = settings->midiModeActive ||
+                                (vKey == settings->toggleKey) ||
+                                (vKey == settings->performanceModeKey);
             } else {
               // If no settings manager, always broadcast (backward
               // compatibility)
@@ -379,43 +378,65 @@ int64_t __stdcall RawInputManager::rawInputWndProc(void *hwnd, unsigned int msg,
               }
             }
           }
-        } else if (raw->header.dwType == RIM_TYPEHID) {
+        } else if (raw->header.dwType == RIM_TYPEHID &&
+                   globalManagerInstance) {
           HANDLE deviceHandle = raw->header.hDevice;
-          if (isPrecisionTouchpadDevice(deviceHandle)) {
-            auto contacts = parsePrecisionTouchpadReport(
-                reinterpret_cast<void *>(lParam),
-                reinterpret_cast<void *>(deviceHandle));
-            if (globalManagerInstance) {
-              uintptr_t handle = reinterpret_cast<uintptr_t>(deviceHandle);
-              juce::ScopedLock lock(
-                  globalManagerInstance->touchpadContactsLock);
-              auto &acc =
-                  globalManagerInstance->touchpadContactsByDevice[handle];
-              if (contacts.empty()) {
-                acc.clear();
-              } else {
-                // Update or add each contact from this report. Do not mark
-                // contacts missing from this report as lifted: many PTPs send
-                // one contact per WM_INPUT (alternating), which would otherwise
-                // flicker the other finger to "-". Lift is shown only when the
-                // parser reports that contact with Tip Switch = 0.
-                for (const auto &c : contacts) {
-                  auto it = std::find_if(acc.begin(), acc.end(),
-                                         [&c](const TouchpadContact &a) {
-                                           return a.contactId == c.contactId;
-                                         });
-                  if (it != acc.end())
-                    *it = c;
-                  else
-                    acc.push_back(c);
-                }
+          const uintptr_t handle = reinterpret_cast<uintptr_t>(deviceHandle);
+          auto &plans = globalManagerInstance->touchpadPlans;
+          auto planIt = plans.find(handle);
+          if (planIt == plans.end()) {
+            // Classify the device once, on its first report. Other HID
+            // devices get an empty plan so they are not queried again; a
+            // touchpad whose layout failed to compile is retried instead.
+            if (!isPrecisionTouchpadDevice(deviceHandle)) {
+              planIt = plans.emplace(handle, HidTouchpadPlan{}).first;
+            } else {
+              HidTouchpadPlan plan = buildPrecisionTouchpadPlan(deviceHandle);
+              if (plan.isValid())
+                planIt = plans.emplace(handle, std::move(plan)).first;
+            }
+          }
+          if (planIt != plans.end() && planIt->second.isValid()) {
+            // Windows may pack several reports in one WM_INPUT (dwCount > 1);
+            // each is decoded straight from the RAWINPUT buffer.
+            const HidTouchpadPlan &plan = planIt->second;
+            const DWORD reportSize = raw->data.hid.dwSizeHid;
+            const BYTE *reports = raw->data.hid.bRawData;
+            std::vector<TouchpadContact> contacts;
+            TouchpadContactFrame frame;
+            for (DWORD i = 0; i < raw->data.hid.dwCount; ++i) {
+              if (decodeTouchpadReport(plan, reports + i * reportSize,
+                                       reportSize, frame))
+                contacts.insert(contacts.end(), frame.begin(), frame.end());
+            }
+            juce::ScopedLock lock(
+                globalManagerInstance->touchpadContactsLock);
+            auto &acc =
+                globalManagerInstance->touchpadContactsByDevice[handle];
+            if (contacts.empty()) {
+              acc.clear();
+            } else {
+              // Update or add each contact from this report. Do not mark
+              // contacts missing from this report as lifted: many PTPs send
+              // one contact per WM_INPUT (alternating), which would otherwise
+              // flicker the other finger to "-". Lift is shown only when the
+              // parser reports that contact with Tip Switch = 0.
+              for (const auto &c : contacts) {
+                auto it = std::find_if(acc.begin(), acc.end(),
+                                       [&c](const TouchpadContact &a) {
+                                         return a.contactId == c.contactId;
+                                       });
+                if (it != acc.end())
+                  *it = c;
+                else
+                  acc.push_back(c);
               }
-              auto contactsCopy = acc;
-              globalManagerInstance->listeners.call(
-                  [handle, contactsCopy](Listener &l) {
-                    l.handleTouchpadContacts(handle, contactsCopy);
-                  });
             }
+            auto contactsCopy = acc;
+            globalManagerInstance->listeners.call(
+                [handle, contactsCopy](Listener &l) {
+                  l.handleTouchpadContacts(handle, contactsCopy);
+                });
           }
         }
       }
@@ -427,7 +448,11 @@ int64_t __stdcall RawInputManager::rawInputWndProc(void *hwnd, unsigned int msg,
           wParam, lParam, hwnd);
     }
   } else if (msg == WM_INPUT_DEVICE_CHANGE) {
-    // Device plug/unplug event (0x00FE)
+    // Device plug/unplug event (0x00FE). lParam is the device handle; a
+    // (re)attached touchpad gets its report layout compiled again.
+    if (globalManagerInstance)
+      globalManagerInstance->touchpadPlans.erase(
+          static_cast<uintptr_t>(lParam));
     if (globalManagerInstance &&
         globalManagerInstance->onDeviceChangeCallback) {
       // Call the callback asynchronously to avoid blocking the message loop
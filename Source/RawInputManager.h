@@ -7,6 +7,7 @@
 #include <set>
 #include <vector>
 
+#include "HidTouchpadDecoder.h"
 #include "TouchpadTypes.h"
 
 // Forward declaration
@@ -70,6 +71,10 @@ private:
   std::map<uintptr_t, std::vector<TouchpadContact>> touchpadContactsByDevice;
   juce::CriticalSection touchpadContactsLock;
 
+  // Compiled report layout per HID device, built on its first report; empty
+  // (invalid) for devices that are not touchpads (message thread only)
+  std::map<uintptr_t, HidTouchpadPlan> touchpadPlans;
+
   // Static WNDPROC wrapper
   static int64_t __stdcall rawInputWndProc(void *hwnd, unsigned int msg,
                                            uint64_t wParam, int64_t lParam);
@@ -0,0 +1,116 @@
+#include "RealtimeScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+#if JUCE_WINDOWS
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+RealtimeScheduler::RealtimeScheduler() : juce::Thread("MIDIQy Scheduler") {
+  dueScratch.reserve(16); // No allocation on the tick path
+  startThread();
+}
+
+RealtimeScheduler::~RealtimeScheduler() {
+  signalThreadShouldExit();
+  wakeEvent.signal();
+  stopThread(2000);
+}
+
+double RealtimeScheduler::nowMs() {
+  return juce::Time::getMillisecondCounterHiRes();
+}
+
+void RealtimeScheduler::registerClient(Client &client, Order order) {
+  juce::ScopedLock sl(deadlineLock);
+  if (findEntry(client) != nullptr)
+    return;
+  Entry entry;
+  entry.client = &client;
+  entry.order = order;
+  auto pos = std::upper_bound(entries.begin(), entries.end(), order,
+                              [](Order o, const Entry &e) {
+                                return (int)o < (int)e.order;
+                              });
+  entries.insert(pos, entry);
+}
+
+void RealtimeScheduler::unregisterClient(Client &client) {
+  juce::ScopedLock tl(tickLock); // Wait out an in-flight tick
+  juce::ScopedLock sl(deadlineLock);
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [&client](const Entry &e) {
+                                 return e.client == &client;
+                               }),
+                entries.end());
+}
+
+void RealtimeScheduler::scheduleAt(Client &client, double deadlineMs) {
+  {
+    juce::ScopedLock sl(deadlineLock);
+    Entry *entry = findEntry(client);
+    if (entry == nullptr || deadlineMs >= entry->deadlineMs)
+      return;
+    entry->deadlineMs = deadlineMs;
+  }
+  wakeEvent.signal();
+}
+
+RealtimeScheduler::Entry *RealtimeScheduler::findEntry(Client &client) {
+  for (auto &e : entries) {
+    if (e.client == &client)
+      return &e;
+  }
+  return nullptr;
+}
+
+void RealtimeScheduler::run() {
+#if JUCE_WINDOWS
+  // Default Windows timer resolution is ~15.6 ms; strum and release timing
+  // need 1 ms (what the per-engine HighResolutionTimers used to provide).
+  timeBeginPeriod(1);
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#endif
+
+  while (!threadShouldExit()) {
+    double next = idle;
+    {
+      juce::ScopedLock sl(deadlineLock);
+      for (const auto &e : entries)
+        next = std::min(next, e.deadlineMs);
+    }
+
+    const double now = nowMs();
+    if (next > now) {
+      // Fully idle (no wakeups) until a client posts a deadline.
+      const int waitMs =
+          (next == idle) ? -1
+                         : std::max(1, (int)std::ceil(next - now));
+      wakeEvent.wait(waitMs);
+      continue;
+    }
+
+    // Batch every due client into one tick, in Order.
+    juce::ScopedLock tl(tickLock);
+    dueScratch.clear();
+    {
+      juce::ScopedLock sl(deadlineLock);
+      for (auto &e : entries) {
+        if (e.deadlineMs <= now) {
+          dueScratch.push_back(e.client);
+          e.deadlineMs = idle;
+        }
+      }
+    }
+    for (Client *client : dueScratch) {
+      const double nextDeadline = client->onSchedulerTick(now);
+      if (nextDeadline < idle)
+        scheduleAt(*client, nextDeadline);
+    }
+  }
+
+#if JUCE_WINDOWS
+  timeEndPeriod(1);
+#endif
+}
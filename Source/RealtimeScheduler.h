@@ -0,0 +1,70 @@
+#pragma once
+#include <JuceHeader.h>
+#include <limits>
+#include <vector>
+
+// Single real-time timing thread shared by the MIDI engines (strum, delayed
+// releases, ADSR envelopes, portamento). Each engine registers as a Client
+// and posts its earliest deadline; the thread sleeps until the earliest
+// deadline of all clients, runs every due client in one batch (in fixed
+// Order, so same-tick events are deterministic), and blocks indefinitely
+// when nothing is pending. Obtain via juce::SharedResourcePointer so all
+// engines in the process share one thread.
+class RealtimeScheduler : private juce::Thread {
+public:
+  // No deadline pending.
+  static constexpr double idle = std::numeric_limits<double>::infinity();
+
+  // Tick order within one batch (lower runs first).
+  enum class Order {
+    Strum = 0,
+    Release = 1,
+    Expression = 2,
+    Portamento = 3,
+    Axis = 4
+  };
+
+  class Client {
+  public:
+    virtual ~Client() = default;
+    // Run all work due at nowMs. Return the next deadline (ms, same clock as
+    // nowMs()) or RealtimeScheduler::idle. Called on the scheduler thread.
+    virtual double onSchedulerTick(double nowMs) = 0;
+  };
+
+  RealtimeScheduler();
+  ~RealtimeScheduler() override;
+
+  void registerClient(Client &client, Order order);
+  // Blocks until any tick currently running this client has returned.
+  void unregisterClient(Client &client);
+
+  // Request a tick at or before deadlineMs. Keeps the earlier of the pending
+  // and requested deadline. Safe to call from any thread, including from
+  // inside onSchedulerTick.
+  void scheduleAt(Client &client, double deadlineMs);
+  void scheduleAfter(Client &client, double delayMs) {
+    scheduleAt(client, nowMs() + delayMs);
+  }
+
+  // Clock used for all deadlines (juce::Time::getMillisecondCounterHiRes).
+  static double nowMs();
+
+private:
+  struct Entry {
+    Client *client = nullptr;
+    Order order = Order::Strum;
+    double deadlineMs = idle;
+  };
+
+  void run() override;
+  Entry *findEntry(Client &client);
+
+  std::vector<Entry> entries; // Sorted by order, then registration
+  juce::CriticalSection deadlineLock; // entries (short holds only)
+  juce::CriticalSection tickLock;     // Held while clients run
+  juce::WaitableEvent wakeEvent;
+  std::vector<Client *> dueScratch; // Scheduler thread only
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeScheduler)
+};
@@ -40,6 +40,23 @@ InspectorSchema SettingsDefinition::getSchema() {
     schema.push_back(delaySeconds);
   }
 
+  // --- Pointer input section ---
+  schema.push_back(
+      MappingDefinition::createSeparator("Pointer Input",
+                                         juce::Justification::centredLeft));
+  {
+    InspectorControl coalesce;
+    coalesce.propertyId = "axisCoalesceMs";
+    coalesce.label = "Pointer CC interval (0 = every change)";
+    coalesce.controlType = InspectorControl::Type::Slider;
+    coalesce.min = 0.0;
+    coalesce.max = 50.0;
+    coalesce.step = 1.0;
+    coalesce.suffix = "ms";
+    coalesce.valueFormat = InspectorControl::Format::Integer;
+    schema.push_back(coalesce);
+  }
+
   // --- Visualizer section ---
   schema.push_back(
       MappingDefinition::createSeparator("Visualizer",
@@ -24,50 +24,60 @@ SettingsManager::SettingsManager() {
   rootNode.setProperty("rememberUiState", true, nullptr);
   rootNode.setProperty("delayMidiEnabled", false, nullptr);
   rootNode.setProperty("delayMidiSeconds", 1, nullptr);
+  rootNode.setProperty("axisCoalesceMs", 4, nullptr);
 
   // Ensure UIState child exists for layout persistence
   if (!rootNode.getChildWithName("UIState").isValid()) {
     rootNode.addChild(juce::ValueTree("UIState"), -1, nullptr);
   }
   rootNode.addListener(this);
-  updateCachedMidiModeActive();
+  publishRuntimeSettings();
 }
 
 SettingsManager::~SettingsManager() { rootNode.removeListener(this); }
 
-int SettingsManager::getPitchBendRange() const {
-  return rootNode.getProperty("pitchBendRange", 12);
+void SettingsManager::publishRuntimeSettings() {
+  auto next = std::make_shared<RuntimeSettings>();
+  next->midiModeActive = rootNode.getProperty("midiModeActive", false);
+  next->studioMode = rootNode.getProperty("studioMode", false);
+  next->toggleKey = rootNode.getProperty("toggleKeyCode", 0x7B);
+  next->performanceModeKey =
+      rootNode.getProperty("performanceModeKeyCode", 0x7A);
+  next->pitchBendRange = rootNode.getProperty("pitchBendRange", 12);
+  next->stepsPerSemitone =
+      8192.0 / static_cast<double>(juce::jmax(1, next->pitchBendRange));
+  next->delayMidiEnabled = rootNode.getProperty("delayMidiEnabled", false);
+  next->delayMidiSeconds = juce::jlimit(
+      1, 10, static_cast<int>(rootNode.getProperty("delayMidiSeconds", 1)));
+  next->axisCoalesceMs = juce::jlimit(
+      0, 50, static_cast<int>(rootNode.getProperty("axisCoalesceMs", 4)));
+  runtimeSettings.store(std::move(next), std::memory_order_release);
 }
 
-void SettingsManager::updateCachedStepsPerSemitone() {
-  int range = juce::jmax(1, getPitchBendRange());
-  cachedStepsPerSemitone = 8192.0 / static_cast<double>(range);
+int SettingsManager::getPitchBendRange() const {
+  return getRuntimeSettings()->pitchBendRange;
 }
 
 double SettingsManager::getStepsPerSemitone() const {
-  return cachedStepsPerSemitone;
+  return getRuntimeSettings()->stepsPerSemitone;
 }
 
 void SettingsManager::setPitchBendRange(int range) {
   rootNode.setProperty("pitchBendRange", juce::jlimit(1, 96, range), nullptr);
-  updateCachedStepsPerSemitone();
   sendChangeMessage();
 }
 
-bool SettingsManager::isMidiModeActive() const { return cachedMidiModeActive; }
-
-void SettingsManager::updateCachedMidiModeActive() {
-  cachedMidiModeActive = rootNode.getProperty("midiModeActive", false);
+bool SettingsManager::isMidiModeActive() const {
+  return getRuntimeSettings()->midiModeActive;
 }
 
 void SettingsManager::setMidiModeActive(bool active) {
   rootNode.setProperty("midiModeActive", active, nullptr);
-  updateCachedMidiModeActive();
   sendChangeMessage();
 }
 
 int SettingsManager::getToggleKey() const {
-  return rootNode.getProperty("toggleKeyCode", 0x7B); // VK_F12 default
+  return getRuntimeSettings()->toggleKey;
 }
 
 void SettingsManager::setToggleKey(int vkCode) {
@@ -76,7 +86,7 @@ void SettingsManager::setToggleKey(int vkCode) {
 }
 
 int SettingsManager::getPerformanceModeKey() const {
-  return rootNode.getProperty("performanceModeKeyCode", 0x7A); // VK_F11 default
+  return getRuntimeSettings()->performanceModeKey;
 }
 
 void SettingsManager::setPerformanceModeKey(int vkCode) {
@@ -94,7 +104,7 @@ void SettingsManager::setLastMidiDevice(const juce::String &name) {
 }
 
 bool SettingsManager::isStudioMode() const {
-  return rootNode.getProperty("studioMode", false);
+  return getRuntimeSettings()->studioMode;
 }
 
 void SettingsManager::setStudioMode(bool active) {
@@ -126,7 +136,7 @@ void SettingsManager::setDebugModeEnabled(bool enabled) {
 }
 
 bool SettingsManager::isDelayMidiEnabled() const {
-  return rootNode.getProperty("delayMidiEnabled", false);
+  return getRuntimeSettings()->delayMidiEnabled;
 }
 
 void SettingsManager::setDelayMidiEnabled(bool enabled) {
@@ -135,8 +145,7 @@ void SettingsManager::setDelayMidiEnabled(bool enabled) {
 }
 
 int SettingsManager::getDelayMidiSeconds() const {
-  return juce::jlimit(
-      1, 10, static_cast<int>(rootNode.getProperty("delayMidiSeconds", 1)));
+  return getRuntimeSettings()->delayMidiSeconds;
 }
 
 void SettingsManager::setDelayMidiSeconds(int seconds) {
@@ -145,6 +154,15 @@ void SettingsManager::setDelayMidiSeconds(int seconds) {
   sendChangeMessage();
 }
 
+int SettingsManager::getAxisCoalesceMs() const {
+  return getRuntimeSettings()->axisCoalesceMs;
+}
+
+void SettingsManager::setAxisCoalesceMs(int ms) {
+  rootNode.setProperty("axisCoalesceMs", juce::jlimit(0, 50, ms), nullptr);
+  sendChangeMessage();
+}
+
 float SettingsManager::getVisualizerXOpacity() const {
   double v = rootNode.getProperty("visualizerXOpacity", 0.45);
   return juce::jlimit(0.0, 1.0, v);
@@ -645,6 +663,7 @@ void SettingsManager::loadFromXml(juce::File file) {
         rootNode.setProperty("debugModeEnabled", false, nullptr);
         rootNode.setProperty("delayMidiEnabled", false, nullptr);
         rootNode.setProperty("delayMidiSeconds", 1, nullptr);
+        rootNode.setProperty("axisCoalesceMs", 4, nullptr);
         rootNode.setProperty("rememberUiState", true, nullptr);
       } else {
         // Phase 43: Validate (sanitize) – prevent divide-by-zero from bad saved
@@ -666,6 +685,8 @@ void SettingsManager::loadFromXml(juce::File file) {
           rootNode.setProperty("delayMidiEnabled", false, nullptr);
         if (!rootNode.hasProperty("delayMidiSeconds"))
           rootNode.setProperty("delayMidiSeconds", 1, nullptr);
+        if (!rootNode.hasProperty("axisCoalesceMs"))
+          rootNode.setProperty("axisCoalesceMs", 4, nullptr);
         if (!rootNode.hasProperty("hideCursorInPerformanceMode"))
           rootNode.setProperty("hideCursorInPerformanceMode", false, nullptr);
         if (!rootNode.hasProperty("rememberUiState"))
@@ -678,8 +699,7 @@ void SettingsManager::loadFromXml(juce::File file) {
       // Normalize any invalid or missing UIState indices / flags.
       sanitizeUiStateNode();
       rootNode.addListener(this);
-      updateCachedStepsPerSemitone();
-      updateCachedMidiModeActive();
+      publishRuntimeSettings();
       sendChangeMessage();
     }
   }
@@ -688,7 +708,7 @@ void SettingsManager::loadFromXml(juce::File file) {
 void SettingsManager::valueTreePropertyChanged(
     juce::ValueTree &tree, const juce::Identifier &property) {
   if (tree == rootNode) {
-    updateCachedMidiModeActive();
+    publishRuntimeSettings();
     sendChangeMessage();
   }
 }
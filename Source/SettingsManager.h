@@ -1,6 +1,23 @@
 #pragma once
 #include "MappingTypes.h"
 #include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+// Settings read on the input, MIDI output and timer threads. Rebuilt from the
+// settings tree on every change and published as an immutable snapshot, so
+// hot paths read plain fields instead of ValueTree properties.
+struct RuntimeSettings {
+  bool midiModeActive = false;
+  bool studioMode = false;
+  int toggleKey = 0x7B;          // VK_F12
+  int performanceModeKey = 0x7A; // VK_F11
+  int pitchBendRange = 12;
+  double stepsPerSemitone = 8192.0 / 12.0; // 8192 / pitchBendRange
+  bool delayMidiEnabled = false;
+  int delayMidiSeconds = 1; // 1-10
+  int axisCoalesceMs = 4;   // Min spacing of axis CCs per axis; 0 = off
+};
 
 class SettingsManager : public juce::ChangeBroadcaster,
                         public juce::ValueTree::Listener {
@@ -8,6 +25,13 @@ public:
   SettingsManager();
   ~SettingsManager() override;
 
+  // Current runtime snapshot (any thread; takes no mutex, though the atomic
+  // shared_ptr is not guaranteed lock-free). Take one per event and read
+  // fields from it rather than calling the getters below repeatedly.
+  std::shared_ptr<const RuntimeSettings> getRuntimeSettings() const {
+    return runtimeSettings.load(std::memory_order_acquire);
+  }
+
   // Pitch Bend Range
   int getPitchBendRange() const;
   void setPitchBendRange(int range);
@@ -49,6 +73,10 @@ public:
   int getDelayMidiSeconds() const;
   void setDelayMidiSeconds(int seconds);
 
+  // Pointer/axis CC coalescing interval in ms (0-50; 0 sends every change)
+  int getAxisCoalesceMs() const;
+  void setAxisCoalesceMs(int ms);
+
   // Visualizer: opacity for X and Y touchpad overlays (0.0–1.0)
   float getVisualizerXOpacity() const;
   void setVisualizerXOpacity(float alpha);
@@ -152,8 +180,8 @@ public:
 
 private:
   juce::ValueTree rootNode;
-  double cachedStepsPerSemitone = 8192.0 / 12.0; // 8192 / pitchBendRange
-  bool cachedMidiModeActive = false;
+  std::atomic<std::shared_ptr<const RuntimeSettings>> runtimeSettings{
+      std::make_shared<const RuntimeSettings>()};
 
   juce::ValueTree getUiStateNode();
   juce::ValueTree getUiStateNode() const;
@@ -162,8 +190,8 @@ private:
   void sanitizeUiStateNode();
 
   juce::String getTypePropertyName(ActionType type) const;
-  void updateCachedStepsPerSemitone();
-  void updateCachedMidiModeActive();
+  // Rebuilds runtimeSettings from rootNode (message thread).
+  void publishRuntimeSettings();
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SettingsManager)
 };
@@ -478,6 +478,8 @@ juce::var SettingsPanel::getSettingsValue(const juce::String &propertyId) const
     return juce::var(settingsManager.isDelayMidiEnabled());
   if (propertyId == "delayMidiSeconds")
     return juce::var(settingsManager.getDelayMidiSeconds());
+  if (propertyId == "axisCoalesceMs")
+    return juce::var(settingsManager.getAxisCoalesceMs());
   if (propertyId == "rememberUiState")
     return juce::var(settingsManager.getRememberUiState());
   if (propertyId == "debugModeEnabled")
@@ -517,6 +519,8 @@ void SettingsPanel::applySettingsValue(const juce::String &propertyId,
   } else if (propertyId == "delayMidiSeconds") {
     int v = static_cast<int>(value);
     settingsManager.setDelayMidiSeconds(v);
+  } else if (propertyId == "axisCoalesceMs") {
+    settingsManager.setAxisCoalesceMs(static_cast<int>(value));
   } else if (propertyId == "rememberUiState") {
     settingsManager.setRememberUiState(static_cast<bool>(value));
   } else if (propertyId == "debugModeEnabled") {
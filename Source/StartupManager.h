@@ -28,6 +28,11 @@ public:
   // Save immediately (flush pending saves)
   void saveImmediate();
 
+  // Compiled-context cache for the autoload session (next to autoload.xml).
+  juce::File getContextCacheFile() const {
+    return appDataFolder.getChildFile("autoload.compiled");
+  }
+
   // Timer callback (auto-save)
   void timerCallback() override;
 
@@ -1,17 +1,19 @@
 #include "StrumEngine.h"
 #include "MappingTypes.h"
+#include <algorithm>
 #include <unordered_map>
 
 StrumEngine::StrumEngine(MidiEngine& engine, OnNotePlayedCallback onPlayed)
   : midiEngine(engine), onNotePlayed(std::move(onPlayed)) {
-  startTimer(1);
+  noteQueue.reserve(256); // Strums append without reallocating
+  scheduler->registerClient(*this, RealtimeScheduler::Order::Strum);
 }
 
 StrumEngine::~StrumEngine() {
-  stopTimer();
+  scheduler->unregisterClient(*this);
 }
 
-void StrumEngine::triggerStrum(const std::vector<int>& notes, const std::vector<int>& velocities, int channel,
+void StrumEngine::triggerStrum(std::span<const int> notes, std::span<const int> velocities, int channel,
                                int speedMs, InputID source, bool allowSustain, int strumPattern,
                                int humanizeTimeMs) {
   juce::ScopedLock lock(queueLock);
@@ -20,20 +22,16 @@ void StrumEngine::triggerStrum(const std::vector<int>& notes, const std::vector<
   if (strumPattern == 2)
     autoStrumDownNext = !autoStrumDownNext;
 
-  std::vector<int> n = notes;
-  std::vector<int> v = (velocities.size() >= notes.size()) ? velocities : std::vector<int>(notes.size(), velocities.empty() ? 100 : velocities[0]);
-  if (v.size() < n.size())
-    v.resize(n.size(), 100);
-  if (up) {
-    std::reverse(n.begin(), n.end());
-    std::reverse(v.begin(), v.end());
-  }
+  const int defaultVel = velocities.empty() ? 100 : velocities[0];
+  const size_t count = notes.size();
 
   juce::Random& rng = juce::Random::getSystemRandom();
-  for (size_t i = 0; i < n.size(); ++i) {
+  double earliestTimeMs = RealtimeScheduler::idle;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t src = up ? count - 1 - i : i; // Upstroke plays high to low
     PendingNote p;
-    p.note = n[i];
-    p.velocity = (i < v.size()) ? v[i] : 100;
+    p.note = notes[src];
+    p.velocity = (src < velocities.size()) ? velocities[src] : defaultVel;
     p.channel = channel;
     double baseTime = now + (static_cast<double>(i) * speedMs);
     double jitter = (humanizeTimeMs > 0)
@@ -43,7 +41,10 @@ void StrumEngine::triggerStrum(const std::vector<int>& notes, const std::vector<
     p.source = source;
     p.allowSustain = allowSustain;
     noteQueue.push_back(p);
+    earliestTimeMs = std::min(earliestTimeMs, p.targetTimeMs);
   }
+  scheduler->scheduleAt(*this,
+                       earliestTimeMs - MidiEngine::kScheduleLookaheadMs);
 }
 
 void StrumEngine::cancelPendingNotes(InputID source) {
@@ -68,6 +69,7 @@ void StrumEngine::markSourceReleased(InputID source, int durationMs, bool should
     info.durationMs = durationMs;
     info.shouldSustain = shouldSustain;
     releaseMap[source] = info;
+    scheduler->scheduleAt(*this, info.releaseTimeMs + durationMs);
   } else {
     // Duration is 0, cancel immediately (unless shouldSustain is true, then just remove from release map)
     if (!shouldSustain) {
@@ -84,9 +86,9 @@ void StrumEngine::cancelAll() {
   releaseMap.clear();
 }
 
-void StrumEngine::hiResTimerCallback() {
+double StrumEngine::onSchedulerTick(double nowMs) {
   juce::ScopedLock lock(queueLock);
-  double now = getCurrentTimeMs();
+  double now = nowMs;
   currentTimeMs = now;
 
   // Check for expired releases
@@ -135,15 +137,31 @@ void StrumEngine::hiResTimerCallback() {
       }
     }
 
+    // Notes inside the lookahead window are handed to the timestamped output
+    // queue so spacing is exact rather than tick-quantized.
     if (it->targetTimeMs <= now) {
       midiEngine.sendNoteOn(it->channel, it->note, static_cast<float>(it->velocity) / 127.0f);
       if (onNotePlayed)
         onNotePlayed(it->source, it->note, it->channel, it->allowSustain);
       it = noteQueue.erase(it);
+    } else if (it->targetTimeMs <= now + MidiEngine::kScheduleLookaheadMs) {
+      midiEngine.sendNoteOnAt(it->channel, it->note, static_cast<float>(it->velocity) / 127.0f,
+                              it->targetTimeMs);
+      if (onNotePlayed)
+        onNotePlayed(it->source, it->note, it->channel, it->allowSustain);
+      it = noteQueue.erase(it);
     } else {
       ++it;
     }
   }
+
+  // Next deadline: earliest pending note or release expiration
+  double next = RealtimeScheduler::idle;
+  for (const auto& p : noteQueue)
+    next = std::min(next, p.targetTimeMs - MidiEngine::kScheduleLookaheadMs);
+  for (const auto& r : releaseMap)
+    next = std::min(next, r.second.releaseTimeMs + r.second.durationMs);
+  return next;
 }
 
 double StrumEngine::getCurrentTimeMs() const {
@@ -1,12 +1,14 @@
 #pragma once
 #include "MidiEngine.h"
 #include "MappingTypes.h"
+#include "RealtimeScheduler.h"
 #include <JuceHeader.h>
+#include <span>
 #include <vector>
 #include <functional>
 #include <unordered_map>
 
-class StrumEngine : public juce::HighResolutionTimer {
+class StrumEngine : public RealtimeScheduler::Client {
 public:
   struct PendingNote {
     int note;
@@ -25,7 +27,8 @@ public:
   // Trigger a strum with multiple notes (with per-note velocities).
   // strumPattern: 0 = Down, 1 = Up, 2 = Auto-alternating.
   // humanizeTimeMs: if > 0, add ±humanizeTimeMs jitter to each note's delay.
-  void triggerStrum(const std::vector<int>& notes, const std::vector<int>& velocities, int channel,
+  // Missing velocities repeat velocities[0] (100 if none).
+  void triggerStrum(std::span<const int> notes, std::span<const int> velocities, int channel,
                     int speedMs, InputID source, bool allowSustain = true, int strumPattern = 0,
                     int humanizeTimeMs = 0);
 
@@ -38,8 +41,8 @@ public:
   // Clear entire queue (e.g. for panic)
   void cancelAll();
 
-  // HighResolutionTimer callback
-  void hiResTimerCallback() override;
+  // Scheduler tick: plays due notes, expires releases; returns next deadline
+  double onSchedulerTick(double nowMs) override;
 
 private:
   struct ReleaseInfo {
@@ -55,5 +58,6 @@ private:
   juce::CriticalSection queueLock;
   double currentTimeMs = 0.0;
   bool autoStrumDownNext = true; // for AutoAlternating
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
   double getCurrentTimeMs() const;
 };
@@ -0,0 +1,73 @@
+#include "TaskPool.h"
+#include <algorithm>
+
+TaskPool::TaskPool(int numWorkers) {
+  workers.reserve((size_t)std::max(0, numWorkers));
+  for (int i = 0; i < numWorkers; ++i)
+    workers.emplace_back([this] { workerLoop(); });
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+int TaskPool::defaultNumWorkers() {
+  const int hardware = (int)std::thread::hardware_concurrency();
+  return std::clamp(hardware - 1, 0, 7);
+}
+
+void TaskPool::parallelFor(int count, const std::function<void(int)> &task) {
+  if (count <= 0)
+    return;
+  if (workers.empty() || count == 1) {
+    for (int i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+
+  Batch batch;
+  batch.task = &task;
+  batch.count = count;
+  batch.remaining = count;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  pending.push_back(&batch);
+  workAvailable.notify_all();
+
+  while (batch.remaining > 0) {
+    // Help with our own (or any older) batch rather than sleep.
+    if (!runOne(lock))
+      batchFinished.wait(lock);
+  }
+}
+
+bool TaskPool::runOne(std::unique_lock<std::mutex> &lock) {
+  if (pending.empty())
+    return false;
+  Batch *batch = pending.front();
+  const int index = batch->next++;
+  if (batch->next == batch->count)
+    pending.pop_front(); // Fully claimed; its owner waits for remaining
+
+  lock.unlock();
+  (*batch->task)(index);
+  lock.lock();
+
+  if (--batch->remaining == 0)
+    batchFinished.notify_all();
+  return true;
+}
+
+void TaskPool::workerLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!stopping) {
+    if (!runOne(lock))
+      workAvailable.wait(lock);
+  }
+}
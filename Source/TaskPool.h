@@ -0,0 +1,53 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fork-join pool for compile-time work (MappingCompiler). parallelFor
+// publishes a batch of independent tasks; idle workers and the calling
+// thread claim task indices from it until the batch is drained, so uneven
+// tasks balance themselves. A thread waiting on a batch runs queued tasks
+// instead of blocking, which makes nested parallelFor calls deadlock-free.
+// Not for the real-time path: tasks may allocate and take locks.
+class TaskPool {
+public:
+  // numWorkers = 0: every parallelFor runs serially on the calling thread.
+  explicit TaskPool(int numWorkers = defaultNumWorkers());
+  ~TaskPool();
+
+  // Run task(0) .. task(count - 1) and return once all have finished. Tasks
+  // must not throw. Results should be written to per-index slots and merged
+  // by the caller afterwards, so the outcome does not depend on scheduling.
+  void parallelFor(int count, const std::function<void(int)> &task);
+
+  int getNumWorkers() const { return (int)workers.size(); }
+
+  // Hardware threads minus one (the caller also runs tasks), at most 7.
+  static int defaultNumWorkers();
+
+private:
+  struct Batch {
+    const std::function<void(int)> *task = nullptr;
+    int count = 0;
+    int next = 0;      // Next unclaimed index
+    int remaining = 0; // Claimed or unclaimed, not yet finished
+  };
+
+  void workerLoop();
+  // Claim and run one task of the oldest batch with unclaimed work. Returns
+  // false if there is none. Called (and returns) with lock held.
+  bool runOne(std::unique_lock<std::mutex> &lock);
+
+  std::mutex mutex;
+  std::condition_variable workAvailable;
+  std::condition_variable batchFinished;
+  std::deque<Batch *> pending; // Batches with unclaimed indices
+  bool stopping = false;
+  std::vector<std::thread> workers;
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+};
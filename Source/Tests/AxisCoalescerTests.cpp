@@ -0,0 +1,93 @@
+#include "../AxisCoalescer.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+class AxisCoalescerTest : public ::testing::Test {
+protected:
+  struct Sent {
+    int channel, cc, value;
+    bool operator==(const Sent &) const = default;
+  };
+  std::vector<Sent> sent;
+  AxisCoalescer coalescer{[this](int channel, int cc, int value) {
+    sent.push_back({channel, cc, value});
+  }};
+  const InputID pointerX{1, InputTypes::PointerX};
+  const InputID pointerY{1, InputTypes::PointerY};
+};
+
+TEST_F(AxisCoalescerTest, FirstChangeIsSentImmediately) {
+  EXPECT_EQ(coalescer.push(pointerX, 1, 10, 64, 100.0, 5.0),
+            RealtimeScheduler::idle);
+  EXPECT_EQ(sent, (std::vector<Sent>{{1, 10, 64}}));
+}
+
+TEST_F(AxisCoalescerTest, BurstCollapsesToNewestValue) {
+  coalescer.push(pointerX, 1, 10, 60, 100.0, 5.0);
+  EXPECT_EQ(coalescer.push(pointerX, 1, 10, 61, 101.0, 5.0), 105.0);
+  coalescer.push(pointerX, 1, 10, 62, 102.0, 5.0);
+  coalescer.push(pointerX, 1, 10, 63, 103.0, 5.0);
+  EXPECT_EQ(sent.size(), 1u);
+
+  EXPECT_EQ(coalescer.flush(104.0), 105.0); // Not due yet
+  EXPECT_EQ(sent.size(), 1u);
+  EXPECT_EQ(coalescer.flush(105.0), RealtimeScheduler::idle);
+  EXPECT_EQ(sent, (std::vector<Sent>{{1, 10, 60}, {1, 10, 63}}));
+}
+
+TEST_F(AxisCoalescerTest, UnchangedValuesAreDropped) {
+  coalescer.push(pointerX, 1, 10, 60, 100.0, 5.0);
+  coalescer.push(pointerX, 1, 10, 60, 200.0, 5.0);
+  EXPECT_EQ(sent.size(), 1u);
+
+  // A held change that returns to the sent value is cancelled.
+  coalescer.push(pointerX, 1, 10, 61, 201.0, 5.0);
+  coalescer.push(pointerX, 1, 10, 60, 202.0, 5.0);
+  coalescer.flush(300.0);
+  EXPECT_EQ(sent.size(), 2u);
+  EXPECT_EQ(sent.back().value, 60);
+}
+
+TEST_F(AxisCoalescerTest, AxesAreLimitedIndependently) {
+  coalescer.push(pointerX, 1, 10, 60, 100.0, 5.0);
+  coalescer.push(pointerY, 1, 11, 30, 100.5, 5.0);
+  EXPECT_EQ(sent, (std::vector<Sent>{{1, 10, 60}, {1, 11, 30}}));
+
+  coalescer.push(pointerX, 1, 10, 70, 101.0, 5.0);
+  coalescer.push(pointerY, 1, 11, 40, 101.0, 5.0);
+  EXPECT_EQ(coalescer.flush(105.0), 105.5);
+  EXPECT_EQ(sent.back(), (Sent{1, 10, 70}));
+  EXPECT_EQ(coalescer.flush(105.5), RealtimeScheduler::idle);
+  EXPECT_EQ(sent.back(), (Sent{1, 11, 40}));
+}
+
+TEST_F(AxisCoalescerTest, ZeroIntervalSendsEveryChange) {
+  for (int v = 0; v < 5; ++v)
+    coalescer.push(pointerX, 1, 10, v, 100.0, 0.0);
+  coalescer.push(pointerX, 1, 10, 4, 100.0, 0.0);
+  EXPECT_EQ(sent.size(), 5u);
+}
+
+TEST_F(AxisCoalescerTest, RemappedCcStartsFresh) {
+  coalescer.push(pointerX, 1, 10, 60, 100.0, 5.0);
+  coalescer.push(pointerX, 1, 10, 61, 101.0, 5.0); // Held on CC 10
+  EXPECT_EQ(coalescer.push(pointerX, 2, 20, 60, 102.0, 5.0),
+            RealtimeScheduler::idle);
+  // The held value lands on the old CC, the new CC is not delayed.
+  EXPECT_EQ(sent, (std::vector<Sent>{{1, 10, 60}, {1, 10, 61}, {2, 20, 60}}));
+  EXPECT_EQ(coalescer.flush(110.0), RealtimeScheduler::idle);
+  EXPECT_EQ(sent.size(), 3u);
+}
+
+TEST_F(AxisCoalescerTest, ClearDropsHeldValues) {
+  coalescer.push(pointerX, 1, 10, 60, 100.0, 5.0);
+  coalescer.push(pointerX, 1, 10, 61, 101.0, 5.0);
+  coalescer.clear();
+  EXPECT_EQ(coalescer.flush(110.0), RealtimeScheduler::idle);
+  EXPECT_EQ(sent.size(), 1u);
+  // Sources start over: the next change is sent at once.
+  coalescer.push(pointerX, 1, 10, 60, 102.0, 5.0);
+  EXPECT_EQ(sent.size(), 2u);
+}
@@ -0,0 +1,138 @@
+#include "../CompiledContextCache.h"
+#include "../DeviceManager.h"
+#include "../MappingCompiler.h"
+#include "../PresetManager.h"
+#include "../ScaleLibrary.h"
+#include "../SettingsManager.h"
+#include "../TouchpadLayoutManager.h"
+#include "../Zone.h"
+#include "../ZoneManager.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+
+class CompiledContextCacheTest : public ::testing::Test {
+protected:
+  PresetManager presetMgr;
+  DeviceManager deviceMgr;
+  ScaleLibrary scaleLib;
+  SettingsManager settingsMgr;
+  TouchpadLayoutManager touchpadLayoutMgr;
+  ZoneManager zoneMgr{scaleLib};
+  juce::File file;
+  uintptr_t aliasHash = 0;
+
+  void SetUp() override {
+    presetMgr.getLayersList().removeAllChildren(nullptr);
+    presetMgr.ensureStaticLayers();
+    deviceMgr.createAlias("CacheDevice");
+    aliasHash = DeviceManager::getAliasHash("CacheDevice");
+
+    addNote(0, 81, 0);
+    addNote(2, 82, aliasHash);
+    auto zone = std::make_shared<Zone>();
+    zone->name = "Cached Triad";
+    zone->layerID = 1;
+    zone->inputKeyCodes = {70};
+    zone->chordType = ChordUtilities::ChordType::Triad;
+    zone->scaleName = "Major";
+    zone->rootNote = 60;
+    zoneMgr.addZone(zone);
+
+    file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+               .getNonexistentChildFile("midiqy_cache_", ".compiled", false);
+  }
+
+  void TearDown() override { file.deleteFile(); }
+
+  void addNote(int layerId, int keyCode, uintptr_t deviceHash) {
+    juce::ValueTree m("Mapping");
+    m.setProperty("inputKey", keyCode, nullptr);
+    m.setProperty("deviceHash",
+                  juce::String::toHexString((juce::int64)deviceHash)
+                      .toUpperCase(),
+                  nullptr);
+    m.setProperty("type", "Note", nullptr);
+    m.setProperty("data1", 60 + keyCode % 12, nullptr);
+    m.setProperty("layerID", layerId, nullptr);
+    presetMgr.getMappingsListForLayer(layerId).addChild(m, -1, nullptr);
+  }
+
+  juce::uint64 key() {
+    return CompiledContextCache::computeKey(presetMgr, deviceMgr, zoneMgr,
+                                            touchpadLayoutMgr, settingsMgr,
+                                            scaleLib);
+  }
+
+  std::shared_ptr<CompiledMapContext> compile() {
+    return MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                    touchpadLayoutMgr, settingsMgr);
+  }
+};
+
+TEST_F(CompiledContextCacheTest, RoundTripRestoresKeyboardPart) {
+  auto compiled = compile();
+  ASSERT_TRUE(CompiledContextCache::write(file, key(), *compiled, zoneMgr));
+  auto cached = CompiledContextCache::read(file, key(), zoneMgr);
+  ASSERT_NE(cached, nullptr);
+
+  EXPECT_EQ(cached->actionPool, compiled->actionPool);
+  EXPECT_EQ(cached->chordPool, compiled->chordPool);
+  EXPECT_EQ(cached->zoneTable, compiled->zoneTable);
+  EXPECT_EQ(cached->globalKeysWrittenByLayer,
+            compiled->globalKeysWrittenByLayer);
+  for (size_t layer = 0; layer < 9; ++layer) {
+    EXPECT_TRUE(*cached->globalGrids[layer] == *compiled->globalGrids[layer]);
+    EXPECT_TRUE(*cached->deviceGrids.at(aliasHash)[layer] ==
+                *compiled->deviceGrids.at(aliasHash)[layer]);
+    const auto &vCached = *cached->visualLookup.at(aliasHash)[layer];
+    const auto &vCompiled = *compiled->visualLookup.at(aliasHash)[layer];
+    for (size_t slot = 0; slot < 256; ++slot) {
+      EXPECT_EQ(vCached[slot].state, vCompiled[slot].state);
+      EXPECT_EQ(vCached[slot].displayColor, vCompiled[slot].displayColor);
+      EXPECT_EQ(cached->labelFor(vCached[slot]),
+                compiled->labelFor(vCompiled[slot]));
+    }
+  }
+  // Grids shared in memory stay shared after loading.
+  EXPECT_EQ(cached->globalGrids[0] == cached->globalGrids[8],
+            compiled->globalGrids[0] == compiled->globalGrids[8]);
+
+  // The keyboard part is reused as-is when only touchpads are recompiled.
+  auto live = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                       touchpadLayoutMgr, settingsMgr,
+                                       cached.get(),
+                                       MappingCompiler::Scope::touchpadOnly());
+  EXPECT_EQ(live->globalGrids[1], cached->globalGrids[1]);
+}
+
+TEST_F(CompiledContextCacheTest, ChangedSessionMissesTheCache) {
+  const juce::uint64 before = key();
+  ASSERT_TRUE(CompiledContextCache::write(file, before, *compile(), zoneMgr));
+
+  addNote(3, 83, 0);
+  const juce::uint64 after = key();
+  EXPECT_NE(after, before);
+  EXPECT_EQ(CompiledContextCache::read(file, after, zoneMgr), nullptr);
+  EXPECT_NE(CompiledContextCache::read(file, before, zoneMgr), nullptr);
+}
+
+TEST_F(CompiledContextCacheTest, CorruptFilesAreRejected) {
+  ASSERT_TRUE(CompiledContextCache::write(file, key(), *compile(), zoneMgr));
+  juce::MemoryBlock data;
+  ASSERT_TRUE(file.loadFileAsData(data));
+
+  // Truncated body: the header's size no longer matches.
+  file.replaceWithData(data.getData(), data.getSize() / 2);
+  EXPECT_EQ(CompiledContextCache::read(file, key(), zoneMgr), nullptr);
+
+  // Same size, scrambled body: indices and counts fail validation.
+  juce::MemoryBlock scrambled(data);
+  for (size_t i = 24; i < scrambled.getSize(); i += 7)
+    scrambled[i] = (char)0xFF;
+  file.replaceWithData(scrambled.getData(), scrambled.getSize());
+  EXPECT_EQ(CompiledContextCache::read(file, key(), zoneMgr), nullptr);
+
+  file.deleteFile();
+  EXPECT_EQ(CompiledContextCache::read(file, key(), zoneMgr), nullptr);
+}
@@ -0,0 +1,155 @@
+#include "../ExpressionEngine.h"
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// The scheduler thread may tick the engine too, so sends are recorded under
+// a lock.
+class ExpressionRecorder : public MidiEngine {
+public:
+  struct Sent {
+    bool isPitchBend;
+    int channel;
+    int controller;
+    int value;
+  };
+  void sendCC(int channel, int controller, int value) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    sent.push_back({false, channel, controller, value});
+  }
+  void sendPitchBend(int channel, int value) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    sent.push_back({true, channel, 0, value});
+  }
+  std::vector<int> ccValues(int channel, int controller) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> out;
+    for (const auto &s : sent)
+      if (!s.isPitchBend && s.channel == channel && s.controller == controller)
+        out.push_back(s.value);
+    return out;
+  }
+  std::vector<int> pitchBends(int channel) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> out;
+    for (const auto &s : sent)
+      if (s.isPitchBend && s.channel == channel)
+        out.push_back(s.value);
+    return out;
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<Sent> sent;
+};
+
+AdsrSettings ccEnvelope(int cc, int attackMs, int decayMs, float sustain,
+                        int releaseMs) {
+  AdsrSettings s;
+  s.target = AdsrTarget::CC;
+  s.ccNumber = cc;
+  s.attackMs = attackMs;
+  s.decayMs = decayMs;
+  s.sustainLevel = sustain;
+  s.releaseMs = releaseMs;
+  s.useCustomEnvelope = true;
+  s.valueWhenOn = 127;
+  s.valueWhenOff = 0;
+  return s;
+}
+
+void runUntilSettled(ExpressionEngine &engine) {
+  for (int i = 0; i < 10000 && engine.processOneTick(); ++i) {
+  }
+}
+
+} // namespace
+
+TEST(ExpressionEngineTest, CcEnvelopeRisesToPeakDecaysAndReleases) {
+  ExpressionRecorder midi;
+  ExpressionEngine engine(midi);
+  const InputID key{0, 65};
+  engine.triggerEnvelope(key, 1, ccEnvelope(7, 50, 50, 0.5f, 50), 127);
+  runUntilSettled(engine);
+
+  auto values = midi.ccValues(1, 7);
+  ASSERT_FALSE(values.empty());
+  EXPECT_EQ(*std::max_element(values.begin(), values.end()), 127);
+  EXPECT_EQ(values.back(), 63); // Sustain at half of 127
+  for (size_t i = 1; i < values.size(); ++i)
+    EXPECT_NE(values[i], values[i - 1]); // Only changes are sent
+
+  engine.releaseEnvelope(key);
+  runUntilSettled(engine);
+  values = midi.ccValues(1, 7);
+  EXPECT_EQ(values.back(), 0);
+  EXPECT_EQ(engine.getNumActiveEnvelopes(), 0);
+}
+
+TEST(ExpressionEngineTest, InstantAttackStillRunsTheDecay) {
+  ExpressionRecorder midi;
+  ExpressionEngine engine(midi);
+  engine.triggerEnvelope(InputID{0, 65}, 1, ccEnvelope(7, 0, 100, 0.0f, 10),
+                         127);
+  runUntilSettled(engine);
+  // 100ms decay at 200Hz: a ramp down, not a jump straight to sustain.
+  const auto values = midi.ccValues(1, 7);
+  EXPECT_GT(values.size(), 10u);
+  EXPECT_EQ(values.back(), 0);
+}
+
+TEST(ExpressionEngineTest, ManyEnvelopesAdvanceIndependently) {
+  ExpressionRecorder midi;
+  ExpressionEngine engine(midi);
+  for (int i = 0; i < 256; ++i)
+    engine.triggerEnvelope(InputID{0, i}, 1 + i / 16,
+                           ccEnvelope(i % 16, 10 + i, 20, 1.0f, 30), 127);
+  EXPECT_EQ(engine.getNumActiveEnvelopes(), 256);
+  runUntilSettled(engine);
+  for (int ch = 1; ch <= 16; ++ch)
+    for (int cc = 0; cc < 16; ++cc)
+      EXPECT_EQ(midi.ccValues(ch, cc).back(), 127) << ch << "/" << cc;
+
+  for (int i = 0; i < 256; i += 2)
+    engine.releaseEnvelope(InputID{0, i});
+  runUntilSettled(engine);
+  EXPECT_EQ(engine.getNumActiveEnvelopes(), 128);
+  EXPECT_EQ(midi.ccValues(1, 0).back(), 0);
+  EXPECT_EQ(midi.ccValues(1, 1).back(), 127);
+}
+
+TEST(ExpressionEngineTest, PitchBendHandsBackToPreviousKey) {
+  ExpressionRecorder midi;
+  ExpressionEngine engine(midi);
+  AdsrSettings pb;
+  pb.target = AdsrTarget::PitchBend;
+  pb.attackMs = 20;
+  pb.decayMs = 0;
+  pb.sustainLevel = 1.0f;
+  pb.releaseMs = 20;
+  pb.useCustomEnvelope = true;
+
+  const InputID low{0, 1}, high{0, 2};
+  engine.triggerEnvelope(low, 1, pb, 4096);
+  runUntilSettled(engine);
+  EXPECT_EQ(midi.pitchBends(1).back(), 4096);
+
+  engine.triggerEnvelope(high, 1, pb, 12288);
+  runUntilSettled(engine);
+  EXPECT_EQ(midi.pitchBends(1).back(), 12288);
+
+  // Releasing the driver re-attacks the key underneath.
+  engine.releaseEnvelope(high);
+  runUntilSettled(engine);
+  EXPECT_EQ(midi.pitchBends(1).back(), 4096);
+
+  engine.releaseEnvelope(low);
+  runUntilSettled(engine);
+  EXPECT_EQ(midi.pitchBends(1).back(), 8192);
+  EXPECT_EQ(engine.getNumActiveEnvelopes(), 0);
+}
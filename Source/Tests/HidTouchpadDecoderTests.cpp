@@ -0,0 +1,265 @@
+#include "../HidTouchpadDecoder.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// Two-finger Precision Touchpad descriptor in the layout of the Windows PTP
+// reference: per finger Confidence + Tip bits, a 2-bit Contact ID, 4 bits of
+// padding and 16-bit X/Y; then scan time, contact count, one button and a
+// feature report the decoder must ignore.
+std::vector<uint8_t> ptpDescriptor() {
+  const std::vector<uint8_t> finger = {
+      0x05, 0x0D,       // Usage Page (Digitizer)
+      0x09, 0x22,       // Usage (Finger)
+      0xA1, 0x02,       // Collection (Logical)
+      0x15, 0x00,       //   Logical Minimum (0)
+      0x25, 0x01,       //   Logical Maximum (1)
+      0x09, 0x47,       //   Usage (Confidence)
+      0x09, 0x42,       //   Usage (Tip Switch)
+      0x95, 0x02,       //   Report Count (2)
+      0x75, 0x01,       //   Report Size (1)
+      0x81, 0x02,       //   Input (Data, Var, Abs)
+      0x95, 0x01,       //   Report Count (1)
+      0x75, 0x02,       //   Report Size (2)
+      0x25, 0x02,       //   Logical Maximum (2)
+      0x09, 0x51,       //   Usage (Contact Identifier)
+      0x81, 0x02,       //   Input (Data, Var, Abs)
+      0x75, 0x01,       //   Report Size (1)
+      0x95, 0x04,       //   Report Count (4)
+      0x81, 0x03,       //   Input (Const)
+      0x05, 0x01,       //   Usage Page (Generic Desktop)
+      0x15, 0x00,       //   Logical Minimum (0)
+      0x26, 0xFF, 0x0F, //   Logical Maximum (4095)
+      0x75, 0x10,       //   Report Size (16)
+      0x95, 0x01,       //   Report Count (1)
+      0x55, 0x0E,       //   Unit Exponent (-2)
+      0x65, 0x11,       //   Unit (cm)
+      0x09, 0x30,       //   Usage (X)
+      0x35, 0x00,       //   Physical Minimum (0)
+      0x46, 0x90, 0x01, //   Physical Maximum (400)
+      0x81, 0x02,       //   Input (Data, Var, Abs)
+      0x46, 0x13, 0x01, //   Physical Maximum (275)
+      0x09, 0x31,       //   Usage (Y)
+      0x81, 0x02,       //   Input (Data, Var, Abs)
+      0xC0,             // End Collection
+  };
+  std::vector<uint8_t> d = {
+      0x05, 0x0D, // Usage Page (Digitizer)
+      0x09, 0x05, // Usage (Touch Pad)
+      0xA1, 0x01, // Collection (Application)
+      0x85, 0x01, //   Report ID (1)
+  };
+  d.insert(d.end(), finger.begin(), finger.end());
+  d.insert(d.end(), finger.begin(), finger.end());
+  d.insert(d.end(), {
+                        0x05, 0x0D,       // Usage Page (Digitizer)
+                        0x55, 0x0C,       // Unit Exponent (-4)
+                        0x66, 0x01, 0x10, // Unit (s)
+                        0x47, 0xFF, 0xFF, 0x00, 0x00, // Physical Max (65535)
+                        0x27, 0xFF, 0xFF, 0x00, 0x00, // Logical Max (65535)
+                        0x75, 0x10,       // Report Size (16)
+                        0x95, 0x01,       // Report Count (1)
+                        0x09, 0x56,       // Usage (Scan Time)
+                        0x81, 0x02,       // Input (Data, Var, Abs)
+                        0x09, 0x54,       // Usage (Contact Count)
+                        0x25, 0x7F,       // Logical Maximum (127)
+                        0x75, 0x08,       // Report Size (8)
+                        0x81, 0x02,       // Input (Data, Var, Abs)
+                        0x05, 0x09,       // Usage Page (Button)
+                        0x09, 0x01,       // Usage (Button 1)
+                        0x25, 0x01,       // Logical Maximum (1)
+                        0x75, 0x01,       // Report Size (1)
+                        0x81, 0x02,       // Input (Data, Var, Abs)
+                        0x95, 0x07,       // Report Count (7)
+                        0x81, 0x03,       // Input (Const)
+                        0x05, 0x0D,       // Usage Page (Digitizer)
+                        0x85, 0x02,       // Report ID (2)
+                        0x09, 0x55,       // Usage (Contact Count Maximum)
+                        0x09, 0x59,       // Usage (Pad Type)
+                        0x75, 0x04,       // Report Size (4)
+                        0x95, 0x02,       // Report Count (2)
+                        0x25, 0x0F,       // Logical Maximum (15)
+                        0xB1, 0x02,       // Feature (Data, Var, Abs)
+                        0xC0,             // End Collection
+                    });
+  return d;
+}
+
+const std::vector<uint8_t> kPtpDescriptor = ptpDescriptor();
+
+// One report for kPtpDescriptor: ID, two fingers, scan time, contact count.
+std::vector<uint8_t> ptpReport(int id0, bool tip0, int x0, int y0, int id1,
+                               bool tip1, int x1, int y1, int count) {
+  auto finger = [](std::vector<uint8_t> &r, int id, bool tip, int x, int y) {
+    r.push_back((uint8_t)(0x01 | (tip ? 0x02 : 0) | (id << 2)));
+    r.push_back((uint8_t)x);
+    r.push_back((uint8_t)(x >> 8));
+    r.push_back((uint8_t)y);
+    r.push_back((uint8_t)(y >> 8));
+  };
+  std::vector<uint8_t> r{0x01};
+  finger(r, id0, tip0, x0, y0);
+  finger(r, id1, tip1, x1, y1);
+  r.insert(r.end(), {0x34, 0x12, (uint8_t)count, 0x00});
+  return r;
+}
+
+HidTouchpadPlan compile(const std::vector<uint8_t> &descriptor) {
+  return compileTouchpadPlan(descriptor.data(), descriptor.size());
+}
+} // namespace
+
+TEST(HidTouchpadDecoderTest, CompilesReferenceDescriptorToBitOffsets) {
+  const HidTouchpadPlan plan = compile(kPtpDescriptor);
+  ASSERT_TRUE(plan.isValid());
+  EXPECT_EQ(plan.reportId, 1);
+  EXPECT_EQ(plan.reportBytes, 15u);
+  EXPECT_EQ(plan.contactSlots, 2);
+
+  const auto &f0 = plan.contacts[0];
+  EXPECT_EQ(f0.tip.bitOffset, 9u);
+  EXPECT_EQ(f0.tip.bitSize, 1);
+  EXPECT_EQ(f0.contactId.bitOffset, 10u);
+  EXPECT_EQ(f0.contactId.bitSize, 2);
+  EXPECT_EQ(f0.x.bitOffset, 16u);
+  EXPECT_EQ(f0.x.logicalMax, 4095);
+  EXPECT_EQ(f0.y.bitOffset, 32u);
+  EXPECT_EQ(plan.contacts[1].x.bitOffset, 56u);
+  EXPECT_EQ(plan.contactCount.bitOffset, 104u);
+  EXPECT_EQ(plan.contactCount.bitSize, 8);
+}
+
+TEST(HidTouchpadDecoderTest, DecodesContactsFromReport) {
+  const HidTouchpadPlan plan = compile(kPtpDescriptor);
+  const auto report = ptpReport(1, true, 4095, 0, 2, false, 1000, 2048, 2);
+
+  TouchpadContactFrame frame;
+  ASSERT_TRUE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  ASSERT_EQ(frame.count, 2);
+
+  const TouchpadContact &a = frame.contacts[0];
+  EXPECT_EQ(a.contactId, 1);
+  EXPECT_TRUE(a.tipDown);
+  EXPECT_EQ(a.x, 4095);
+  EXPECT_EQ(a.y, 0);
+  EXPECT_FLOAT_EQ(a.normX, 1.0f);
+  EXPECT_FLOAT_EQ(a.normY, 0.0f);
+
+  const TouchpadContact &b = frame.contacts[1];
+  EXPECT_EQ(b.contactId, 2);
+  EXPECT_FALSE(b.tipDown);
+  EXPECT_EQ(b.x, 1000);
+  EXPECT_EQ(b.y, 2048);
+  EXPECT_NEAR(b.normY, 2048.0f / 4095.0f, 1e-6f);
+}
+
+TEST(HidTouchpadDecoderTest, ContactCountLimitsSlots) {
+  const HidTouchpadPlan plan = compile(kPtpDescriptor);
+  TouchpadContactFrame frame;
+
+  auto report = ptpReport(0, true, 10, 20, 0, false, 0, 0, 1);
+  ASSERT_TRUE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  EXPECT_EQ(frame.count, 1);
+
+  // Hybrid-mode follow-up reports carry a zero count: every slot is decoded.
+  report = ptpReport(0, true, 10, 20, 1, true, 30, 40, 0);
+  ASSERT_TRUE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  EXPECT_EQ(frame.count, 2);
+}
+
+TEST(HidTouchpadDecoderTest, RejectsOtherReportsAndShortReports) {
+  const HidTouchpadPlan plan = compile(kPtpDescriptor);
+  TouchpadContactFrame frame;
+
+  auto report = ptpReport(1, true, 10, 20, 2, true, 30, 40, 2);
+  report[0] = 0x02;
+  EXPECT_FALSE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  EXPECT_EQ(frame.count, 0);
+
+  report[0] = 0x01;
+  EXPECT_FALSE(decodeTouchpadReport(plan, report.data(), 8, frame));
+  EXPECT_EQ(frame.count, 0);
+}
+
+TEST(HidTouchpadDecoderTest, ParallelArraysMapToConsecutiveSlots) {
+  // No report IDs, no Finger collections: three contacts as parallel arrays
+  // of 8-bit signed X and Y.
+  const std::vector<uint8_t> descriptor = {
+      0x05, 0x0D, 0x09, 0x05, 0xA1, 0x01, // Digitizer / Touch Pad
+      0x05, 0x01,                         //   Generic Desktop
+      0x15, 0x81, 0x25, 0x7F,             //   Logical -127..127
+      0x75, 0x08, 0x95, 0x03,             //   8 bits x 3
+      0x09, 0x30, 0x81, 0x02,             //   X
+      0x09, 0x31, 0x81, 0x02,             //   Y
+      0xC0,
+  };
+  const HidTouchpadPlan plan = compile(descriptor);
+  ASSERT_TRUE(plan.isValid());
+  EXPECT_EQ(plan.reportId, 0);
+  EXPECT_EQ(plan.reportBytes, 6u);
+  EXPECT_EQ(plan.contactSlots, 3);
+  EXPECT_EQ(plan.contacts[2].y.bitOffset, 40u);
+  EXPECT_EQ(plan.contacts[0].x.logicalMin, -127);
+  EXPECT_EQ(plan.contacts[0].x.logicalMax, 127);
+
+  const std::vector<uint8_t> report = {0x81, 0x00, 0x7F, 0x7F, 0x00, 0xFF};
+  TouchpadContactFrame frame;
+  ASSERT_TRUE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  ASSERT_EQ(frame.count, 3);
+  EXPECT_EQ(frame.contacts[0].x, -127);
+  EXPECT_FLOAT_EQ(frame.contacts[0].normX, 0.0f);
+  EXPECT_EQ(frame.contacts[2].y, -1);
+  EXPECT_EQ(frame.contacts[1].contactId, 1); // Slot index without an ID field
+  EXPECT_TRUE(frame.contacts[1].tipDown);    // No Tip Switch: assumed down
+}
+
+TEST(HidTouchpadDecoderTest, NonTouchpadOrCorruptDescriptorsAreInvalid) {
+  // A mouse: X/Y outside any Touch Pad collection.
+  const std::vector<uint8_t> mouse = {0x05, 0x01, 0x09, 0x02, 0xA1, 0x01,
+                                      0x09, 0x30, 0x09, 0x31, 0x75, 0x08,
+                                      0x95, 0x02, 0x81, 0x06, 0xC0};
+  EXPECT_FALSE(compile(mouse).isValid());
+
+  // Truncated reference descriptor.
+  std::vector<uint8_t> truncated(kPtpDescriptor.begin(),
+                                 kPtpDescriptor.begin() + 40);
+  EXPECT_FALSE(compile(truncated).isValid());
+
+  // Oversized report count.
+  const std::vector<uint8_t> huge = {0x05, 0x0D, 0x09, 0x05, 0xA1, 0x01,
+                                     0x75, 0x20, 0x97, 0xFF, 0xFF, 0xFF,
+                                     0x7F, 0x81, 0x03, 0xC0};
+  const HidTouchpadPlan plan = compile(huge);
+  EXPECT_FALSE(plan.isValid());
+  TouchpadContactFrame frame;
+  const uint8_t report[4] = {};
+  EXPECT_FALSE(decodeTouchpadReport(plan, report, sizeof(report), frame));
+}
+
+TEST(HidTouchpadDecoderTest, NormalizesFullWidth32BitFields) {
+  // 32-bit X and Y over -1..INT32_MAX: value - logicalMin exceeds int32.
+  const std::vector<uint8_t> descriptor = {
+      0x05, 0x0D, 0x09, 0x05, 0xA1, 0x01, // Digitizer / Touch Pad
+      0x05, 0x01,                         //   Generic Desktop
+      0x17, 0xFF, 0xFF, 0xFF, 0xFF,       //   Logical Minimum (-1)
+      0x27, 0xFF, 0xFF, 0xFF, 0x7F,       //   Logical Maximum (INT32_MAX)
+      0x75, 0x20, 0x95, 0x01,             //   32 bits x 1
+      0x09, 0x30, 0x81, 0x02,             //   X
+      0x09, 0x31, 0x81, 0x02,             //   Y
+      0xC0,
+  };
+  const HidTouchpadPlan plan = compile(descriptor);
+  ASSERT_TRUE(plan.isValid());
+  EXPECT_EQ(plan.contacts[0].x.logicalMin, -1);
+  EXPECT_EQ(plan.contacts[0].x.bitSize, 32u);
+
+  const std::vector<uint8_t> report = {0xFF, 0xFF, 0xFF, 0x7F,
+                                       0xFF, 0xFF, 0xFF, 0x3F};
+  TouchpadContactFrame frame;
+  ASSERT_TRUE(decodeTouchpadReport(plan, report.data(), report.size(), frame));
+  ASSERT_EQ(frame.count, 1);
+  EXPECT_EQ(frame.contacts[0].x, INT32_MAX);
+  EXPECT_FLOAT_EQ(frame.contacts[0].normX, 1.0f);
+  EXPECT_NEAR(frame.contacts[0].normY, 0.5f, 1e-6f);
+}
@@ -45,6 +45,12 @@ public:
   void sendNoteOff(int channel, int note) override {
     events.push_back({channel, note, 0.0f, false});
   }
+  void sendNoteOnAt(int channel, int note, float velocity, double) override {
+    sendNoteOn(channel, note, velocity);
+  }
+  void sendNoteOffAt(int channel, int note, double) override {
+    sendNoteOff(channel, note);
+  }
   void sendPitchBend(int channel, int value) override {
     pitchEvents.push_back({channel, value});
   }
@@ -198,12 +204,14 @@ protected:
                               stepsPerSemitone);
   }
   int getLastPitchBend(uintptr_t deviceHandle) const {
-    auto key =
-        std::make_tuple(deviceHandle, 0, (int)TouchpadEvent::Finger1X, 1, -1);
-    auto it = proc.lastTouchpadContinuousValues.find(key);
-    if (it == proc.lastTouchpadContinuousValues.end())
+    // The pitch mapping is the only compiled touchpad mapping (row 0).
+    int slot = proc.touchpadState.findDevice(deviceHandle);
+    if (slot == TouchpadStateTable::kNoValue ||
+        proc.touchpadState.numMappings() == 0)
       return 8192;
-    return it->second;
+    int v = proc.touchpadState.mapping
+                .lastContinuousValue[proc.touchpadState.mappingRow(slot, 0)];
+    return v == TouchpadStateTable::kNoValue ? 8192 : v;
   }
 };
 
@@ -927,6 +935,28 @@ TEST_F(ReleaseBehaviorTest,
   EXPECT_EQ(mockMidi.events[1].note, 60);
 }
 
+// A zone release (releaseMs) stays cancellable until it is due: retriggering
+// the note just before then must not let the old NoteOff cut the new note.
+TEST_F(ReleaseBehaviorTest, ReleaseTail_RetriggerJustBeforeDue_NoStaleNoteOff) {
+  InputID id{0, 20};
+  voiceMgr.noteOn(id, 60, 100, 1, true, 1000);
+  const double earliestDueMs = RealtimeScheduler::nowMs() + 1000.0;
+  voiceMgr.handleKeyUp(id);
+  const double dueMs = RealtimeScheduler::nowMs() + 1000.0;
+  mockMidi.clear();
+
+  // Inside MidiEngine::kScheduleLookaheadMs of the release
+  voiceMgr.onSchedulerTick(earliestDueMs - 1.0);
+  EXPECT_TRUE(mockMidi.events.empty())
+      << "NoteOff must not be handed off before it is due";
+
+  voiceMgr.noteOn(id, 60, 100, 1, true, 1000); // Retrigger
+  voiceMgr.onSchedulerTick(dueMs + 5.0);
+  ASSERT_EQ(mockMidi.events.size(), 1u);
+  EXPECT_TRUE(mockMidi.events[0].isNoteOn);
+  EXPECT_EQ(mockMidi.events[0].note, 60);
+}
+
 TEST_F(ReleaseBehaviorTest,
        AlwaysLatch_PressReleasePressRelease_UnlatchesOnSecondPress) {
   addNoteMapping(20, 60, "Always Latch");
@@ -6345,6 +6375,90 @@ TEST_F(InputProcessorTest, RecompileWhenTouchpadLayoutGroupIdChanges) {
   EXPECT_EQ(opt2->touchpadLayoutGroupId, 2);
 }
 
+// Test: editing a Touchpad-alias mapping recompiles the touchpad entries,
+// not just the keyboard grids. The Touchpad tab entry shares its Mapping tree
+// with the preset layer here, so the preset listener sees the edit.
+TEST_F(InputProcessorTest, TouchpadMappingEditRecompilesTouchpadEntries) {
+  auto cfg = makeTouchpadMappingConfig(0, TouchpadEvent::Finger1Down, "Note",
+                                       "Send Note Off", "", 1, 60);
+  touchpadMixerMgr.addTouchpadMapping(cfg);
+  presetMgr.getMappingsListForLayer(0).appendChild(cfg.mapping, nullptr);
+  proc.forceRebuildMappings();
+
+  ASSERT_EQ(proc.getContext()->touchpadMappings.size(), 1u);
+  EXPECT_EQ(proc.getContext()->touchpadMappings.front().action.data1, 60);
+
+  cfg.mapping.setProperty("data1", 64, nullptr);
+
+  auto ctx = proc.getContext();
+  ASSERT_EQ(ctx->touchpadMappings.size(), 1u);
+  EXPECT_EQ(ctx->touchpadMappings.front().action.data1, 64)
+      << "Touchpad mapping edit must rebuild the touchpad part";
+}
+
+// Test: scroll codes resolve through the grid like keys, and
+// hasPointerMappings follows the compiled per-layer mask.
+TEST_F(InputProcessorTest, ScrollAndPointerMappingsResolveThroughGrid) {
+  auto mappings = presetMgr.getMappingsListForLayer(0);
+  juce::ValueTree m("Mapping");
+  m.setProperty("inputKey", InputTypes::ScrollDown, nullptr);
+  m.setProperty("deviceHash",
+                juce::String::toHexString((juce::int64)0).toUpperCase(),
+                nullptr);
+  m.setProperty("type", "Note", nullptr);
+  m.setProperty("data1", 65, nullptr);
+  m.setProperty("layerID", 0, nullptr);
+  mappings.appendChild(m, nullptr);
+  proc.forceRebuildMappings();
+
+  auto ref = proc.findMappingForInput(InputID{0, InputTypes::ScrollDown});
+  ASSERT_TRUE(ref);
+  EXPECT_EQ(ref->data1, 65);
+  EXPECT_FALSE(proc.findMappingForInput(InputID{0, InputTypes::ScrollUp}));
+  EXPECT_FALSE(proc.hasPointerMappings());
+
+  // Inactive layer: not counted.
+  TouchpadLayoutConfig cfg;
+  cfg.type = TouchpadType::Mixer;
+  cfg.layerId = 3;
+  touchpadMixerMgr.addLayout(cfg);
+  proc.forceRebuildMappings();
+  EXPECT_FALSE(proc.hasPointerMappings());
+
+  cfg.layerId = 0;
+  touchpadMixerMgr.updateLayout(0, cfg);
+  proc.forceRebuildMappings();
+  EXPECT_TRUE(proc.hasPointerMappings());
+}
+
+// Test: findMappingForInput returns a view into the context it was found in;
+// the view stays valid (and unchanged) after a rebuild publishes a new one.
+TEST_F(InputProcessorTest, FoundMappingOutlivesRebuild) {
+  auto mappings = presetMgr.getMappingsListForLayer(0);
+  juce::ValueTree m("Mapping");
+  m.setProperty("inputKey", 62, nullptr);
+  m.setProperty("deviceHash",
+                juce::String::toHexString((juce::int64)0).toUpperCase(),
+                nullptr);
+  m.setProperty("type", "Note", nullptr);
+  m.setProperty("data1", 64, nullptr);
+  m.setProperty("layerID", 0, nullptr);
+  mappings.appendChild(m, nullptr);
+  proc.forceRebuildMappings();
+
+  EXPECT_FALSE(proc.findMappingForInput(InputID{0, 63}));
+  auto ref = proc.findMappingForInput(InputID{0, 62});
+  ASSERT_TRUE(ref);
+  EXPECT_EQ(ref->data1, 64);
+
+  m.setProperty("data1", 67, nullptr);
+  proc.forceRebuildMappings();
+  EXPECT_EQ(ref->data1, 64);
+  auto fresh = proc.findMappingForInput(InputID{0, 62});
+  ASSERT_TRUE(fresh);
+  EXPECT_EQ(fresh->data1, 67);
+}
+
 // Test: Changing touchpadSoloScope on a mapping triggers grid rebuild and
 // compiled action reflects new value.
 TEST_F(InputProcessorTest, RecompileWhenTouchpadSoloScopeChanges) {
@@ -6827,12 +6941,14 @@ protected:
   }
 
   int getLastPitchBend(uintptr_t deviceHandle) const {
-    auto key =
-        std::make_tuple(deviceHandle, 0, (int)TouchpadEvent::Finger1X, 1, -1);
-    auto it = proc.lastTouchpadContinuousValues.find(key);
-    if (it == proc.lastTouchpadContinuousValues.end())
+    // The pitch mapping is the only compiled touchpad mapping (row 0).
+    int slot = proc.touchpadState.findDevice(deviceHandle);
+    if (slot == TouchpadStateTable::kNoValue ||
+        proc.touchpadState.numMappings() == 0)
       return 8192;
-    return it->second;
+    int v = proc.touchpadState.mapping
+                .lastContinuousValue[proc.touchpadState.mappingRow(slot, 0)];
+    return v == TouchpadStateTable::kNoValue ? 8192 : v;
   }
 };
 
@@ -0,0 +1,101 @@
+#include "../InputRecording.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+
+namespace {
+InputRecording makeRecording() {
+  InputRecording rec;
+  InputRecording::Event key;
+  key.timeMs = 1.5;
+  key.device = 0x1234;
+  key.code = 0x41;
+  key.isDown = true;
+  key.kind = InputRecording::Kind::Key;
+  rec.events.push_back(key);
+
+  InputRecording::Event axis;
+  axis.timeMs = 2.25;
+  axis.device = 0x1234;
+  axis.code = 0x1000;
+  axis.value = 0.75f;
+  axis.kind = InputRecording::Kind::Axis;
+  rec.events.push_back(axis);
+
+  InputRecording::Event pad;
+  pad.timeMs = 3.0;
+  pad.device = 0xBEEF;
+  pad.kind = InputRecording::Kind::Touchpad;
+  pad.firstContact = 0;
+  pad.numContacts = 2;
+  rec.events.push_back(pad);
+  rec.contacts.push_back({1, 100, 200, 0.1f, 0.2f, true});
+  rec.contacts.push_back({2, 300, 400, 0.3f, 0.4f, false});
+  return rec;
+}
+} // namespace
+
+TEST(InputRecordingTest, RoundTripsThroughBinaryStream) {
+  const auto rec = makeRecording();
+  juce::MemoryOutputStream out;
+  rec.writeTo(out);
+
+  juce::MemoryInputStream in(out.getData(), out.getDataSize(), false);
+  InputRecording loaded;
+  ASSERT_TRUE(loaded.readFrom(in));
+  ASSERT_EQ(loaded.events.size(), 3u);
+  ASSERT_EQ(loaded.contacts.size(), 2u);
+
+  EXPECT_EQ(loaded.events[0].kind, InputRecording::Kind::Key);
+  EXPECT_EQ(loaded.events[0].device, (uintptr_t)0x1234);
+  EXPECT_EQ(loaded.events[0].code, 0x41);
+  EXPECT_TRUE(loaded.events[0].isDown);
+  EXPECT_DOUBLE_EQ(loaded.events[0].timeMs, 1.5);
+
+  EXPECT_EQ(loaded.events[1].kind, InputRecording::Kind::Axis);
+  EXPECT_FLOAT_EQ(loaded.events[1].value, 0.75f);
+
+  EXPECT_EQ(loaded.events[2].kind, InputRecording::Kind::Touchpad);
+  EXPECT_EQ(loaded.events[2].numContacts, 2);
+  EXPECT_EQ(loaded.contacts[1].contactId, 2);
+  EXPECT_EQ(loaded.contacts[1].y, 400);
+  EXPECT_FLOAT_EQ(loaded.contacts[1].normX, 0.3f);
+  EXPECT_FALSE(loaded.contacts[1].tipDown);
+  EXPECT_DOUBLE_EQ(loaded.durationMs(), 3.0);
+}
+
+TEST(InputRecordingTest, RejectsTruncatedAndForeignData) {
+  const auto rec = makeRecording();
+  juce::MemoryOutputStream out;
+  rec.writeTo(out);
+
+  juce::MemoryInputStream truncated(out.getData(), out.getDataSize() - 5,
+                                    false);
+  InputRecording loaded;
+  EXPECT_FALSE(loaded.readFrom(truncated));
+  EXPECT_TRUE(loaded.events.empty());
+
+  const char garbage[32] = "not a capture";
+  juce::MemoryInputStream foreign(garbage, sizeof(garbage), false);
+  EXPECT_FALSE(loaded.readFrom(foreign));
+}
+
+TEST(InputRecorderTest, CapturesOnlyWhileStarted) {
+  InputRecorder recorder;
+  recorder.recordKey(1, 0x41, true); // Not started: ignored
+  recorder.start();
+  recorder.recordKey(1, 0x42, true);
+  recorder.recordAxis(1, 0x1000, 0.5f);
+  recorder.recordTouchpad(2, {{7, 10, 20, 0.5f, 0.5f, true}});
+  const auto rec = recorder.stop();
+  recorder.recordKey(1, 0x43, false); // Stopped: ignored
+
+  ASSERT_EQ(rec.events.size(), 3u);
+  EXPECT_EQ(rec.events[0].code, 0x42);
+  EXPECT_EQ(rec.events[1].kind, InputRecording::Kind::Axis);
+  EXPECT_EQ(rec.events[2].numContacts, 1);
+  ASSERT_EQ(rec.contacts.size(), 1u);
+  EXPECT_EQ(rec.contacts[0].contactId, 7);
+  EXPECT_LE(rec.events[0].timeMs, rec.events[2].timeMs);
+  EXPECT_FALSE(recorder.isRecording());
+}
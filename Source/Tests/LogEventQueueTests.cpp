@@ -0,0 +1,75 @@
+#include "../LogEventQueue.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(LogEventQueueTest, PopsInFifoOrder) {
+  LogEventQueue queue(8);
+  ASSERT_TRUE(queue.push({LogEvent::Kind::Key, true, 0x41, 7}));
+  ASSERT_TRUE(queue.push({LogEvent::Kind::Axis, false, 0x1001, 7, 0.25f}));
+
+  LogEvent e;
+  ASSERT_TRUE(queue.pop(e));
+  EXPECT_EQ(e.kind, LogEvent::Kind::Key);
+  EXPECT_TRUE(e.isDown);
+  EXPECT_EQ(e.code, 0x41);
+  EXPECT_EQ(e.device, (uintptr_t)7);
+
+  ASSERT_TRUE(queue.pop(e));
+  EXPECT_EQ(e.kind, LogEvent::Kind::Axis);
+  EXPECT_EQ(e.code, 0x1001);
+  EXPECT_FLOAT_EQ(e.value, 0.25f);
+  EXPECT_FALSE(queue.pop(e));
+}
+
+TEST(LogEventQueueTest, DropsAndCountsWhenFull) {
+  LogEventQueue queue(4);
+  ASSERT_EQ(queue.capacity(), 4u);
+  for (int i = 0; i < 4; ++i)
+    ASSERT_TRUE(queue.push({LogEvent::Kind::Key, true, i}));
+  EXPECT_FALSE(queue.push({LogEvent::Kind::Key, true, 99}));
+  EXPECT_FALSE(queue.push({LogEvent::Kind::Key, true, 100}));
+  EXPECT_EQ(queue.takeDroppedCount(), 2u);
+  EXPECT_EQ(queue.takeDroppedCount(), 0u);
+
+  LogEvent e;
+  ASSERT_TRUE(queue.pop(e));
+  EXPECT_EQ(e.code, 0);
+  EXPECT_TRUE(queue.push({LogEvent::Kind::Key, true, 4}));
+}
+
+// Several producers, one consumer: every event arrives exactly once and each
+// producer's events stay in order.
+TEST(LogEventQueueTest, MultipleProducersDeliverEverythingInPerThreadOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 2000;
+  LogEventQueue queue(128);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!queue.push({LogEvent::Kind::Key, true, i, (uintptr_t)p}))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  std::vector<int> lastSeen(kProducers, -1);
+  int received = 0;
+  LogEvent e;
+  while (received < kProducers * kPerProducer) {
+    if (!queue.pop(e)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_LT(e.device, (uintptr_t)kProducers);
+    EXPECT_EQ(e.code, lastSeen[e.device] + 1);
+    lastSeen[e.device] = e.code;
+    ++received;
+  }
+  for (auto &t : producers)
+    t.join();
+  EXPECT_FALSE(queue.pop(e));
+}
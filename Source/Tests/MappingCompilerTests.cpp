@@ -6,6 +6,7 @@
 #include "../PresetManager.h"
 #include "../ScaleLibrary.h"
 #include "../SettingsManager.h"
+#include "../TaskPool.h"
 #include "../TouchpadLayoutManager.h"
 #include "../TouchpadLayoutTypes.h"
 #include "../Zone.h"
@@ -258,6 +259,38 @@ TEST_F(MappingCompilerTest, VerticalOverride) {
   EXPECT_EQ((*l1)[81].state, VisualState::Override);
 }
 
+// Incremental compile: editing layer 2 reuses the layer 0/1 grids from the
+// previous context and produces the same layer 2+ result as a full compile.
+TEST_F(MappingCompilerTest, IncrementalCompileReusesLowerLayers) {
+  addMapping(0, 81, 0);
+  addMapping(1, 82, 0);
+  auto previous = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                           touchpadLayoutMgr, settingsMgr);
+
+  addMapping(2, 83, 0);
+  auto incremental = MappingCompiler::compile(
+      presetMgr, deviceMgr, zoneMgr, touchpadLayoutMgr, settingsMgr,
+      previous.get(), MappingCompiler::Scope::keyboardOnly(2));
+  auto full = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                       touchpadLayoutMgr, settingsMgr);
+
+  EXPECT_EQ(incremental->globalGrids[0], previous->globalGrids[0]);
+  EXPECT_EQ(incremental->globalGrids[1], previous->globalGrids[1]);
+  EXPECT_NE(incremental->globalGrids[2], previous->globalGrids[2]);
+
+  for (int layer = 0; layer < 9; ++layer) {
+    for (int key : {81, 82, 83}) {
+      EXPECT_EQ((*incremental->globalGrids[(size_t)layer])[(size_t)key].isActive,
+                (*full->globalGrids[(size_t)layer])[(size_t)key].isActive)
+          << "layer " << layer << " key " << key;
+      EXPECT_EQ((*incremental->visualLookup[0][(size_t)layer])[(size_t)key].state,
+                (*full->visualLookup[0][(size_t)layer])[(size_t)key].state)
+          << "layer " << layer << " key " << key;
+    }
+  }
+  EXPECT_TRUE((*incremental->globalGrids[2])[83].isActive);
+}
+
 // Test Case 3: Conflict Detection (The Bug Fix)
 TEST_F(MappingCompilerTest, ConflictDetection) {
   // Arrange: Layer 0
@@ -277,6 +310,28 @@ TEST_F(MappingCompilerTest, ConflictDetection) {
   EXPECT_EQ((*l0)[81].displayColor, juce::Colours::red);
 }
 
+// Labels and source names are interned once per context, not per slot.
+TEST_F(MappingCompilerTest, VisualTextIsInterned) {
+  addMapping(0, 81, 0);
+  addMapping(0, 82, 0);
+  addMapping(0, 83, 0);
+  addZone(0, 83, 1, 0); // Conflicts with the mapping on 83
+
+  auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                          touchpadLayoutMgr, settingsMgr);
+  const auto &l0 = *context->visualLookup[0][0];
+  const auto &l4 = *context->visualLookup[0][4];
+  EXPECT_EQ(l0[81].labelId, l0[82].labelId);
+  EXPECT_EQ(l0[81].sourceNameId, l0[82].sourceNameId);
+  EXPECT_EQ(l4[81].labelId, l0[81].labelId); // Inherited copy, same id
+  EXPECT_EQ(context->labelFor(l0[81]), "C4");
+  EXPECT_EQ(context->sourceNameFor(l0[81]), "Mapping");
+  EXPECT_TRUE(context->labelFor(l0[83]).endsWith(" (!)"));
+  // Empty slots resolve to the empty string without a pool entry.
+  EXPECT_EQ(l0[0x20].labelId, 0u);
+  EXPECT_TRUE(context->labelFor(l0[0x20]).isEmpty());
+}
+
 // Test Case 4: Device Specific Override
 TEST_F(MappingCompilerTest, DeviceOverridesGlobal) {
   // Arrange
@@ -310,6 +365,85 @@ TEST_F(MappingCompilerTest, DeviceInheritsFromGlobal) {
   EXPECT_EQ((*deviceGrid)[81].state, VisualState::Inherited);
 }
 
+// Identical audio grids are shared, and the action behind them is stored once.
+TEST_F(MappingCompilerTest, IdenticalAudioGridsAreShared) {
+  addMapping(0, 81, 0);         // Global on every layer (inherited)
+  addMapping(1, 82, aliasHash); // Device-specific on layer 1 only
+
+  auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                          touchpadLayoutMgr, settingsMgr);
+
+  const auto &deviceLayers = context->deviceGrids.at(aliasHash);
+  // Layer 0: the alias adds nothing, so it shares the global grid.
+  EXPECT_EQ(deviceLayers[0], context->globalGrids[0]);
+  // Layers 1-8 inherit the same content from layer 0.
+  EXPECT_EQ(context->globalGrids[8], context->globalGrids[0]);
+  // The alias's own layer-1 mapping makes that grid distinct.
+  EXPECT_NE(deviceLayers[1], context->globalGrids[1]);
+  EXPECT_TRUE((*deviceLayers[1])[82].isActive);
+  EXPECT_FALSE((*context->globalGrids[1])[82].isActive);
+
+  const auto &globalSlot = (*context->globalGrids[0])[81];
+  const auto &deviceSlot = (*deviceLayers[1])[81];
+  ASSERT_TRUE(globalSlot.isActive);
+  ASSERT_TRUE(deviceSlot.isActive);
+  EXPECT_EQ(globalSlot.actionIndex, deviceSlot.actionIndex);
+  EXPECT_EQ(globalSlot.type, ActionType::Note);
+  EXPECT_EQ(context->actionFor(globalSlot).type, ActionType::Note);
+  EXPECT_LE(sizeof(KeyAudioSlot), 32u);
+}
+
+// Alias stacks compile as parallel tasks into private pools; merging them in
+// order must give exactly the pools and indices of a serial compile.
+TEST_F(MappingCompilerTest, ParallelCompileMatchesSerial) {
+  std::vector<uintptr_t> hashes{aliasHash};
+  for (int i = 0; i < 4; ++i) {
+    const juce::String name = "Parallel" + juce::String(i);
+    deviceMgr.createAlias(name);
+    hashes.push_back(
+        static_cast<uintptr_t>(std::hash<juce::String>{}(name)));
+  }
+  addMapping(0, 81, 0);
+  addZoneWithChord(0, 70, 0);
+  addForceAllLayersMappingOnBase(90, hashes[1]);
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    addMapping((int)i % 9, 82 + (int)i, hashes[i]);
+    addMapping(((int)i + 3) % 9, 82, hashes[i], ActionType::Expression);
+    addMapping(2, 90, hashes[i]); // Conflicts with the forced mapping
+    addZoneWithChord((int)i, 65 + (int)i, hashes[i]);
+  }
+
+  TaskPool serialPool(0), parallelPool(3);
+  auto serial = MappingCompiler::compile(
+      presetMgr, deviceMgr, zoneMgr, touchpadLayoutMgr, settingsMgr, nullptr,
+      MappingCompiler::Scope::all(), &serialPool);
+  auto parallel = MappingCompiler::compile(
+      presetMgr, deviceMgr, zoneMgr, touchpadLayoutMgr, settingsMgr, nullptr,
+      MappingCompiler::Scope::all(), &parallelPool);
+
+  EXPECT_EQ(parallel->actionPool, serial->actionPool);
+  EXPECT_EQ(parallel->chordPool, serial->chordPool);
+  EXPECT_EQ(parallel->zoneTable, serial->zoneTable);
+  ASSERT_EQ(parallel->visualStrings.size(), serial->visualStrings.size());
+  for (uintptr_t hash : hashes) {
+    for (size_t layer = 0; layer < 9; ++layer) {
+      const auto &aSerial = *serial->deviceGrids.at(hash)[layer];
+      const auto &aParallel = *parallel->deviceGrids.at(hash)[layer];
+      const auto &vSerial = *serial->visualLookup.at(hash)[layer];
+      const auto &vParallel = *parallel->visualLookup.at(hash)[layer];
+      EXPECT_TRUE(aParallel == aSerial) << "layer " << layer;
+      for (size_t key = 0; key < 256; ++key) {
+        EXPECT_EQ(vParallel[key].state, vSerial[key].state);
+        EXPECT_EQ(vParallel[key].labelId, vSerial[key].labelId);
+        EXPECT_EQ(vParallel[key].sourceNameId, vSerial[key].sourceNameId);
+      }
+    }
+  }
+  EXPECT_TRUE(
+      serial->labelFor((*serial->visualLookup.at(hashes[1])[2])[90])
+          .endsWith(" (!)"));
+}
+
 // TEST D: Horizontal Override (Device masks Global) – device maps Q to CC
 TEST_F(MappingCompilerTest, DeviceOverridesGlobalWithCC) {
   // Arrange
@@ -352,9 +486,9 @@ TEST_F(MappingCompilerTest, SpecificModifierOverridesGeneric) {
   auto grid = context->visualLookup[0][0];
 
   // LShift: specific Note (default data1=60 -> "C4")
-  EXPECT_EQ((*grid)[0xA0].label, "C4");
+  EXPECT_EQ(context->labelFor((*grid)[0xA0]), "C4");
   // RShift: inherited generic CC (default data1=60)
-  EXPECT_EQ((*grid)[0xA1].label, "Expr: CC");
+  EXPECT_EQ(context->labelFor((*grid)[0xA1]), "Expr: CC");
 }
 
 // TEST H: Chord Compilation (Audio Data)
@@ -382,6 +516,40 @@ TEST_F(MappingCompilerTest, ZoneCompilesToChordPool) {
   EXPECT_EQ(chord.size(), 3u); // Triad = 3 notes
 }
 
+// Zone slots carry a handle into CompiledContext::zoneTable so key-down can
+// reach the owning zone without alias lookups; manual mappings carry none.
+TEST_F(MappingCompilerTest, ZoneSlotResolvesOwningZoneHandle) {
+  auto zone = std::make_shared<Zone>();
+  zone->name = "Handle Zone";
+  zone->layerID = 0;
+  zone->targetAliasHash = 0;
+  zone->inputKeyCodes = {81, 87};
+  zone->scaleName = "Major";
+  zone->rootNote = 60;
+  zoneMgr.addZone(zone);
+  addMapping(0, 69, 0); // Manual mapping on E
+
+  auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                          touchpadLayoutMgr, settingsMgr);
+  ASSERT_EQ(context->zoneTable.size(), 1u);
+  EXPECT_EQ(context->zoneTable[0].get(), zone.get());
+
+  const auto &zoneSlot = (*context->globalGrids[0])[81];
+  ASSERT_TRUE(zoneSlot.isActive);
+  EXPECT_EQ(zoneSlot.zoneIndex, 0);
+  EXPECT_EQ((*context->globalGrids[0])[87].zoneIndex, 0);
+
+  const auto &manualSlot = (*context->globalGrids[0])[69];
+  ASSERT_TRUE(manualSlot.isActive);
+  EXPECT_EQ(manualSlot.zoneIndex, -1);
+
+  // Inherited into higher layers and device stacks with the same handle.
+  EXPECT_EQ((*context->globalGrids[1])[81].zoneIndex, 0);
+  auto it = context->deviceGrids.find(aliasHash);
+  ASSERT_NE(it, context->deviceGrids.end());
+  EXPECT_EQ((*it->second[0])[81].zoneIndex, 0);
+}
+
 // Zone useGlobalRoot: when true, rebuildZoneCache uses global root
 TEST_F(MappingCompilerTest, ZoneUseGlobalRoot_UsesGlobalRootWhenCompiling) {
   scaleLib.loadDefaults();
@@ -800,15 +968,16 @@ TEST_F(MappingCompilerTest, ExpressionSimpleCcProducesFastPathAdsr) {
   const auto &slot = (*audioGrid)[50];
 
   ASSERT_TRUE(slot.isActive);
-  EXPECT_EQ(slot.action.type, ActionType::Expression);
-  EXPECT_EQ(slot.action.adsrSettings.ccNumber, 7);
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOn, 64);
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOff, 0);
-  EXPECT_EQ(slot.action.data2, 64);
-  EXPECT_EQ(slot.action.adsrSettings.attackMs, 0);
-  EXPECT_EQ(slot.action.adsrSettings.decayMs, 0);
-  EXPECT_EQ(slot.action.adsrSettings.releaseMs, 0);
-  EXPECT_FLOAT_EQ(slot.action.adsrSettings.sustainLevel, 1.0f);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.type, ActionType::Expression);
+  EXPECT_EQ(action.adsrSettings.ccNumber, 7);
+  EXPECT_EQ(action.adsrSettings.valueWhenOn, 64);
+  EXPECT_EQ(action.adsrSettings.valueWhenOff, 0);
+  EXPECT_EQ(action.data2, 64);
+  EXPECT_EQ(action.adsrSettings.attackMs, 0);
+  EXPECT_EQ(action.adsrSettings.decayMs, 0);
+  EXPECT_EQ(action.adsrSettings.releaseMs, 0);
+  EXPECT_FLOAT_EQ(action.adsrSettings.sustainLevel, 1.0f);
 }
 
 // Phase 56.1: Expression with useCustomEnvelope=true -> reads ADSR from
@@ -839,13 +1008,14 @@ TEST_F(MappingCompilerTest, ExpressionCustomEnvelopeReadsAdsr) {
   const auto &slot = (*audioGrid)[51];
 
   ASSERT_TRUE(slot.isActive);
-  EXPECT_EQ(slot.action.type, ActionType::Expression);
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOn, 127);
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOff, 0);
-  EXPECT_EQ(slot.action.adsrSettings.attackMs, 100);
-  EXPECT_EQ(slot.action.adsrSettings.decayMs, 50);
-  EXPECT_FLOAT_EQ(slot.action.adsrSettings.sustainLevel, 0.6f);
-  EXPECT_EQ(slot.action.adsrSettings.releaseMs, 200);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.type, ActionType::Expression);
+  EXPECT_EQ(action.adsrSettings.valueWhenOn, 127);
+  EXPECT_EQ(action.adsrSettings.valueWhenOff, 0);
+  EXPECT_EQ(action.adsrSettings.attackMs, 100);
+  EXPECT_EQ(action.adsrSettings.decayMs, 50);
+  EXPECT_FLOAT_EQ(action.adsrSettings.sustainLevel, 0.6f);
+  EXPECT_EQ(action.adsrSettings.releaseMs, 200);
 }
 
 // Centralized defaults: Expression with useCustomEnvelope but no ADSR
@@ -869,12 +1039,13 @@ TEST_F(MappingCompilerTest, ExpressionOmittedAdsrUsesMappingDefaults) {
   const auto &slot = (*context->globalGrids[0])[54];
 
   ASSERT_TRUE(slot.isActive);
-  EXPECT_EQ(slot.action.type, ActionType::Expression);
-  EXPECT_EQ(slot.action.adsrSettings.attackMs, MappingDefaults::ADSRAttackMs);
-  EXPECT_EQ(slot.action.adsrSettings.decayMs, MappingDefaults::ADSRDecayMs);
-  EXPECT_FLOAT_EQ(slot.action.adsrSettings.sustainLevel,
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.type, ActionType::Expression);
+  EXPECT_EQ(action.adsrSettings.attackMs, MappingDefaults::ADSRAttackMs);
+  EXPECT_EQ(action.adsrSettings.decayMs, MappingDefaults::ADSRDecayMs);
+  EXPECT_FLOAT_EQ(action.adsrSettings.sustainLevel,
                   static_cast<float>(MappingDefaults::ADSRSustain));
-  EXPECT_EQ(slot.action.adsrSettings.releaseMs, MappingDefaults::ADSRReleaseMs);
+  EXPECT_EQ(action.adsrSettings.releaseMs, MappingDefaults::ADSRReleaseMs);
 }
 
 // Expression: value when on/off compiled from touchpadValueWhenOn/Off (keyboard
@@ -898,9 +1069,11 @@ TEST_F(MappingCompilerTest, ExpressionValueWhenOnOffCompiled) {
                                        touchpadLayoutMgr, settingsMgr);
   const auto &slot = (*context->globalGrids[0])[53];
 
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOn, 100);
-  EXPECT_EQ(slot.action.adsrSettings.valueWhenOff, 20);
-  EXPECT_EQ(slot.action.data2, 100);
+  ASSERT_TRUE(slot.isActive);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.adsrSettings.valueWhenOn, 100);
+  EXPECT_EQ(action.adsrSettings.valueWhenOff, 20);
+  EXPECT_EQ(action.data2, 100);
 }
 
 // Phase 56.1: Expression with adsrTarget=PitchBend uses Bend (semitones) =
@@ -922,12 +1095,14 @@ TEST_F(MappingCompilerTest, ExpressionPitchBendCompilesCorrectly) {
   auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
                                        touchpadLayoutMgr, settingsMgr);
   auto l0 = context->visualLookup[0][0];
-  EXPECT_EQ((*l0)[52].label, "Expr: PB");
+  EXPECT_EQ(context->labelFor((*l0)[52]), "Expr: PB");
 
   auto audioGrid = context->globalGrids[0];
   const auto &slot = (*audioGrid)[52];
-  EXPECT_EQ(slot.action.adsrSettings.target, AdsrTarget::PitchBend);
-  EXPECT_EQ(slot.action.data2, 2);
+  ASSERT_TRUE(slot.isActive);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.adsrSettings.target, AdsrTarget::PitchBend);
+  EXPECT_EQ(action.data2, 2);
 }
 
 // Settings: pitch bend range affects compiled Expression PitchBend data2 clamp
@@ -948,8 +1123,10 @@ TEST_F(MappingCompilerTest, SettingsPitchBendRangeAffectsExpressionBend) {
   auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
                                        touchpadLayoutMgr, settingsMgr);
   const auto &slot = (*context->globalGrids[0])[53];
-  EXPECT_EQ(slot.action.adsrSettings.target, AdsrTarget::PitchBend);
-  EXPECT_EQ(slot.action.data2, 4);
+  ASSERT_TRUE(slot.isActive);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.adsrSettings.target, AdsrTarget::PitchBend);
+  EXPECT_EQ(action.data2, 4);
 
   presetMgr.getMappingsListForLayer(0).removeChild(0, nullptr);
   juce::ValueTree m2("Mapping");
@@ -964,7 +1141,7 @@ TEST_F(MappingCompilerTest, SettingsPitchBendRangeAffectsExpressionBend) {
   presetMgr.getMappingsListForLayer(0).addChild(m2, -1, nullptr);
   auto ctx2 = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
                                     touchpadLayoutMgr, settingsMgr);
-  EXPECT_EQ((*ctx2->globalGrids[0])[54].action.data2, 6)
+  EXPECT_EQ(ctx2->actionFor((*ctx2->globalGrids[0])[54]).data2, 6)
       << "Bend semitones should be clamped to pitch bend range 6";
 }
 
@@ -987,7 +1164,7 @@ TEST_F(MappingCompilerTest, NoteReleaseBehaviorCompiles) {
     auto ctx = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
                                      touchpadLayoutMgr, settingsMgr);
     auto grid = ctx->globalGrids[0];
-    EXPECT_EQ((*grid)[50].action.releaseBehavior, expected)
+    EXPECT_EQ(ctx->actionFor((*grid)[50]).releaseBehavior, expected)
         << "releaseBehavior \"" << rbStr << "\"";
   };
   addAndCheck("Send Note Off", NoteReleaseBehavior::SendNoteOff);
@@ -1021,13 +1198,15 @@ TEST_F(MappingCompilerTest, SmartScaleBendLookupIsBuilt) {
   auto audioGrid = context->globalGrids[0];
   const auto &slot = (*audioGrid)[52];
 
-  EXPECT_EQ(slot.action.adsrSettings.target, AdsrTarget::SmartScaleBend);
-  ASSERT_EQ(slot.action.smartBendLookup.size(), 128u)
+  ASSERT_TRUE(slot.isActive);
+  const MidiAction &action = context->actionFor(slot);
+  EXPECT_EQ(action.adsrSettings.target, AdsrTarget::SmartScaleBend);
+  ASSERT_EQ(action.smartBendLookup.size(), 128u)
       << "SmartScaleBend lookup must have 128 entries";
 
   // C4 (60) + 1 scale step in C Major = D4 (62). Semitones = 2. PB range 2 ->
   // full bend up = 16383
-  int c4Pb = slot.action.smartBendLookup[60];
+  int c4Pb = action.smartBendLookup[60];
   EXPECT_EQ(c4Pb, 16383)
       << "C4 +1 scale step (-> D4) with PB range 2 = full bend up";
 
@@ -1035,7 +1214,7 @@ TEST_F(MappingCompilerTest, SmartScaleBendLookupIsBuilt) {
   // note = 8192 (Actually +0 step: target = same note, semitones = 0 -> 8192.
   // We have step 1 so not this.) D4 (62) + 1 scale step = E4 (64). Semitones
   // = 2. Same full bend.
-  int d4Pb = slot.action.smartBendLookup[62];
+  int d4Pb = action.smartBendLookup[62];
   EXPECT_EQ(d4Pb, 16383)
       << "D4 +1 scale step (-> E4) with PB range 2 = full bend up";
 }
@@ -1066,10 +1245,12 @@ TEST_F(MappingCompilerTest, SmartScaleBendScalesWithPitchBendRange) {
   auto audioGrid = context->globalGrids[0];
   const auto &slot = (*audioGrid)[52];
 
-  ASSERT_EQ(slot.action.smartBendLookup.size(), 128u);
+  ASSERT_TRUE(slot.isActive);
+  const MidiAction &action = context->actionFor(slot);
+  ASSERT_EQ(action.smartBendLookup.size(), 128u);
   // C4 -> D4 = 2 semitones. PB range 6 -> 2/6 * 8192 = 2730.67 up from center
   // -> 8192+2731 = 10923
-  int c4Pb = slot.action.smartBendLookup[60];
+  int c4Pb = action.smartBendLookup[60];
   int expected = 8192 + static_cast<int>(std::round(8192.0 * 2.0 / 6.0));
   EXPECT_EQ(c4Pb, expected) << "C4 +1 step with PB range 6 = 1/3 of full bend";
 }
@@ -1727,6 +1908,39 @@ TEST_F(MappingCompilerTest, TouchpadMixerRestoreEmptyTreeClearsLayouts) {
 }
 
 // --- MappingCompiler touchpad mixer layout compilation ---
+// Scroll and pointer codes live in the grids' extended slots and follow the
+// same layering as keys; pointer slots and touchpad layouts set the layer's
+// bit in pointerLayerMask.
+TEST_F(MappingCompilerTest, NonKeyboardInputsCompileIntoExtendedSlots) {
+  addMapping(0, InputTypes::ScrollUp, 0);
+  addMapping(2, InputTypes::PointerX, 0, ActionType::Expression);
+  addMapping(0, 0x1234, 0); // No slot: ignored
+
+  TouchpadLayoutConfig cfg;
+  cfg.type = TouchpadType::Mixer;
+  cfg.layerId = 4;
+  touchpadLayoutMgr.addLayout(cfg);
+
+  auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                          touchpadLayoutMgr, settingsMgr);
+
+  const int scrollSlot = InputTypes::gridSlot(InputTypes::ScrollUp);
+  const int pointerSlot = InputTypes::gridSlot(InputTypes::PointerX);
+  EXPECT_EQ(scrollSlot, 256);
+  EXPECT_EQ(InputTypes::gridSlot(0x1234), -1);
+  EXPECT_TRUE((*context->globalGrids[0])[(size_t)scrollSlot].isActive);
+  EXPECT_TRUE((*context->globalGrids[3])[(size_t)scrollSlot].isActive)
+      << "Extended slots are inherited like keys";
+  EXPECT_FALSE((*context->globalGrids[0])[(size_t)pointerSlot].isActive);
+  EXPECT_EQ((*context->globalGrids[2])[(size_t)pointerSlot].type,
+            ActionType::Expression);
+  EXPECT_EQ(context->visualLookup.at(0)[2]->at((size_t)pointerSlot).state,
+            VisualState::Active);
+
+  // Layer 2 (pointer slot) and the layers above that inherit it, plus 4.
+  EXPECT_EQ(context->pointerLayerMask, 0b111111100);
+}
+
 TEST_F(MappingCompilerTest, TouchpadMixerLayoutCompiledIntoContext) {
   TouchpadLayoutConfig cfg;
   cfg.type = TouchpadType::Mixer;
@@ -2225,3 +2439,43 @@ TEST_F(MappingCompilerTest, TouchpadTab_DisabledTouchpadMappingNotInContext) {
   EXPECT_EQ(context->touchpadMappings.size(), 0u)
       << "Disabled touchpad mapping should not be in context";
 }
+
+// The layout hit-test index lists, per bucket, exactly the layouts whose
+// region can contain a point in it, topmost z-index first.
+TEST_F(MappingCompilerTest, TouchpadLayoutIndexBucketsInZOrder) {
+  TouchpadLayoutConfig left;
+  left.type = TouchpadType::Mixer;
+  left.region = {0.0f, 0.0f, 0.5f, 1.0f};
+  left.zIndex = 1;
+  TouchpadLayoutConfig full;
+  full.type = TouchpadType::ChordPad;
+  full.zIndex = 5;
+  touchpadLayoutMgr.addLayout(left);
+  touchpadLayoutMgr.addLayout(full);
+
+  auto context = MappingCompiler::compile(presetMgr, deviceMgr, zoneMgr,
+                                          touchpadLayoutMgr, settingsMgr);
+  const auto &index = context->touchpadLayoutIndex;
+  ASSERT_EQ(index.candidates.size(), 2u);
+  EXPECT_EQ(index.candidates[0].type, TouchpadType::ChordPad);
+  EXPECT_EQ(index.candidates[1].type, TouchpadType::Mixer);
+
+  auto bucketTypes = [&](float nx, float ny) {
+    std::vector<TouchpadType> types;
+    size_t b = (size_t)TouchpadLayoutIndex::bucketFor(nx, ny);
+    for (uint32_t e = index.bucketStart[b]; e < index.bucketStart[b + 1]; ++e) {
+      const auto &c = index.candidates[index.bucketEntries[e]];
+      if (TouchpadLayoutIndex::contains(c, nx, ny))
+        types.push_back(c.type);
+    }
+    return types;
+  };
+  EXPECT_EQ(bucketTypes(0.1f, 0.5f),
+            (std::vector<TouchpadType>{TouchpadType::ChordPad,
+                                       TouchpadType::Mixer}));
+  EXPECT_EQ(bucketTypes(0.9f, 0.5f),
+            (std::vector<TouchpadType>{TouchpadType::ChordPad}));
+  // Right edge is exclusive
+  EXPECT_EQ(bucketTypes(0.5f, 0.5f),
+            (std::vector<TouchpadType>{TouchpadType::ChordPad}));
+}
@@ -0,0 +1,79 @@
+#include "../MidiOutputQueue.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(MidiOutputQueueTest, PopsInFifoOrderWithTimestamps) {
+  MidiOutputQueue queue(8);
+  ASSERT_TRUE(queue.push(juce::MidiMessage::noteOn(1, 60, (juce::uint8)100),
+                         10.0));
+  ASSERT_TRUE(queue.push(juce::MidiMessage::noteOff(1, 60), 20.0));
+
+  MidiOutputQueue::Message m;
+  ASSERT_TRUE(queue.pop(m));
+  EXPECT_EQ(m.sendAtMs, 10.0);
+  EXPECT_EQ(m.size, 3);
+  EXPECT_EQ(m.bytes[0], 0x90);
+  EXPECT_EQ(m.bytes[1], 60);
+  EXPECT_EQ(m.bytes[2], 100);
+
+  ASSERT_TRUE(queue.pop(m));
+  EXPECT_EQ(m.sendAtMs, 20.0);
+  EXPECT_EQ(m.bytes[0] & 0xF0, 0x80);
+  EXPECT_FALSE(queue.pop(m));
+}
+
+TEST(MidiOutputQueueTest, RejectsWhenFullAndRecoversAfterPop) {
+  MidiOutputQueue queue(4);
+  ASSERT_EQ(queue.capacity(), 4u);
+  for (int i = 0; i < 4; ++i)
+    ASSERT_TRUE(queue.push(juce::MidiMessage::controllerEvent(1, 1, i), 0.0));
+  EXPECT_FALSE(queue.push(juce::MidiMessage::controllerEvent(1, 1, 99), 0.0));
+
+  MidiOutputQueue::Message m;
+  ASSERT_TRUE(queue.pop(m));
+  EXPECT_EQ(m.bytes[2], 0);
+  EXPECT_TRUE(queue.push(juce::MidiMessage::controllerEvent(1, 1, 4), 0.0));
+}
+
+// Several producers, one consumer: every message arrives exactly once and
+// each producer's messages stay in order.
+TEST(MidiOutputQueueTest, MultipleProducersDeliverEverythingInPerThreadOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 2000;
+  MidiOutputQueue queue(256);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        // Channel = producer, value encodes sequence (CC number = i / 128)
+        auto msg = juce::MidiMessage::controllerEvent(p + 1, i / 128, i % 128);
+        while (!queue.push(msg, (double)i))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  std::vector<int> lastSeen(kProducers, -1);
+  int received = 0;
+  MidiOutputQueue::Message m;
+  while (received < kProducers * kPerProducer) {
+    if (!queue.pop(m)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const int producer = m.bytes[0] & 0x0F;
+    const int seq = m.bytes[1] * 128 + m.bytes[2];
+    ASSERT_LT(producer, kProducers);
+    EXPECT_EQ(seq, lastSeen[(size_t)producer] + 1);
+    EXPECT_EQ(m.sendAtMs, (double)seq);
+    lastSeen[(size_t)producer] = seq;
+    ++received;
+  }
+  for (auto &t : producers)
+    t.join();
+  EXPECT_FALSE(queue.pop(m));
+}
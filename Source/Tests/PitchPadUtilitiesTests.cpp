@@ -1,6 +1,7 @@
 #include "../MappingTypes.h"
 #include "../PitchPadUtilities.h"
 
+#include <cmath>
 #include <gtest/gtest.h>
 
 TEST(PitchPadUtilitiesTest, LayoutCoversUnitIntervalWithRestAndTransitions) {
@@ -69,3 +70,56 @@ TEST(PitchPadUtilitiesTest, LegacyRestingSpacePercentFallback) {
     if (b.isRest) ++restCount;
   EXPECT_EQ(restCount, 5);
 }
+
+TEST(PitchPadUtilitiesTest, BakedTableMatchesBandWalkAtSamples) {
+  PitchPadConfig cfg;
+  cfg.minStep = -3;
+  cfg.maxStep = 5;
+  cfg.restZonePercent = 12.0f;
+  cfg.transitionZonePercent = 7.0f;
+
+  PitchPadLayout layout = buildPitchPadLayout(cfg);
+  auto table = bakePitchPadTable(layout, cfg, false, 12);
+  ASSERT_NE(table, nullptr);
+  EXPECT_TRUE(table->pitchBend.empty());
+
+  constexpr int last = PitchPadTable::kSize - 1;
+  for (int i = 0; i <= last; i += 37) {
+    const float x = (float)i / (float)last;
+    EXPECT_FLOAT_EQ(table->stepAt(x), mapXToStep(layout, x).step) << x;
+  }
+  EXPECT_FLOAT_EQ(table->stepAt(-0.5f), mapXToStep(layout, 0.0f).step);
+  EXPECT_FLOAT_EQ(table->stepAt(1.5f), mapXToStep(layout, 1.0f).step);
+
+  // Between samples the error is at most half a sample of transition slope.
+  ASSERT_FALSE(layout.bands[1].isRest);
+  const float slope = layout.bands[1].invSpan;
+  for (float x = 0.0f; x <= 1.0f; x += 0.0013f)
+    EXPECT_NEAR(table->stepAt(x), mapXToStep(layout, x).step,
+                slope * 0.5f / (float)last + 1.0e-5f);
+}
+
+TEST(PitchPadUtilitiesTest, BakedPitchBendMatchesRuntimeFormula) {
+  PitchPadConfig cfg;
+  cfg.minStep = -4;
+  cfg.maxStep = 4;
+  cfg.start = PitchPadStart::Left;
+  cfg.zeroStep = -4.0f;
+
+  const int pbRange = 2;
+  auto table =
+      bakePitchPadTable(buildPitchPadLayout(cfg), cfg, true, pbRange);
+  ASSERT_EQ(table->pitchBend.size(), (size_t)PitchPadTable::kSize);
+  EXPECT_EQ(table->pitchBendRange, pbRange);
+
+  for (float x = 0.0f; x <= 1.0f; x += 0.01f) {
+    const float offset = juce::jlimit((float)-pbRange, (float)pbRange,
+                                      table->stepAt(x) - cfg.zeroStep);
+    const int expected = juce::jlimit(
+        0, 16383, (int)std::round(8192.0 + offset * (8192.0 / pbRange)));
+    EXPECT_EQ(table->pitchBendAt(x), expected) << x;
+  }
+  // Left start: the left edge is centre, the right edge saturates.
+  EXPECT_EQ(table->pitchBendAt(0.0f), 8192);
+  EXPECT_EQ(table->pitchBendAt(1.0f), 16383);
+}
@@ -0,0 +1,102 @@
+#include "../PortamentoEngine.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// The scheduler thread ticks the engine too, so pitch bends are recorded
+// under a lock.
+class PitchBendRecorder : public MidiEngine {
+public:
+  void sendPitchBend(int channel, int value) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    sent.push_back({channel, value});
+  }
+  std::vector<std::pair<int, int>> onChannel(int channel) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::pair<int, int>> out;
+    for (const auto &e : sent)
+      if (e.first == channel)
+        out.push_back(e);
+    return out;
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<std::pair<int, int>> sent;
+};
+
+} // namespace
+
+TEST(PortamentoEngineTest, CurvesStartAtZeroAndEndAtOne) {
+  using Curve = PortamentoEngine::GlideCurve;
+  for (auto curve : {Curve::Linear, Curve::Exponential}) {
+    EXPECT_FLOAT_EQ(PortamentoEngine::curveAt(curve, 0.0), 0.0f);
+    EXPECT_FLOAT_EQ(PortamentoEngine::curveAt(curve, 1.0), 1.0f);
+    float prev = 0.0f;
+    for (int i = 1; i <= 100; ++i) {
+      const float v = PortamentoEngine::curveAt(curve, i / 100.0);
+      EXPECT_GE(v, prev);
+      prev = v;
+    }
+  }
+  EXPECT_NEAR(PortamentoEngine::curveAt(Curve::Linear, 0.5), 0.5f, 1e-6f);
+  // Exponential eases out: most of the distance is covered early.
+  EXPECT_GT(PortamentoEngine::curveAt(Curve::Exponential, 0.5), 0.8f);
+}
+
+TEST(PortamentoEngineTest, ChannelsGlideIndependently) {
+  PitchBendRecorder midi;
+  PortamentoEngine engine(midi);
+  engine.startGlide(8192, 12000, 60000, 1);
+  engine.startGlide(8192, 4000, 60000, 2,
+                    PortamentoEngine::GlideCurve::Exponential);
+  EXPECT_TRUE(engine.isActive(1));
+  EXPECT_TRUE(engine.isActive(2));
+
+  // Stopping channel 1 leaves channel 2 gliding.
+  engine.stop(1);
+  EXPECT_FALSE(engine.isActive(1));
+  EXPECT_TRUE(engine.isActive(2));
+  EXPECT_EQ(engine.getCurrentValue(1), 8192);
+  EXPECT_EQ(midi.onChannel(1).back().second, 8192);
+
+  // Past the glide's end: channel 2 lands exactly on its target.
+  engine.onSchedulerTick(RealtimeScheduler::nowMs() + 120000.0);
+  EXPECT_FALSE(engine.isActive(2));
+  EXPECT_EQ(engine.getCurrentValue(2), 4000);
+  EXPECT_EQ(midi.onChannel(2).back().second, 4000);
+  EXPECT_EQ(midi.onChannel(1).back().second, 8192);
+}
+
+TEST(PortamentoEngineTest, SendsOnlyWhenQuantizedValueChanges) {
+  PitchBendRecorder midi;
+  PortamentoEngine engine(midi);
+  engine.startGlide(8000, 8003, 60000, 3);
+  const double t0 = RealtimeScheduler::nowMs();
+  for (int i = 0; i < 200; ++i)
+    engine.onSchedulerTick(t0 + i * 5.0);
+  engine.onSchedulerTick(t0 + 120000.0);
+
+  // 200 ticks over a 3-step range: no value is ever sent twice in a row.
+  const auto sent = midi.onChannel(3);
+  ASSERT_FALSE(sent.empty());
+  for (size_t i = 1; i < sent.size(); ++i)
+    EXPECT_NE(sent[i].second, sent[i - 1].second);
+  EXPECT_EQ(sent.back().second, 8003);
+}
+
+TEST(PortamentoEngineTest, InstantGlideSendsTargetImmediately) {
+  PitchBendRecorder midi;
+  PortamentoEngine engine(midi);
+  engine.startGlide(8192, 10000, 0, 16);
+  EXPECT_FALSE(engine.isActive(16));
+  ASSERT_EQ(midi.onChannel(16).size(), 1u);
+  EXPECT_EQ(midi.onChannel(16)[0].second, 10000);
+  // Out-of-range channels are ignored.
+  engine.startGlide(8192, 10000, 0, 17);
+  EXPECT_FALSE(engine.isActive(17));
+}
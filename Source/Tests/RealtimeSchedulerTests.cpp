@@ -0,0 +1,80 @@
+#include "../RealtimeScheduler.h"
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// Records the order it was ticked in; signals when `expectedTicks` reached.
+class RecordingClient : public RealtimeScheduler::Client {
+public:
+  RecordingClient(int id, std::vector<int> &log, juce::CriticalSection &lock,
+                  juce::WaitableEvent &done, int &remaining)
+      : id(id), log(log), lock(lock), done(done), remaining(remaining) {}
+
+  double onSchedulerTick(double) override {
+    juce::ScopedLock sl(lock);
+    log.push_back(id);
+    if (--remaining == 0)
+      done.signal();
+    return RealtimeScheduler::idle;
+  }
+
+private:
+  int id;
+  std::vector<int> &log;
+  juce::CriticalSection &lock;
+  juce::WaitableEvent &done;
+  int &remaining;
+};
+
+} // namespace
+
+// Clients due in the same tick run in Order, regardless of registration or
+// scheduling order.
+TEST(RealtimeSchedulerTest, SameTickClientsRunInFixedOrder) {
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
+  std::vector<int> log;
+  juce::CriticalSection lock;
+  juce::WaitableEvent done;
+  int remaining = 3;
+
+  RecordingClient portamento(3, log, lock, done, remaining);
+  RecordingClient strum(0, log, lock, done, remaining);
+  RecordingClient release(1, log, lock, done, remaining);
+  scheduler->registerClient(portamento, RealtimeScheduler::Order::Portamento);
+  scheduler->registerClient(strum, RealtimeScheduler::Order::Strum);
+  scheduler->registerClient(release, RealtimeScheduler::Order::Release);
+
+  // Same deadline, far enough out that all three are posted before it fires.
+  const double due = RealtimeScheduler::nowMs() + 50.0;
+  scheduler->scheduleAt(portamento, due);
+  scheduler->scheduleAt(release, due);
+  scheduler->scheduleAt(strum, due);
+
+  ASSERT_TRUE(done.wait(2000));
+  scheduler->unregisterClient(portamento);
+  scheduler->unregisterClient(strum);
+  scheduler->unregisterClient(release);
+
+  juce::ScopedLock sl(lock);
+  EXPECT_EQ(log, (std::vector<int>{0, 1, 3}));
+}
+
+// An unscheduled client is never ticked (scheduler stays idle).
+TEST(RealtimeSchedulerTest, IdleClientIsNotTicked) {
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
+  std::vector<int> log;
+  juce::CriticalSection lock;
+  juce::WaitableEvent done;
+  int remaining = 1;
+
+  RecordingClient client(0, log, lock, done, remaining);
+  scheduler->registerClient(client, RealtimeScheduler::Order::Expression);
+  EXPECT_FALSE(done.wait(20));
+  scheduler->unregisterClient(client);
+
+  juce::ScopedLock sl(lock);
+  EXPECT_TRUE(log.empty());
+}
@@ -0,0 +1,67 @@
+#include "../SettingsManager.h"
+
+#include <gtest/gtest.h>
+
+TEST(RuntimeSettingsTest, SettersPublishANewSnapshotAndKeepOldOnesIntact) {
+  SettingsManager mgr;
+  const auto before = mgr.getRuntimeSettings();
+  EXPECT_FALSE(before->midiModeActive);
+  EXPECT_EQ(before->toggleKey, 0x7B);
+  EXPECT_EQ(before->performanceModeKey, 0x7A);
+
+  mgr.setMidiModeActive(true);
+  mgr.setStudioMode(true);
+  mgr.setToggleKey(0x70);
+  mgr.setPitchBendRange(2);
+  mgr.setDelayMidiEnabled(true);
+  mgr.setDelayMidiSeconds(42); // Clamped to 10
+
+  const auto after = mgr.getRuntimeSettings();
+  EXPECT_NE(before, after);
+  EXPECT_TRUE(after->midiModeActive);
+  EXPECT_TRUE(after->studioMode);
+  EXPECT_EQ(after->toggleKey, 0x70);
+  EXPECT_EQ(after->pitchBendRange, 2);
+  EXPECT_DOUBLE_EQ(after->stepsPerSemitone, 4096.0);
+  EXPECT_TRUE(after->delayMidiEnabled);
+  EXPECT_EQ(after->delayMidiSeconds, 10);
+
+  // Readers holding the old snapshot still see a consistent old view
+  EXPECT_FALSE(before->midiModeActive);
+  EXPECT_EQ(before->pitchBendRange, 12);
+
+  // Getters agree with the snapshot
+  EXPECT_TRUE(mgr.isMidiModeActive());
+  EXPECT_TRUE(mgr.isStudioMode());
+  EXPECT_EQ(mgr.getToggleKey(), 0x70);
+  EXPECT_DOUBLE_EQ(mgr.getStepsPerSemitone(), 4096.0);
+}
+
+TEST(RuntimeSettingsTest, LoadFromXmlPublishesLoadedValues) {
+  auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                 .getChildFile("MIDIQyTests");
+  dir.createDirectory();
+  auto file = dir.getChildFile("settings-runtime.xml");
+  file.deleteFile();
+
+  {
+    SettingsManager mgr;
+    mgr.setStudioMode(true);
+    mgr.setPerformanceModeKey(0x71);
+    mgr.setPitchBendRange(24);
+    mgr.saveToXml(file);
+  }
+
+  SettingsManager loaded;
+  loaded.loadFromXml(file);
+  const auto settings = loaded.getRuntimeSettings();
+  EXPECT_TRUE(settings->studioMode);
+  EXPECT_EQ(settings->performanceModeKey, 0x71);
+  EXPECT_EQ(settings->pitchBendRange, 24);
+  EXPECT_DOUBLE_EQ(settings->stepsPerSemitone, 8192.0 / 24.0);
+
+  // Edits after a load still republish
+  loaded.setStudioMode(false);
+  EXPECT_FALSE(loaded.getRuntimeSettings()->studioMode);
+  file.deleteFile();
+}
@@ -0,0 +1,37 @@
+#include "../TaskPool.h"
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(TaskPoolTest, RunsEveryIndexExactlyOnce) {
+  TaskPool pool(3);
+  std::vector<std::atomic<int>> runs(1000);
+  pool.parallelFor((int)runs.size(), [&](int i) { runs[(size_t)i]++; });
+  for (size_t i = 0; i < runs.size(); ++i)
+    EXPECT_EQ(runs[i].load(), 1) << i;
+}
+
+TEST(TaskPoolTest, NestedParallelForCompletes) {
+  // More nested batches than threads: waiting threads must run queued work.
+  TaskPool pool(2);
+  std::atomic<int> total{0};
+  pool.parallelFor(8, [&](int) {
+    pool.parallelFor(16, [&](int j) { total += j; });
+  });
+  EXPECT_EQ(total.load(), 8 * (15 * 16 / 2));
+}
+
+TEST(TaskPoolTest, NoWorkersRunsInOrderOnCaller) {
+  TaskPool pool(0);
+  EXPECT_EQ(pool.getNumWorkers(), 0);
+  const auto caller = std::this_thread::get_id();
+  std::vector<int> order;
+  pool.parallelFor(5, [&](int i) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    order.push_back(i);
+  });
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
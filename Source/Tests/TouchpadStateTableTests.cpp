@@ -0,0 +1,59 @@
+#include "../TouchpadStateTable.h"
+
+#include <gtest/gtest.h>
+
+static std::vector<TouchpadMixerEntry> makeStrips(std::vector<int> faders) {
+  std::vector<TouchpadMixerEntry> strips;
+  for (int n : faders) {
+    TouchpadMixerEntry e;
+    e.numFaders = n;
+    strips.push_back(e);
+  }
+  return strips;
+}
+
+TEST(TouchpadStateTableTest, RowsAreIndependentPerDeviceAndMapping) {
+  TouchpadStateTable table;
+  auto strips = makeStrips({4, 2});
+  table.setShape(3, strips);
+  EXPECT_TRUE(table.hasShape(3, strips));
+  EXPECT_EQ(table.findDevice(0x10), TouchpadStateTable::kNoValue);
+
+  int a = table.addDevice(0x10);
+  int b = table.addDevice(0x20);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(table.addDevice(0x10), a);
+  EXPECT_EQ(table.numMappingRows(), 6u);
+
+  table.mapping.lastContinuousValue[table.mappingRow(a, 1)] = 100;
+  EXPECT_EQ(table.mapping.lastContinuousValue[table.mappingRow(a, 0)],
+            TouchpadStateTable::kNoValue);
+  EXPECT_EQ(table.mapping.lastContinuousValue[table.mappingRow(b, 1)],
+            TouchpadStateTable::kNoValue);
+
+  EXPECT_EQ(table.fadersInStrip(0), 4);
+  EXPECT_EQ(table.fadersInStrip(1), 2);
+  EXPECT_EQ(table.fadersInStrip(2), 0);
+  table.fader.lastCC[table.faderRow(b, 1, 1)] = 42;
+  EXPECT_EQ(table.fader.lastCC[table.faderRow(a, 1, 1)],
+            TouchpadStateTable::kNoValue);
+  EXPECT_EQ(table.fader.lastCC[table.faderRow(b, 0, 3)],
+            TouchpadStateTable::kNoValue);
+}
+
+TEST(TouchpadStateTableTest, ReshapeClearsState) {
+  TouchpadStateTable table;
+  auto strips = makeStrips({2});
+  table.setShape(2, strips);
+  int slot = table.addDevice(0x10);
+  table.mapping.noteOnSent[table.mappingRow(slot, 1)] = 1;
+
+  auto wider = makeStrips({3});
+  EXPECT_FALSE(table.hasShape(2, wider));
+  EXPECT_FALSE(table.hasShape(3, strips));
+  table.setShape(3, wider);
+  EXPECT_EQ(table.numDevices(), 0);
+  slot = table.addDevice(0x10);
+  EXPECT_EQ(table.mapping.noteOnSent[table.mappingRow(slot, 1)], 0);
+  EXPECT_EQ(table.fadersInStrip(0), 3);
+}
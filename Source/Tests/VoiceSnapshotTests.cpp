@@ -0,0 +1,88 @@
+#include "../MidiEngine.h"
+#include "../SettingsManager.h"
+#include "../VoiceManager.h"
+#include "../VoiceSnapshot.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(VoiceSnapshotTest, KeyAndNoteBitsAreIndependentPerPlane) {
+  VoiceSnapshot snap;
+  snap.setKey(VoiceSnapshot::Latched, 65);
+  snap.setNote(VoiceSnapshot::Held, 16, 127);
+  snap.setKey(VoiceSnapshot::Held, 4096); // Out of keyboard range: ignored
+  snap.setFlags(true, false);
+
+  EXPECT_TRUE(snap.isKeyLatched(65));
+  EXPECT_FALSE(snap.isKeyHeld(65));
+  EXPECT_FALSE(snap.isKeyLatched(64));
+  EXPECT_TRUE(snap.note(VoiceSnapshot::Held, 16, 127));
+  EXPECT_FALSE(snap.note(VoiceSnapshot::Held, 15, 127));
+  EXPECT_FALSE(snap.note(VoiceSnapshot::Held, 0, 0));
+  EXPECT_FALSE(snap.isKeyHeld(4096));
+  EXPECT_TRUE(snap.isSustainActive());
+  EXPECT_FALSE(snap.isLatchActive());
+}
+
+// The reader must only ever see whole snapshots: the writer alternates two
+// patterns that differ in every word.
+TEST(VoiceSnapshotTest, ConcurrentReadsNeverSeeTornSnapshots) {
+  VoiceSnapshot a, b;
+  for (auto &w : a.words)
+    w = 0x5555555555555555ull;
+  for (auto &w : b.words)
+    w = 0xAAAAAAAAAAAAAAAAull;
+
+  VoiceSnapshotBuffer buffer;
+  buffer.publish(a);
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    for (int i = 0; !stop.load(std::memory_order_relaxed); ++i)
+      buffer.publish((i & 1) ? a : b);
+  });
+
+  for (int i = 0; i < 20000; ++i) {
+    const auto snap = buffer.read();
+    const uint64_t first = snap.words[0];
+    ASSERT_TRUE(first == a.words[0] || first == b.words[0]);
+    for (const auto w : snap.words)
+      ASSERT_EQ(w, first);
+  }
+  stop.store(true, std::memory_order_relaxed);
+  writer.join();
+}
+
+TEST(VoiceSnapshotTest, VoiceManagerPublishesHeldSustainedAndLatchedVoices) {
+  MidiEngine midiEng;
+  SettingsManager settingsMgr;
+  VoiceManager voiceMgr(midiEng, settingsMgr);
+
+  voiceMgr.noteOn(InputID{0, 81}, 60, 100, 1);
+  auto snap = voiceMgr.getVoiceSnapshot();
+  EXPECT_TRUE(snap.isKeyHeld(81));
+  EXPECT_TRUE(snap.note(VoiceSnapshot::Held, 1, 60));
+
+  voiceMgr.setSustain(true);
+  voiceMgr.handleKeyUp(InputID{0, 81});
+  snap = voiceMgr.getVoiceSnapshot();
+  EXPECT_TRUE(snap.isSustainActive());
+  EXPECT_FALSE(snap.isKeyHeld(81));
+  EXPECT_TRUE(snap.isKeySustained(81));
+
+  voiceMgr.setSustain(false);
+  voiceMgr.setLatch(true);
+  voiceMgr.noteOn(InputID{0, 82}, 62, 100, 2);
+  voiceMgr.handleKeyUp(InputID{0, 82});
+  snap = voiceMgr.getVoiceSnapshot();
+  EXPECT_FALSE(snap.isKeySustained(81));
+  EXPECT_TRUE(snap.isLatchActive());
+  EXPECT_TRUE(snap.isKeyLatched(82));
+  EXPECT_TRUE(voiceMgr.isKeyLatched(82));
+  EXPECT_TRUE(snap.note(VoiceSnapshot::Latched, 2, 62));
+
+  voiceMgr.panic();
+  snap = voiceMgr.getVoiceSnapshot();
+  EXPECT_FALSE(snap.isKeyLatched(82));
+  EXPECT_FALSE(snap.isLatchActive());
+}
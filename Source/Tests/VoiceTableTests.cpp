@@ -0,0 +1,127 @@
+#include "../VoiceTable.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+VoiceTable::Voice makeVoice(int channel, int note, InputID source,
+                            VoiceTable::State state =
+                                VoiceTable::State::Playing) {
+  VoiceTable::Voice v;
+  v.midiChannel = channel;
+  v.noteNumber = note;
+  v.source = source;
+  v.state = state;
+  return v;
+}
+
+std::vector<int> notesFromSource(const VoiceTable &table, InputID source) {
+  std::vector<int> notes;
+  table.forEachFromSource(source,
+                          [&](int i) { notes.push_back(table[i].noteNumber); });
+  return notes;
+}
+
+} // namespace
+
+TEST(VoiceTableTest, SourceListKeepsPressOrderAcrossRemovals) {
+  VoiceTable table;
+  const InputID key{1, 65};
+  const int a = table.add(makeVoice(1, 60, key));
+  table.add(makeVoice(1, 64, key));
+  table.add(makeVoice(1, 67, key));
+  table.add(makeVoice(1, 72, InputID{1, 66}));
+  ASSERT_EQ(table.size(), 4);
+  EXPECT_EQ(notesFromSource(table, key), (std::vector<int>{60, 64, 67}));
+
+  table.remove(a);
+  EXPECT_EQ(notesFromSource(table, key), (std::vector<int>{64, 67}));
+  table.add(makeVoice(1, 48, key));
+  EXPECT_EQ(notesFromSource(table, key), (std::vector<int>{64, 67, 48}));
+}
+
+TEST(VoiceTableTest, VisitorsMayRemoveTheCurrentVoice) {
+  VoiceTable table;
+  const InputID key{1, 65};
+  for (int n = 0; n < 5; ++n)
+    table.add(makeVoice(2, 60 + n, key));
+  table.add(makeVoice(3, 60, key));
+
+  table.forEachOnChannel(2, [&](int i) { table.remove(i); });
+  EXPECT_EQ(table.size(), 1);
+  EXPECT_EQ(table.findOnChannel(2, VoiceTable::State::Playing),
+            VoiceTable::kNone);
+  EXPECT_EQ(notesFromSource(table, key), (std::vector<int>{60}));
+
+  table.forEachFromSource(key, [&](int i) { table.remove(i); });
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(table.anyFromSource(key, 0xFF));
+}
+
+TEST(VoiceTableTest, StateBitsTrackSetState) {
+  VoiceTable table;
+  const InputID key{1, 65};
+  const int a = table.add(makeVoice(1, 60, key));
+  const int b = table.add(makeVoice(1, 60, key)); // Same note, second press
+  table.setState(a, VoiceTable::State::Sustained);
+
+  const auto playing = VoiceTable::stateMask(VoiceTable::State::Playing);
+  const auto latched = VoiceTable::stateMask(VoiceTable::State::Latched);
+  EXPECT_TRUE(table.anyFromSource(key, playing));
+  EXPECT_FALSE(table.anyFromSource(key, latched));
+  EXPECT_EQ(table.firstInState(VoiceTable::State::Sustained), a);
+  EXPECT_EQ(table.findOnChannel(1, VoiceTable::State::Playing), b);
+
+  int sustained = 0;
+  table.forEachInState(VoiceTable::State::Sustained, [&](int i) {
+    ++sustained;
+    table.remove(i);
+  });
+  EXPECT_EQ(sustained, 1);
+  EXPECT_EQ(table.size(), 1);
+  EXPECT_EQ(table.firstInState(VoiceTable::State::Sustained),
+            VoiceTable::kNone);
+}
+
+TEST(VoiceTableTest, FindOnChannelReturnsLowestNote) {
+  VoiceTable table;
+  table.add(makeVoice(4, 72, InputID{1, 1}));
+  table.add(makeVoice(4, 48, InputID{1, 2}));
+  table.add(makeVoice(4, 100, InputID{1, 3}));
+  const int i = table.findOnChannel(4, VoiceTable::State::Playing);
+  ASSERT_NE(i, VoiceTable::kNone);
+  EXPECT_EQ(table[i].noteNumber, 48);
+}
+
+TEST(VoiceTableTest, RejectsOutOfRangeAndFullTable) {
+  VoiceTable table;
+  EXPECT_EQ(table.add(makeVoice(0, 60, InputID{1, 1})), VoiceTable::kNone);
+  EXPECT_EQ(table.add(makeVoice(1, 128, InputID{1, 1})), VoiceTable::kNone);
+
+  for (int i = 0; i < VoiceTable::kCapacity; ++i)
+    ASSERT_NE(table.add(makeVoice(1 + i % 16, i % 128, InputID{1, i})),
+              VoiceTable::kNone);
+  EXPECT_TRUE(table.isFull());
+  EXPECT_EQ(table.add(makeVoice(1, 60, InputID{2, 0})), VoiceTable::kNone);
+
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(notesFromSource(table, InputID{1, 0}), std::vector<int>{});
+  EXPECT_NE(table.add(makeVoice(1, 60, InputID{1, 0})), VoiceTable::kNone);
+}
+
+// Many sources colliding in the open-addressed table: removing from the
+// middle of a probe chain must not hide the sources behind it.
+TEST(VoiceTableTest, SourceLookupSurvivesChurn) {
+  VoiceTable table;
+  std::vector<int> index(600, VoiceTable::kNone);
+  for (int k = 0; k < 600; ++k)
+    index[(size_t)k] = table.add(makeVoice(1 + k % 16, k % 128, InputID{7, k}));
+  for (int k = 0; k < 600; k += 2)
+    table.remove(index[(size_t)k]);
+  for (int k = 0; k < 600; ++k) {
+    const bool expected = (k % 2) == 1;
+    EXPECT_EQ(table.anyFromSource(InputID{7, k}, 0xFF), expected) << k;
+  }
+}
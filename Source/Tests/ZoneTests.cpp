@@ -142,6 +142,37 @@ TEST(ZoneIgnoreGlobalTranspose, GetNotesForKeyRespectsFlag) {
   EXPECT_EQ((*notesFollow)[0].pitch, 72);
 }
 
+// Precomputed transposed chords match getNotesForKey under the same global
+// transpose, and follow setGlobalTranspose without a cache rebuild.
+TEST(ZoneTransposedChord, MatchesGetNotesForKeyAfterTransposeChange) {
+  ScaleLibrary scaleLib;
+  std::vector<int> majorIntervals = scaleLib.getIntervals("Major");
+  ASSERT_FALSE(majorIntervals.empty());
+
+  auto zone = std::make_shared<Zone>();
+  zone->layoutStrategy = Zone::LayoutStrategy::Linear;
+  zone->inputKeyCodes = {kKeyQ, kKeyW};
+  zone->chordType = ChordUtilities::ChordType::Triad;
+  zone->rebuildCache(majorIntervals, 60);
+  EXPECT_EQ(zone->getTransposedChord(kKeyA), nullptr);
+
+  for (auto [chrom, deg] : {std::pair{0, 0}, std::pair{2, 1}, std::pair{-1, 3}}) {
+    zone->setGlobalTranspose(chrom, deg);
+    for (int key : {kKeyQ, kKeyW}) {
+      const auto *chord = zone->getTransposedChord(key);
+      auto expected = zone->getNotesForKey(key, chrom, deg, &majorIntervals);
+      ASSERT_NE(chord, nullptr);
+      ASSERT_TRUE(expected.has_value());
+      ASSERT_EQ((size_t)chord->size, expected->size());
+      for (size_t i = 0; i < expected->size(); ++i) {
+        EXPECT_EQ(chord->pitch[i], (*expected)[i].pitch)
+            << "chrom " << chrom << " deg " << deg << " note " << i;
+        EXPECT_EQ(chord->isGhost[i], (*expected)[i].isGhost);
+      }
+    }
+  }
+}
+
 // Effective root passed to rebuildCache is used for getNotesForKey
 TEST(ZoneEffectiveRoot, GetNotesForKeyUsesPassedRoot) {
   ScaleLibrary scaleLib;
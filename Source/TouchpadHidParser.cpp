@@ -1,7 +1,6 @@
 #include "TouchpadHidParser.h"
 
 #include <algorithm>
-#include <map>
 #include <vector>
 
 // clang-format off
@@ -12,34 +11,14 @@
 // clang-format on
 
 namespace {
-struct ContactBuilder {
-  int contactId = 0;
-  int x = 0;
-  int y = 0;
-  float normX = 0.0f;
-  float normY = 0.0f;
-  bool hasId = false;
-  bool hasX = false;
-  bool hasY = false;
-  bool tipDown = true;
-  bool hasTipDown = false;
-};
-
-float normalizeFromLogical(int value, LONG logicalMin, LONG logicalMax) {
-  LONG range = logicalMax - logicalMin;
-  if (range <= 0)
-    return 0.5f;
-  float norm =
-      static_cast<float>(value - logicalMin) / static_cast<float>(range);
-  return std::clamp(norm, 0.0f, 1.0f);
-}
-
 USHORT getUsage(const HIDP_VALUE_CAPS &cap) {
   return cap.IsRange ? cap.Range.UsageMin : cap.NotRange.Usage;
 }
 
-bool isUsage(const HIDP_VALUE_CAPS &cap, USHORT page, USHORT usage) {
-  return cap.UsagePage == page && getUsage(cap) == usage;
+bool hasUsage(const HIDP_BUTTON_CAPS &cap, USHORT usage) {
+  return cap.IsRange
+             ? (usage >= cap.Range.UsageMin && usage <= cap.Range.UsageMax)
+             : cap.NotRange.Usage == usage;
 }
 
 std::vector<HIDP_VALUE_CAPS>
@@ -55,277 +34,199 @@ sortedByLinkCollection(std::vector<HIDP_VALUE_CAPS> caps) {
   return caps;
 }
 
-// For value caps with ReportCount > 1, extract all values via
-// HidP_GetUsageValueArray. Returns empty on failure.
-std::vector<ULONG> getUsageValueArray(const HIDP_VALUE_CAPS &cap,
-                                      PHIDP_PREPARSED_DATA preparsed,
-                                      PCHAR report, ULONG reportLen) {
-  std::vector<ULONG> out;
-  if (cap.ReportCount <= 1)
-    return out;
-  // Buffer size in bytes: (BitSize * ReportCount + 7) / 8
-  USHORT bitSize = cap.BitSize;
-  USHORT reportCount = cap.ReportCount;
-  if (bitSize == 0 || bitSize > 32)
-    return out;
-  size_t byteLen = (static_cast<size_t>(bitSize) * reportCount + 7) / 8;
-  if (byteLen > 256)
-    return out;
-  std::vector<BYTE> buf(byteLen, 0);
-  USAGE usagePage = cap.UsagePage;
-  USAGE usage = getUsage(cap);
-  if (HidP_GetUsageValueArray(HidP_Input, usagePage, cap.LinkCollection, usage,
-                              reinterpret_cast<PCHAR>(buf.data()),
-                              static_cast<USHORT>(byteLen), preparsed, report,
-                              reportLen) != HIDP_STATUS_SUCCESS) {
-    return out;
-  }
-  out.reserve(reportCount);
-  size_t bitOffset = 0;
-  for (USHORT i = 0; i < reportCount; ++i) {
-    ULONG val = 0;
-    for (USHORT b = 0; b < bitSize; ++b) {
-      size_t byteIdx = bitOffset / 8;
-      int bitInByte = static_cast<int>(bitOffset % 8);
-      if (byteIdx < buf.size())
-        val |= (static_cast<ULONG>((buf[byteIdx] >> bitInByte) & 1) << b);
-      ++bitOffset;
-    }
-    out.push_back(val);
-  }
-  return out;
-}
-
-// Parses a single HID input report (one report = dwSizeHid bytes).
-// Used when multiple reports are packed in one WM_INPUT (dwCount > 1).
-std::vector<TouchpadContact>
-parseOneReport(PCHAR report, ULONG reportLen, PHIDP_PREPARSED_DATA preparsed,
-               const std::vector<HIDP_VALUE_CAPS> &orderedCaps) {
-  std::vector<TouchpadContact> result;
+// Blank input report for reportId, as HidP_* expects it (ID byte first).
+struct ReportProbe {
+  PHIDP_PREPARSED_DATA preparsed = nullptr;
+  ULONG reportBytes = 0;
 
-  ULONG contactCount = 0;
-  for (const auto &cap : orderedCaps) {
-    if (cap.LinkCollection == 0 && isUsage(cap, 0x0D, 0x54)) {
-      ULONG v = 0;
-      if (HidP_GetUsageValue(HidP_Input, cap.UsagePage, 0,
-                             static_cast<USAGE>(getUsage(cap)), &v, preparsed,
-                             report, reportLen) == HIDP_STATUS_SUCCESS)
-        contactCount = v;
-      break;
-    }
-  }
-
-  const HIDP_VALUE_CAPS *capContactId = nullptr;
-  const HIDP_VALUE_CAPS *capX = nullptr;
-  const HIDP_VALUE_CAPS *capY = nullptr;
-  const HIDP_VALUE_CAPS *capTip = nullptr;
-  for (const auto &cap : orderedCaps) {
-    if (cap.LinkCollection == 0 && isUsage(cap, 0x0D, 0x54))
-      continue;
-    if (cap.ReportCount > 1) {
-      if (isUsage(cap, 0x0D, 0x51))
-        capContactId = &cap;
-      else if (isUsage(cap, 0x01, 0x30))
-        capX = &cap;
-      else if (isUsage(cap, 0x01, 0x31))
-        capY = &cap;
-      else if (isUsage(cap, 0x0D, 0x42))
-        capTip = &cap;
-    }
-  }
-
-  if (capContactId || capX || capY) {
-    std::vector<ULONG> ids, xs, ys, tips;
-    if (capContactId)
-      ids = getUsageValueArray(*capContactId, preparsed, report, reportLen);
-    if (capX)
-      xs = getUsageValueArray(*capX, preparsed, report, reportLen);
-    if (capY)
-      ys = getUsageValueArray(*capY, preparsed, report, reportLen);
-    if (capTip && capTip->ReportCount > 1)
-      tips = getUsageValueArray(*capTip, preparsed, report, reportLen);
-    size_t n = std::max({ids.size(), xs.size(), ys.size()});
-    if (contactCount > 0 && n > contactCount)
-      n = contactCount;
-    for (size_t i = 0; i < n; ++i) {
-      int cid = (i < ids.size()) ? static_cast<int>(ids[i]) : 0;
-      int xval = (i < xs.size()) ? static_cast<int>(xs[i]) : 0;
-      int yval = (i < ys.size()) ? static_cast<int>(ys[i]) : 0;
-      float nx = 0.5f, ny = 0.5f;
-      if (capX && i < xs.size())
-        nx = normalizeFromLogical(xval, capX->LogicalMin, capX->LogicalMax);
-      if (capY && i < ys.size())
-        ny = normalizeFromLogical(yval, capY->LogicalMin, capY->LogicalMax);
-      bool tipDown = true;
-      if (i < tips.size())
-        tipDown = (tips[i] != 0);
-      result.push_back(TouchpadContact{cid, xval, yval, nx, ny, tipDown});
-    }
-    return result;
-  }
-
-  std::map<USHORT, ContactBuilder> contacts;
-  for (const auto &cap : orderedCaps) {
-    ULONG value = 0;
-    const USAGE usagePage = static_cast<USAGE>(cap.UsagePage);
-    const USAGE usage = static_cast<USAGE>(getUsage(cap));
-    if (HidP_GetUsageValue(HidP_Input, usagePage, cap.LinkCollection, usage,
-                           &value, preparsed, report,
-                           reportLen) != HIDP_STATUS_SUCCESS) {
-      continue;
-    }
-
-    if (cap.LinkCollection == 0) {
-      if (isUsage(cap, 0x0D, 0x54))
-        contactCount = value;
-      continue;
-    }
-
-    auto &builder = contacts[cap.LinkCollection];
-    if (isUsage(cap, 0x0D, 0x51)) {
-      builder.contactId = static_cast<int>(value);
-      builder.hasId = true;
-    } else if (isUsage(cap, 0x01, 0x30)) {
-      builder.x = static_cast<int>(value);
-      builder.normX =
-          normalizeFromLogical(builder.x, cap.LogicalMin, cap.LogicalMax);
-      builder.hasX = true;
-    } else if (isUsage(cap, 0x01, 0x31)) {
-      builder.y = static_cast<int>(value);
-      builder.normY =
-          normalizeFromLogical(builder.y, cap.LogicalMin, cap.LogicalMax);
-      builder.hasY = true;
-    } else if (isUsage(cap, 0x0D, 0x42)) {
-      builder.tipDown = (value != 0);
-      builder.hasTipDown = true;
-    }
+  bool blank(UCHAR reportId, std::vector<CHAR> &report) const {
+    report.assign(reportBytes, 0);
+    return HidP_InitializeReportForID(HidP_Input, reportId, preparsed,
+                                      report.data(),
+                                      reportBytes) == HIDP_STATUS_SUCCESS;
   }
+};
 
-  // Tip Switch (0x42) as button: read per link collection if not already set
-  // from value caps
-  const ULONG kMaxButtonUsages = 32;
-  std::vector<USAGE_AND_PAGE> usageList(kMaxButtonUsages);
-  for (auto &entry : contacts) {
-    if (entry.second.hasTipDown)
-      continue;
-    USHORT linkCollection = entry.first;
-    ULONG usageLength = static_cast<ULONG>(usageList.size());
-    if (HidP_GetUsagesEx(HidP_Input, linkCollection, usageList.data(),
-                         &usageLength, preparsed, report,
-                         reportLen) == HIDP_STATUS_SUCCESS) {
-      bool tipSet = false;
-      for (ULONG u = 0; u < usageLength; ++u) {
-        if (usageList[u].UsagePage == 0x0D && usageList[u].Usage == 0x42) {
-          tipSet = true;
-          break;
-        }
+// The contiguous run of bits that differs between two probe reports.
+HidField diffField(const std::vector<CHAR> &a, const std::vector<CHAR> &b) {
+  HidField field;
+  bool found = false;
+  uint32_t first = 0, last = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    const auto diff = static_cast<uint8_t>(a[i] ^ b[i]);
+    for (uint32_t bit = 0; bit < 8; ++bit) {
+      if ((diff >> bit) & 1) {
+        const uint32_t pos = static_cast<uint32_t>(i) * 8 + bit;
+        if (!found)
+          first = pos;
+        last = pos;
+        found = true;
       }
-      entry.second.tipDown = tipSet;
-      entry.second.hasTipDown = true;
     }
   }
+  if (found && last - first < 32) {
+    field.bitOffset = first;
+    field.bitSize = static_cast<uint8_t>(last - first + 1);
+  }
+  return field;
+}
 
-  for (const auto &entry : contacts) {
-    const auto &builder = entry.second;
-    if ((builder.hasId || builder.hasX || builder.hasY) &&
-        (builder.hasX && builder.hasY)) {
-      int cid =
-          builder.hasId ? builder.contactId : static_cast<int>(entry.first);
-      bool tipDown = builder.hasTipDown ? builder.tipDown : true;
-      result.push_back(TouchpadContact{cid, builder.x, builder.y, builder.normX,
-                                       builder.normY, tipDown});
-      if (contactCount > 0 && result.size() >= contactCount)
-        break;
+// Locate element `index` of a value cap: write all-zero and all-one values
+// into two blank reports and diff them.
+HidField probeValue(const ReportProbe &probe, const HIDP_VALUE_CAPS &cap,
+                    USHORT index) {
+  if (cap.BitSize == 0 || cap.BitSize > 32)
+    return {};
+  std::vector<CHAR> zeros, ones;
+  if (!probe.blank(cap.ReportID, zeros))
+    return {};
+  ones = zeros;
+
+  const USAGE usage = getUsage(cap);
+  NTSTATUS zeroStatus, oneStatus;
+  if (cap.ReportCount > 1) {
+    const size_t bits = static_cast<size_t>(cap.BitSize) * cap.ReportCount;
+    std::vector<CHAR> zeroArray((bits + 7) / 8, 0), oneArray(zeroArray);
+    for (USHORT b = 0; b < cap.BitSize; ++b) {
+      const size_t bit = static_cast<size_t>(index) * cap.BitSize + b;
+      oneArray[bit / 8] |= static_cast<CHAR>(1 << (bit % 8));
     }
+    const auto arrayLen = static_cast<USHORT>(zeroArray.size());
+    zeroStatus = HidP_SetUsageValueArray(
+        HidP_Input, cap.UsagePage, cap.LinkCollection, usage, zeroArray.data(),
+        arrayLen, probe.preparsed, zeros.data(), probe.reportBytes);
+    oneStatus = HidP_SetUsageValueArray(
+        HidP_Input, cap.UsagePage, cap.LinkCollection, usage, oneArray.data(),
+        arrayLen, probe.preparsed, ones.data(), probe.reportBytes);
+  } else {
+    const ULONG mask =
+        cap.BitSize == 32 ? 0xFFFFFFFFul : ((1ul << cap.BitSize) - 1);
+    zeroStatus = HidP_SetUsageValue(HidP_Input, cap.UsagePage,
+                                    cap.LinkCollection, usage, 0,
+                                    probe.preparsed, zeros.data(),
+                                    probe.reportBytes);
+    oneStatus = HidP_SetUsageValue(HidP_Input, cap.UsagePage,
+                                   cap.LinkCollection, usage, mask,
+                                   probe.preparsed, ones.data(),
+                                   probe.reportBytes);
   }
+  if (zeroStatus != HIDP_STATUS_SUCCESS || oneStatus != HIDP_STATUS_SUCCESS)
+    return {};
+
+  HidField field = diffField(zeros, ones);
+  field.logicalMin = cap.LogicalMin;
+  field.logicalMax = cap.LogicalMax;
+  field.isSigned = cap.LogicalMin < 0;
+  return field;
+}
 
-  return result;
+// Locate a one-bit button usage (Tip Switch) by setting it in a blank report.
+HidField probeButton(const ReportProbe &probe, const HIDP_BUTTON_CAPS &cap,
+                     USAGE usage) {
+  std::vector<CHAR> up, down;
+  if (!probe.blank(cap.ReportID, up))
+    return {};
+  down = up;
+  ULONG usageLength = 1;
+  if (HidP_SetUsages(HidP_Input, cap.UsagePage, cap.LinkCollection, &usage,
+                     &usageLength, probe.preparsed, down.data(),
+                     probe.reportBytes) != HIDP_STATUS_SUCCESS)
+    return {};
+
+  HidField field = diffField(up, down);
+  field.logicalMax = 1;
+  return field;
 }
 } // namespace
 
-std::vector<TouchpadContact> parsePrecisionTouchpadReport(void *rawInputHandle,
-                                                          void *deviceHandle) {
-  std::vector<TouchpadContact> result;
-
-  if (rawInputHandle == nullptr || deviceHandle == nullptr)
-    return result;
-
-  HRAWINPUT hRawInput = static_cast<HRAWINPUT>(rawInputHandle);
+HidTouchpadPlan buildPrecisionTouchpadPlan(void *deviceHandle) {
+  HidTouchpadPlan plan;
+  if (deviceHandle == nullptr)
+    return plan;
   HANDLE hDevice = static_cast<HANDLE>(deviceHandle);
 
-  UINT rawInputSize = 0;
-  if (GetRawInputData(hRawInput, RID_INPUT, nullptr, &rawInputSize,
-                      sizeof(RAWINPUTHEADER)) != 0) {
-    return result;
-  }
-
-  if (rawInputSize == 0)
-    return result;
-
-  std::vector<BYTE> rawInputBuffer(rawInputSize);
-  if (GetRawInputData(hRawInput, RID_INPUT, rawInputBuffer.data(),
-                      &rawInputSize, sizeof(RAWINPUTHEADER)) != rawInputSize) {
-    return result;
-  }
-
-  auto *rawInput = reinterpret_cast<RAWINPUT *>(rawInputBuffer.data());
-  if (rawInput->header.dwType != RIM_TYPEHID)
-    return result;
-
-  const UINT dwSizeHid = rawInput->data.hid.dwSizeHid;
-  const UINT dwCount = rawInput->data.hid.dwCount;
-  if (dwSizeHid == 0 || dwCount == 0)
-    return result;
-
-  BYTE *rawHidData = rawInput->data.hid.bRawData;
-
   UINT preparsedSize = 0;
   if (GetRawInputDeviceInfo(hDevice, RIDI_PREPARSEDDATA, nullptr,
-                            &preparsedSize) != 0) {
-    return result;
+                            &preparsedSize) != 0 ||
+      preparsedSize == 0) {
+    return plan;
   }
-
-  if (preparsedSize == 0)
-    return result;
-
   std::vector<BYTE> preparsedBuffer(preparsedSize);
   if (GetRawInputDeviceInfo(hDevice, RIDI_PREPARSEDDATA, preparsedBuffer.data(),
                             &preparsedSize) != preparsedSize) {
-    return result;
+    return plan;
   }
+  auto *preparsed =
+      reinterpret_cast<PHIDP_PREPARSED_DATA>(preparsedBuffer.data());
 
   HIDP_CAPS caps{};
-  if (HidP_GetCaps(
-          reinterpret_cast<PHIDP_PREPARSED_DATA>(preparsedBuffer.data()),
-          &caps) != HIDP_STATUS_SUCCESS) {
-    return result;
+  if (HidP_GetCaps(preparsed, &caps) != HIDP_STATUS_SUCCESS ||
+      caps.InputReportByteLength == 0) {
+    return plan;
   }
+  const ReportProbe probe{preparsed, caps.InputReportByteLength};
 
   USHORT valueCapsLength = caps.NumberInputValueCaps;
-  if (valueCapsLength == 0)
-    return result;
-
   std::vector<HIDP_VALUE_CAPS> valueCaps(valueCapsLength);
-  if (HidP_GetValueCaps(HidP_Input, valueCaps.data(), &valueCapsLength,
-                        reinterpret_cast<PHIDP_PREPARSED_DATA>(
-                            preparsedBuffer.data())) != HIDP_STATUS_SUCCESS) {
-    return result;
+  if (valueCapsLength == 0 ||
+      HidP_GetValueCaps(HidP_Input, valueCaps.data(), &valueCapsLength,
+                        preparsed) != HIDP_STATUS_SUCCESS) {
+    return plan;
   }
-
   valueCaps.resize(valueCapsLength);
-  auto orderedCaps = sortedByLinkCollection(std::move(valueCaps));
-  auto *preparsed =
-      reinterpret_cast<PHIDP_PREPARSED_DATA>(preparsedBuffer.data());
 
-  // Parse each HID report separately. Windows may pack multiple reports in one
-  // WM_INPUT (dwCount > 1); HidP_* expects one report at a time.
-  for (UINT i = 0; i < dwCount; ++i) {
-    PCHAR report = reinterpret_cast<PCHAR>(rawHidData +
-                                           static_cast<size_t>(i) * dwSizeHid);
-    ULONG reportLen = dwSizeHid;
-    auto contacts = parseOneReport(report, reportLen, preparsed, orderedCaps);
-    result.insert(result.end(), contacts.begin(), contacts.end());
+  // Each contact link collection, in order, becomes a slot; link collection
+  // 0 holds report-wide values (Contact Count) and parallel arrays.
+  std::vector<USHORT> links;
+  auto slotFor = [&links](USHORT link) {
+    auto it = std::find(links.begin(), links.end(), link);
+    if (it == links.end())
+      it = links.insert(links.end(), link);
+    return static_cast<int>(it - links.begin());
+  };
+  bool haveReport = false;
+  auto add = [&](USHORT page, USHORT usage, int slot, UCHAR reportId,
+                 const HidField &field) {
+    if (haveReport && reportId != plan.reportId)
+      return; // Contacts are taken from a single report
+    if (plan.addField(page, usage, slot, field) && !haveReport) {
+      haveReport = true;
+      plan.reportId = reportId;
+    }
+  };
+
+  for (const auto &cap : sortedByLinkCollection(std::move(valueCaps))) {
+    const USHORT usage = getUsage(cap);
+    if (cap.ReportCount > 1) {
+      for (USHORT e = 0; e < cap.ReportCount; ++e)
+        add(cap.UsagePage, usage, e, cap.ReportID, probeValue(probe, cap, e));
+    } else {
+      const int slot =
+          cap.LinkCollection == 0 ? 0 : slotFor(cap.LinkCollection);
+      add(cap.UsagePage, usage, slot, cap.ReportID, probeValue(probe, cap, 0));
+    }
+  }
+
+  // Tip Switch is usually a button rather than a value.
+  USHORT buttonCapsLength = caps.NumberInputButtonCaps;
+  std::vector<HIDP_BUTTON_CAPS> buttonCaps(buttonCapsLength);
+  if (buttonCapsLength > 0 &&
+      HidP_GetButtonCaps(HidP_Input, buttonCaps.data(), &buttonCapsLength,
+                         preparsed) == HIDP_STATUS_SUCCESS) {
+    buttonCaps.resize(buttonCapsLength);
+    for (const auto &cap : buttonCaps) {
+      if (cap.UsagePage != HID_USAGE_PAGE_DIGITIZER ||
+          cap.LinkCollection == 0 ||
+          !hasUsage(cap, HID_USAGE_DIGITIZER_TIP_SWITCH))
+        continue;
+      add(cap.UsagePage, HID_USAGE_DIGITIZER_TIP_SWITCH,
+          slotFor(cap.LinkCollection), cap.ReportID,
+          probeButton(probe, cap, HID_USAGE_DIGITIZER_TIP_SWITCH));
+    }
   }
 
-  return result;
+  if (!plan.isValid())
+    return HidTouchpadPlan{};
+  plan.reportBytes = caps.InputReportByteLength;
+  return plan;
 }
@@ -1,11 +1,11 @@
 #pragma once
 
-#include <vector>
+#include "HidTouchpadDecoder.h"
 
-#include "TouchpadTypes.h"
-
-// Parses Precision Touchpad contacts from a WM_INPUT (HRAWINPUT) handle.
-// rawInputHandle and deviceHandle are passed as void* to keep headers
-// Windows-free per project rules.
-std::vector<TouchpadContact> parsePrecisionTouchpadReport(void *rawInputHandle,
-                                                          void *deviceHandle);
+// Compiles a Precision Touchpad's input report layout from its preparsed data
+// (RIDI_PREPARSEDDATA). Windows does not expose the raw report descriptor, so
+// each field is located once by writing probe values into blank reports with
+// HidP_Set* and diffing them; reports are then decoded with
+// decodeTouchpadReport. deviceHandle is passed as void* to keep headers
+// Windows-free per project rules. Returns an invalid plan on failure.
+HidTouchpadPlan buildPrecisionTouchpadPlan(void *deviceHandle);
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include <cmath>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -255,3 +256,40 @@ struct TouchpadDrumFxSplitEntry {
   float invRegionWidth = 1.0f, invRegionHeight = 1.0f;
   bool regionLock = false;
 };
+
+// Compiled hit-test index over all touchpad layouts (mixer, drum pad, chord
+// pad). Normalized pad space is split into kGridSize x kGridSize buckets; each
+// bucket lists the layouts whose region overlaps it, in z-order (same order
+// as CompiledContext::touchpadLayoutOrder, topmost first). A contact only
+// tests the layouts in its bucket instead of every layout on every layer.
+struct TouchpadLayoutIndex {
+  static constexpr int kGridSize = 16; // Power of two: exact bucket maths
+
+  struct Candidate {
+    TouchpadType type = TouchpadType::Mixer;
+    size_t index = 0; // Index in that type's compiled vector
+    int layerId = 0;
+    int layoutGroupId = 0;
+    float regionLeft = 0.0f, regionTop = 0.0f, regionRight = 1.0f,
+          regionBottom = 1.0f;
+  };
+
+  std::vector<Candidate> candidates; // z-order
+  // Bucket b lists candidates[bucketEntries[bucketStart[b] ..
+  // bucketStart[b + 1])], ascending (so still in z-order). Built by
+  // MappingCompiler.
+  std::vector<uint32_t> bucketStart;
+  std::vector<uint32_t> bucketEntries;
+
+  static int bucketCoord(float v) {
+    return juce::jlimit(0, kGridSize - 1,
+                        (int)std::floor(v * (float)kGridSize));
+  }
+  static int bucketFor(float nx, float ny) {
+    return bucketCoord(ny) * kGridSize + bucketCoord(nx);
+  }
+  static bool contains(const Candidate &c, float nx, float ny) {
+    return nx >= c.regionLeft && nx < c.regionRight && ny >= c.regionTop &&
+           ny < c.regionBottom;
+  }
+};
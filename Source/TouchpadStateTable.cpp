@@ -0,0 +1,104 @@
+#include "TouchpadStateTable.h"
+#include <algorithm>
+
+void TouchpadStateTable::clear() {
+  devices.clear();
+  resizeRows();
+}
+
+bool TouchpadStateTable::hasShape(
+    size_t numMappings, const std::vector<TouchpadMixerEntry> &strips) const {
+  if (numMappings != mappingsPerDevice || strips.size() != stripsPerDevice)
+    return false;
+  size_t faders = 0;
+  for (size_t i = 0; i < strips.size(); ++i) {
+    if (faderBase[i] != faders)
+      return false;
+    faders += (size_t)std::max(0, strips[i].numFaders);
+  }
+  return faders == fadersPerDevice;
+}
+
+void TouchpadStateTable::setShape(
+    size_t numMappings, const std::vector<TouchpadMixerEntry> &strips) {
+  mappingsPerDevice = numMappings;
+  stripsPerDevice = strips.size();
+  faderBase.resize(strips.size());
+  fadersPerDevice = 0;
+  for (size_t i = 0; i < strips.size(); ++i) {
+    faderBase[i] = fadersPerDevice;
+    fadersPerDevice += (size_t)std::max(0, strips[i].numFaders);
+  }
+  clear();
+}
+
+int TouchpadStateTable::fadersInStrip(int stripIdx) const {
+  if (stripIdx < 0 || (size_t)stripIdx >= stripsPerDevice)
+    return 0;
+  const size_t end = ((size_t)stripIdx + 1 < stripsPerDevice)
+                         ? faderBase[(size_t)stripIdx + 1]
+                         : fadersPerDevice;
+  return (int)(end - faderBase[(size_t)stripIdx]);
+}
+
+int TouchpadStateTable::findDevice(uintptr_t deviceHandle) const {
+  // A handful of devices at most: linear scan beats hashing.
+  for (size_t i = 0; i < devices.size(); ++i) {
+    if (devices[i] == deviceHandle)
+      return (int)i;
+  }
+  return kNoValue;
+}
+
+int TouchpadStateTable::addDevice(uintptr_t deviceHandle) {
+  int slot = findDevice(deviceHandle);
+  if (slot != kNoValue)
+    return slot;
+  devices.push_back(deviceHandle);
+  resizeRows(); // Appends a default-initialised row block
+  return (int)devices.size() - 1;
+}
+
+void TouchpadStateTable::resizeRows() {
+  const size_t m = devices.size() * mappingsPerDevice;
+  const TouchGlideState idleGlide;
+  mapping.prevTip1.resize(m, uint8_t(0));
+  mapping.prevTip2.resize(m, uint8_t(0));
+  mapping.noteOnSent.resize(m, uint8_t(0));
+  mapping.expressionActive.resize(m, uint8_t(0));
+  mapping.ccLatchedOn.resize(m, uint8_t(0));
+  mapping.lastContinuousValue.resize(m, (int)kNoValue);
+  mapping.pitchGlide.resize(m, idleGlide);
+  mapping.hasPitchAnchor.resize(m, uint8_t(0));
+  mapping.pitchAnchorT.resize(m, 0.0f);
+  mapping.pitchAnchorStep.resize(m, 0.0f);
+  mapping.lastSlideValue.resize(m, (int)kNoValue);
+  mapping.slideRelativeValue.resize(m, 0.0f);
+  mapping.slideRelativeAnchor.resize(m, 0.0f);
+  mapping.slideLockedContact.resize(m, (int)kNoValue);
+  mapping.slideApplierDownPrev.resize(m, uint8_t(0));
+  mapping.slideReturn.resize(m, idleGlide);
+  mapping.lastEncoderValue.resize(m, (int)kNoValue);
+  mapping.encoderActiveCount.resize(m, (int)kNoValue);
+  mapping.encoderLastSentSteps.resize(m, 0);
+  mapping.hasEncoderAnchor.resize(m, uint8_t(0));
+  mapping.encoderAnchor.resize(m, 0.0f);
+  mapping.encoderAnchorX.resize(m, 0.0f);
+  mapping.encoderAnchorY.resize(m, 0.0f);
+  mapping.encoderHadActivePrev.resize(m, uint8_t(0));
+  mapping.encoderPushPrev.resize(m, uint8_t(0));
+  mapping.encoderPushOn.resize(m, uint8_t(0));
+
+  const size_t s = devices.size() * stripsPerDevice;
+  strip.lockedFader.resize(s, (int)kNoValue);
+  strip.lastFaderIndex.resize(s, (int)kNoValue);
+  strip.applierDownPrev.resize(s, uint8_t(0));
+  strip.contactPrev.resize(s * kMaxStripContacts, StripContactPrev{});
+
+  const size_t f = devices.size() * fadersPerDevice;
+  fader.lastCC.resize(f, (int)kNoValue);
+  fader.valueBeforeMute.resize(f, (int)kNoValue);
+  fader.muted.resize(f, uint8_t(0));
+  fader.relativeValue.resize(f, 0.0f);
+  fader.relativeAnchor.resize(f, 0.0f);
+}
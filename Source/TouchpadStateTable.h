@@ -0,0 +1,141 @@
+#pragma once
+#include "TouchpadLayoutTypes.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Touch glide: smooth transition on touch/release for touchpad PitchBend, and
+// Slide CC return-to-rest.
+enum class TouchGlidePhase {
+  Idle,
+  GlidingToFinger,
+  FollowingFinger,
+  GlidingToCenter
+};
+struct TouchGlideState {
+  TouchGlidePhase phase = TouchGlidePhase::Idle;
+  int startValue = 8192;
+  int targetValue = 8192;
+  uint32_t startTimeMs = 0;
+  int durationMs = 0;
+  int lastSentValue = -1;
+};
+
+// Runtime state for compiled touchpad mappings and mixer strips, stored as
+// flat parallel arrays (one column per field) instead of tuple-keyed maps.
+// Rows are addressed by (device slot, compiled index): the index is the
+// entry's position in CompiledContext::touchpadMappings /
+// touchpadMixerStrips, so a frame does direct indexed loads with no hashing,
+// tree walks or node allocations. Memory is only (re)allocated when the
+// compiled touchpad part changes shape or a new device appears.
+//
+// Rows are only meaningful for the touchpad entries they were shaped for;
+// call clear() whenever those entries are recompiled.
+class TouchpadStateTable {
+public:
+  static constexpr int kNoValue = -1;
+  // Contacts remembered per mixer strip (Precision Touchpads report <= 5).
+  static constexpr int kMaxStripContacts = 10;
+
+  // Per compiled touchpad mapping.
+  struct MappingColumns {
+    // Local finger 1/2 tip state last frame (Finger*Down/Up edges)
+    std::vector<uint8_t> prevTip1, prevTip2;
+    // BoolToGate / ContinuousToGate: note currently on
+    std::vector<uint8_t> noteOnSent;
+    // BoolToCC Expression: envelope to release when the finger lifts
+    std::vector<uint8_t> expressionActive;
+    // BoolToCC CC Position with CcReleaseBehavior::AlwaysLatch
+    std::vector<uint8_t> ccLatchedOn;
+    // ContinuousToRange: last sent CC (0-127) or PB (0-16383), or kNoValue
+    std::vector<int> lastContinuousValue;
+    std::vector<TouchGlideState> pitchGlide;
+    // Relative pitch-pad: gesture anchor (axis t and the step it maps to).
+    // Guarded by InputProcessor::anchorLock (read by the visualizer).
+    std::vector<uint8_t> hasPitchAnchor;
+    std::vector<float> pitchAnchorT, pitchAnchorStep;
+    // SlideToCC
+    std::vector<int> lastSlideValue;   // kNoValue = nothing sent yet
+    std::vector<float> slideRelativeValue, slideRelativeAnchor;
+    std::vector<int> slideLockedContact; // kNoValue = none
+    std::vector<uint8_t> slideApplierDownPrev;
+    std::vector<TouchGlideState> slideReturn;
+    // EncoderCC
+    std::vector<int> lastEncoderValue;   // kNoValue = nothing sent yet
+    std::vector<int> encoderActiveCount; // kNoValue = no gesture
+    std::vector<int> encoderLastSentSteps;
+    std::vector<uint8_t> hasEncoderAnchor;
+    std::vector<float> encoderAnchor, encoderAnchorX, encoderAnchorY;
+    std::vector<uint8_t> encoderHadActivePrev, encoderPushPrev, encoderPushOn;
+  };
+
+  // Per compiled mixer strip.
+  struct StripContactPrev {
+    int contactId = kNoValue;
+    float y = 0.0f; // Effective (region-lock clamped) Y last frame
+  };
+  struct StripColumns {
+    std::vector<int> lockedFader;    // kNoValue = none
+    std::vector<int> lastFaderIndex; // kNoValue = none
+    std::vector<uint8_t> applierDownPrev;
+    // kMaxStripContacts entries per row
+    std::vector<StripContactPrev> contactPrev;
+  };
+
+  // Per mixer fader (strip rows expanded by TouchpadMixerEntry::numFaders).
+  struct FaderColumns {
+    std::vector<int> lastCC;          // kNoValue = nothing sent yet
+    std::vector<int> valueBeforeMute; // kNoValue = unknown
+    std::vector<uint8_t> muted;
+    std::vector<float> relativeValue, relativeAnchor;
+  };
+
+  MappingColumns mapping;
+  StripColumns strip;
+  FaderColumns fader;
+
+  // Drops all state and devices (keeps capacity).
+  void clear();
+
+  // True if rows are laid out for this compiled touchpad part.
+  bool hasShape(size_t numMappings,
+                const std::vector<TouchpadMixerEntry> &strips) const;
+  // Re-lays out (and clears) the table for a compiled touchpad part.
+  void setShape(size_t numMappings,
+                const std::vector<TouchpadMixerEntry> &strips);
+
+  // Device slot for a handle, or kNoValue if the device has not been seen.
+  int findDevice(uintptr_t deviceHandle) const;
+  // Device slot for a handle; adds a row block on first use.
+  int addDevice(uintptr_t deviceHandle);
+  int numDevices() const { return (int)devices.size(); }
+  uintptr_t deviceAt(int slot) const { return devices[(size_t)slot]; }
+
+  size_t numMappings() const { return mappingsPerDevice; }
+  // Faders laid out for a mixer strip (0 for an unknown strip index).
+  int fadersInStrip(int stripIdx) const;
+  size_t numMappingRows() const { return devices.size() * mappingsPerDevice; }
+
+  size_t mappingRow(int slot, size_t mapIdx) const {
+    return (size_t)slot * mappingsPerDevice + mapIdx;
+  }
+  size_t stripRow(int slot, size_t stripIdx) const {
+    return (size_t)slot * stripsPerDevice + stripIdx;
+  }
+  size_t faderRow(int slot, size_t stripIdx, int faderIdx) const {
+    return (size_t)slot * fadersPerDevice + faderBase[stripIdx] +
+           (size_t)faderIdx;
+  }
+  StripContactPrev *stripContacts(size_t stripRowIdx) {
+    return &strip.contactPrev[stripRowIdx * kMaxStripContacts];
+  }
+
+private:
+  void resizeRows();
+
+  std::vector<uintptr_t> devices;
+  size_t mappingsPerDevice = 0;
+  size_t stripsPerDevice = 0;
+  size_t fadersPerDevice = 0;
+  std::vector<size_t> faderBase; // Strip index -> first fader in a row block
+};
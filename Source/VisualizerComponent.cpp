@@ -385,8 +385,8 @@ void VisualizerComponent::refreshCache() {
           isGhost = slot.isGhost;
           if (!slot.displayColor.isTransparent())
             underlayColor = slot.displayColor;
-          if (slot.label.isNotEmpty())
-            labelText = slot.label;
+          if (slot.labelId != 0)
+            labelText = contextPtr->labelFor(slot);
         }
       }
 
@@ -495,7 +495,9 @@ void VisualizerComponent::paint(juce::Graphics &g) {
   if (contentW < 0)
     contentW = 0;
   auto headerRect = juce::Rectangle<int>(0, 0, contentW, 30);
-  bool sustainActive = voiceManager.isSustainActive();
+  // One lock-free read of voice state for the whole frame
+  const VoiceSnapshot voiceState = voiceManager.getVoiceSnapshot();
+  bool sustainActive = voiceState.isSustainActive();
   juce::Colour sustainColor =
       sustainActive ? juce::Colours::lime : juce::Colours::grey;
   int indicatorSize = 12;
@@ -574,7 +576,7 @@ void VisualizerComponent::paint(juce::Graphics &g) {
   const auto &layout = KeyboardLayoutUtils::getLayout();
   for (const auto &pair : layout) {
     int keyCode = pair.first;
-    if (voiceManager.isKeyLatched(keyCode)) {
+    if (voiceState.isKeyLatched(keyCode)) {
       keysToRender.insert(keyCode);
     }
   }
@@ -603,7 +605,7 @@ void VisualizerComponent::paint(juce::Graphics &g) {
     // Get key state (input overlays only – no simulation in paint)
     bool isPressed =
         (activeKeysSnapshot.find(keyCode) != activeKeysSnapshot.end());
-    bool isLatched = voiceManager.isKeyLatched(keyCode);
+    bool isLatched = voiceState.isKeyLatched(keyCode);
 
     juce::String labelText = geometry.label;
 
@@ -818,7 +820,7 @@ void VisualizerComponent::changeListenerCallback(
   }
   if (source == &voiceManager) {
     // Sustain state changed -> update indicator immediately
-    lastSustainState = voiceManager.isSustainActive();
+    lastSustainState = voiceManager.getVoiceSnapshot().isSustainActive();
     needsRepaint.store(true, std::memory_order_release);
     repaint();
     return;
@@ -1004,7 +1006,7 @@ void VisualizerComponent::timerCallback() {
   // Step 2: Poll external state + rebuild cache / repaint on demand.
 
   // Check external Sustain state
-  bool sus = voiceManager.isSustainActive();
+  bool sus = voiceManager.getVoiceSnapshot().isSustainActive();
   if (lastSustainState != sus) {
     lastSustainState = sus;
     needsRepaint.store(true, std::memory_order_release);
@@ -1,14 +1,14 @@
 #include "VoiceManager.h"
 #include <algorithm>
-#include <set>
+#include <bit>
+#include <bitset>
 
 VoiceManager::VoiceManager(MidiEngine &engine, SettingsManager &settingsMgr)
     : midiEngine(engine), settingsManager(settingsMgr),
       strumEngine(engine, [this](InputID s, int n, int c,
                                  bool a) { addVoiceFromStrum(s, n, c, a); }),
       portamentoEngine(engine) {
-  juce::HighResolutionTimer::startTimer(
-      1); // Check for expired releases every 1ms
+  scheduler->registerClient(*this, RealtimeScheduler::Order::Release);
   juce::Timer::startTimer(
       100); // Watchdog for stuck notes every 100ms (Phase 26.6)
 
@@ -23,8 +23,8 @@ VoiceManager::~VoiceManager() {
   // 1. Stop Watchdog (juce::Timer)
   juce::Timer::stopTimer();
 
-  // 2. Stop Release Envelopes (juce::HighResolutionTimer)
-  juce::HighResolutionTimer::stopTimer();
+  // 2. Stop Release Envelopes (shared RealtimeScheduler)
+  scheduler->unregisterClient(*this);
 
   // 3. Remove listeners
   settingsManager.removeChangeListener(this);
@@ -36,18 +36,75 @@ VoiceManager::~VoiceManager() {
   }
 
   // 5. Reset portamento
-  portamentoEngine.stop(); // Reset PB to center
+  portamentoEngine.stopAll(); // Reset PB to center
 }
 
 void VoiceManager::addVoiceFromStrum(InputID source, int note, int channel,
                                      bool allowSustain) {
-  juce::ScopedLock lock(voicesLock);
-  voices.push_back({note, channel, source, allowSustain, false,
-                    VoiceState::Playing, 0, PolyphonyMode::Poly});
+  VoicesWriteLock lock(*this);
+  addVoice({note, channel, source, allowSustain, false, VoiceState::Playing,
+            0, PolyphonyMode::Poly});
+}
+
+void VoiceManager::addVoice(const ActiveVoice &voice) {
+  if (voices.isFull()) {
+    // Steal the lowest-indexed voice, preferring ones no key is holding.
+    int victim = voices.firstInState(VoiceState::Sustained);
+    if (victim == VoiceTable::kNone)
+      victim = voices.firstInState(VoiceState::Latched);
+    if (victim == VoiceTable::kNone)
+      victim = voices.firstInState(VoiceState::Playing);
+    midiEngine.sendNoteOff(voices[victim].midiChannel,
+                           voices[victim].noteNumber);
+    voices.remove(victim);
+  }
+  voices.add(voice);
+}
+
+void VoiceManager::killVoicesOnChannel(int channel) {
+  voices.forEachOnChannel(channel, [this](int i) {
+    midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    voices.remove(i);
+  });
+}
+
+void VoiceManager::killVoicesOnNote(int channel, int note) {
+  voices.forEachOnNote(channel, note, [this](int i) {
+    midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    voices.remove(i);
+  });
+}
+
+void VoiceManager::killVoicesFromSource(InputID source, bool sendNoteOffs) {
+  voices.forEachFromSource(source, [this, sendNoteOffs](int i) {
+    if (sendNoteOffs)
+      midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    voices.remove(i);
+  });
+}
+
+void VoiceManager::cancelPendingNoteOff(int channel, int note) {
+  if (channel < 1 || channel > 16 || note < 0 || note > 127)
+    return;
+  const int slot = (channel - 1) * 128 + note;
+  pendingNoteOffBits[(size_t)(slot / 64)] &= ~(uint64_t(1) << (slot % 64));
+}
+
+void VoiceManager::queuePendingNoteOff(int channel, int note,
+                                       double targetTimeMs) {
+  if (channel < 1 || channel > 16 || note < 0 || note > 127)
+    return;
+  const int slot = (channel - 1) * 128 + note;
+  const uint64_t bit = uint64_t(1) << (slot % 64);
+  auto &word = pendingNoteOffBits[(size_t)(slot / 64)];
+  // One NoteOff per note: a later release of the same note extends it.
+  if (!(word & bit) || pendingNoteOffAtMs[(size_t)slot] < targetTimeMs)
+    pendingNoteOffAtMs[(size_t)slot] = targetTimeMs;
+  word |= bit;
 }
 
 void VoiceManager::rebuildPbLookup() {
-  int globalRange = settingsManager.getPitchBendRange();
+  int globalRange = settingsManager.getRuntimeSettings()->pitchBendRange;
   if (globalRange < 1)
     globalRange = 12; // Phase 43: prevent div/0 from bad saved data
   double stepsPerSemitone = 8192.0 / static_cast<double>(globalRange);
@@ -69,12 +126,8 @@ void VoiceManager::rebuildPbLookup() {
 
 int VoiceManager::getCurrentPlayingNote(int channel) const {
   juce::ScopedLock lock(voicesLock);
-  for (const auto &voice : voices) {
-    if (voice.midiChannel == channel && voice.state == VoiceState::Playing) {
-      return voice.noteNumber;
-    }
-  }
-  return -1; // No note playing
+  const int i = voices.findOnChannel(channel, VoiceState::Playing);
+  return i != VoiceTable::kNone ? voices[i].noteNumber : -1;
 }
 
 void VoiceManager::pushToMonoStack(int channel, int note, InputID source) {
@@ -140,12 +193,7 @@ void VoiceManager::noteOn(InputID source, int note, int vel, int channel,
                           bool alwaysLatch, bool sustainUntilRetrigger) {
   {
     juce::ScopedLock rl(releasesLock);
-    releaseQueue.erase(std::remove_if(releaseQueue.begin(), releaseQueue.end(),
-                                      [note, channel](const PendingNoteOff &p) {
-                                        return p.note == note &&
-                                               p.channel == channel;
-                                      }),
-                       releaseQueue.end());
+    cancelPendingNoteOff(channel, note);
   }
 
   // Handle Mono/Legato modes
@@ -166,19 +214,11 @@ void VoiceManager::noteOn(InputID source, int note, int vel, int channel,
           (stackIt == monoStacks.end() || stackIt->second.empty());
 
       if (stackEmpty) {
-        // Check for zombie voices on this channel
-        juce::ScopedLock lock(voicesLock);
-        for (auto it = voices.begin(); it != voices.end();) {
-          if (it->midiChannel == channel) {
-            // Zombie voice found - kill it (self-healing)
-            midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-            it = voices.erase(it);
-          } else {
-            ++it;
-          }
-        }
+        // Zombie voices on this channel: kill them (self-healing)
+        VoicesWriteLock lock(*this);
+        killVoicesOnChannel(channel);
         // Reset PB and stop portamento for clean state
-        portamentoEngine.stop();
+        portamentoEngine.stop(channel);
         midiEngine.sendPitchBend(channel, 8192);
       }
     }
@@ -198,8 +238,8 @@ void VoiceManager::noteOn(InputID source, int note, int vel, int channel,
         // Legato glide: use portamento
         // Start from current PB value if portamento is active, otherwise center
         // (8192)
-        int startPB = portamentoEngine.isActive()
-                          ? portamentoEngine.getCurrentValue()
+        int startPB = portamentoEngine.isActive(channel)
+                          ? portamentoEngine.getCurrentValue(channel)
                           : 8192;
         int targetPB = pbLookup[lookupIndex];
         portamentoEngine.startGlide(startPB, targetPB, glideSpeed, channel);
@@ -207,22 +247,15 @@ void VoiceManager::noteOn(InputID source, int note, int vel, int channel,
         return; // Exit early, no new note triggered
       } else {
         // Retrigger: NoteOff current, reset PB, NoteOn new
-        juce::ScopedLock lock(voicesLock);
-        for (auto it = voices.begin(); it != voices.end();) {
-          if (it->midiChannel == channel && it->noteNumber == currentNote) {
-            midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-            it = voices.erase(it);
-          } else {
-            ++it;
-          }
-        }
+        VoicesWriteLock lock(*this);
+        killVoicesOnNote(channel, currentNote);
         // Reset PB to center
-        portamentoEngine.stop();
+        portamentoEngine.stop(channel);
         midiEngine.sendPitchBend(channel, 8192);
       }
     } else if (currentNote < 0) {
       // No note currently playing, reset PB to center
-      portamentoEngine.stop();
+      portamentoEngine.stop(channel);
       midiEngine.sendPitchBend(channel, 8192);
     }
   } else {
@@ -230,37 +263,26 @@ void VoiceManager::noteOn(InputID source, int note, int vel, int channel,
     channelPolyModes.erase(channel);
   }
 
-  juce::ScopedLock lock(voicesLock);
+  VoicesWriteLock lock(*this);
 
   // Second press of same key: for SustainUntilRetrigger, clear voice without
   // note off (then fall through to note on); otherwise unlatch (note off +
   // return).
-  auto it =
-      std::find_if(voices.begin(), voices.end(), [&](const ActiveVoice &v) {
-        return v.source == source && (v.state == VoiceState::Playing ||
-                                      v.state == VoiceState::Latched);
-      });
-  if (it != voices.end()) {
-    for (auto i = voices.begin(); i != voices.end();) {
-      if (i->source.deviceHandle == source.deviceHandle &&
-          i->source.keyCode == source.keyCode) {
-        if (!sustainUntilRetrigger)
-          midiEngine.sendNoteOff(i->midiChannel, i->noteNumber);
-        i = voices.erase(i);
-      } else
-        ++i;
-    }
+  if (voices.anyFromSource(source,
+                           VoiceTable::stateMask(VoiceState::Playing) |
+                               VoiceTable::stateMask(VoiceState::Latched))) {
+    killVoicesFromSource(source, !sustainUntilRetrigger);
     if (!sustainUntilRetrigger)
       return;
   }
 
   midiEngine.sendNoteOn(channel, note, static_cast<float>(vel) / 127.0f);
-  voices.push_back({note, channel, source, allowSustain, alwaysLatch,
-                    VoiceState::Playing, releaseMs, PolyphonyMode::Poly});
+  addVoice({note, channel, source, allowSustain, alwaysLatch,
+            VoiceState::Playing, releaseMs, PolyphonyMode::Poly});
 }
 
-void VoiceManager::noteOn(InputID source, const std::vector<int> &notes,
-                          const std::vector<int> &velocities, int channel,
+void VoiceManager::noteOn(InputID source, std::span<const int> notes,
+                          std::span<const int> velocities, int channel,
                           int strumSpeedMs, bool allowSustain, int releaseMs,
                           PolyphonyMode polyMode, int glideSpeed,
                           int strumPattern, int humanizeTimeMs) {
@@ -269,53 +291,32 @@ void VoiceManager::noteOn(InputID source, const std::vector<int> &notes,
 
   if (strumSpeedMs == 0) {
     juce::ScopedLock rl(releasesLock);
-    for (int n : notes) {
-      releaseQueue.erase(
-          std::remove_if(releaseQueue.begin(), releaseQueue.end(),
-                         [n, channel](const PendingNoteOff &p) {
-                           return p.note == n && p.channel == channel;
-                         }),
-          releaseQueue.end());
-    }
+    for (int n : notes)
+      cancelPendingNoteOff(channel, n);
   }
 
-  juce::ScopedLock lock(voicesLock);
-
-  if (globalLatchActive) {
-    bool anyFromSource =
-        std::any_of(voices.begin(), voices.end(), [&](const ActiveVoice &v) {
-          return v.source == source && (v.state == VoiceState::Playing ||
-                                        v.state == VoiceState::Latched);
-        });
-    if (anyFromSource) {
-      for (auto i = voices.begin(); i != voices.end();) {
-        if (i->source == source) {
-          midiEngine.sendNoteOff(i->midiChannel, i->noteNumber);
-          i = voices.erase(i);
-        } else
-          ++i;
-      }
-      strumEngine.cancelPendingNotes(source);
-      return;
-    }
-  }
+  VoicesWriteLock lock(*this);
 
-  std::vector<int> finalVelocities = velocities;
-  if (finalVelocities.size() < notes.size()) {
-    int defaultVel = finalVelocities.empty() ? 100 : finalVelocities[0];
-    finalVelocities.resize(notes.size(), defaultVel);
+  if (globalLatchActive &&
+      voices.anyFromSource(source,
+                           VoiceTable::stateMask(VoiceState::Playing) |
+                               VoiceTable::stateMask(VoiceState::Latched))) {
+    killVoicesFromSource(source, true);
+    strumEngine.cancelPendingNotes(source);
+    return;
   }
 
   if (strumSpeedMs == 0) {
+    const int defaultVel = velocities.empty() ? 100 : velocities[0];
     for (size_t i = 0; i < notes.size(); ++i) {
-      int vel = (i < finalVelocities.size()) ? finalVelocities[i] : 100;
+      int vel = (i < velocities.size()) ? velocities[i] : defaultVel;
       int note = notes[i];
       midiEngine.sendNoteOn(channel, note, static_cast<float>(vel) / 127.0f);
-      voices.push_back({note, channel, source, allowSustain, false,
-                        VoiceState::Playing, releaseMs, polyMode});
+      addVoice({note, channel, source, allowSustain, false,
+                VoiceState::Playing, releaseMs, polyMode});
     }
   } else {
-    strumEngine.triggerStrum(notes, finalVelocities, channel, strumSpeedMs,
+    strumEngine.triggerStrum(notes, velocities, channel, strumSpeedMs,
                              source, allowSustain, strumPattern,
                              humanizeTimeMs);
   }
@@ -327,10 +328,10 @@ void VoiceManager::strumNotes(const std::vector<int> &notes, int speedMs,
     return;
 
   {
-    juce::ScopedLock lock(voicesLock);
-    for (const auto &v : voices) {
-      midiEngine.sendNoteOff(v.midiChannel, v.noteNumber);
-    }
+    VoicesWriteLock lock(*this);
+    voices.forEachVoice([this](int i) {
+      midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    });
     voices.clear();
   }
 
@@ -358,31 +359,21 @@ void VoiceManager::handleKeyUp(InputID source) {
       false; // Track if Legato voice was preserved (Phase 26.4)
 
   {
-    juce::ScopedLock lock(voicesLock);
-    for (auto it = voices.begin(); it != voices.end();) {
-      if (it->source.deviceHandle != source.deviceHandle ||
-          it->source.keyCode != source.keyCode) {
-        ++it;
-        continue;
-      }
-
-      releasedChannel = it->midiChannel;
-      releasedNote = it->noteNumber;
-      releasedPolyMode = it->polyphonyMode; // Store polyphony mode (Phase 26.3)
-
-      if (it->alwaysLatch) {
-        it->state = VoiceState::Latched;
-        ++it;
-      } else if (globalLatchActive) {
-        it->state = VoiceState::Latched;
-        ++it;
-      } else if (globalSustainActive && it->allowSustain) {
-        it->state = VoiceState::Sustained;
-        ++it;
-      } else if (it->releaseMs > 0) {
+    VoicesWriteLock lock(*this);
+    voices.forEachFromSource(source, [&](int i) {
+      const ActiveVoice &voice = voices[i];
+      releasedChannel = voice.midiChannel;
+      releasedNote = voice.noteNumber;
+      releasedPolyMode = voice.polyphonyMode; // Phase 26.3
+
+      if (voice.alwaysLatch || globalLatchActive) {
+        voices.setState(i, VoiceState::Latched);
+      } else if (globalSustainActive && voice.allowSustain) {
+        voices.setState(i, VoiceState::Sustained);
+      } else if (voice.releaseMs > 0) {
         toQueue.push_back(
-            {it->noteNumber, it->midiChannel, now + it->releaseMs});
-        it = voices.erase(it);
+            {voice.noteNumber, voice.midiChannel, now + voice.releaseMs});
+        voices.remove(i);
       } else {
         // Check if this is a Legato anchor that should be preserved
         bool shouldPreserveVoice = false;
@@ -428,7 +419,8 @@ void VoiceManager::handleKeyUp(InputID source) {
                   if (lookupIndex >= 0 && lookupIndex < 255 &&
                       pbLookup[lookupIndex] != -1) {
                     // Glide PB to new top note
-                    int startPB = portamentoEngine.getCurrentValue();
+                    int startPB =
+                        portamentoEngine.getCurrentValue(releasedChannel);
                     int targetPB = pbLookup[lookupIndex];
                     auto polyModeIt = channelPolyModes.find(releasedChannel);
                     int glideSpeed = (polyModeIt != channelPolyModes.end())
@@ -451,16 +443,14 @@ void VoiceManager::handleKeyUp(InputID source) {
           }
         }
 
+        // Legato anchor with a non-empty stack keeps sounding
         if (!shouldPreserveVoice) {
           // Standard release: send NoteOff and remove voice
-          midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-          it = voices.erase(it);
-        } else {
-          // Preserve voice (Legato anchor with non-empty stack)
-          ++it;
+          midiEngine.sendNoteOff(voice.midiChannel, voice.noteNumber);
+          voices.remove(i);
         }
       }
-    }
+    });
   }
 
   // If this key had no active voice, check if it's in a mono stack
@@ -521,7 +511,8 @@ void VoiceManager::handleKeyUp(InputID source) {
                     // Legato glide back to previous note's PB value
                     // Always use getCurrentValue() - it holds the last PB value
                     // even when inactive
-                    int startPB = portamentoEngine.getCurrentValue();
+                    int startPB =
+                        portamentoEngine.getCurrentValue(foundChannel);
                     // Target is the PB value for the previous note (relative to
                     // current note)
                     int targetPB = pbLookup[lookupIndex];
@@ -540,23 +531,23 @@ void VoiceManager::handleKeyUp(InputID source) {
                           startPB, targetPB, returnGlideSpeed, foundChannel);
                     } else {
                       // Already at target, just ensure it's set
-                      if (!portamentoEngine.isActive()) {
+                      if (!portamentoEngine.isActive(foundChannel)) {
                         midiEngine.sendPitchBend(foundChannel, targetPB);
                       }
                     }
                   } else {
                     // Out of range or invalid, just reset to center
-                    portamentoEngine.stop();
+                    portamentoEngine.stop(foundChannel);
                     midiEngine.sendPitchBend(foundChannel, 8192);
                   }
                 } else {
                   // No note playing, reset PB
-                  portamentoEngine.stop();
+                  portamentoEngine.stop(foundChannel);
                   midiEngine.sendPitchBend(foundChannel, 8192);
                 }
               } else {
                 // Stack empty, reset PB
-                portamentoEngine.stop();
+                portamentoEngine.stop(foundChannel);
                 midiEngine.sendPitchBend(foundChannel, 8192);
                 channelPolyModes.erase(polyModeIt);
               }
@@ -601,17 +592,10 @@ void VoiceManager::handleKeyUp(InputID source) {
         // CASE 1: Stack is empty (Final Release) - Hard Stop (Phase 26.5)
         if (targetNote < 0) {
           // Force-kill ANY voice on this channel (don't trust the ID)
-          juce::ScopedLock lock(voicesLock);
-          for (auto it = voices.begin(); it != voices.end();) {
-            if (it->midiChannel == releasedChannel) {
-              midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-              it = voices.erase(it);
-            } else {
-              ++it;
-            }
-          }
+          VoicesWriteLock lock(*this);
+          killVoicesOnChannel(releasedChannel);
           // Reset PB and force-stop portamento engine
-          portamentoEngine.stop();
+          portamentoEngine.stop(releasedChannel);
           midiEngine.sendPitchBend(releasedChannel, 8192);
           channelPolyModes.erase(polyModeIt);
         }
@@ -619,33 +603,30 @@ void VoiceManager::handleKeyUp(InputID source) {
         else {
           // Find the "Anchor" (The voice actually playing audio on this
           // channel)
-          ActiveVoice *anchor = nullptr;
+          int anchorNote = -1;
           {
             juce::ScopedLock lock(voicesLock);
-            for (auto &v : voices) {
-              if (v.midiChannel == releasedChannel &&
-                  v.state == VoiceState::Playing) {
-                anchor = &v;
-                break;
-              }
-            }
+            const int anchor =
+                voices.findOnChannel(releasedChannel, VoiceState::Playing);
+            if (anchor != VoiceTable::kNone)
+              anchorNote = voices[anchor].noteNumber;
           }
 
           // Sub-Case A: No Anchor exists (was killed by a non-legato note or
           // out-of-range retrigger)
-          if (anchor == nullptr) {
+          if (anchorNote < 0) {
             // We must RETRIGGER the target note
             midiEngine.sendNoteOn(releasedChannel, targetNote, 100.0f / 127.0f);
-            juce::ScopedLock lock(voicesLock);
-            voices.push_back({targetNote, releasedChannel, targetSource, true,
-                              false, VoiceState::Playing, 0, polyMode});
+            VoicesWriteLock lock(*this);
+            addVoice({targetNote, releasedChannel, targetSource, true, false,
+                      VoiceState::Playing, 0, polyMode});
             // Reset PB to center for the new note
-            portamentoEngine.stop();
+            portamentoEngine.stop(releasedChannel);
             midiEngine.sendPitchBend(releasedChannel, 8192);
           }
           // Sub-Case B: Anchor exists
           else {
-            int currentRoot = anchor->noteNumber;
+            int currentRoot = anchorNote;
             int delta = targetNote - currentRoot;
             int lookupIndex = delta + 127;
 
@@ -653,7 +634,7 @@ void VoiceManager::handleKeyUp(InputID source) {
             if (lookupIndex >= 0 && lookupIndex < 255 &&
                 pbLookup[lookupIndex] != -1) {
               // GLIDE (Ghost Anchor) - Keep Anchor alive, just move PB
-              int startPB = portamentoEngine.getCurrentValue();
+              int startPB = portamentoEngine.getCurrentValue(releasedChannel);
               int targetPB = pbLookup[lookupIndex];
               int glideSpeed = polyModeIt->second.second;
               if (glideSpeed < 1)
@@ -666,23 +647,15 @@ void VoiceManager::handleKeyUp(InputID source) {
             } else {
               // HARD SWITCH (Retrigger) - Range too far. Kill Anchor. Start
               // Target.
-              juce::ScopedLock lock(voicesLock);
-              for (auto it = voices.begin(); it != voices.end();) {
-                if (it->midiChannel == releasedChannel &&
-                    it->noteNumber == currentRoot) {
-                  midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-                  it = voices.erase(it);
-                } else {
-                  ++it;
-                }
-              }
+              VoicesWriteLock lock(*this);
+              killVoicesOnNote(releasedChannel, currentRoot);
               // Trigger target note
               midiEngine.sendNoteOn(releasedChannel, targetNote,
                                     100.0f / 127.0f);
-              voices.push_back({targetNote, releasedChannel, targetSource, true,
-                                false, VoiceState::Playing, 0, polyMode});
+              addVoice({targetNote, releasedChannel, targetSource, true, false,
+                        VoiceState::Playing, 0, polyMode});
               // Reset PB to center
-              portamentoEngine.stop();
+              portamentoEngine.stop(releasedChannel);
               midiEngine.sendPitchBend(releasedChannel, 8192);
             }
           }
@@ -693,8 +666,12 @@ void VoiceManager::handleKeyUp(InputID source) {
 
   if (!toQueue.empty()) {
     juce::ScopedLock lock(releasesLock);
-    for (const auto &p : toQueue)
-      releaseQueue.push_back(p);
+    double earliestMs = RealtimeScheduler::idle;
+    for (const auto &p : toQueue) {
+      queuePendingNoteOff(p.channel, p.note, p.targetTimeMs);
+      earliestMs = std::min(earliestMs, p.targetTimeMs);
+    }
+    scheduler->scheduleAt(*this, earliestMs);
   }
 }
 
@@ -715,6 +692,8 @@ void VoiceManager::handleKeyUp(InputID source, int releaseDurationMs,
       release.durationMs = releaseDurationMs;
       release.shouldSustain = false;
       pendingReleases[source] = release;
+      scheduler->scheduleAt(*this,
+                            release.releaseTimeMs + release.durationMs);
     }
     // Sustain mode: Don't send noteOff, let notes continue naturally
     // No need to track - notes will just continue playing
@@ -731,35 +710,38 @@ void VoiceManager::cancelPendingRelease(InputID source) {
   if (it != pendingReleases.end()) {
     // Send immediate note-off for any voices with this source
     {
-      juce::ScopedLock voicesLockGuard(voicesLock);
-      for (auto voiceIt = voices.begin(); voiceIt != voices.end();) {
-        if (voiceIt->source.deviceHandle == source.deviceHandle &&
-            voiceIt->source.keyCode == source.keyCode) {
-          midiEngine.sendNoteOff(voiceIt->midiChannel, voiceIt->noteNumber);
-          voiceIt = voices.erase(voiceIt);
-        } else {
-          ++voiceIt;
-        }
-      }
+      VoicesWriteLock voicesLockGuard(*this);
+      killVoicesFromSource(source, true);
     }
     // Remove the pending release
     pendingReleases.erase(it);
   }
 }
 
-void VoiceManager::hiResTimerCallback() {
-  double now = getCurrentTimeMs();
+double VoiceManager::onSchedulerTick(double nowMs) {
+  const double now = nowMs;
+  double next = RealtimeScheduler::idle;
 
   {
     juce::ScopedLock releasesLockGuard(releasesLock);
 
-    auto it = releaseQueue.begin();
-    while (it != releaseQueue.end()) {
-      if (it->targetTimeMs <= now) {
-        midiEngine.sendNoteOff(it->channel, it->note);
-        it = releaseQueue.erase(it);
-      } else {
-        ++it;
+    for (size_t w = 0; w < pendingNoteOffBits.size(); ++w) {
+      uint64_t bits = pendingNoteOffBits[w];
+      while (bits != 0) {
+        const int slot = (int)w * 64 + std::countr_zero(bits);
+        const uint64_t bit = bits & (~bits + 1);
+        bits &= bits - 1;
+        const int channel = slot / 128 + 1;
+        const int note = slot % 128;
+        const double targetTimeMs = pendingNoteOffAtMs[(size_t)slot];
+        // Not handed to the output thread early: a retrigger before the
+        // release is due must still be able to cancel it.
+        if (targetTimeMs <= now) {
+          midiEngine.sendNoteOff(channel, note);
+          pendingNoteOffBits[w] &= ~bit;
+        } else {
+          next = std::min(next, targetTimeMs);
+        }
       }
     }
 
@@ -772,29 +754,24 @@ void VoiceManager::hiResTimerCallback() {
         InputID source = prIt->first;
         prIt = pendingReleases.erase(prIt);
 
-        juce::ScopedLock voicesLockGuard(voicesLock);
-        for (auto voiceIt = voices.begin(); voiceIt != voices.end();) {
-          if (voiceIt->source.deviceHandle == source.deviceHandle &&
-              voiceIt->source.keyCode == source.keyCode) {
-            if (globalLatchActive) {
-              voiceIt->state = VoiceState::Latched;
-              ++voiceIt;
-            } else if (globalSustainActive && voiceIt->allowSustain) {
-              voiceIt->state = VoiceState::Sustained;
-              ++voiceIt;
-            } else {
-              midiEngine.sendNoteOff(voiceIt->midiChannel, voiceIt->noteNumber);
-              voiceIt = voices.erase(voiceIt);
-            }
+        VoicesWriteLock voicesLockGuard(*this);
+        voices.forEachFromSource(source, [this](int i) {
+          if (globalLatchActive) {
+            voices.setState(i, VoiceState::Latched);
+          } else if (globalSustainActive && voices[i].allowSustain) {
+            voices.setState(i, VoiceState::Sustained);
           } else {
-            ++voiceIt;
+            midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+            voices.remove(i);
           }
-        }
+        });
       } else {
+        next = std::min(next, expirationTime);
         ++prIt;
       }
     }
   }
+  return next;
 }
 
 double VoiceManager::getCurrentTimeMs() const {
@@ -809,46 +786,35 @@ void VoiceManager::timerCallback() {
   if (tryLock.isLocked()) {
     juce::ScopedLock stackLock(monoStackLock);
 
-    // 1. Iterate over all active voices
-    juce::ScopedLock lock(voicesLock);
-    for (auto it = voices.begin(); it != voices.end();) {
-      // Only care about Mono/Legato voices (Poly handles itself)
-      // If Stack is tracked for this channel, we use Stack logic.
-
-      int ch = it->midiChannel;
-      bool channelHasStack = (monoStacks.count(ch) > 0);
-
-      if (channelHasStack) {
-        bool stackEmpty = monoStacks[ch].empty();
-        bool sustainActive = globalSustainActive && it->allowSustain;
-        bool latched = (it->state == VoiceState::Latched);
+    // 1. Iterate over the voices of every channel with a tracked stack
+    // (only Mono/Legato voices; Poly handles itself)
+    VoicesWriteLock lock(*this);
+    for (const auto &[ch, stack] : monoStacks) {
+      if (!stack.empty())
+        continue;
+      voices.forEachOnChannel(ch, [this, ch = ch](int i) {
+        bool sustainActive = globalSustainActive && voices[i].allowSustain;
+        bool latched = (voices[i].state == VoiceState::Latched);
 
         // ZOMBIE CONDITION:
         // Stack is Empty AND Not Sustained AND Not Latched.
-        if (stackEmpty && !sustainActive && !latched) {
+        if (!sustainActive && !latched) {
           // Kill it.
-          midiEngine.sendNoteOff(ch, it->noteNumber);
+          midiEngine.sendNoteOff(ch, voices[i].noteNumber);
           midiEngine.sendPitchBend(ch, 8192); // Reset PB
 
-          // Force stop glide if on this channel
-          // Check if portamento is active and on this channel
-          if (portamentoEngine.isActive()) {
-            portamentoEngine.stop();
-          }
+          // Force stop this channel's glide
+          portamentoEngine.stop(ch);
 
-          // Remove from vector
-          it = voices.erase(it);
-          continue; // Loop continues
+          voices.remove(i);
         }
-      }
-
-      ++it;
+      });
     }
   }
 }
 
 void VoiceManager::setSustain(bool active) {
-  juce::ScopedLock lock(voicesLock);
+  VoicesWriteLock lock(*this);
   bool wasActive = globalSustainActive;
   globalSustainActive = active;
 
@@ -859,16 +825,17 @@ void VoiceManager::setSustain(bool active) {
     // Only send one NoteOff per unique (channel, note) - multiple presses
     // of the same key create multiple Sustained voices, but MIDI needs
     // exactly one NoteOff per note
-    std::set<std::pair<int, int>> sentNoteOffs;
-    for (auto it = voices.begin(); it != voices.end();) {
-      if (it->state == VoiceState::Sustained) {
-        auto key = std::make_pair(it->midiChannel, it->noteNumber);
-        if (sentNoteOffs.insert(key).second)
-          midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-        it = voices.erase(it);
-      } else
-        ++it;
-    }
+    std::bitset<16 * 128> sentNoteOffs;
+    voices.forEachInState(VoiceState::Sustained, [&](int i) {
+      const auto &voice = voices[i];
+      const size_t key =
+          (size_t)(voice.midiChannel - 1) * 128 + (size_t)voice.noteNumber;
+      if (!sentNoteOffs.test(key)) {
+        sentNoteOffs.set(key);
+        midiEngine.sendNoteOff(voice.midiChannel, voice.noteNumber);
+      }
+      voices.remove(i);
+    });
   }
 }
 
@@ -880,17 +847,17 @@ void VoiceManager::panic() {
 
   // 1. Manually kill every tracked note (Robust)
   {
-    juce::ScopedLock lock(voicesLock);
-    for (const auto &voice : voices) {
+    VoicesWriteLock lock(*this);
+    voices.forEachVoice([this](int i) {
       // Send NoteOff for every voice (Playing, Sustained, Latched)
-      midiEngine.sendNoteOff(voice.midiChannel, voice.noteNumber);
-    }
+      midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    });
     // 2. Clear Internal State
     voices.clear();
   }
 
   // Phase 26.5: Stop portamento engine and reset PB on all channels
-  portamentoEngine.stop();
+  portamentoEngine.stopAll();
   for (int ch = 1; ch <= 16; ++ch) {
     midiEngine.sendPitchBend(ch, 8192);
   }
@@ -905,12 +872,15 @@ void VoiceManager::panic() {
   {
     juce::ScopedLock lock(releasesLock);
     pendingReleases.clear();
-    releaseQueue.clear();
+    pendingNoteOffBits.fill(0);
   }
 
   // 3. Reset Performance Flags
-  globalSustainActive = false;
-  globalLatchActive = false;
+  {
+    VoicesWriteLock lock(*this);
+    globalSustainActive = false;
+    globalLatchActive = false;
+  }
 
   // 4. Send MIDI Panic (Backup) - All Notes Off on all 16 channels
   for (int ch = 1; ch <= 16; ++ch) {
@@ -921,29 +891,42 @@ void VoiceManager::panic() {
 }
 
 void VoiceManager::panicLatch() {
-  juce::ScopedLock lock(voicesLock);
-  for (auto it = voices.begin(); it != voices.end();) {
-    if (it->state == VoiceState::Latched) {
-      midiEngine.sendNoteOff(it->midiChannel, it->noteNumber);
-      it = voices.erase(it);
-    } else
-      ++it;
-  }
+  VoicesWriteLock lock(*this);
+  voices.forEachInState(VoiceState::Latched, [this](int i) {
+    midiEngine.sendNoteOff(voices[i].midiChannel, voices[i].noteNumber);
+    voices.remove(i);
+  });
 }
 
 void VoiceManager::resetPerformanceState() {
+  VoicesWriteLock lock(*this);
   globalSustainActive = false;
   globalLatchActive = false;
 }
 
+void VoiceManager::setLatch(bool active) {
+  VoicesWriteLock lock(*this);
+  globalLatchActive = active;
+}
+
 bool VoiceManager::isKeyLatched(int keyCode) const {
-  juce::ScopedLock lock(voicesLock);
-  for (const auto &voice : voices) {
-    if (voice.source.keyCode == keyCode && voice.state == VoiceState::Latched) {
-      return true;
-    }
-  }
-  return false;
+  return voiceSnapshot.read().isKeyLatched(keyCode);
+}
+
+void VoiceManager::publishVoiceSnapshot() {
+  VoiceSnapshot snap;
+  voices.forEachVoice([&](int i) {
+    const auto &voice = voices[i];
+    const auto plane = voice.state == VoiceState::Latched
+                           ? VoiceSnapshot::Latched
+                       : voice.state == VoiceState::Sustained
+                           ? VoiceSnapshot::Sustained
+                           : VoiceSnapshot::Held;
+    snap.setKey(plane, voice.source.keyCode);
+    snap.setNote(plane, voice.midiChannel, voice.noteNumber);
+  });
+  snap.setFlags(globalSustainActive, globalLatchActive);
+  voiceSnapshot.publish(snap);
 }
 
 void VoiceManager::sendCC(int channel, int controller, int value) {
@@ -2,16 +2,20 @@
 #include "MappingTypes.h"
 #include "MidiEngine.h"
 #include "PortamentoEngine.h"
+#include "RealtimeScheduler.h"
 #include "SettingsManager.h"
 #include "StrumEngine.h"
+#include "VoiceSnapshot.h"
+#include "VoiceTable.h"
 #include <JuceHeader.h>
 #include <array>
 #include <deque>
 #include <functional>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
-class VoiceManager : public juce::HighResolutionTimer,
+class VoiceManager : public RealtimeScheduler::Client,
                      public juce::Timer,
                      public juce::ChangeListener,
                      public juce::ChangeBroadcaster {
@@ -25,8 +29,9 @@ public:
               PolyphonyMode polyMode = PolyphonyMode::Poly,
               int glideTimeMs = 50, bool alwaysLatch = false,
               bool sustainUntilRetrigger = false);
-  void noteOn(InputID source, const std::vector<int> &notes,
-              const std::vector<int> &velocities, int channel, int strumSpeedMs,
+  // Chord / strum. Missing velocities repeat velocities[0] (100 if none).
+  void noteOn(InputID source, std::span<const int> notes,
+              std::span<const int> velocities, int channel, int strumSpeedMs,
               bool allowSustain = true, int releaseMs = 0,
               PolyphonyMode polyMode = PolyphonyMode::Poly,
               int glideTimeMs = 50, int strumPattern = 0,
@@ -52,12 +57,17 @@ public:
   bool isSustainActive() const { return globalSustainActive; }
 
   // --- Latch (toggle hold) ---
-  void setLatch(bool active) { globalLatchActive = active; }
+  void setLatch(bool active);
   bool isLatchActive() const { return globalLatchActive; }
 
-  // Check if a specific key code has any latched voices
+  // Check if a specific key code has any latched voices (lock-free; for a
+  // whole frame prefer one getVoiceSnapshot()).
   bool isKeyLatched(int keyCode) const;
 
+  // Held / sustained / latched state per key code and per channel/note, as
+  // of the last change. Lock-free; for the visualizer and other UI readers.
+  VoiceSnapshot getVoiceSnapshot() const { return voiceSnapshot.read(); }
+
   // --- Panic ---
   void panic();
   void panicLatch();
@@ -82,26 +92,26 @@ private:
   int getMonoStackTop(int channel) const; // Returns -1 if empty
   std::pair<int, InputID>
   getMonoStackTopWithSource(int channel) const; // Returns {-1, {0,0}} if empty
-  enum class VoiceState { Playing, Sustained, Latched };
-
-  struct ActiveVoice {
-    int noteNumber;
-    int midiChannel;
-    InputID source;
-    bool allowSustain;
-    bool alwaysLatch =
-        false; // If true, latch on release (ignores global latch)
-    VoiceState state;
-    int releaseMs = 0; // Zone release envelope; 0 = instant NoteOff
-    PolyphonyMode polyphonyMode =
-        PolyphonyMode::Poly; // Polyphony mode for this voice (Phase 26.3)
-  };
+  using VoiceState = VoiceTable::State;
+  using ActiveVoice = VoiceTable::Voice;
+
+  // Voice table helpers; caller holds voicesLock (via VoicesWriteLock).
+  // addVoice steals a voice (Sustained, then Latched, then Playing) when the
+  // table is full.
+  void addVoice(const ActiveVoice &voice);
+  void killVoicesOnChannel(int channel);
+  void killVoicesOnNote(int channel, int note);
+  void killVoicesFromSource(InputID source, bool sendNoteOffs);
+
+  // Delayed NoteOff table helpers; caller holds releasesLock.
+  void cancelPendingNoteOff(int channel, int note);
+  void queuePendingNoteOff(int channel, int note, double targetTimeMs);
 
   void addVoiceFromStrum(InputID source, int note, int channel,
                          bool allowSustain);
 
-  // HighResolutionTimer callback - checks for expired releases
-  void hiResTimerCallback() override;
+  // Scheduler tick - sends due delayed NoteOffs and expired releases
+  double onSchedulerTick(double nowMs) override;
 
   // Timer callback - Watchdog for stuck notes (Phase 26.6)
   void timerCallback() override;
@@ -122,12 +132,37 @@ private:
   SettingsManager &settingsManager;
   StrumEngine strumEngine;
   PortamentoEngine portamentoEngine;
-  mutable std::vector<ActiveVoice> voices;  // Mutable for const accessors
+  VoiceTable voices;
   mutable juce::CriticalSection voicesLock; // Mutable for const accessors
+  VoiceSnapshotBuffer voiceSnapshot;        // Republished on every change
+
+  // Rebuilds and publishes voiceSnapshot. Caller holds voicesLock.
+  void publishVoiceSnapshot();
+
+  // Scoped voicesLock for code that mutates voices or the sustain / latch
+  // flags: republishes the snapshot before unlocking.
+  class VoicesWriteLock {
+  public:
+    explicit VoicesWriteLock(VoiceManager &vm) : owner(vm) {
+      owner.voicesLock.enter();
+    }
+    ~VoicesWriteLock() {
+      owner.publishVoiceSnapshot();
+      owner.voicesLock.exit();
+    }
+
+  private:
+    VoiceManager &owner;
+    JUCE_DECLARE_NON_COPYABLE(VoicesWriteLock)
+  };
   std::unordered_map<InputID, PendingRelease>
       pendingReleases; // Track releases waiting for expiration
-  std::vector<PendingNoteOff> releaseQueue; // Delayed NoteOff (Phase 21.3)
+  // Delayed NoteOff (Phase 21.3), one slot per (channel - 1) * 128 + note.
+  // A set bit marks a pending NoteOff due at pendingNoteOffAtMs[slot].
+  std::array<double, 16 * 128> pendingNoteOffAtMs{};
+  std::array<uint64_t, 16 * 128 / 64> pendingNoteOffBits{};
   juce::CriticalSection releasesLock;
+  juce::SharedResourcePointer<RealtimeScheduler> scheduler;
 
   bool globalSustainActive = false;
   bool globalLatchActive = false;
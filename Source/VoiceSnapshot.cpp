@@ -0,0 +1,28 @@
+#include "VoiceSnapshot.h"
+
+void VoiceSnapshotBuffer::publish(const VoiceSnapshot &snapshot) {
+  const int next = 1 - current.load(std::memory_order_relaxed);
+  Slot &slot = slots[next];
+  const uint32_t seq = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < snapshot.words.size(); ++i)
+    slot.words[i].store(snapshot.words[i], std::memory_order_relaxed);
+  slot.sequence.store(seq + 2, std::memory_order_release);
+  current.store(next, std::memory_order_release);
+}
+
+VoiceSnapshot VoiceSnapshotBuffer::read() const {
+  VoiceSnapshot out;
+  for (;;) {
+    const Slot &slot = slots[current.load(std::memory_order_acquire)];
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1u)
+      continue; // Writer is mid-update of this slot
+    for (size_t i = 0; i < out.words.size(); ++i)
+      out.words[i] = slot.words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == before)
+      return out;
+  }
+}
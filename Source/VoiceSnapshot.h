@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Point-in-time view of VoiceManager state for the UI: which key codes and
+// (channel, note) pairs have Playing (held), Sustained or Latched voices,
+// plus the global sustain / latch flags. Plain bitsets, cheap to copy.
+struct VoiceSnapshot {
+  enum Plane { Held = 0, Sustained, Latched, kNumPlanes };
+
+  static constexpr int kNumKeyCodes = 256; // Keyboard VK range
+  static constexpr int kNumChannels = 16;
+  static constexpr int kNumNotes = 128;
+  static constexpr int kKeyWords = kNumKeyCodes / 64;
+  static constexpr int kNoteWords = kNumChannels * kNumNotes / 64;
+  static constexpr int kPlaneWords = kKeyWords + kNoteWords;
+  static constexpr int kFlagsWord = kNumPlanes * kPlaneWords;
+  static constexpr int kNumWords = kFlagsWord + 1;
+
+  std::array<uint64_t, kNumWords> words{};
+
+  // keyCode outside [0, 256) reads false / is ignored.
+  bool key(Plane plane, int keyCode) const {
+    if (keyCode < 0 || keyCode >= kNumKeyCodes)
+      return false;
+    return test(plane * kPlaneWords, keyCode);
+  }
+  // channel is 1-16; out of range reads false / is ignored.
+  bool note(Plane plane, int channel, int noteNumber) const {
+    const int bit = noteBit(channel, noteNumber);
+    return bit >= 0 && test(plane * kPlaneWords + kKeyWords, bit);
+  }
+  bool isKeyHeld(int keyCode) const { return key(Held, keyCode); }
+  bool isKeySustained(int keyCode) const { return key(Sustained, keyCode); }
+  bool isKeyLatched(int keyCode) const { return key(Latched, keyCode); }
+  bool isSustainActive() const { return (words[kFlagsWord] & 1u) != 0; }
+  bool isLatchActive() const { return (words[kFlagsWord] & 2u) != 0; }
+
+  void setKey(Plane plane, int keyCode) {
+    if (keyCode >= 0 && keyCode < kNumKeyCodes)
+      set(plane * kPlaneWords, keyCode);
+  }
+  void setNote(Plane plane, int channel, int noteNumber) {
+    const int bit = noteBit(channel, noteNumber);
+    if (bit >= 0)
+      set(plane * kPlaneWords + kKeyWords, bit);
+  }
+  void setFlags(bool sustainActive, bool latchActive) {
+    words[kFlagsWord] = (sustainActive ? 1u : 0u) | (latchActive ? 2u : 0u);
+  }
+
+private:
+  static int noteBit(int channel, int noteNumber) {
+    if (channel < 1 || channel > kNumChannels || noteNumber < 0 ||
+        noteNumber >= kNumNotes)
+      return -1;
+    return (channel - 1) * kNumNotes + noteNumber;
+  }
+  bool test(int base, int bit) const {
+    return (words[(size_t)(base + bit / 64)] >> (bit % 64)) & 1u;
+  }
+  void set(int base, int bit) {
+    words[(size_t)(base + bit / 64)] |= uint64_t(1) << (bit % 64);
+  }
+};
+
+// Double-buffered seqlock around a VoiceSnapshot. The writer fills the slot
+// readers are not pointed at, then flips 'current'; readers copy the current
+// slot and retry only if it was rewritten meanwhile (two publishes during one
+// read). Readers never block writers and take no locks. Words are relaxed
+// atomics, so a torn read is detected rather than being a data race.
+class VoiceSnapshotBuffer {
+public:
+  // Writers must be serialized by the caller (VoiceManager holds voicesLock).
+  void publish(const VoiceSnapshot &snapshot);
+  // Any thread, wait-free in practice.
+  VoiceSnapshot read() const;
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence{0}; // Odd while being written
+    std::array<std::atomic<uint64_t>, VoiceSnapshot::kNumWords> words{};
+  };
+
+  Slot slots[2];
+  std::atomic<int> current{0};
+};
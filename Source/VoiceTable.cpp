@@ -0,0 +1,186 @@
+#include "VoiceTable.h"
+#include <algorithm>
+#include <functional>
+
+VoiceTable::VoiceTable() {
+  nodes.resize((size_t)kCapacity);
+  sources.resize((size_t)kSourceSlots);
+  noteHead.fill(kNone);
+}
+
+size_t VoiceTable::homeSlot(InputID source) {
+  // Fibonacci mix on top of std::hash: key codes are small and dense.
+  const uint64_t h = (uint64_t)std::hash<InputID>{}(source);
+  return (size_t)((h * 0x9E3779B97F4A7C15ull) >> 32) & (kSourceSlots - 1);
+}
+
+int VoiceTable::findSourceSlot(InputID source) const {
+  for (size_t s = homeSlot(source);; s = (s + 1) & (kSourceSlots - 1)) {
+    const auto &entry = sources[s];
+    if (entry.head == kNone)
+      return kNone;
+    if (entry.source == source)
+      return (int)s;
+  }
+}
+
+void VoiceTable::eraseSourceSlot(int slot) {
+  // Backward-shift deletion keeps probe chains intact without tombstones.
+  size_t hole = (size_t)slot;
+  sources[hole] = SourceEntry{};
+  for (size_t s = (hole + 1) & (kSourceSlots - 1); sources[s].head != kNone;
+       s = (s + 1) & (kSourceSlots - 1)) {
+    const size_t home = homeSlot(sources[s].source);
+    // Move the entry back if its home is not in the (hole, s] range.
+    const bool homeInRange = (hole <= s) ? (hole < home && home <= s)
+                                         : (hole < home || home <= s);
+    if (!homeInRange) {
+      sources[hole] = sources[s];
+      sources[s] = SourceEntry{};
+      hole = s;
+    }
+  }
+}
+
+int VoiceTable::add(const Voice &voice) {
+  const int slot = noteSlot(voice.midiChannel, voice.noteNumber);
+  if (slot == kNone || count == kCapacity)
+    return kNone;
+
+  int index = kNone;
+  for (int w = 0; w < kWords; ++w) {
+    if (used[(size_t)w] != ~uint64_t(0)) {
+      index = w * 64 + std::countr_zero(~used[(size_t)w]);
+      break;
+    }
+  }
+
+  Node &node = nodes[(size_t)index];
+  node.voice = voice;
+
+  // (channel, note) list: push front
+  node.prevNote = kNone;
+  node.nextNote = noteHead[(size_t)slot];
+  if (node.nextNote != kNone)
+    nodes[(size_t)node.nextNote].prevNote = index;
+  noteHead[(size_t)slot] = index;
+  channelNotes[(size_t)((voice.midiChannel - 1) * 2 + voice.noteNumber / 64)] |=
+      uint64_t(1) << (voice.noteNumber % 64);
+
+  // Source list: append (keeps press order for release handling)
+  size_t s = homeSlot(voice.source);
+  while (sources[s].head != kNone && !(sources[s].source == voice.source))
+    s = (s + 1) & (kSourceSlots - 1);
+  auto &entry = sources[s];
+  node.nextSource = kNone;
+  if (entry.head == kNone) {
+    entry.source = voice.source;
+    entry.head = index;
+    node.prevSource = kNone;
+  } else {
+    node.prevSource = entry.tail;
+    nodes[(size_t)entry.tail].nextSource = index;
+  }
+  entry.tail = index;
+
+  setBit(used, index);
+  setBit(stateBits[(size_t)voice.state], index);
+  ++count;
+  return index;
+}
+
+void VoiceTable::remove(int index) {
+  Node &node = nodes[(size_t)index];
+  const Voice &voice = node.voice;
+
+  const int slot = noteSlot(voice.midiChannel, voice.noteNumber);
+  if (node.prevNote != kNone)
+    nodes[(size_t)node.prevNote].nextNote = node.nextNote;
+  else
+    noteHead[(size_t)slot] = node.nextNote;
+  if (node.nextNote != kNone)
+    nodes[(size_t)node.nextNote].prevNote = node.prevNote;
+  if (noteHead[(size_t)slot] == kNone)
+    channelNotes[(size_t)((voice.midiChannel - 1) * 2 +
+                          voice.noteNumber / 64)] &=
+        ~(uint64_t(1) << (voice.noteNumber % 64));
+
+  const int sourceSlot = findSourceSlot(voice.source);
+  auto &entry = sources[(size_t)sourceSlot];
+  if (node.prevSource != kNone)
+    nodes[(size_t)node.prevSource].nextSource = node.nextSource;
+  else
+    entry.head = node.nextSource;
+  if (node.nextSource != kNone)
+    nodes[(size_t)node.nextSource].prevSource = node.prevSource;
+  else
+    entry.tail = node.prevSource;
+  if (entry.head == kNone)
+    eraseSourceSlot(sourceSlot);
+
+  clearBit(used, index);
+  clearBit(stateBits[(size_t)voice.state], index);
+  node.prevNote = node.nextNote = node.prevSource = node.nextSource = kNone;
+  --count;
+}
+
+void VoiceTable::setState(int index, State state) {
+  Voice &voice = nodes[(size_t)index].voice;
+  if (voice.state == state)
+    return;
+  clearBit(stateBits[(size_t)voice.state], index);
+  voice.state = state;
+  setBit(stateBits[(size_t)state], index);
+}
+
+void VoiceTable::clear() {
+  if (count == 0)
+    return;
+  // Links of unused nodes are rewritten by add(); only the indexes reset.
+  std::fill(sources.begin(), sources.end(), SourceEntry{});
+  noteHead.fill(kNone);
+  channelNotes.fill(0);
+  used.fill(0);
+  for (auto &bits : stateBits)
+    bits.fill(0);
+  count = 0;
+}
+
+bool VoiceTable::anyFromSource(InputID source, uint8_t stateBitsMask) const {
+  const int slot = findSourceSlot(source);
+  if (slot == kNone)
+    return false;
+  for (int i = sources[(size_t)slot].head; i != kNone;
+       i = nodes[(size_t)i].nextSource) {
+    if (stateBitsMask & stateMask(nodes[(size_t)i].voice.state))
+      return true;
+  }
+  return false;
+}
+
+int VoiceTable::findOnChannel(int channel, State state) const {
+  if (channel < 1 || channel > kNumChannels)
+    return kNone;
+  for (int w = 0; w < 2; ++w) {
+    uint64_t bits = channelNotes[(size_t)((channel - 1) * 2 + w)];
+    while (bits != 0) {
+      const int note = w * 64 + std::countr_zero(bits);
+      bits &= bits - 1;
+      for (int i = noteHead[(size_t)noteSlot(channel, note)]; i != kNone;
+           i = nodes[(size_t)i].nextNote) {
+        if (nodes[(size_t)i].voice.state == state)
+          return i;
+      }
+    }
+  }
+  return kNone;
+}
+
+int VoiceTable::firstInState(State state) const {
+  const auto &bits = stateBits[(size_t)state];
+  for (int w = 0; w < kWords; ++w) {
+    if (bits[(size_t)w] != 0)
+      return w * 64 + std::countr_zero(bits[(size_t)w]);
+  }
+  return kNone;
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include "MappingTypes.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity table of tracked voices for VoiceManager. Every voice sits in
+// a pooled node that is linked into two intrusive lists, one per
+// (channel, note) slot and one per input source. It is also flagged in a
+// per-state bitset. Adding or removing a voice is O(1). Lookups by source or
+// note, and sweeps over one state (e.g. sustain pedal up), only visit the
+// voices they concern. Nothing allocates after construction.
+//
+// Several voices may share a (channel, note) slot or a source (e.g. repeated
+// presses while the pedal is down), exactly as with the old flat vector.
+class VoiceTable {
+public:
+  static constexpr int kCapacity = 1024;
+  static constexpr int kNone = -1;
+  static constexpr int kNumChannels = 16;
+  static constexpr int kNumNotes = 128;
+
+  enum class State : uint8_t { Playing = 0, Sustained, Latched };
+  static constexpr uint8_t stateMask(State s) {
+    return (uint8_t)(1u << (unsigned)s);
+  }
+
+  struct Voice {
+    int noteNumber = 0;
+    int midiChannel = 1; // 1-16
+    InputID source{0, 0};
+    bool allowSustain = true;
+    bool alwaysLatch = false; // If true, latch on release (ignores global)
+    State state = State::Playing;
+    int releaseMs = 0; // Zone release envelope; 0 = instant NoteOff
+    PolyphonyMode polyphonyMode = PolyphonyMode::Poly;
+  };
+
+  VoiceTable();
+
+  // Returns the new voice's index, or kNone if the table is full (or the
+  // channel / note is out of MIDI range).
+  int add(const Voice &voice);
+  void remove(int index);
+  void setState(int index, State state);
+  void clear();
+
+  const Voice &operator[](int index) const {
+    return nodes[(size_t)index].voice;
+  }
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool isFull() const { return count == kCapacity; }
+
+  // True if the source has a voice in any state of stateBits (stateMask()s).
+  bool anyFromSource(InputID source, uint8_t stateBits) const;
+  // First voice in 'state' on the channel (lowest note first), or kNone.
+  int findOnChannel(int channel, State state) const;
+  // Any voice in 'state' (lowest index first), or kNone.
+  int firstInState(State state) const;
+
+  // Visitors receive a voice index and may remove that voice (only that
+  // one) or change its state. Voices added during a visit may be skipped.
+  template <typename Fn> void forEachFromSource(InputID source, Fn &&fn) const {
+    const int slot = findSourceSlot(source);
+    if (slot == kNone)
+      return;
+    for (int i = sources[(size_t)slot].head; i != kNone;) {
+      const int next = nodes[(size_t)i].nextSource;
+      fn(i);
+      i = next;
+    }
+  }
+  template <typename Fn>
+  void forEachOnNote(int channel, int note, Fn &&fn) const {
+    const int slot = noteSlot(channel, note);
+    if (slot == kNone)
+      return;
+    for (int i = noteHead[(size_t)slot]; i != kNone;) {
+      const int next = nodes[(size_t)i].nextNote;
+      fn(i);
+      i = next;
+    }
+  }
+  template <typename Fn> void forEachOnChannel(int channel, Fn &&fn) const {
+    if (channel < 1 || channel > kNumChannels)
+      return;
+    for (int w = 0; w < 2; ++w) {
+      uint64_t bits = channelNotes[(size_t)((channel - 1) * 2 + w)];
+      while (bits != 0) {
+        const int note = w * 64 + std::countr_zero(bits);
+        bits &= bits - 1;
+        forEachOnNote(channel, note, fn);
+      }
+    }
+  }
+  template <typename Fn> void forEachInState(State state, Fn &&fn) const {
+    forEachBit(stateBits[(size_t)state], fn);
+  }
+  template <typename Fn> void forEachVoice(Fn &&fn) const {
+    forEachBit(used, fn);
+  }
+
+private:
+  static constexpr int kWords = kCapacity / 64;
+  static constexpr int kSourceSlots = kCapacity * 2; // Load factor <= 0.5
+  using Bits = std::array<uint64_t, kWords>;
+
+  struct Node {
+    Voice voice;
+    int prevNote = kNone, nextNote = kNone;
+    int prevSource = kNone, nextSource = kNone;
+  };
+  // Open-addressed (linear probing) source -> voice list. head == kNone
+  // marks an empty slot.
+  struct SourceEntry {
+    InputID source{0, 0};
+    int head = kNone;
+    int tail = kNone;
+  };
+
+  template <typename Fn> static void forEachBit(const Bits &set, Fn &fn) {
+    for (int w = 0; w < kWords; ++w) {
+      uint64_t bits = set[(size_t)w];
+      while (bits != 0) {
+        const int index = w * 64 + std::countr_zero(bits);
+        bits &= bits - 1;
+        fn(index);
+      }
+    }
+  }
+  static void setBit(Bits &set, int i) {
+    set[(size_t)(i / 64)] |= uint64_t(1) << (i % 64);
+  }
+  static void clearBit(Bits &set, int i) {
+    set[(size_t)(i / 64)] &= ~(uint64_t(1) << (i % 64));
+  }
+  static int noteSlot(int channel, int note) {
+    if (channel < 1 || channel > kNumChannels || note < 0 || note >= kNumNotes)
+      return kNone;
+    return (channel - 1) * kNumNotes + note;
+  }
+  static size_t homeSlot(InputID source);
+  int findSourceSlot(InputID source) const;
+  void eraseSourceSlot(int slot);
+
+  std::vector<Node> nodes;
+  std::vector<SourceEntry> sources;
+  std::array<int, kNumChannels * kNumNotes> noteHead;
+  std::array<uint64_t, kNumChannels * 2> channelNotes{}; // Occupied notes
+  Bits used{};
+  std::array<Bits, 3> stateBits{};
+  int count = 0;
+};
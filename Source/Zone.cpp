@@ -16,6 +16,44 @@ Zone::Zone()
 
 void Zone::rebuildCache(const std::vector<int> &scaleIntervals,
                         int effectiveRoot) {
+  buildChordCache(scaleIntervals, effectiveRoot);
+
+  cacheScaleIntervals = scaleIntervals;
+  keyToTransposedChord.clear();
+  for (const auto &[keyCode, notes] : keyToChordCache)
+    fillTransposedChord(notes, keyToTransposedChord[keyCode]);
+}
+
+void Zone::setGlobalTranspose(int chromatic, int degree) {
+  if (chromatic == cacheChromaticTranspose && degree == cacheDegreeTranspose)
+    return;
+  cacheChromaticTranspose = chromatic;
+  cacheDegreeTranspose = degree;
+  // Same key set: overwrite entries in place (no rehash under a reader).
+  for (auto &[keyCode, chord] : keyToTransposedChord) {
+    auto it = keyToChordCache.find(keyCode);
+    if (it != keyToChordCache.end())
+      fillTransposedChord(it->second, chord);
+  }
+}
+
+void Zone::fillTransposedChord(
+    const std::vector<ChordUtilities::ChordNote> &notes,
+    TransposedChord &out) const {
+  jassert(notes.size() <= (size_t)TransposedChord::kMaxNotes);
+  const auto *intervals =
+      cacheScaleIntervals.empty() ? nullptr : &cacheScaleIntervals;
+  out.size = (int)std::min(notes.size(), (size_t)TransposedChord::kMaxNotes);
+  for (int i = 0; i < out.size; ++i) {
+    const auto &cn = notes[(size_t)i];
+    out.pitch[(size_t)i] = transposeNote(cn.pitch, cacheChromaticTranspose,
+                                         cacheDegreeTranspose, intervals);
+    out.isGhost[(size_t)i] = cn.isGhost;
+  }
+}
+
+void Zone::buildChordCache(const std::vector<int> &scaleIntervals,
+                           int effectiveRoot) {
   keyToChordCache.clear();
   keyToLabelCache.clear();
   cacheEffectiveRoot = effectiveRoot;
@@ -335,6 +373,25 @@ void Zone::rebuildCache(const std::vector<int> &scaleIntervals,
   }
 }
 
+int Zone::transposeNote(int relativePitch, int globalChromTrans,
+                        int globalDegTrans,
+                        const std::vector<int> *scaleIntervals) const {
+  int effChromTrans = ignoreGlobalTranspose ? 0 : globalChromTrans;
+  int effDegTrans = ignoreGlobalTranspose ? 0 : globalDegTrans;
+  if (scaleIntervals != nullptr && !scaleIntervals->empty() &&
+      effDegTrans != 0) {
+    int baseNote = cacheEffectiveRoot + relativePitch + chromaticOffset;
+    int degree = ScaleUtilities::findScaleDegree(baseNote, cacheEffectiveRoot,
+                                                 *scaleIntervals);
+    int noteInScale = ScaleUtilities::calculateMidiNote(
+        cacheEffectiveRoot, *scaleIntervals, degree + effDegTrans);
+    return juce::jlimit(0, 127, noteInScale + effChromTrans);
+  }
+  return juce::jlimit(0, 127,
+                      cacheEffectiveRoot + relativePitch + chromaticOffset +
+                          effChromTrans);
+}
+
 // Play-time: O(1) hash lookup + O(k) transpose apply (k = chord size, typically
 // 3–5). When scaleIntervals provided and degree transpose non-zero, applies
 // scale-degree shift via ScaleUtilities.
@@ -346,30 +403,13 @@ Zone::getNotesForKey(int keyCode, int globalChromTrans, int globalDegTrans,
     return std::nullopt;
 
   const std::vector<ChordUtilities::ChordNote> &relativeChordNotes = it->second;
-  int effChromTrans = ignoreGlobalTranspose ? 0 : globalChromTrans;
-  int effDegTrans = ignoreGlobalTranspose ? 0 : globalDegTrans;
-  bool applyDegreeTranspose = (scaleIntervals != nullptr &&
-                              !scaleIntervals->empty() && effDegTrans != 0);
-
   std::vector<ChordUtilities::ChordNote> finalChordNotes;
   finalChordNotes.reserve(relativeChordNotes.size());
   for (const auto &cn : relativeChordNotes) {
-    int finalNote;
-    if (applyDegreeTranspose) {
-      int baseNote =
-          cacheEffectiveRoot + cn.pitch + chromaticOffset;
-      int degree = ScaleUtilities::findScaleDegree(
-          baseNote, cacheEffectiveRoot, *scaleIntervals);
-      int newDegree = degree + effDegTrans;
-      int noteInScale =
-          ScaleUtilities::calculateMidiNote(cacheEffectiveRoot,
-                                            *scaleIntervals, newDegree);
-      finalNote = juce::jlimit(0, 127, noteInScale + effChromTrans);
-    } else {
-      finalNote = cacheEffectiveRoot + cn.pitch + chromaticOffset + effChromTrans;
-      finalNote = juce::jlimit(0, 127, finalNote);
-    }
-    finalChordNotes.emplace_back(finalNote, cn.isGhost);
+    finalChordNotes.emplace_back(
+        transposeNote(cn.pitch, globalChromTrans, globalDegTrans,
+                      scaleIntervals),
+        cn.isGhost);
   }
   return finalChordNotes;
 }
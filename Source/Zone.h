@@ -3,6 +3,7 @@
 #include "MappingTypes.h"
 #include "ScaleUtilities.h"
 #include <JuceHeader.h>
+#include <array>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -107,12 +108,31 @@ public:
       keyToLabelCache; // keyCode -> display label (note name or Roman numeral)
   int cacheEffectiveRoot =
       60; // Root used for last rebuild; getNotesForKey uses this
-
-  // Config-time: (re)build keyToChordCache when zone/scale/chord/keys change.
-  // Caller provides scaleIntervals and effectiveRoot (global or local per
-  // ZoneManager logic).
+  std::vector<int> cacheScaleIntervals; // Scale used for last rebuild
+
+  // Play-time chord for a key with the global transpose already applied:
+  // fixed capacity, so the note-on path never touches the heap.
+  struct TransposedChord {
+    static constexpr int kMaxNotes = 16;
+    std::array<int, kMaxNotes> pitch{};
+    std::array<bool, kMaxNotes> isGhost{};
+    int size = 0;
+  };
+  // keyCode -> keyToChordCache entry transposed by the current global
+  // chromatic/degree transpose (degree steps use cacheScaleIntervals).
+  std::unordered_map<int, TransposedChord> keyToTransposedChord;
+  int cacheChromaticTranspose = 0; // Global transpose baked into the above
+  int cacheDegreeTranspose = 0;
+
+  // Config-time: (re)build keyToChordCache and keyToTransposedChord when
+  // zone/scale/chord/keys change. Caller provides scaleIntervals and
+  // effectiveRoot (global or local per ZoneManager logic).
   void rebuildCache(const std::vector<int> &scaleIntervals, int effectiveRoot);
 
+  // Re-applies the global transpose to keyToTransposedChord (in place; no-op
+  // when unchanged). Called by ZoneManager when the global transpose changes.
+  void setGlobalTranspose(int chromatic, int degree);
+
   bool usesGlobalScale() const { return useGlobalScale; }
   bool usesGlobalRoot() const { return useGlobalRoot; }
 
@@ -124,6 +144,13 @@ public:
   getNotesForKey(int keyCode, int globalChromTrans, int globalDegTrans,
                  const std::vector<int> *scaleIntervals = nullptr);
 
+  // Play-time, allocation free: the key's chord under the current global
+  // transpose, or nullptr if the key is not in this zone.
+  const TransposedChord *getTransposedChord(int keyCode) const {
+    auto it = keyToTransposedChord.find(keyCode);
+    return it != keyToTransposedChord.end() ? &it->second : nullptr;
+  }
+
   // Get display label for a key (note name or Roman numeral)
   juce::String getKeyLabel(int keyCode) const;
 
@@ -144,4 +171,14 @@ public:
   // Serialization
   juce::ValueTree toValueTree() const;
   static std::shared_ptr<Zone> fromValueTree(const juce::ValueTree &vt);
+
+private:
+  // Fills keyToChordCache / keyToLabelCache (chord generation).
+  void buildChordCache(const std::vector<int> &scaleIntervals,
+                       int effectiveRoot);
+  // Final MIDI note for a cached (root-relative) chord note.
+  int transposeNote(int relativePitch, int globalChromTrans, int globalDegTrans,
+                    const std::vector<int> *scaleIntervals) const;
+  void fillTransposedChord(const std::vector<ChordUtilities::ChordNote> &notes,
+                           TransposedChord &out) const;
 };
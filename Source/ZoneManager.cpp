@@ -27,6 +27,7 @@ void ZoneManager::rebuildZoneCache(Zone *zone) {
   int root = zone->usesGlobalRoot()
                  ? (globalRootNote + 12 * zone->globalRootOctaveOffset)
                  : zone->rootNote;
+  zone->setGlobalTranspose(globalChromaticTranspose, globalDegreeTranspose);
   zone->rebuildCache(intervals, root);
 }
 
@@ -187,6 +188,8 @@ void ZoneManager::setGlobalTranspose(int chromatic, int degree) {
   juce::ScopedWriteLock lock(zoneLock);
   globalChromaticTranspose = chromatic;
   globalDegreeTranspose = degree;
+  for (const auto &zone : zones)
+    zone->setGlobalTranspose(chromatic, degree);
   sendChangeMessage();
 }
 